@@ -0,0 +1,149 @@
+ /**
+  * This module is for unit testing the le_arena module in the legato
+  * runtime library (liblegato.so).
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+#define NUM_SMALL_ALLOCS    1000
+#define LARGE_ALLOC_SIZE    (64 * 1024)
+
+
+// Checks that a block is suitably aligned and fills it so that overlapping blocks get caught.
+static void FillBlock(void* blockPtr, size_t size, uint8_t value)
+{
+    LE_ASSERT(((uintptr_t)blockPtr % sizeof(uint64_t)) == 0);
+    memset(blockPtr, value, size);
+}
+
+
+static void* ScratchThreadMain(void* contextPtr)
+{
+    le_arena_Ref_t scratch = le_arena_GetScratch();
+
+    // Every thread has its own scratch arena.
+    LE_ASSERT(scratch != contextPtr);
+    LE_ASSERT(le_arena_GetScratch() == scratch);
+
+    le_arena_Mark_t mark = le_arena_GetMark(scratch);
+    FillBlock(le_arena_Alloc(scratch, 100), 100, 0x55);
+    le_arena_Rewind(scratch, mark);
+
+    return NULL;
+}
+
+
+COMPONENT_INIT
+{
+    uint8_t* blocksPtr[NUM_SMALL_ALLOCS];
+    size_t i;
+
+    LE_TEST_INIT;
+
+    LE_INFO("\n");
+    LE_INFO("====  Unit test for  le_arena module. ====");
+
+
+    //
+    // Allocate lots of small blocks of different sizes, spanning several chunks.
+    //
+    le_arena_Ref_t arena = le_arena_Create("Test Arena");
+
+    for (i = 0; i < NUM_SMALL_ALLOCS; i++)
+    {
+        blocksPtr[i] = le_arena_Alloc(arena, (i % 37) + 1);
+        FillBlock(blocksPtr[i], (i % 37) + 1, (uint8_t)i);
+    }
+
+    bool intact = true;
+
+    for (i = 0; i < NUM_SMALL_ALLOCS; i++)
+    {
+        intact = intact && (blocksPtr[i][i % 37] == (uint8_t)i);
+    }
+    LE_TEST(intact);
+
+    char* strPtr = le_arena_StrDup(arena, "Hello arena");
+    LE_TEST(strcmp(strPtr, "Hello arena") == 0);
+
+    LE_INFO("Allocated small blocks correctly.");
+
+
+    //
+    // Large blocks get memory of their own.
+    //
+    uint8_t* largePtr = le_arena_Alloc(arena, LARGE_ALLOC_SIZE);
+    FillBlock(largePtr, LARGE_ALLOC_SIZE, 0xAA);
+    LE_TEST(blocksPtr[NUM_SMALL_ALLOCS - 1][0] == (uint8_t)(NUM_SMALL_ALLOCS - 1));
+
+    LE_INFO("Allocated large block correctly.");
+
+
+    //
+    // Rewinding to a mark gives back everything allocated after the mark.
+    //
+    le_arena_Mark_t mark = le_arena_GetMark(arena);
+    uint8_t* firstPtr = le_arena_Alloc(arena, 16);
+    le_arena_Alloc(arena, LARGE_ALLOC_SIZE);
+    le_arena_Rewind(arena, mark);
+
+    LE_TEST(le_arena_Alloc(arena, 16) == firstPtr);
+
+    LE_INFO("Rewound arena correctly.");
+
+
+    //
+    // Resetting re-uses the arena's chunks, without fetching new ones.
+    //
+    le_mem_PoolStats_t stats;
+    le_mem_PoolRef_t chunkPool = _le_mem_FindPool("framework", "ArenaChunk");
+    LE_TEST(chunkPool != NULL);
+
+    le_mem_GetStats(chunkPool, &stats);
+    size_t numChunks = stats.numBlocksInUse;
+
+    le_arena_Reset(arena);
+
+    bool reused = true;
+
+    for (i = 0; i < NUM_SMALL_ALLOCS; i++)
+    {
+        reused = reused && (le_arena_Alloc(arena, (i % 37) + 1) == blocksPtr[i]);
+    }
+    LE_TEST(reused);
+
+    le_mem_GetStats(chunkPool, &stats);
+    LE_TEST(stats.numBlocksInUse == numChunks);
+
+    LE_INFO("Reset arena correctly.");
+
+
+    //
+    // Deleting the arena gives its chunks back.
+    //
+    le_arena_Delete(arena);
+
+    le_mem_GetStats(chunkPool, &stats);
+    LE_TEST(stats.numBlocksInUse < numChunks);
+
+    LE_INFO("Deleted arena correctly.");
+
+
+    //
+    // Scratch arenas are per-thread.
+    //
+    pthread_t thread;
+    le_arena_Ref_t scratch = le_arena_GetScratch();
+
+    LE_TEST(pthread_create(&thread, NULL, ScratchThreadMain, scratch) == 0);
+    LE_TEST(pthread_join(thread, NULL) == 0);
+
+    LE_INFO("Scratch arenas work correctly.");
+
+
+    LE_INFO("====  le_arena test complete. ====");
+
+    LE_TEST_SUMMARY;
+}
@@ -0,0 +1,355 @@
+ /**
+  * Tests for the Condition Variable API.
+  *
+  * Checks that waits time out when nobody signals (even if signal handlers keep interrupting
+  * them), that a broadcast wakes up every waiter, and that a bounded queue shared by several
+  * producer and consumer threads loses nothing.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+#define NUM_WAITERS         3
+#define NUM_PRODUCERS       2
+#define NUM_CONSUMERS       2
+#define ITEMS_PER_PRODUCER  10000
+#define QUEUE_SIZE          8
+
+
+static le_mutex_Ref_t MutexRef;
+
+
+static le_thread_Ref_t StartThread(const char* name, le_thread_MainFunc_t func, void* contextPtr)
+{
+    le_thread_Ref_t threadRef = le_thread_Create(name, func, contextPtr);
+    le_thread_SetJoinable(threadRef);
+    le_thread_Start(threadRef);
+
+    return threadRef;
+}
+
+static void* JoinThread(le_thread_Ref_t threadRef)
+{
+    void* resultPtr;
+
+    LE_ASSERT(le_thread_Join(threadRef, &resultPtr) == LE_OK);
+
+    return resultPtr;
+}
+
+
+static uint64_t ElapsedMs(le_clk_Time_t startTime)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec * 1000 + elapsed.usec / 1000;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A wait times out if nobody signals, even if somebody signalled before the wait started, and the
+ * mutex is locked again afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* TryLockMutex(void* contextPtr)
+{
+    le_result_t result = le_mutex_TryLock(MutexRef);
+
+    if (result == LE_OK)
+    {
+        le_mutex_Unlock(MutexRef);
+    }
+
+    return (void*)(intptr_t)result;
+}
+
+static void TestTimeout(void)
+{
+    le_clk_Time_t timeout = { .sec = 0, .usec = 50000 };
+
+    LE_INFO("---- Timeout ----");
+
+    le_cond_Ref_t condRef = le_cond_Create("timeout");
+
+    le_cond_Signal(condRef);
+    le_cond_Broadcast(condRef);
+
+    le_mutex_Lock(MutexRef);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    LE_TEST(le_cond_WaitWithTimeOut(condRef, MutexRef, timeout) == LE_TIMEOUT);
+    LE_TEST(ElapsedMs(startTime) >= 50);
+
+    LE_TEST((le_result_t)(intptr_t)JoinThread(StartThread("tryer", TryLockMutex, NULL))
+            == LE_WOULD_BLOCK);
+
+    le_mutex_Unlock(MutexRef);
+
+    le_cond_Delete(condRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal handlers interrupting a timed wait neither end it early nor extend it.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_INTERRUPTS 20
+
+static pthread_t WaitingThread;
+static volatile sig_atomic_t NumHandled;
+
+static void InterruptHandler(int sigNum)
+{
+    NumHandled++;
+}
+
+static void* Interrupter(void* contextPtr)
+{
+    int i;
+
+    for (i = 0; i < NUM_INTERRUPTS; i++)
+    {
+        usleep(5000);
+        LE_ASSERT(pthread_kill(WaitingThread, SIGUSR2) == 0);
+    }
+
+    return NULL;
+}
+
+static void TestInterruptedTimeout(void)
+{
+    le_clk_Time_t timeout = { .sec = 0, .usec = 200000 };
+    struct sigaction action = { .sa_handler = InterruptHandler };   // No SA_RESTART.
+    struct sigaction oldAction;
+
+    LE_INFO("---- Interrupted Timeout ----");
+
+    le_cond_Ref_t condRef = le_cond_Create("interrupted");
+
+    WaitingThread = pthread_self();
+    NumHandled = 0;
+    sigemptyset(&action.sa_mask);
+    LE_ASSERT(sigaction(SIGUSR2, &action, &oldAction) == 0);
+
+    le_mutex_Lock(MutexRef);
+
+    le_thread_Ref_t threadRef = StartThread("interrupter", Interrupter, NULL);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    LE_TEST(le_cond_WaitWithTimeOut(condRef, MutexRef, timeout) == LE_TIMEOUT);
+    uint64_t elapsedMs = ElapsedMs(startTime);
+    LE_TEST(elapsedMs >= 200);
+    LE_TEST(elapsedMs < 1000);
+
+    le_mutex_Unlock(MutexRef);
+
+    JoinThread(threadRef);
+    LE_TEST(NumHandled == NUM_INTERRUPTS);
+
+    LE_ASSERT(sigaction(SIGUSR2, &oldAction, NULL) == 0);
+
+    le_cond_Delete(condRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A broadcast wakes up all of the waiters.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_cond_Ref_t FlagCondRef;
+static le_cond_Ref_t WaitingCondRef;
+static bool Flag;
+static int NumWaiting;
+
+static void* FlagWaiter(void* contextPtr)
+{
+    le_clk_Time_t timeout = { .sec = 5, .usec = 0 };
+    bool isOk = true;
+
+    le_mutex_Lock(MutexRef);
+
+    NumWaiting++;
+    le_cond_Signal(WaitingCondRef);
+
+    while (!Flag && isOk)
+    {
+        isOk = (le_cond_WaitWithTimeOut(FlagCondRef, MutexRef, timeout) == LE_OK);
+    }
+
+    le_mutex_Unlock(MutexRef);
+
+    return (void*)isOk;
+}
+
+static void TestBroadcast(void)
+{
+    le_thread_Ref_t threadRefs[NUM_WAITERS];
+    bool allOk = true;
+    int i;
+
+    LE_INFO("---- Broadcast ----");
+
+    FlagCondRef = le_cond_Create("flag");
+    WaitingCondRef = le_cond_Create("waiting");
+
+    for (i = 0; i < NUM_WAITERS; i++)
+    {
+        threadRefs[i] = StartThread("flagWaiter", FlagWaiter, NULL);
+    }
+
+    le_mutex_Lock(MutexRef);
+
+    while (NumWaiting < NUM_WAITERS)
+    {
+        le_cond_Wait(WaitingCondRef, MutexRef);
+    }
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    Flag = true;
+    le_cond_Broadcast(FlagCondRef);
+
+    le_mutex_Unlock(MutexRef);
+
+    for (i = 0; i < NUM_WAITERS; i++)
+    {
+        allOk = allOk && (JoinThread(threadRefs[i]) != NULL);
+    }
+
+    LE_TEST(allOk);
+    LE_TEST(ElapsedMs(startTime) < 1000);
+
+    le_cond_Delete(FlagCondRef);
+    le_cond_Delete(WaitingCondRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Producers and consumers passing items through a bounded queue, waiting when it is full or empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_cond_Ref_t NotFullRef;
+static le_cond_Ref_t NotEmptyRef;
+static uint64_t Queue[QUEUE_SIZE];
+static size_t QueueHead;
+static size_t QueueCount;
+static size_t ItemsLeft;
+
+static void* Producer(void* contextPtr)
+{
+    uint64_t i;
+
+    for (i = 1; i <= ITEMS_PER_PRODUCER; i++)
+    {
+        le_mutex_Lock(MutexRef);
+
+        while (QueueCount == QUEUE_SIZE)
+        {
+            le_cond_Wait(NotFullRef, MutexRef);
+        }
+
+        Queue[(QueueHead + QueueCount) % QUEUE_SIZE] = i;
+        QueueCount++;
+        le_cond_Signal(NotEmptyRef);
+
+        le_mutex_Unlock(MutexRef);
+    }
+
+    return NULL;
+}
+
+static void* Consumer(void* contextPtr)
+{
+    uint64_t sum = 0;
+
+    le_mutex_Lock(MutexRef);
+
+    while (ItemsLeft > 0)
+    {
+        if (QueueCount == 0)
+        {
+            le_cond_Wait(NotEmptyRef, MutexRef);
+            continue;
+        }
+
+        sum += Queue[QueueHead];
+        QueueHead = (QueueHead + 1) % QUEUE_SIZE;
+        QueueCount--;
+        ItemsLeft--;
+
+        le_cond_Signal(NotFullRef);
+
+        if (ItemsLeft == 0)
+        {
+            // Let the other consumers see that there's nothing left.
+            le_cond_Broadcast(NotEmptyRef);
+        }
+    }
+
+    le_mutex_Unlock(MutexRef);
+
+    return (void*)(uintptr_t)sum;
+}
+
+static void TestProducerConsumer(void)
+{
+    le_thread_Ref_t producerRefs[NUM_PRODUCERS];
+    le_thread_Ref_t consumerRefs[NUM_CONSUMERS];
+    uint64_t sum = 0;
+    int i;
+
+    LE_INFO("---- Producer/Consumer ----");
+
+    NotFullRef = le_cond_Create("notFull");
+    NotEmptyRef = le_cond_Create("notEmpty");
+    ItemsLeft = NUM_PRODUCERS * ITEMS_PER_PRODUCER;
+
+    for (i = 0; i < NUM_CONSUMERS; i++)
+    {
+        consumerRefs[i] = StartThread("consumer", Consumer, NULL);
+    }
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        producerRefs[i] = StartThread("producer", Producer, NULL);
+    }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        JoinThread(producerRefs[i]);
+    }
+    for (i = 0; i < NUM_CONSUMERS; i++)
+    {
+        sum += (uintptr_t)JoinThread(consumerRefs[i]);
+    }
+
+    LE_TEST(QueueCount == 0);
+    LE_TEST(sum == (uint64_t)NUM_PRODUCERS * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2);
+
+    le_cond_Delete(NotFullRef);
+    le_cond_Delete(NotEmptyRef);
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    LE_INFO("====  Unit test for the Condition Variable API. ====");
+
+    MutexRef = le_mutex_CreateNonRecursive("testMutex");
+
+    TestTimeout();
+    TestInterruptedTimeout();
+    TestBroadcast();
+    TestProducerConsumer();
+
+    le_mutex_Delete(MutexRef);
+
+    LE_TEST_SUMMARY;
+}
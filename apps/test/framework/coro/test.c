@@ -0,0 +1,367 @@
+ /**
+  * Tests for the Coroutine API.
+  *
+  * The tests are run one after the other by a driver coroutine in the main thread.  Most of them
+  * start other coroutines, wait for them to finish, and check the order in which everything ran.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log of what ran, in order.  Each entry is a small number chosen by the test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_LOG_ENTRIES 32
+
+static int Log[MAX_LOG_ENTRIES];
+static size_t LogCount;
+
+
+static void AddToLog(int entry)
+{
+    LE_ASSERT(LogCount < MAX_LOG_ENTRIES);
+    Log[LogCount++] = entry;
+}
+
+
+static bool CheckLog(const int* expectedPtr, size_t expectedCount)
+{
+    size_t i;
+    bool result = (LogCount == expectedCount);
+
+    for (i = 0; i < LogCount; i++)
+    {
+        LE_INFO("Log[%zu] = %d", i, Log[i]);
+        result = result && (Log[i] == expectedPtr[i]);
+    }
+
+    LogCount = 0;
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The driver coroutine, and the number of coroutines it is waiting for.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_coro_Ref_t DriverRef;
+static int Running;
+
+
+static void StartCoro(const char* name, le_coro_Func_t func, void* contextPtr)
+{
+    Running++;
+    le_coro_Start(le_coro_Create(name, func, contextPtr));
+}
+
+
+static void CoroDone(void)
+{
+    Running--;
+    le_coro_Resume(DriverRef);
+}
+
+
+static void WaitForCoros(void)
+{
+    while (Running > 0)
+    {
+        le_coro_Suspend();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Coroutines don't run until the Event Loop gets to them, and have a stack of their own.
+ */
+//--------------------------------------------------------------------------------------------------
+static uintptr_t MainStackAddr;
+
+static void StartedCoro(void* contextPtr)
+{
+    uint8_t stackVar;
+
+    LE_TEST(contextPtr == &MainStackAddr);
+    LE_TEST(le_coro_GetCurrent() != NULL);
+    LE_TEST(le_coro_GetCurrent() != DriverRef);
+    LE_TEST(strcmp(le_coro_GetName(le_coro_GetCurrent()), "started") == 0);
+
+    intptr_t distance = (intptr_t)&stackVar - (intptr_t)MainStackAddr;
+    LE_TEST((distance > 1024 * 1024) || (distance < -1024 * 1024));
+
+    AddToLog(2);
+    CoroDone();
+}
+
+static void TestStart(void)
+{
+    static const int expected[] = { 1, 2, 3 };
+
+    LE_INFO("---- Start ----");
+
+    StartCoro("started", StartedCoro, &MainStackAddr);
+    AddToLog(1);
+
+    WaitForCoros();
+    AddToLog(3);
+
+    LE_TEST(CheckLog(expected, NUM_ARRAY_MEMBERS(expected)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Coroutines that yield take turns.
+ */
+//--------------------------------------------------------------------------------------------------
+static void YieldingCoro(void* contextPtr)
+{
+    int id = (int)(intptr_t)contextPtr;
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        AddToLog(id + i);
+        le_coro_Yield();
+    }
+
+    CoroDone();
+}
+
+static void TestYield(void)
+{
+    static const int expected[] = { 10, 20, 11, 21, 12, 22 };
+
+    LE_INFO("---- Yield ----");
+
+    StartCoro("yield10", YieldingCoro, (void*)10);
+    StartCoro("yield20", YieldingCoro, (void*)20);
+    WaitForCoros();
+
+    LE_TEST(CheckLog(expected, NUM_ARRAY_MEMBERS(expected)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A suspended coroutine carries on when a handler resumes it, and a resume that comes while it is
+ * still running isn't lost.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResumeHandler(void* param1Ptr, void* param2Ptr)
+{
+    AddToLog(2);
+    le_coro_Resume(param1Ptr);
+}
+
+static void SuspendingCoro(void* contextPtr)
+{
+    AddToLog(1);
+
+    le_event_QueueFunction(ResumeHandler, le_coro_GetCurrent(), NULL);
+    le_coro_Suspend();
+    AddToLog(3);
+
+    // Resumed before suspending, so this doesn't wait.
+    le_coro_Resume(le_coro_GetCurrent());
+    le_coro_Suspend();
+    AddToLog(4);
+
+    CoroDone();
+}
+
+static void TestSuspendResume(void)
+{
+    static const int expected[] = { 1, 2, 3, 4 };
+
+    LE_INFO("---- Suspend/Resume ----");
+
+    StartCoro("suspend", SuspendingCoro, NULL);
+    WaitForCoros();
+
+    LE_TEST(CheckLog(expected, NUM_ARRAY_MEMBERS(expected)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sleeping coroutines wake up in order of their wake-up times, and don't wake up early.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SleepingCoro(void* contextPtr)
+{
+    int ms = (int)(intptr_t)contextPtr;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    le_coro_SleepMs(ms);
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    LE_TEST(elapsed.sec * 1000 + elapsed.usec / 1000 >= ms);
+
+    AddToLog(ms);
+
+    // Sleeping again re-uses the coroutine's timer.
+    le_coro_SleepMs(1);
+
+    CoroDone();
+}
+
+static void TestSleep(void)
+{
+    static const int expected[] = { 10, 20, 30 };
+
+    LE_INFO("---- Sleep ----");
+
+    StartCoro("sleep30", SleepingCoro, (void*)30);
+    StartCoro("sleep10", SleepingCoro, (void*)10);
+    StartCoro("sleep20", SleepingCoro, (void*)20);
+    WaitForCoros();
+
+    LE_TEST(CheckLog(expected, NUM_ARRAY_MEMBERS(expected)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A coroutine can wait for a file descriptor, including waiting for hang-up.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadingCoro(void* contextPtr)
+{
+    int fd = *(int*)contextPtr;
+    char c;
+
+    short events = le_coro_AwaitFd(fd, POLLIN);
+    LE_TEST(events == POLLIN);
+    LE_TEST(read(fd, &c, 1) == 1);
+    AddToLog(c);
+
+    events = le_coro_AwaitFd(fd, POLLIN);
+    LE_TEST((events & POLLHUP) != 0);
+    LE_TEST(read(fd, &c, 1) == 0);
+    AddToLog(3);
+
+    CoroDone();
+}
+
+static void TestAwaitFd(void)
+{
+    static const int expected[] = { 1, 2, 3 };
+    int fds[2];
+    char c = 2;
+
+    LE_INFO("---- AwaitFd ----");
+
+    LE_ASSERT(pipe(fds) == 0);
+
+    StartCoro("reader", ReadingCoro, &fds[0]);
+    le_coro_SleepMs(10);
+
+    AddToLog(1);
+    LE_ASSERT(write(fds[1], &c, 1) == 1);
+    le_coro_SleepMs(10);
+
+    LE_ASSERT(close(fds[1]) == 0);
+    WaitForCoros();
+
+    LE_ASSERT(close(fds[0]) == 0);
+
+    LE_TEST(CheckLog(expected, NUM_ARRAY_MEMBERS(expected)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Coroutines that are left waiting when their thread exits are deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ForeverCoro(void* contextPtr)
+{
+    int fds[2];
+
+    LE_ASSERT(pipe(fds) == 0);
+
+    AddToLog(1);
+
+    // Never woken up.
+    le_coro_AwaitFd(fds[0], POLLIN);
+    LE_TEST(false);
+}
+
+static void ExitThread(void* param1Ptr, void* param2Ptr)
+{
+    AddToLog(2);
+    le_thread_Exit(NULL);
+}
+
+static void* ThreadMain(void* contextPtr)
+{
+    le_coro_Start(le_coro_Create("forever", ForeverCoro, NULL));
+
+    le_coro_Ref_t sleeperRef = le_coro_Create("sleeper", SleepingCoro, (void*)100000);
+    le_coro_Start(sleeperRef);
+
+    // Never started.
+    le_coro_Create("new", ForeverCoro, NULL);
+
+    le_event_QueueFunction(ExitThread, NULL, NULL);
+
+    le_event_RunLoop();
+}
+
+static void TestThreadExit(void)
+{
+    static const int expected[] = { 1, 2 };
+
+    LE_INFO("---- Thread exit ----");
+
+    le_thread_Ref_t threadRef = le_thread_Create("coroThread", ThreadMain, NULL);
+    le_thread_SetJoinable(threadRef);
+    le_thread_Start(threadRef);
+
+    LE_TEST(le_thread_Join(threadRef, NULL) == LE_OK);
+
+    LE_TEST(CheckLog(expected, NUM_ARRAY_MEMBERS(expected)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs all of the tests.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Driver(void* contextPtr)
+{
+    TestStart();
+    TestYield();
+    TestSuspendResume();
+    TestSleep();
+    TestAwaitFd();
+    TestThreadExit();
+
+    LE_TEST_SUMMARY;
+}
+
+
+COMPONENT_INIT
+{
+    uint8_t stackVar;
+
+    LE_TEST_INIT;
+
+    LE_INFO("====  Unit test for the Coroutine API. ====");
+
+    MainStackAddr = (uintptr_t)&stackVar;
+
+    LE_TEST(le_coro_GetCurrent() == NULL);
+
+    DriverRef = le_coro_Create("driver", Driver, NULL);
+    le_coro_Start(DriverRef);
+}
@@ -0,0 +1,274 @@
+ /**
+  * Benchmark of the Event Loop backends on an IPC-heavy workload.
+  *
+  * A client thread sends small requests over a number of Unix domain socket connections, keeping
+  * a few requests in flight on each.  The main thread, like a daemon, has an FD Monitor on each of
+  * the server ends, and answers each request as it is read.  Both threads run Event Loops, so both
+  * use whichever backend has been selected with the LE_EVENT_BACKEND environment variable (see
+  * @ref c_event_ioUring).  Run it once with each backend to compare them.
+  *
+  * The elapsed time, the CPU time and the number of context switches for the whole process are
+  * printed.  To count the system calls as well, run it under "strace -c -f".
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of connections, number of requests in flight on each, size of each message, and the
+ * total number of requests sent.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_CONNECTIONS     8
+#define WINDOW_SIZE         4
+#define MESSAGE_BYTES       64
+#define NUM_REQUESTS        200000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client and server ends of the connections.
+ */
+//--------------------------------------------------------------------------------------------------
+static int ClientFds[NUM_CONNECTIONS];
+static int ServerFds[NUM_CONNECTIONS];
+
+static size_t RequestsSent;
+static size_t RepliesReceived;
+static size_t RequestsAnswered;
+
+static le_thread_Ref_t MainThreadRef;
+static le_clk_Time_t StartTime;
+static struct rusage StartUsage;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of microseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t MicrosecondsSince
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of microseconds between two CPU times from getrusage().
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t MicrosecondsBetween
+(
+    struct timeval startTime,
+    struct timeval endTime
+)
+{
+    return ((int64_t)endTime.tv_sec - startTime.tv_sec) * 1000000
+           + (endTime.tv_usec - startTime.tv_usec);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads one message, which must be there.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadMessage
+(
+    int fd,
+    char* bufferPtr
+)
+{
+    ssize_t bytesRead;
+
+    do
+    {
+        bytesRead = read(fd, bufferPtr, MESSAGE_BYTES);
+    }
+    while ((bytesRead == -1) && (errno == EINTR));
+
+    LE_FATAL_IF(bytesRead != MESSAGE_BYTES, "read() returned %zd (%m).", bytesRead);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes one message.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteMessage
+(
+    int fd,
+    const char* bufferPtr
+)
+{
+    ssize_t bytesWritten;
+
+    do
+    {
+        bytesWritten = write(fd, bufferPtr, MESSAGE_BYTES);
+    }
+    while ((bytesWritten == -1) && (errno == EINTR));
+
+    LE_FATAL_IF(bytesWritten != MESSAGE_BYTES, "write() returned %zd (%m).", bytesWritten);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the results and ends the test.  Runs in the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Finish
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    struct rusage usage;
+    const char* backendStr = getenv("LE_EVENT_BACKEND");
+    uint64_t elapsed = MicrosecondsSince(StartTime);
+
+    LE_ASSERT(getrusage(RUSAGE_SELF, &usage) == 0);
+
+    printf("%-10s %10s %10s %10s %12s %12s\n",
+           "backend", "elapsed", "user", "system", "voluntary", "involuntary");
+    printf("%-10s %10"PRIu64" %10"PRIu64" %10"PRIu64" %12ld %12ld\n",
+           (backendStr != NULL ? backendStr : "epoll"),
+           elapsed,
+           MicrosecondsBetween(StartUsage.ru_utime, usage.ru_utime),
+           MicrosecondsBetween(StartUsage.ru_stime, usage.ru_stime),
+           usage.ru_nvcsw - StartUsage.ru_nvcsw,
+           usage.ru_nivcsw - StartUsage.ru_nivcsw);
+
+    LE_TEST(RequestsAnswered == NUM_REQUESTS);
+
+    LE_TEST_SUMMARY;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Answers a request.  Runs in the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerHandler
+(
+    int fd,
+    short events
+)
+{
+    char buffer[MESSAGE_BYTES];
+
+    LE_ASSERT(events == POLLIN);
+
+    ReadMessage(fd, buffer);
+    RequestsAnswered++;
+    WriteMessage(fd, buffer);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives a reply and sends another request in its place.  Runs in the client thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClientHandler
+(
+    int fd,
+    short events
+)
+{
+    char buffer[MESSAGE_BYTES];
+
+    LE_ASSERT(events == POLLIN);
+
+    ReadMessage(fd, buffer);
+    RepliesReceived++;
+
+    if (RequestsSent < NUM_REQUESTS)
+    {
+        WriteMessage(fd, buffer);
+        RequestsSent++;
+    }
+    else if (RepliesReceived == NUM_REQUESTS)
+    {
+        le_event_QueueFunctionToThread(MainThreadRef, Finish, NULL, NULL);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client thread.  Fills the window on each connection, then sends a new request each time a reply
+ * comes back.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ClientThread
+(
+    void* contextPtr
+)
+{
+    char buffer[MESSAGE_BYTES];
+    int i;
+    int j;
+
+    memset(buffer, 'x', sizeof(buffer));
+
+    for (i = 0; i < NUM_CONNECTIONS; i++)
+    {
+        le_fdMonitor_Create("client", ClientFds[i], ClientHandler, POLLIN);
+
+        for (j = 0; j < WINDOW_SIZE; j++)
+        {
+            WriteMessage(ClientFds[i], buffer);
+            RequestsSent++;
+        }
+    }
+
+    le_event_RunLoop();
+}
+
+
+COMPONENT_INIT
+{
+    int i;
+
+    LE_TEST_INIT;
+
+    LE_INFO("====  Benchmark of the Event Loop on an IPC-heavy workload. ====");
+
+    printf("%d connections, %d requests in flight on each, %d requests of %d bytes.\n"
+           "All times are in microseconds.\n",
+           NUM_CONNECTIONS, WINDOW_SIZE, NUM_REQUESTS, MESSAGE_BYTES);
+
+    for (i = 0; i < NUM_CONNECTIONS; i++)
+    {
+        int fds[2];
+
+        LE_ASSERT(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) == 0);
+        ClientFds[i] = fds[0];
+        ServerFds[i] = fds[1];
+
+        le_fdMonitor_Create("server", ServerFds[i], ServerHandler, POLLIN);
+    }
+
+    MainThreadRef = le_thread_GetCurrent();
+
+    LE_ASSERT(getrusage(RUSAGE_SELF, &StartUsage) == 0);
+    StartTime = le_clk_GetRelativeTime();
+
+    le_thread_Start(le_thread_Create("client", ClientThread, NULL));
+}
@@ -11,6 +11,7 @@ static bool TestCPassed = false;
 static le_event_Id_t EventIdA;
 static le_event_Id_t EventIdB;
 static le_event_Id_t EventIdC;
+static le_event_Id_t EventIdD;
 
 static char EventContextA[] = "Context A";
 
@@ -62,6 +63,25 @@ static void EventHandlerB
 }
 
 
+// Event D is reported without copying its payload, to two handlers which should both get the
+// reporter's buffer.
+static void* ZeroCopyPayloadPtr;
+static int NumZeroCopyHandlerCalls = 0;
+
+static void ZeroCopyHandler
+(
+    void* reportPtr // Non-ref-counted (zero-copy report).
+)
+{
+    Report_t* objPtr = reportPtr;
+
+    LE_ASSERT(reportPtr == ZeroCopyPayloadPtr);
+    LE_ASSERT(strcmp(objPtr->str, "Report D") == 0);
+
+    NumZeroCopyHandlerCalls++;
+}
+
+
 static void Destructor
 (
     void* objPtr
@@ -82,21 +102,272 @@ static void Destructor
 }
 
 
+// Several threads queue functions to the main thread at once, to check that each thread's
+// functions are run in the order they were queued and that none are lost.
+#define NUM_PRODUCERS   4
+#define NUM_QUEUED      10000
+
+static le_thread_Ref_t MainThread;
+static size_t NextSeqNum[NUM_PRODUCERS];
+static size_t NumReceived = 0;
+
+// Then a lot of bulk functions are queued to the main thread along with an urgent function and
+// an fd event, neither of which should have to wait for all the bulk functions to run.
+#define NUM_BULK        1000
+#define BATCH_SIZE      10
+
+static size_t NumBulkRun = 0;
+static bool UrgentRan = false;
+static bool PipeHandlerRan = false;
+static int PipeFds[2];
+
+
+static void UrgentFunction
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LE_INFO("Urgent function ran after %zu bulk functions.", NumBulkRun);
+
+    // This was queued by the first bulk function, so it should be run before the second one.
+    LE_ASSERT(NumBulkRun == 1);
+
+    UrgentRan = true;
+}
+
+
+static void PipeHandler
+(
+    int fd,
+    short events
+)
+{
+    char c;
+
+    LE_INFO("Pipe handler ran after %zu bulk functions.", NumBulkRun);
+
+    LE_ASSERT(read(fd, &c, 1) == 1);
+
+    // The pipe was written by the first bulk function, so the Event Loop should have seen it
+    // within the next couple of batches.
+    LE_ASSERT(NumBulkRun <= 3 * BATCH_SIZE);
+
+    PipeHandlerRan = true;
+}
+
+
+// Finally, an edge-triggered fd is only reported when more data arrives, until it is switched back
+// to level-triggered.
+static int EdgePipeFds[2];
+static int NumEdgeHandlerCalls = 0;
+
+
+static void EdgeHandler
+(
+    int fd,
+    short events
+);
+
+
+static void CheckNotReportedAgain
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    // epoll_wait() has been called since the handler left a byte in the pipe.
+    LE_ASSERT(NumEdgeHandlerCalls == 1);
+
+    LE_ASSERT(write(EdgePipeFds[1], "b", 1) == 1);
+}
+
+
+static void CheckAfterEpollWait
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    // Queued functions run in the same pass as the fd handler that queued them, so queue another
+    // one to let the Event Loop go back to epoll_wait() first.
+    le_event_QueueFunction(CheckNotReportedAgain, NULL, NULL);
+}
+
+
+static void EdgeHandler
+(
+    int fd,
+    short events
+)
+{
+    char buff[4];
+
+    NumEdgeHandlerCalls++;
+
+    LE_INFO("Edge-triggered pipe handler call %d.", NumEdgeHandlerCalls);
+
+    LE_ASSERT(events == POLLIN);
+
+    switch (NumEdgeHandlerCalls)
+    {
+        case 1:
+            // Read only one of the two bytes.  The other won't be reported again.
+            LE_ASSERT(read(fd, buff, 1) == 1);
+            le_event_QueueFunction(CheckAfterEpollWait, NULL, NULL);
+            break;
+
+        case 2:
+            // Drain the pipe, as edge-triggered handlers must.
+            LE_ASSERT(read(fd, buff, sizeof(buff)) == 2);
+            LE_ASSERT(read(fd, buff, sizeof(buff)) == -1);
+            LE_ASSERT(errno == EAGAIN);
+
+            // Level-triggered, this handler gets called once for each of these.
+            le_fdMonitor_SetEdgeTriggered(le_fdMonitor_GetMonitor(), false);
+            LE_ASSERT(write(EdgePipeFds[1], "cd", 2) == 2);
+            break;
+
+        case 3:
+            LE_ASSERT(read(fd, buff, 1) == 1);
+            break;
+
+        case 4:
+            LE_ASSERT(read(fd, buff, 1) == 1);
+
+            LE_INFO("======== EVENT LOOP TEST COMPLETE (PASSED) ========");
+            exit(EXIT_SUCCESS);
+
+        default:
+            LE_FATAL("Too many calls.");
+    }
+}
+
+
+static void StartEdgeTriggeredTest
+(
+    void
+)
+{
+    LE_INFO("Monitoring an edge-triggered pipe.");
+
+    LE_ASSERT(pipe2(EdgePipeFds, O_NONBLOCK) == 0);
+
+    le_fdMonitor_Ref_t monitorRef = le_fdMonitor_Create("edgePipe",
+                                                        EdgePipeFds[0],
+                                                        EdgeHandler,
+                                                        POLLIN);
+    le_fdMonitor_SetEdgeTriggered(monitorRef, true);
+
+    LE_ASSERT(write(EdgePipeFds[1], "aa", 2) == 2);
+}
+
+
+static void BulkFunction
+(
+    void* param1Ptr,    // Sequence number.
+    void* param2Ptr
+)
+{
+    LE_ASSERT((size_t)param1Ptr == NumBulkRun);
+    NumBulkRun++;
+
+    if (NumBulkRun == 1)
+    {
+        le_event_QueueFunctionUrgent(UrgentFunction, NULL, NULL);
+        LE_ASSERT(write(PipeFds[1], "x", 1) == 1);
+    }
+    else if (NumBulkRun == NUM_BULK)
+    {
+        LE_ASSERT(UrgentRan);
+        LE_ASSERT(PipeHandlerRan);
+
+        StartEdgeTriggeredTest();
+    }
+}
+
+
+static void StartBatchTest
+(
+    void
+)
+{
+    size_t i;
+
+    LE_INFO("Queueing %d bulk functions with batch size %d.", NUM_BULK, BATCH_SIZE);
+
+    le_event_SetBatchSize(BATCH_SIZE);
+
+    LE_ASSERT(pipe(PipeFds) == 0);
+    le_fdMonitor_Create("testPipe", PipeFds[0], PipeHandler, POLLIN);
+
+    for (i = 0; i < NUM_BULK; i++)
+    {
+        le_event_QueueFunction(BulkFunction, (void*)i, NULL);
+    }
+}
+
+
+static void ReceiveQueuedFunction
+(
+    void* param1Ptr,    // Producer number.
+    void* param2Ptr     // Sequence number.
+)
+{
+    size_t producer = (size_t)param1Ptr;
+    size_t seqNum = (size_t)param2Ptr;
+
+    LE_ASSERT(producer < NUM_PRODUCERS);
+    LE_ASSERT(seqNum == NextSeqNum[producer]);
+    NextSeqNum[producer]++;
+
+    if (++NumReceived == NUM_PRODUCERS * NUM_QUEUED)
+    {
+        StartBatchTest();
+    }
+}
+
+
+static void* ProducerThread
+(
+    void* contextPtr    // Producer number.
+)
+{
+    size_t i;
+
+    for (i = 0; i < NUM_QUEUED; i++)
+    {
+        le_event_QueueFunctionToThread(MainThread, ReceiveQueuedFunction, contextPtr, (void*)i);
+    }
+
+    return NULL;
+}
+
+
 static void CheckTestResults
 (
     void* param1Ptr,
     void* param2Ptr
 )
 {
+    size_t i;
+
     LE_ASSERT(param1Ptr == &ReportA);
     LE_ASSERT(param2Ptr == &ReportB);
 
     LE_ASSERT(TestAPassed);
     LE_ASSERT(TestBPassed);
     LE_ASSERT(TestCPassed);
+    LE_ASSERT(NumZeroCopyHandlerCalls == 2);
 
-    LE_INFO("======== EVENT LOOP TEST COMPLETE (PASSED) ========");
-    exit(EXIT_SUCCESS);
+    LE_INFO("Starting %d threads to queue %d functions each.", NUM_PRODUCERS, NUM_QUEUED);
+
+    MainThread = le_thread_GetCurrent();
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        le_thread_Start(le_thread_Create("producer", ProducerThread, (void*)i));
+    }
 }
 
 
@@ -130,5 +401,25 @@ COMPONENT_INIT
     memcpy(reportPtr, &ReportC, sizeof(*reportPtr));
     le_event_ReportWithRefCounting(EventIdC, reportPtr);
 
+    EventIdD = le_event_CreateId("Event D", sizeof(Report_t));
+    le_event_AddHandler("Zero Copy Handler 1", EventIdD, ZeroCopyHandler);
+    le_event_AddHandler("Zero Copy Handler 2", EventIdD, ZeroCopyHandler);
+
+    reportPtr = le_event_AllocPayload(EventIdD);
+    strcpy(reportPtr->str, "Report D");
+    reportPtr->passedFlagPtr = NULL;
+    ZeroCopyPayloadPtr = reportPtr;
+    le_event_ReportZeroCopy(EventIdD, reportPtr);
+
+    // A plain event that nobody has a handler for shouldn't take a payload from its pool.
+    le_event_Id_t eventIdE = le_event_CreateId("Event E", sizeof(ReportA));
+    le_event_Report(eventIdE, &ReportA, sizeof(ReportA));
+
+    le_mem_PoolStats_t stats;
+    le_mem_PoolRef_t payloadPool = _le_mem_FindPool("framework", "Event E-payloads");
+    LE_ASSERT(payloadPool != NULL);
+    le_mem_GetStats(payloadPool, &stats);
+    LE_ASSERT(stats.numAllocs == 0);
+
     le_event_QueueFunction(CheckTestResults, &ReportA, &ReportB);
 }
@@ -0,0 +1,231 @@
+ /**
+  * Benchmark comparing the chained hashmaps made by le_hashmap_Create() with the flat hashmaps
+  * made by le_hashmap_CreateFlat().
+  *
+  * Each map type is filled with the same keys, then looked up (hits and misses), iterated and
+  * emptied, and the time taken for each phase is printed.  The results of every lookup are also
+  * checked, so this doubles as a test that both map types behave the same way.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of keys put into each map, and number of times each key is looked up.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_KEYS        20000
+#define NUM_LOOKUPS     10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a string key (including the null terminator).
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_KEY_BYTES   24
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keys.  Integer keys 0 to NUM_KEYS - 1 are put in the maps, and NUM_KEYS to 2 * NUM_KEYS - 1 are
+ * used for lookups that miss.  String keys are the same numbers, formatted like service names.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t IntKeys[NUM_KEYS * 2];
+static char StrKeys[NUM_KEYS * 2][MAX_KEY_BYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to create a map of either type.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef le_hashmap_Ref_t (*CreateFunc_t)
+(
+    const char* nameStr,
+    size_t capacity,
+    le_hashmap_HashFunc_t hashFunc,
+    le_hashmap_EqualsFunc_t equalsFunc
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of microseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t MicrosecondsSince
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the benchmark on one map.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    const char* descriptionStr,     ///< Description of the map, for the results.
+    le_hashmap_Ref_t map,           ///< An empty map.
+    void* keysPtr,                  ///< Array of 2 * NUM_KEYS keys.
+    size_t keySize                  ///< Size of each key in the array.
+)
+{
+    uint8_t* keyBytesPtr = keysPtr;
+    le_clk_Time_t startTime;
+    size_t i;
+    int round;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+    size_t iterCount = 0;
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_KEYS; i++)
+    {
+        le_hashmap_Put(map, keyBytesPtr + i * keySize, keyBytesPtr + i * keySize);
+    }
+    uint64_t putTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (round = 0; round < NUM_LOOKUPS; round++)
+    {
+        for (i = 0; i < NUM_KEYS; i++)
+        {
+            if (le_hashmap_Get(map, keyBytesPtr + i * keySize) == keyBytesPtr + i * keySize)
+            {
+                hitCount++;
+            }
+        }
+    }
+    uint64_t hitTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (round = 0; round < NUM_LOOKUPS; round++)
+    {
+        for (i = NUM_KEYS; i < NUM_KEYS * 2; i++)
+        {
+            if (le_hashmap_Get(map, keyBytesPtr + i * keySize) == NULL)
+            {
+                missCount++;
+            }
+        }
+    }
+    uint64_t missTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(map);
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        iterCount++;
+    }
+    uint64_t iterTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_KEYS; i++)
+    {
+        le_hashmap_Remove(map, keyBytesPtr + i * keySize);
+    }
+    uint64_t removeTime = MicrosecondsSince(startTime);
+
+    LE_TEST(hitCount == NUM_KEYS * NUM_LOOKUPS);
+    LE_TEST(missCount == NUM_KEYS * NUM_LOOKUPS);
+    LE_TEST(iterCount == NUM_KEYS);
+    LE_TEST(le_hashmap_isEmpty(map));
+
+    printf("%-24s %10"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64" %10"PRIu64"\n",
+           descriptionStr, putTime, hitTime, missTime, iterTime, removeTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the benchmark on both types of map, for integer keys and for string keys with each of the
+ * string hash functions.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunAll
+(
+    const char* sizingStr,          ///< Description of the capacity hint, for the results.
+    size_t capacity                 ///< Capacity hint to create the maps with.
+)
+{
+    static const struct
+    {
+        const char* nameStr;
+        CreateFunc_t createFunc;
+    }
+    mapTypes[] =
+    {
+        { "chained", le_hashmap_Create },
+        { "flat", le_hashmap_CreateFlat },
+    };
+
+    char descriptionStr[64];
+    char nameStr[64];
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(mapTypes); i++)
+    {
+        // Map names have to stay valid for as long as the maps exist.
+        snprintf(nameStr, sizeof(nameStr), "%s-u32-%s", mapTypes[i].nameStr, sizingStr);
+        le_hashmap_Ref_t map = mapTypes[i].createFunc(strdup(nameStr), capacity,
+                                                      le_hashmap_HashUInt32,
+                                                      le_hashmap_EqualsUInt32);
+        snprintf(descriptionStr, sizeof(descriptionStr), "%s u32 (%s)", mapTypes[i].nameStr,
+                 sizingStr);
+        RunBenchmark(descriptionStr, map, IntKeys, sizeof(IntKeys[0]));
+
+        snprintf(nameStr, sizeof(nameStr), "%s-str-%s", mapTypes[i].nameStr, sizingStr);
+        map = mapTypes[i].createFunc(strdup(nameStr), capacity,
+                                     le_hashmap_HashString,
+                                     le_hashmap_EqualsString);
+        snprintf(descriptionStr, sizeof(descriptionStr), "%s str (%s)", mapTypes[i].nameStr,
+                 sizingStr);
+        RunBenchmark(descriptionStr, map, StrKeys, sizeof(StrKeys[0]));
+
+        snprintf(nameStr, sizeof(nameStr), "%s-strfast-%s", mapTypes[i].nameStr, sizingStr);
+        map = mapTypes[i].createFunc(strdup(nameStr), capacity,
+                                     le_hashmap_HashStringFast,
+                                     le_hashmap_EqualsString);
+        snprintf(descriptionStr, sizeof(descriptionStr), "%s strfast (%s)", mapTypes[i].nameStr,
+                 sizingStr);
+        RunBenchmark(descriptionStr, map, StrKeys, sizeof(StrKeys[0]));
+    }
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+
+    LE_TEST_INIT;
+
+    LE_INFO("====  Benchmark of le_hashmap implementations. ====");
+
+    for (i = 0; i < NUM_KEYS * 2; i++)
+    {
+        IntKeys[i] = i;
+        snprintf(StrKeys[i], sizeof(StrKeys[i]), "le_service%zu", i);
+    }
+
+    printf("%d keys, %d lookups per key.  All times are in microseconds.\n",
+           NUM_KEYS, NUM_LOOKUPS);
+    printf("%-24s %10s %10s %10s %10s %10s\n", "map", "put", "get-hit", "get-miss", "iterate",
+           "remove");
+
+    // Once with the maps sized for the keys up front, and once with the maps having to grow.
+    RunAll("sized", NUM_KEYS);
+    RunAll("growing", 1);
+
+    LE_TEST_SUMMARY;
+}
@@ -6,6 +6,7 @@
   */
 
 #include "legato.h"
+#include <sys/mman.h>
 
 
 void TestIntHashMap(le_hashmap_Ref_t map);
@@ -20,6 +21,10 @@ size_t le_hashmap_HashCustom(const void* keyPtr);
 bool le_hashmap_EqualsCustom(const void* firstPtr, const void* secondPtr);
 bool itHandler(const void* keyPtr, const void* valuePtr, void* contextPtr);
 void TestIterRemove(le_hashmap_Ref_t map);
+void TestResize(le_hashmap_Ref_t map, bool isChained);
+void TestFlatMaps(void);
+void TestFastStringHash(void);
+void TestConcurrentMap(void);
 
 typedef struct Key Key_t;
 struct Key {
@@ -62,6 +67,15 @@ COMPONENT_INIT
     TestNewIter();
     TestIterRemove(map1);
 
+    // Start tiny so the map has to grow several times.
+    le_hashmap_Ref_t map6 = le_hashmap_Create("MapResize", 1, &le_hashmap_HashUInt32,
+                                              &le_hashmap_EqualsUInt32);
+    TestResize(map6, true);
+
+    TestFlatMaps();
+    TestFastStringHash();
+    TestConcurrentMap();
+
     LE_INFO("==== Hashmap Tests PASSED ====\n");
 
     LE_TEST_SUMMARY;
@@ -128,7 +142,7 @@ void TestIntHashMap(le_hashmap_Ref_t map)
         le_hashmap_GetValue(mapIt);
     }
     LE_INFO("Iterator count = %d", itercnt);
-    LE_TEST(itercnt == -1);
+    LE_TEST(itercnt == 0);
 
     // Cleanup the map again to allow it to be reused
     le_hashmap_RemoveAll(map);
@@ -428,3 +442,433 @@ void TestIterRemove(le_hashmap_Ref_t map)
     LE_TEST(itercnt == 1000);
     LE_TEST(le_hashmap_Size(map) == 500);
 }
+
+void TestResize(le_hashmap_Ref_t map, bool isChained)
+{
+    static uint32_t iKeys[5000];
+    static bool visited[10000];
+    int itercnt = 0;
+    bool allFound = true;
+
+    LE_INFO("*** Running hashmap resize tests ***");
+
+    memset(visited, 0, sizeof(visited));
+    le_hashmap_SetAutoShrink(map, true);
+
+    int j;
+    for (j = 0; j < 5000; j++)
+    {
+        iKeys[j] = j;
+        le_hashmap_Put(map, &iKeys[j], &iKeys[j]);
+
+        // Keys put earlier must still be found while old buckets are being migrated.
+        if (le_hashmap_Get(map, &iKeys[j / 2]) != &iKeys[j / 2])
+        {
+            allFound = false;
+        }
+    }
+    LE_TEST(allFound);
+    LE_TEST(le_hashmap_Size(map) == 5000);
+    if (isChained)
+    {
+        // The buckets must have grown along with the map.
+        LE_TEST(le_hashmap_CountCollisions(map) < 5000 / 2);
+    }
+
+    // Adding entries during an iteration may start a resize, but must not make the iterator skip
+    // or repeat any of the entries that were already there.  Flat maps put off resizing only until
+    // they are full, so add fewer entries to those.
+    static uint32_t newKeys[5000];
+    uint32_t addCount = isChained ? 5000 : 3000;
+    bool noRepeats = true;
+    for (j = 0; j < 5000; j++)
+    {
+        newKeys[j] = j + 5000;
+    }
+    le_hashmap_It_Ref_t mapIt = le_hashmap_GetIterator(map);
+    while (le_hashmap_NextNode(mapIt) == LE_OK)
+    {
+        const uint32_t* keyPtr = le_hashmap_GetKey(mapIt);
+
+        if (visited[*keyPtr])
+        {
+            noRepeats = false;
+        }
+        visited[*keyPtr] = true;
+
+        if (*keyPtr < 5000)
+        {
+            itercnt++;
+            if (*keyPtr < addCount)
+            {
+                le_hashmap_Put(map, &newKeys[*keyPtr], &newKeys[*keyPtr]);
+            }
+        }
+    }
+    LE_TEST(noRepeats);
+    LE_TEST(itercnt == 5000);
+    LE_TEST(le_hashmap_Size(map) == 5000 + addCount);
+
+    // Remove almost everything and check the rest is still there as the map shrinks.
+    for (j = 0; j < 5000; j++)
+    {
+        le_hashmap_Remove(map, &newKeys[j]);
+        if (j % 100 != 0)
+        {
+            le_hashmap_Remove(map, &iKeys[j]);
+        }
+    }
+    LE_TEST(le_hashmap_Size(map) == 50);
+
+    allFound = true;
+    for (j = 0; j < 5000; j += 100)
+    {
+        if (le_hashmap_Get(map, &iKeys[j]) != &iKeys[j])
+        {
+            allFound = false;
+        }
+    }
+    LE_TEST(allFound);
+    LE_TEST(le_hashmap_Get(map, &iKeys[1]) == NULL);
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+
+    if (isChained)
+    {
+        // An iteration that is given up part way through must not hold up resizing forever.  Once
+        // the map has to grow again, the held-up resize is finished and the iterator starts over.
+        static uint32_t moreKeys[10000];
+
+        for (j = 0; j < 5000; j++)
+        {
+            le_hashmap_Put(map, &iKeys[j], &iKeys[j]);
+        }
+
+        mapIt = le_hashmap_GetIterator(map);
+        LE_TEST(le_hashmap_NextNode(mapIt) == LE_OK);
+
+        for (j = 0; j < 10000; j++)
+        {
+            moreKeys[j] = j + 10000;
+            le_hashmap_Put(map, &moreKeys[j], &moreKeys[j]);
+        }
+        LE_TEST(le_hashmap_GetKey(mapIt) == NULL);
+        LE_TEST(le_hashmap_CountCollisions(map) < 15000 / 2);
+
+        itercnt = 0;
+        while (le_hashmap_NextNode(mapIt) == LE_OK)
+        {
+            itercnt++;
+        }
+        LE_TEST(itercnt == 15000);
+
+        le_hashmap_RemoveAll(map);
+        LE_TEST(le_hashmap_isEmpty(map));
+    }
+}
+
+void TestFlatMaps(void)
+{
+    LE_INFO("*** Running flat hashmap tests ***");
+
+    le_hashmap_Ref_t flatMap1 = le_hashmap_CreateFlat("FlatMap1", 200, &le_hashmap_HashUInt32,
+                                                      &le_hashmap_EqualsUInt32);
+    le_hashmap_Ref_t flatMap2 = le_hashmap_CreateFlat("FlatMap2", 200, &le_hashmap_HashString,
+                                                      &le_hashmap_EqualsString);
+    le_hashmap_Ref_t flatMap3 = le_hashmap_CreateFlat("FlatMap3", 200, &le_hashmap_HashCustom,
+                                                      &le_hashmap_EqualsCustom);
+    le_hashmap_Ref_t flatMap4 = le_hashmap_CreateFlat("FlatMap4", 1, &le_hashmap_HashUInt32,
+                                                      &le_hashmap_EqualsUInt32);
+    le_hashmap_Ref_t flatMap5 = le_hashmap_CreateFlat("FlatMap5", 100,
+                                                      &le_hashmap_HashVoidPointer,
+                                                      &le_hashmap_EqualsVoidPointer);
+    le_hashmap_Ref_t flatMap6 = le_hashmap_CreateFlat("FlatMapResize", 1,
+                                                      &le_hashmap_HashUInt32,
+                                                      &le_hashmap_EqualsUInt32);
+
+    TestIntHashMap(flatMap1);
+    TestStringHashMap(flatMap2);
+    TestCustomHashMap(flatMap3);
+    TestTinyMap(flatMap4);
+    TestPointerMap(flatMap5);
+    TestIterRemove(flatMap1);
+    TestResize(flatMap6, false);
+
+    // Removing keys so that deleted slots pile up must not lose any of the other keys.
+    static uint32_t keys[64];
+    uint32_t round;
+    bool allFound = true;
+    le_hashmap_RemoveAll(flatMap4);
+    for (round = 0; round < 100; round++)
+    {
+        uint32_t j;
+        for (j = 0; j < 64; j++)
+        {
+            keys[j] = round * 64 + j;
+            le_hashmap_Put(flatMap4, &keys[j], &keys[j]);
+        }
+        for (j = 0; j < 64; j += 2)
+        {
+            le_hashmap_Remove(flatMap4, &keys[j]);
+        }
+        for (j = 1; j < 64; j += 2)
+        {
+            if (le_hashmap_Get(flatMap4, &keys[j]) != &keys[j])
+            {
+                allFound = false;
+            }
+            le_hashmap_Remove(flatMap4, &keys[j]);
+        }
+    }
+    LE_TEST(allFound);
+    LE_TEST(le_hashmap_isEmpty(flatMap4));
+}
+
+
+void TestFastStringHash(void)
+{
+    LE_INFO("*** Running fast string hash tests ***");
+
+    static const char* const testStrs[] =
+        { "", "a", "le_service", "exactly8", "exactly16chars!!", "AT+CGDCONT", "AT+CGDCONU" };
+    static char buf[64];
+    size_t i;
+    size_t offset;
+
+    // The hash must not depend on where the string is, only on what's in it.
+    bool sameHash = true;
+    for (i = 0; i < NUM_ARRAY_MEMBERS(testStrs); i++)
+    {
+        size_t hash = le_hashmap_HashStringFast(testStrs[i]);
+        for (offset = 0; offset < 8; offset++)
+        {
+            strcpy(buf + offset, testStrs[i]);
+            if (le_hashmap_HashStringFast(buf + offset) != hash)
+            {
+                sameHash = false;
+            }
+        }
+    }
+    LE_TEST(sameHash);
+
+    // Strings that differ by one character, or only in length, should hash differently.
+    bool allDifferent = true;
+    for (i = 1; i < NUM_ARRAY_MEMBERS(testStrs); i++)
+    {
+        if (le_hashmap_HashStringFast(testStrs[i]) == le_hashmap_HashStringFast(testStrs[i - 1]))
+        {
+            allDifferent = false;
+        }
+    }
+    LE_TEST(allDifferent);
+
+    // Strings that end right before a page boundary must be hashed without reading past it.
+    long pageSize = sysconf(_SC_PAGESIZE);
+    char* pagesPtr = mmap(NULL, pageSize * 2, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    LE_TEST(pagesPtr != MAP_FAILED);
+    if (pagesPtr != MAP_FAILED)
+    {
+        LE_TEST(mprotect(pagesPtr + pageSize, pageSize, PROT_NONE) == 0);
+        for (offset = 1; offset <= 16; offset++)
+        {
+            char* strPtr = pagesPtr + pageSize - offset;
+            memset(strPtr, 'x', offset - 1);
+            strPtr[offset - 1] = '\0';
+            memcpy(buf, strPtr, offset);
+            LE_TEST(le_hashmap_HashStringFast(strPtr) == le_hashmap_HashStringFast(buf));
+        }
+        munmap(pagesPtr, pageSize * 2);
+    }
+
+    // Look-ups with a precomputed hash must find the same entries as normal look-ups, in both
+    // chained and flat maps.
+    le_hashmap_Ref_t maps[2];
+    maps[0] = le_hashmap_Create("FastStrChained", 4, le_hashmap_HashStringFast,
+                                le_hashmap_EqualsString);
+    maps[1] = le_hashmap_CreateFlat("FastStrFlat", 4, le_hashmap_HashStringFast,
+                                    le_hashmap_EqualsString);
+    static char keys[200][16];
+    size_t m;
+    for (m = 0; m < NUM_ARRAY_MEMBERS(maps); m++)
+    {
+        bool allFound = true;
+        for (i = 0; i < NUM_ARRAY_MEMBERS(keys); i++)
+        {
+            snprintf(keys[i], sizeof(keys[i]), "key%zu", i);
+            le_hashmap_Put(maps[m], keys[i], keys[i]);
+        }
+        for (i = 0; i < NUM_ARRAY_MEMBERS(keys); i++)
+        {
+            // Use a copy of the key, to make sure it's not just the pointers being compared.
+            snprintf(buf, sizeof(buf), "key%zu", i);
+            size_t hash = le_hashmap_HashStringFast(buf);
+            if ((le_hashmap_GetWithHash(maps[m], buf, hash) != keys[i]) ||
+                (le_hashmap_Get(maps[m], buf) != keys[i]))
+            {
+                allFound = false;
+            }
+        }
+        LE_TEST(allFound);
+        LE_TEST(le_hashmap_GetWithHash(maps[m], "missing",
+                                       le_hashmap_HashStringFast("missing")) == NULL);
+    }
+}
+
+
+#define CONC_STABLE_KEYS    500
+#define CONC_WRITERS        4
+#define CONC_WRITER_KEYS    2000
+#define CONC_READERS        2
+
+static le_hashmap_Ref_t ConcMap;
+static uint32_t ConcStableKeys[CONC_STABLE_KEYS];
+static uint32_t ConcWriterKeys[CONC_WRITERS][CONC_WRITER_KEYS];
+static bool ConcWritersDone;
+
+static void* ConcWriterMain(void* contextPtr)
+{
+    uint32_t* keysPtr = contextPtr;
+    bool ok = true;
+    int round;
+    size_t i;
+
+    for (round = 0; round < 20; round++)
+    {
+        for (i = 0; i < CONC_WRITER_KEYS; i++)
+        {
+            le_hashmap_Put(ConcMap, &keysPtr[i], &keysPtr[i]);
+        }
+        for (i = 0; i < CONC_WRITER_KEYS; i++)
+        {
+            if (le_hashmap_Get(ConcMap, &keysPtr[i]) != &keysPtr[i])
+            {
+                ok = false;
+            }
+        }
+        for (i = 0; i < CONC_WRITER_KEYS; i++)
+        {
+            if (le_hashmap_Remove(ConcMap, &keysPtr[i]) != &keysPtr[i])
+            {
+                ok = false;
+            }
+        }
+    }
+
+    return ok ? contextPtr : NULL;
+}
+
+static void* ConcReaderMain(void* contextPtr)
+{
+    bool ok = true;
+    size_t lookups = 0;
+    size_t i;
+
+    // Keep going until the writers are done, and at least once through.
+    do
+    {
+        for (i = 0; i < CONC_STABLE_KEYS; i++)
+        {
+            if (le_hashmap_Get(ConcMap, &ConcStableKeys[i]) != &ConcStableKeys[i])
+            {
+                ok = false;
+            }
+        }
+        lookups += CONC_STABLE_KEYS;
+    }
+    while (!__atomic_load_n(&ConcWritersDone, __ATOMIC_ACQUIRE));
+
+    LE_INFO("Concurrent reader did %zu lookups.", lookups);
+
+    return ok ? contextPtr : NULL;
+}
+
+static bool CountHandler(const void* keyPtr, const void* valuePtr, void* contextPtr)
+{
+    (*(size_t*)contextPtr)++;
+    return true;
+}
+
+void TestConcurrentMap(void)
+{
+    LE_INFO("*** Running concurrent map tests ***");
+
+    // Start small so that the map has to grow while it's being used.
+    ConcMap = le_hashmap_CreateConcurrent("ConcurrentMap", 4, le_hashmap_HashUInt32,
+                                          le_hashmap_EqualsUInt32);
+
+    uint32_t i, j;
+    for (i = 0; i < CONC_STABLE_KEYS; i++)
+    {
+        ConcStableKeys[i] = i;
+        LE_ASSERT(le_hashmap_Put(ConcMap, &ConcStableKeys[i], &ConcStableKeys[i]) == NULL);
+    }
+    for (i = 0; i < CONC_WRITERS; i++)
+    {
+        for (j = 0; j < CONC_WRITER_KEYS; j++)
+        {
+            ConcWriterKeys[i][j] = CONC_STABLE_KEYS + i * CONC_WRITER_KEYS + j;
+        }
+    }
+
+    // Single-threaded behaviour is the same as for the other map types.
+    uint32_t key = 7;
+    uint32_t missingKey = CONC_STABLE_KEYS + CONC_WRITERS * CONC_WRITER_KEYS;
+    LE_TEST(le_hashmap_Size(ConcMap) == CONC_STABLE_KEYS);
+    LE_TEST(le_hashmap_Get(ConcMap, &key) == &ConcStableKeys[7]);
+    LE_TEST(le_hashmap_GetStoredKey(ConcMap, &key) == &ConcStableKeys[7]);
+    LE_TEST(le_hashmap_ContainsKey(ConcMap, &key));
+    LE_TEST(!le_hashmap_ContainsKey(ConcMap, &missingKey));
+    LE_TEST(le_hashmap_Get(ConcMap, &missingKey) == NULL);
+    LE_TEST(le_hashmap_Remove(ConcMap, &missingKey) == NULL);
+    LE_TEST(le_hashmap_Put(ConcMap, &key, &missingKey) == &ConcStableKeys[7]);
+    LE_TEST(le_hashmap_Put(ConcMap, &key, &ConcStableKeys[7]) == &missingKey);
+    size_t count = 0;
+    le_hashmap_ForEach(ConcMap, CountHandler, &count);
+    LE_TEST(count == CONC_STABLE_KEYS);
+
+    // Writers add and remove their own keys while readers look up the stable keys.
+    le_thread_Ref_t writers[CONC_WRITERS];
+    le_thread_Ref_t readers[CONC_READERS];
+    char name[32];
+    for (i = 0; i < CONC_READERS; i++)
+    {
+        snprintf(name, sizeof(name), "ConcReader%u", i);
+        readers[i] = le_thread_Create(name, ConcReaderMain, &readers[i]);
+        le_thread_SetJoinable(readers[i]);
+        le_thread_Start(readers[i]);
+    }
+    for (i = 0; i < CONC_WRITERS; i++)
+    {
+        snprintf(name, sizeof(name), "ConcWriter%u", i);
+        writers[i] = le_thread_Create(name, ConcWriterMain, ConcWriterKeys[i]);
+        le_thread_SetJoinable(writers[i]);
+        le_thread_Start(writers[i]);
+    }
+
+    bool allOk = true;
+    void* resultPtr;
+    for (i = 0; i < CONC_WRITERS; i++)
+    {
+        LE_ASSERT(le_thread_Join(writers[i], &resultPtr) == LE_OK);
+        allOk = allOk && (resultPtr == ConcWriterKeys[i]);
+    }
+    LE_TEST(allOk);
+
+    __atomic_store_n(&ConcWritersDone, true, __ATOMIC_RELEASE);
+
+    allOk = true;
+    for (i = 0; i < CONC_READERS; i++)
+    {
+        LE_ASSERT(le_thread_Join(readers[i], &resultPtr) == LE_OK);
+        allOk = allOk && (resultPtr != NULL);
+    }
+    LE_TEST(allOk);
+
+    LE_TEST(le_hashmap_Size(ConcMap) == CONC_STABLE_KEYS);
+
+    le_hashmap_RemoveAll(ConcMap);
+    LE_TEST(le_hashmap_isEmpty(ConcMap));
+    LE_TEST(le_hashmap_Get(ConcMap, &key) == NULL);
+}
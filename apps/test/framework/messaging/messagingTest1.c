@@ -119,8 +119,17 @@ static void SendSomeStuffToServer
     msgPtr->payload = 0xBEEFBEEF;
     le_msg_Send(msgRef);
 
-    // Send a request to the server.
-    msgRef = le_msg_CreateMsg(sessionRef);
+    if ((ClientResponseCount % 2) == 0)
+    {
+        // Send a request to the server.
+        msgRef = le_msg_CreateMsg(sessionRef);
+    }
+    else
+    {
+        // Send a request to the server, using a message that is only as big as it needs to be.
+        msgRef = le_msg_CreateMsgWithSize(sessionRef, sizeof(msgPtr->payload));
+        LE_TEST(le_msg_GetMaxPayloadSize(msgRef) >= sizeof(msgPtr->payload));
+    }
     msgPtr = le_msg_GetPayloadPtr(msgRef);
     msgPtr->payload = 0xDEADBEEF;
     le_msg_RequestResponse(msgRef, ClientResponseRecvHandler, (void*)ClientRespContextStr);
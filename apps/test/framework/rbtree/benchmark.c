@@ -0,0 +1,265 @@
+ /**
+  * Benchmark comparing le_rbtree with the hand-sorted le_dls lists that the framework uses for
+  * ordered data (such as the active timer lists in timer.c).
+  *
+  * Both containers are filled with the same random keys, then used as a timer list would be (the
+  * first node is taken out and put back in with a later key), then emptied in random order.  The
+  * time taken for each phase is printed.  Both containers must come out in the same order, so this
+  * doubles as a test that they agree.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of nodes in each container, and number of times the first node is re-scheduled.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_NODES       5000
+#define NUM_RESCHEDULES 20000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark node, which can be in either container.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t key;
+    le_dls_Link_t link;
+    le_rbtree_Node_t treeNode;
+}
+Node_t;
+
+static Node_t Nodes[NUM_NODES];
+static Node_t* RemoveOrder[NUM_NODES];
+static uint64_t RescheduleDelays[NUM_RESCHEDULES];
+
+
+static int CompareKeys(const void* key1Ptr, const void* key2Ptr)
+{
+    uint64_t key1 = *(const uint64_t*)key1Ptr;
+    uint64_t key2 = *(const uint64_t*)key2Ptr;
+
+    return (key1 > key2) - (key1 < key2);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of microseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t MicrosecondsSince
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a node to a sorted list, after any nodes with an equal key, the same way timer.c does.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToSortedList
+(
+    le_dls_List_t* listPtr,
+    Node_t* newNodePtr
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(listPtr);
+
+    while (linkPtr != NULL)
+    {
+        if (CONTAINER_OF(linkPtr, Node_t, link)->key > newNodePtr->key)
+        {
+            break;
+        }
+        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+    }
+
+    if (linkPtr == NULL)
+    {
+        le_dls_Queue(listPtr, &newNodePtr->link);
+    }
+    else
+    {
+        le_dls_AddBefore(listPtr, linkPtr, &newNodePtr->link);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the benchmark on a sorted list.
+ *
+ * @return Sum of the keys of the first node seen after each re-schedule, to compare with the tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t RunListBenchmark(void)
+{
+    le_dls_List_t list = LE_DLS_LIST_INIT;
+    le_clk_Time_t startTime;
+    uint64_t checksum = 0;
+    size_t i;
+
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        Nodes[i].link = LE_DLS_LINK_INIT;
+    }
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        AddToSortedList(&list, &Nodes[i]);
+    }
+    uint64_t insertTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_RESCHEDULES; i++)
+    {
+        Node_t* nodePtr = CONTAINER_OF(le_dls_Pop(&list), Node_t, link);
+
+        nodePtr->key += RescheduleDelays[i];
+        AddToSortedList(&list, nodePtr);
+        checksum += CONTAINER_OF(le_dls_Peek(&list), Node_t, link)->key;
+    }
+    uint64_t rescheduleTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        le_dls_Remove(&list, &RemoveOrder[i]->link);
+    }
+    uint64_t removeTime = MicrosecondsSince(startTime);
+
+    LE_TEST(le_dls_IsEmpty(&list));
+
+    printf("%-12s %12"PRIu64" %12"PRIu64" %12"PRIu64"\n",
+           "le_dls", insertTime, rescheduleTime, removeTime);
+
+    return checksum;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the benchmark on a tree.
+ *
+ * @return Sum of the keys of the first node seen after each re-schedule, to compare with the list.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t RunTreeBenchmark(void)
+{
+    le_rbtree_Tree_t tree;
+    le_clk_Time_t startTime;
+    uint64_t checksum = 0;
+    size_t i;
+
+    le_rbtree_InitTree(&tree, CompareKeys);
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        le_rbtree_InitNode(&Nodes[i].treeNode, &Nodes[i].key);
+    }
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        le_rbtree_Insert(&tree, &Nodes[i].treeNode);
+    }
+    uint64_t insertTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_RESCHEDULES; i++)
+    {
+        le_rbtree_Node_t* treeNodePtr = le_rbtree_GetFirst(&tree);
+        Node_t* nodePtr = CONTAINER_OF(treeNodePtr, Node_t, treeNode);
+
+        le_rbtree_Remove(&tree, treeNodePtr);
+        nodePtr->key += RescheduleDelays[i];
+        le_rbtree_Insert(&tree, treeNodePtr);
+        checksum += CONTAINER_OF(le_rbtree_GetFirst(&tree), Node_t, treeNode)->key;
+    }
+    uint64_t rescheduleTime = MicrosecondsSince(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        le_rbtree_Remove(&tree, &RemoveOrder[i]->treeNode);
+    }
+    uint64_t removeTime = MicrosecondsSince(startTime);
+
+    LE_TEST(le_rbtree_IsEmpty(&tree));
+
+    printf("%-12s %12"PRIu64" %12"PRIu64" %12"PRIu64"\n",
+           "le_rbtree", insertTime, rescheduleTime, removeTime);
+
+    return checksum;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets all the nodes' keys back to their starting values.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResetKeys(void)
+{
+    size_t i;
+
+    srand(1);
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        Nodes[i].key = rand() % 1000000;
+    }
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+
+    LE_TEST_INIT;
+
+    LE_INFO("====  Benchmark of le_rbtree against sorted le_dls lists. ====");
+
+    // The nodes are removed at the end in a random order, and re-scheduled by random delays.
+    srand(2);
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        RemoveOrder[i] = &Nodes[i];
+    }
+    for (i = NUM_NODES - 1; i > 0; i--)
+    {
+        size_t j = rand() % (i + 1);
+        Node_t* tmpPtr = RemoveOrder[i];
+        RemoveOrder[i] = RemoveOrder[j];
+        RemoveOrder[j] = tmpPtr;
+    }
+    for (i = 0; i < NUM_RESCHEDULES; i++)
+    {
+        RescheduleDelays[i] = rand() % 1000000;
+    }
+
+    printf("%d nodes, %d re-schedules.  All times are in microseconds.\n",
+           NUM_NODES, NUM_RESCHEDULES);
+    printf("%-12s %12s %12s %12s\n", "container", "insert", "reschedule", "remove");
+
+    ResetKeys();
+    uint64_t listChecksum = RunListBenchmark();
+    ResetKeys();
+    uint64_t treeChecksum = RunTreeBenchmark();
+
+    LE_TEST(listChecksum == treeChecksum);
+
+    LE_TEST_SUMMARY;
+}
@@ -0,0 +1,393 @@
+ /**
+  * This module is for unit testing the le_rbtree module in the legato
+  * runtime library
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of nodes used by the tests.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_NODES   1000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test node.  Keys are even numbers, so that odd numbers can be used to search between them.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int key;
+    int insertOrder;
+    le_rbtree_Node_t treeNode;
+}
+TestNode_t;
+
+static le_mem_PoolRef_t NodePool;
+
+
+static int CompareInts(const void* key1Ptr, const void* key2Ptr)
+{
+    int key1 = *(const int*)key1Ptr;
+    int key2 = *(const int*)key2Ptr;
+
+    return (key1 > key2) - (key1 < key2);
+}
+
+
+static int NodeKey(const le_rbtree_Node_t* nodePtr)
+{
+    return *(const int*)le_rbtree_GetKey(nodePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the red/black properties and parent links of a sub-tree.
+ *
+ * @return The black height of the sub-tree, or -1 if it is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CheckSubTree(const le_rbtree_Node_t* nodePtr, const le_rbtree_Node_t* parentPtr)
+{
+    if (nodePtr == NULL)
+    {
+        return 1;
+    }
+
+    if ((nodePtr->parentPtr != parentPtr) || (nodePtr->color == LE_RBTREE_NOT_IN_TREE))
+    {
+        return -1;
+    }
+
+    if ((nodePtr->color == LE_RBTREE_RED) &&
+        (((nodePtr->leftPtr != NULL) && (nodePtr->leftPtr->color == LE_RBTREE_RED)) ||
+         ((nodePtr->rightPtr != NULL) && (nodePtr->rightPtr->color == LE_RBTREE_RED))))
+    {
+        return -1;
+    }
+
+    int leftHeight = CheckSubTree(nodePtr->leftPtr, nodePtr);
+    int rightHeight = CheckSubTree(nodePtr->rightPtr, nodePtr);
+
+    if ((leftHeight < 0) || (leftHeight != rightHeight))
+    {
+        return -1;
+    }
+
+    return leftHeight + ((nodePtr->color == LE_RBTREE_BLACK) ? 1 : 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that a tree is a valid red/black tree, that it is in order both ways, and that equal keys
+ * are in insertion order.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsTreeValid(const le_rbtree_Tree_t* treePtr)
+{
+    if ((treePtr->rootPtr != NULL) && (treePtr->rootPtr->color != LE_RBTREE_BLACK))
+    {
+        return false;
+    }
+
+    if (CheckSubTree(treePtr->rootPtr, NULL) < 0)
+    {
+        return false;
+    }
+
+    size_t count = 0;
+    const TestNode_t* prevPtr = NULL;
+    le_rbtree_Node_t* nodePtr = le_rbtree_GetFirst(treePtr);
+
+    while (nodePtr != NULL)
+    {
+        const TestNode_t* testNodePtr = CONTAINER_OF(nodePtr, TestNode_t, treeNode);
+
+        if ((prevPtr != NULL) &&
+            ((prevPtr->key > testNodePtr->key) ||
+             ((prevPtr->key == testNodePtr->key) &&
+              (prevPtr->insertOrder > testNodePtr->insertOrder))))
+        {
+            return false;
+        }
+
+        if ((prevPtr != NULL) && (le_rbtree_GetPrev(treePtr, nodePtr) != &prevPtr->treeNode))
+        {
+            return false;
+        }
+
+        prevPtr = testNodePtr;
+        count++;
+        nodePtr = le_rbtree_GetNext(treePtr, nodePtr);
+    }
+
+    if ((prevPtr != NULL) && (le_rbtree_GetLast(treePtr) != &prevPtr->treeNode))
+    {
+        return false;
+    }
+
+    return (count == le_rbtree_NumNodes(treePtr));
+}
+
+
+static TestNode_t* NewNode(int key, int insertOrder)
+{
+    TestNode_t* nodePtr = le_mem_ForceAlloc(NodePool);
+
+    nodePtr->key = key;
+    nodePtr->insertOrder = insertOrder;
+    le_rbtree_InitNode(&nodePtr->treeNode, &nodePtr->key);
+
+    return nodePtr;
+}
+
+
+static void Shuffle(TestNode_t** nodesPtr, size_t count)
+{
+    size_t i;
+
+    for (i = count - 1; i > 0; i--)
+    {
+        size_t j = rand() % (i + 1);
+        TestNode_t* tmpPtr = nodesPtr[i];
+        nodesPtr[i] = nodesPtr[j];
+        nodesPtr[j] = tmpPtr;
+    }
+}
+
+
+static void TestEmptyTree(void)
+{
+    le_rbtree_Tree_t tree;
+    int key = 0;
+
+    LE_INFO("-> Empty tree");
+
+    le_rbtree_InitTree(&tree, CompareInts);
+
+    LE_TEST(le_rbtree_IsEmpty(&tree));
+    LE_TEST(le_rbtree_NumNodes(&tree) == 0);
+    LE_TEST(le_rbtree_GetFirst(&tree) == NULL);
+    LE_TEST(le_rbtree_GetLast(&tree) == NULL);
+    LE_TEST(le_rbtree_Find(&tree, &key) == NULL);
+    LE_TEST(le_rbtree_LowerBound(&tree, &key) == NULL);
+    LE_TEST(le_rbtree_UpperBound(&tree, &key) == NULL);
+
+    TestNode_t* nodePtr = NewNode(key, 0);
+    LE_TEST(!le_rbtree_IsInTree(&nodePtr->treeNode));
+    le_rbtree_Insert(&tree, &nodePtr->treeNode);
+    LE_TEST(le_rbtree_IsInTree(&nodePtr->treeNode));
+    LE_TEST(le_rbtree_GetFirst(&tree) == &nodePtr->treeNode);
+    LE_TEST(le_rbtree_GetLast(&tree) == &nodePtr->treeNode);
+    LE_TEST(le_rbtree_GetNext(&tree, &nodePtr->treeNode) == NULL);
+    LE_TEST(le_rbtree_GetPrev(&tree, &nodePtr->treeNode) == NULL);
+
+    le_rbtree_Remove(&tree, &nodePtr->treeNode);
+    LE_TEST(!le_rbtree_IsInTree(&nodePtr->treeNode));
+    LE_TEST(le_rbtree_IsEmpty(&tree));
+    LE_TEST(le_rbtree_GetFirst(&tree) == NULL);
+    le_mem_Release(nodePtr);
+}
+
+
+static void TestOrderedOperations(void)
+{
+    le_rbtree_Tree_t tree;
+    TestNode_t* nodes[NUM_NODES];
+    size_t i;
+
+    LE_INFO("-> Insert, search and remove in random order");
+
+    le_rbtree_InitTree(&tree, CompareInts);
+
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        nodes[i] = NewNode(i * 2, i);
+    }
+    Shuffle(nodes, NUM_NODES);
+
+    bool isValid = true;
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        le_rbtree_Insert(&tree, &nodes[i]->treeNode);
+        if ((i % 97) == 0)
+        {
+            isValid = isValid && IsTreeValid(&tree);
+        }
+    }
+    LE_TEST(isValid && IsTreeValid(&tree));
+    LE_TEST(le_rbtree_NumNodes(&tree) == NUM_NODES);
+    LE_TEST(NodeKey(le_rbtree_GetFirst(&tree)) == 0);
+    LE_TEST(NodeKey(le_rbtree_GetLast(&tree)) == (NUM_NODES - 1) * 2);
+
+    bool isFound = true;
+    for (i = 0; i < NUM_NODES * 2; i++)
+    {
+        int key = i;
+        le_rbtree_Node_t* foundPtr = le_rbtree_Find(&tree, &key);
+        le_rbtree_Node_t* lowerPtr = le_rbtree_LowerBound(&tree, &key);
+        le_rbtree_Node_t* upperPtr = le_rbtree_UpperBound(&tree, &key);
+
+        if ((key % 2) == 0)
+        {
+            isFound = isFound && (foundPtr != NULL) && (NodeKey(foundPtr) == key);
+            isFound = isFound && (lowerPtr == foundPtr);
+        }
+        else
+        {
+            isFound = isFound && (foundPtr == NULL);
+            isFound = isFound && (lowerPtr == upperPtr);
+        }
+
+        if (key >= (NUM_NODES - 1) * 2)
+        {
+            isFound = isFound && (upperPtr == NULL);
+        }
+        else
+        {
+            isFound = isFound && (upperPtr != NULL) && (NodeKey(upperPtr) == (key / 2 + 1) * 2);
+        }
+    }
+    LE_TEST(isFound);
+
+    int key = -1;
+    LE_TEST(le_rbtree_LowerBound(&tree, &key) == le_rbtree_GetFirst(&tree));
+
+    // Remove half the nodes in a different random order.
+    Shuffle(nodes, NUM_NODES);
+    isValid = true;
+    for (i = 0; i < NUM_NODES / 2; i++)
+    {
+        le_rbtree_Remove(&tree, &nodes[i]->treeNode);
+        if ((i % 53) == 0)
+        {
+            isValid = isValid && IsTreeValid(&tree);
+        }
+    }
+    LE_TEST(isValid && IsTreeValid(&tree));
+    LE_TEST(le_rbtree_NumNodes(&tree) == NUM_NODES - NUM_NODES / 2);
+
+    isFound = true;
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        bool isInTree = (i >= NUM_NODES / 2);
+
+        isFound = isFound && (le_rbtree_IsInTree(&nodes[i]->treeNode) == isInTree);
+        isFound = isFound &&
+                  ((le_rbtree_Find(&tree, &nodes[i]->key) == &nodes[i]->treeNode) == isInTree);
+    }
+    LE_TEST(isFound);
+
+    // Remove the rest while iterating, fetching the next node first.
+    le_rbtree_Node_t* nodePtr = le_rbtree_GetFirst(&tree);
+    while (nodePtr != NULL)
+    {
+        le_rbtree_Node_t* nextPtr = le_rbtree_GetNext(&tree, nodePtr);
+
+        le_rbtree_Remove(&tree, nodePtr);
+        LE_ASSERT(le_rbtree_GetFirst(&tree) == nextPtr);
+        nodePtr = nextPtr;
+    }
+    LE_TEST(le_rbtree_IsEmpty(&tree));
+    LE_TEST(le_rbtree_NumNodes(&tree) == 0);
+
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        le_mem_Release(nodes[i]);
+    }
+}
+
+
+static void TestDuplicateKeys(void)
+{
+    le_rbtree_Tree_t tree;
+    TestNode_t* nodes[NUM_NODES];
+    size_t i;
+
+    LE_INFO("-> Duplicate keys");
+
+    le_rbtree_InitTree(&tree, CompareInts);
+
+    // Only ten different keys, inserted in random key order.
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        nodes[i] = NewNode((rand() % 10) * 2, i);
+        le_rbtree_Insert(&tree, &nodes[i]->treeNode);
+    }
+    LE_TEST(IsTreeValid(&tree));
+
+    // Find gets the first inserted node with the key, and UpperBound skips all of them.
+    bool isFound = true;
+    int key;
+    for (key = 0; key < 20; key += 2)
+    {
+        le_rbtree_Node_t* foundPtr = le_rbtree_Find(&tree, &key);
+        le_rbtree_Node_t* upperPtr = le_rbtree_UpperBound(&tree, &key);
+
+        if (foundPtr == NULL)
+        {
+            continue;
+        }
+
+        for (i = 0; i < NUM_NODES; i++)
+        {
+            if (nodes[i]->key == key)
+            {
+                isFound = isFound && (foundPtr == &nodes[i]->treeNode);
+                break;
+            }
+        }
+
+        le_rbtree_Node_t* prevPtr = (upperPtr == NULL) ? le_rbtree_GetLast(&tree) :
+                                                         le_rbtree_GetPrev(&tree, upperPtr);
+        isFound = isFound && (NodeKey(prevPtr) == key);
+    }
+    LE_TEST(isFound);
+
+    // Removing from the middle of a run of equal keys keeps the rest in order.
+    for (i = 0; i < NUM_NODES; i += 3)
+    {
+        le_rbtree_Remove(&tree, &nodes[i]->treeNode);
+    }
+    LE_TEST(IsTreeValid(&tree));
+
+    for (i = 0; i < NUM_NODES; i++)
+    {
+        if (le_rbtree_IsInTree(&nodes[i]->treeNode))
+        {
+            le_rbtree_Remove(&tree, &nodes[i]->treeNode);
+        }
+        le_mem_Release(nodes[i]);
+    }
+    LE_TEST(le_rbtree_IsEmpty(&tree));
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    LE_INFO("\n");
+    LE_INFO("====  Unit test for  le_rbtree module. ====");
+
+    NodePool = le_mem_CreatePool("RbtreeTestNodes", sizeof(TestNode_t));
+    le_mem_ExpandPool(NodePool, NUM_NODES);
+
+    srand(1);
+
+    TestEmptyTree();
+    TestOrderedOperations();
+    TestDuplicateKeys();
+
+    LE_INFO("====  le_rbtree test complete. ====");
+
+    LE_TEST_SUMMARY;
+}
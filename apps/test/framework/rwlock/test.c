@@ -0,0 +1,275 @@
+ /**
+  * Tests for the Reader-Writer Lock API.
+  *
+  * The main thread holds the lock in one mode or another while other threads try to get it,
+  * checking who is let in, that a waiting writer goes ahead of readers that come after it, and
+  * finally that the lock keeps data consistent when several threads hammer on it at once.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+#define NUM_STRESS_THREADS      4
+#define NUM_STRESS_ITERATIONS   10000
+
+
+static le_rwlock_Ref_t LockRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs a function in a new thread and returns what it returned.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t StartThread(const char* name, le_thread_MainFunc_t func, void* contextPtr)
+{
+    le_thread_Ref_t threadRef = le_thread_Create(name, func, contextPtr);
+    le_thread_SetJoinable(threadRef);
+    le_thread_Start(threadRef);
+
+    return threadRef;
+}
+
+static void* JoinThread(le_thread_Ref_t threadRef)
+{
+    void* resultPtr;
+
+    LE_ASSERT(le_thread_Join(threadRef, &resultPtr) == LE_OK);
+
+    return resultPtr;
+}
+
+static le_result_t RunInThread(le_thread_MainFunc_t func)
+{
+    return (le_result_t)(intptr_t)JoinThread(StartThread("tryer", func, NULL));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Try to get the lock from another thread, letting it go again straight away if that worked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* TryRead(void* contextPtr)
+{
+    le_result_t result = le_rwlock_TryReadLock(LockRef);
+
+    if (result == LE_OK)
+    {
+        le_rwlock_Unlock(LockRef);
+    }
+
+    return (void*)(intptr_t)result;
+}
+
+static void* TryWrite(void* contextPtr)
+{
+    le_result_t result = le_rwlock_TryWriteLock(LockRef);
+
+    if (result == LE_OK)
+    {
+        le_rwlock_Unlock(LockRef);
+    }
+
+    return (void*)(intptr_t)result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Readers share the lock, but keep writers out.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestShared(void)
+{
+    LE_INFO("---- Shared ----");
+
+    le_rwlock_ReadLock(LockRef);
+
+    LE_TEST(RunInThread(TryRead) == LE_OK);
+    LE_TEST(RunInThread(TryWrite) == LE_WOULD_BLOCK);
+
+    le_rwlock_Unlock(LockRef);
+
+    LE_TEST(RunInThread(TryWrite) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A writer keeps everybody else out.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestExclusive(void)
+{
+    LE_INFO("---- Exclusive ----");
+
+    LE_TEST(le_rwlock_TryWriteLock(LockRef) == LE_OK);
+
+    LE_TEST(RunInThread(TryRead) == LE_WOULD_BLOCK);
+    LE_TEST(RunInThread(TryWrite) == LE_WOULD_BLOCK);
+
+    le_rwlock_Unlock(LockRef);
+
+    LE_TEST(RunInThread(TryRead) == LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Once a writer is waiting, new readers wait behind it.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mutex_Ref_t LogMutex;
+static int Log[2];
+static size_t LogCount;
+
+static void AddToLog(int entry)
+{
+    le_mutex_Lock(LogMutex);
+    LE_ASSERT(LogCount < NUM_ARRAY_MEMBERS(Log));
+    Log[LogCount++] = entry;
+    le_mutex_Unlock(LogMutex);
+}
+
+static void* Writer(void* contextPtr)
+{
+    le_rwlock_WriteLock(LockRef);
+    AddToLog(1);
+    le_rwlock_Unlock(LockRef);
+
+    return NULL;
+}
+
+static void* Reader(void* contextPtr)
+{
+    le_rwlock_ReadLock(LockRef);
+    AddToLog(2);
+    le_rwlock_Unlock(LockRef);
+
+    return NULL;
+}
+
+static void TestWriterPreferred(void)
+{
+    int i;
+
+    LE_INFO("---- Writer preferred ----");
+
+    LogMutex = le_mutex_CreateNonRecursive("log");
+
+    le_rwlock_ReadLock(LockRef);
+
+    le_thread_Ref_t writerRef = StartThread("writer", Writer, NULL);
+
+    // Readers are turned away as soon as the writer is waiting.
+    for (i = 0; i < 1000; i++)
+    {
+        if (RunInThread(TryRead) == LE_WOULD_BLOCK)
+        {
+            break;
+        }
+        usleep(1000);
+    }
+    LE_TEST(i < 1000);
+
+    le_thread_Ref_t readerRef = StartThread("reader", Reader, NULL);
+    usleep(20000);
+
+    le_mutex_Lock(LogMutex);
+    LE_TEST(LogCount == 0);
+    le_mutex_Unlock(LogMutex);
+
+    le_rwlock_Unlock(LockRef);
+
+    JoinThread(writerRef);
+    JoinThread(readerRef);
+
+    LE_TEST(LogCount == 2);
+    LE_TEST((Log[0] == 1) && (Log[1] == 2));
+
+    le_mutex_Delete(LogMutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Several threads reading and writing at once.  Writers keep two counters equal, so readers must
+ * never see them differ.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t CounterA;
+static uint64_t CounterB;
+
+static void* Hammer(void* contextPtr)
+{
+    size_t mismatches = 0;
+    int i;
+
+    for (i = 0; i < NUM_STRESS_ITERATIONS; i++)
+    {
+        if ((i % 8) == 0)
+        {
+            le_rwlock_WriteLock(LockRef);
+            CounterA++;
+            sched_yield();
+            CounterB++;
+            le_rwlock_Unlock(LockRef);
+        }
+        else
+        {
+            le_rwlock_ReadLock(LockRef);
+            if (CounterA != CounterB)
+            {
+                mismatches++;
+            }
+            le_rwlock_Unlock(LockRef);
+        }
+    }
+
+    return (void*)mismatches;
+}
+
+static void TestStress(void)
+{
+    le_thread_Ref_t threadRefs[NUM_STRESS_THREADS];
+    size_t mismatches = 0;
+    int i;
+
+    LE_INFO("---- Stress ----");
+
+    for (i = 0; i < NUM_STRESS_THREADS; i++)
+    {
+        threadRefs[i] = StartThread("hammer", Hammer, NULL);
+    }
+
+    for (i = 0; i < NUM_STRESS_THREADS; i++)
+    {
+        mismatches += (size_t)JoinThread(threadRefs[i]);
+    }
+
+    LE_TEST(mismatches == 0);
+    LE_TEST(CounterA == NUM_STRESS_THREADS * NUM_STRESS_ITERATIONS / 8);
+    LE_TEST(CounterB == CounterA);
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    LE_INFO("====  Unit test for the Reader-Writer Lock API. ====");
+
+    LockRef = le_rwlock_Create("testLock");
+
+    TestShared();
+    TestExclusive();
+    TestWriterPreferred();
+    TestStress();
+
+    le_rwlock_Delete(LockRef);
+
+    LE_TEST_SUMMARY;
+}
@@ -64,6 +64,71 @@ COMPONENT_INIT
     LE_ASSERT(le_ref_Lookup(mapRef1, &mapRef1) == NULL);
     LE_INFO("Looking up a pointer value failed, as expected");
 
+    LE_INFO("Checking that deleted references stay invalid when their slots are re-used...");
+
+    le_ref_DeleteRef(mapRef1, safeRef2);
+    void* safeRef5 = le_ref_CreateRef(mapRef1, (void*)0x1005);
+    LE_ASSERT(safeRef5 != safeRef2);
+    LE_ASSERT(((uintptr_t)safeRef5 & 1) == 1);
+    LE_ASSERT(le_ref_Lookup(mapRef1, safeRef2) == NULL);
+    LE_ASSERT(le_ref_Lookup(mapRef1, safeRef5) == (void*)0x1005);
+    LE_INFO("Deleting stale reference (expect ERROR)");
+    le_ref_DeleteRef(mapRef1, safeRef2);
+    LE_ASSERT(le_ref_Lookup(mapRef1, safeRef5) == (void*)0x1005);
+    LE_ASSERT(le_ref_Lookup(mapRef1, (void*)((uintptr_t)safeRef5 ^ 2)) == NULL);
+
+    LE_INFO("Checking that references from another map are not valid...");
+
+    le_ref_MapRef_t mapRef2 = le_ref_CreateMap("Map 2", 1);
+    void* otherRef = le_ref_CreateRef(mapRef2, (void*)0x2001);
+    LE_ASSERT(le_ref_Lookup(mapRef1, otherRef) == NULL);
+    LE_ASSERT(le_ref_Lookup(mapRef2, safeRef1) == NULL);
+
+    LE_INFO("Growing a map past its expected size...");
+
+    void* manyRefs[100];
+    uintptr_t i;
+    for (i = 0; i < NUM_ARRAY_MEMBERS(manyRefs); i++)
+    {
+        manyRefs[i] = le_ref_CreateRef(mapRef2, (void*)(0x3000 + i));
+    }
+    LE_ASSERT(le_ref_Lookup(mapRef2, otherRef) == (void*)0x2001);
+    for (i = 0; i < NUM_ARRAY_MEMBERS(manyRefs); i++)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef2, manyRefs[i]) == (void*)(0x3000 + i));
+    }
+
+    LE_INFO("Iterating while deleting...");
+
+    // Delete every other reference during iteration, then check the rest are still there.
+    size_t visitCount = 0;
+    le_ref_IterRef_t iterRef = le_ref_GetIterator(mapRef2);
+    LE_ASSERT(le_ref_GetValue(iterRef) == NULL);
+    while (le_ref_NextNode(iterRef) == LE_OK)
+    {
+        void* safeRef = (void*)le_ref_GetSafeRef(iterRef);
+        void* valuePtr = le_ref_GetValue(iterRef);
+
+        LE_ASSERT(le_ref_Lookup(mapRef2, safeRef) == valuePtr);
+        if ((visitCount % 2) == 0)
+        {
+            le_ref_DeleteRef(mapRef2, safeRef);
+            LE_ASSERT(le_ref_GetSafeRef(iterRef) == NULL);
+            LE_ASSERT(le_ref_GetValue(iterRef) == NULL);
+        }
+        visitCount++;
+    }
+    LE_ASSERT(visitCount == NUM_ARRAY_MEMBERS(manyRefs) + 1);
+    LE_ASSERT(le_ref_NextNode(iterRef) == LE_NOT_FOUND);
+
+    visitCount = 0;
+    iterRef = le_ref_GetIterator(mapRef2);
+    while (le_ref_NextNode(iterRef) == LE_OK)
+    {
+        visitCount++;
+    }
+    LE_ASSERT(visitCount == (NUM_ARRAY_MEMBERS(manyRefs) + 1) / 2);
+
 
     LE_INFO("======== SAFE REFERENCES TEST COMPLETE (PASSED) ========");
     exit(EXIT_SUCCESS);
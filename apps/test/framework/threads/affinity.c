@@ -0,0 +1,154 @@
+// -------------------------------------------------------------------------------------------------
+// Implementation of the thread CPU affinity test.
+//
+// At initialization time, pins one joinable thread to a single CPU before starting it, and another
+// one after it has started, then joins with both.  The CPU used is the first one that the process
+// is allowed to run on, so the test works on single-core systems too.
+//
+// Each thread asks the kernel which CPUs it can run on to make sure that's only the chosen one.
+// If an error is detected, the test aborts immediately, so no check at the end is really needed.
+//
+// Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+// -------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "affinity.h"
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * The CPU that the threads are pinned to.
+ */
+// -------------------------------------------------------------------------------------------------
+static int PinnedCpu;
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Semaphore that the thread pinned after it starts waits on until its affinity has been set.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_sem_Ref_t PinnedSem;
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Thread main function.
+ *
+ * @return NULL.
+ */
+// -------------------------------------------------------------------------------------------------
+static void* ThreadMainFunction
+(
+    void* isWaiting  ///< Non-NULL if the thread must wait for its affinity to be set.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (isWaiting != NULL)
+    {
+        le_sem_Wait(PinnedSem);
+    }
+
+    LE_INFO("Checking CPU affinity...");
+
+    cpu_set_t cpuSet;
+
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+    {
+        LE_FATAL("Failed to fetch CPU affinity (%m).");
+    }
+
+    if ((CPU_COUNT(&cpuSet) != 1) || !CPU_ISSET(PinnedCpu, &cpuSet))
+    {
+        LE_FATAL("Expected to run on CPU %d only.  Allowed on %d CPUs.",
+                 PinnedCpu,
+                 CPU_COUNT(&cpuSet));
+    }
+    else
+    {
+        LE_INFO("Affinity correct.");
+    }
+
+    return NULL;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Starts the test.
+ *
+ * Increments the use count on a given memory pool object, then releases it when the test is
+ * complete.
+ */
+// -------------------------------------------------------------------------------------------------
+void aff_Start
+(
+    void* completionObjPtr  ///< [in] Pointer to the object whose reference count is used to signal
+                            ///       the completion of the test.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Note, we actually don't need to increment and decrement the memory block reference count
+    // because we don't return until the test is complete.
+
+    cpu_set_t cpuSet;
+    LE_ASSERT(sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0);
+
+    PinnedCpu = 0;
+    while ((PinnedCpu < CPU_SETSIZE) && !CPU_ISSET(PinnedCpu, &cpuSet))
+    {
+        PinnedCpu++;
+    }
+
+    if (PinnedCpu >= 64)
+    {
+        LE_INFO("No CPU that can be put in a mask; skipping the affinity test.");
+        return;
+    }
+
+    uint64_t cpuMask = (uint64_t)1 << PinnedCpu;
+
+    PinnedSem = le_sem_Create("pinnedSem", 0);
+
+    le_thread_Ref_t beforeThread = le_thread_Create("pinBefore", ThreadMainFunction, NULL);
+    le_thread_Ref_t afterThread = le_thread_Create("pinAfter", ThreadMainFunction, (void*)1);
+
+    le_thread_SetJoinable(beforeThread);
+    le_thread_SetJoinable(afterThread);
+
+    // A mask without any CPUs that exist is refused.
+    LE_ASSERT(LE_OUT_OF_RANGE == le_thread_SetCpuAffinity(beforeThread, 0));
+    if (get_nprocs_conf() < 64)
+    {
+        LE_ASSERT(LE_OUT_OF_RANGE == le_thread_SetCpuAffinity(beforeThread, (uint64_t)1 << 63));
+    }
+
+    LE_ASSERT(LE_OK == le_thread_SetCpuAffinity(beforeThread, cpuMask));
+
+    le_thread_Start(beforeThread);
+    le_thread_Start(afterThread);
+
+    LE_ASSERT(LE_OK == le_thread_SetCpuAffinity(afterThread, cpuMask));
+    le_sem_Post(PinnedSem);
+
+    void* unused;
+    LE_ASSERT(LE_OK == le_thread_Join(beforeThread, &unused));
+    LE_ASSERT(LE_OK == le_thread_Join(afterThread, &unused));
+
+    le_sem_Delete(PinnedSem);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Checks the completion status of the test.
+ */
+// -------------------------------------------------------------------------------------------------
+void aff_CheckResults
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Actually, we don't need to do anything here.
+}
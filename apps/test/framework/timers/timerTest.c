@@ -63,6 +63,120 @@ TimerTestData TimerTestDataArray[] =
 static le_clk_Time_t StartTime;
 
 
+// Slack test timers: interval and slack in ms, and the time at which each is expected to expire.
+// The first timer's slack lets it wait for the second timer, and they expire on the same wakeup.
+// The third timer is too far away to join them.
+typedef struct
+{
+    uint32_t interval;
+    uint32_t slack;
+    uint32_t expectedExpiry;
+    le_clk_Time_t actualExpiry;
+}
+SlackTestData;
+
+static SlackTestData SlackTestDataArray[] =
+{
+    {  100, 300,  300 },
+    {  300,   0,  300 },
+    { 1000,   0, 1000 },
+};
+
+#define NUM_SLACK_TIMERS NUM_ARRAY_MEMBERS(SlackTestDataArray)
+
+static uint64_t SlackStartWakeups;
+static uint64_t SlackStartSavedWakeups;
+static size_t SlackExpiredCount;
+
+
+void SlackTimerExpiryHandler
+(
+    le_timer_Ref_t timerRef    ///< This timer has expired
+)
+{
+    SlackTestData* testDataPtr = le_timer_GetContextPtr(timerRef);
+    size_t i;
+
+    testDataPtr->actualExpiry = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+
+    if (++SlackExpiredCount < NUM_SLACK_TIMERS)
+    {
+        return;
+    }
+
+    LE_INFO("\n ======================================");
+    // Verify that each timer expired when expected, and that the first two shared a wakeup.
+
+    bool passed = true;
+    for (i = 0; i < NUM_SLACK_TIMERS; i++)
+    {
+        uint32_t expectedMs = SlackTestDataArray[i].expectedExpiry;
+        le_clk_Time_t expected = { expectedMs / 1000, (expectedMs % 1000) * ONE_MSEC };
+
+        if ( le_clk_GreaterThan(expected, SlackTestDataArray[i].actualExpiry) ||
+             le_clk_GreaterThan(le_clk_Sub(SlackTestDataArray[i].actualExpiry, expected),
+                                TimerTolerance) )
+        {
+            LE_ERROR("Slack timer %zu expired at %li.%06li s, expected %u ms", i,
+                     SlackTestDataArray[i].actualExpiry.sec,
+                     SlackTestDataArray[i].actualExpiry.usec,
+                     SlackTestDataArray[i].expectedExpiry);
+            passed = false;
+        }
+    }
+
+    uint64_t wakeups;
+    uint64_t savedWakeups;
+    le_timer_GetWakeupCounts(&wakeups, &savedWakeups);
+    LE_INFO("Slack timers used %"PRIu64" wakeups, saved %"PRIu64,
+            wakeups - SlackStartWakeups, savedWakeups - SlackStartSavedWakeups);
+    if ( (wakeups - SlackStartWakeups != 2) || (savedWakeups - SlackStartSavedWakeups != 1) )
+    {
+        passed = false;
+    }
+
+    if (passed)
+    {
+        LE_INFO("Slack timers expired together: TEST PASSED");
+    }
+    else
+    {
+        LE_ERROR("Slack timers: TEST FAILED");
+    }
+
+    // All tests are now done, so exit
+    LE_INFO("ALL TESTS COMPLETE");
+    exit(0);
+}
+
+
+void SlackTests
+(
+    void
+)
+{
+    le_timer_Ref_t timerRef;
+    size_t i;
+
+    le_timer_GetWakeupCounts(&SlackStartWakeups, &SlackStartSavedWakeups);
+
+    StartTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < NUM_SLACK_TIMERS; i++)
+    {
+        timerRef = le_timer_Create("slack timer");
+
+        LE_ASSERT(le_timer_SetMsInterval(timerRef, SlackTestDataArray[i].interval) == LE_OK);
+        LE_ASSERT(le_timer_SetSlack(timerRef, SlackTestDataArray[i].slack) == LE_OK);
+        le_timer_SetContextPtr(timerRef, &SlackTestDataArray[i]);
+        le_timer_SetHandler(timerRef, SlackTimerExpiryHandler);
+
+        le_timer_Start(timerRef);
+        LE_ASSERT(le_timer_SetSlack(timerRef, 0) == LE_BUSY);
+    }
+}
+
+
 void LongTimerExpiryHandler
 (
     le_timer_Ref_t timerRef    ///< This timer has expired
@@ -107,10 +221,7 @@ void LongTimerExpiryHandler
         LE_INFO("Short timer expired %i times: TEST FAILED", expiryCount);
     }
 
-    // All tests are now done, so exit
-    LE_INFO("ALL TESTS COMPLETE");
-    exit(0);
-
+    SlackTests();
 }
 
 void AdditionalTests
@@ -0,0 +1,213 @@
+ /**
+  * Tests for the Work Queue API.
+  *
+  * The pool is given four workers.  Jobs are submitted from the main thread, to check that they
+  * all run in workers and are completed back in the main thread, and from inside a job, to check
+  * that jobs on one worker's deque get stolen by the others.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+#define NUM_WORKERS     4
+#define NUM_JOBS        1000
+#define NUM_CHILD_JOBS  64
+
+
+static le_thread_Ref_t MainThreadRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Jobs submitted from the main thread run in a worker and are completed in the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t input;
+    uint64_t result;
+    le_thread_Ref_t jobThreadRef;
+}
+Job_t;
+
+static Job_t Jobs[NUM_JOBS];
+static size_t CompletedJobs;
+static bool JobsOk = true;
+
+static void StartStealingTest(void);
+
+
+static void SumJob(void* contextPtr)
+{
+    Job_t* jobPtr = contextPtr;
+    uint64_t i;
+
+    jobPtr->jobThreadRef = le_thread_GetCurrent();
+
+    jobPtr->result = 0;
+    for (i = 1; i <= jobPtr->input; i++)
+    {
+        jobPtr->result += i;
+    }
+}
+
+static void SumJobDone(void* contextPtr)
+{
+    Job_t* jobPtr = contextPtr;
+
+    JobsOk = JobsOk
+             && (le_thread_GetCurrent() == MainThreadRef)
+             && (jobPtr->jobThreadRef != MainThreadRef)
+             && (jobPtr->result == jobPtr->input * (jobPtr->input + 1) / 2);
+
+    if (++CompletedJobs == NUM_JOBS)
+    {
+        LE_TEST(JobsOk);
+
+        StartStealingTest();
+    }
+}
+
+static void StartSubmitTest(void)
+{
+    size_t i;
+
+    LE_INFO("---- Submit from a thread ----");
+
+    for (i = 0; i < NUM_JOBS; i++)
+    {
+        Jobs[i].input = i * 100;
+        le_workQueue_Submit(SumJob, SumJobDone, &Jobs[i]);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Jobs submitted by a job go on its worker's deque, and get stolen by the other workers.  Their
+ * completion functions are called in a worker.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_thread_Ref_t ChildThreadRefs[NUM_CHILD_JOBS];
+static size_t CompletedChildJobs;
+
+static void StartNoCompletionTest(void);
+
+
+static void CheckStealing(void* param1Ptr, void* param2Ptr)
+{
+    le_thread_Ref_t threadRefs[NUM_WORKERS] = { NULL };
+    size_t numThreads = 0;
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < NUM_CHILD_JOBS; i++)
+    {
+        LE_TEST(ChildThreadRefs[i] != MainThreadRef);
+
+        for (j = 0; (j < numThreads) && (threadRefs[j] != ChildThreadRefs[i]); j++)
+        {
+        }
+
+        if (j == numThreads)
+        {
+            LE_ASSERT(numThreads < NUM_WORKERS);
+            threadRefs[numThreads++] = ChildThreadRefs[i];
+        }
+    }
+
+    LE_INFO("Child jobs ran in %zu workers.", numThreads);
+    LE_TEST(numThreads > 1);
+
+    StartNoCompletionTest();
+}
+
+static void ChildJob(void* contextPtr)
+{
+    size_t index = (size_t)contextPtr;
+
+    ChildThreadRefs[index] = le_thread_GetCurrent();
+
+    // Give the other workers time to steal.
+    usleep(1000);
+}
+
+static void ChildJobDone(void* contextPtr)
+{
+    LE_TEST(le_thread_GetCurrent() != MainThreadRef);
+
+    if (__atomic_add_fetch(&CompletedChildJobs, 1, __ATOMIC_ACQ_REL) == NUM_CHILD_JOBS)
+    {
+        le_event_QueueFunctionToThread(MainThreadRef, CheckStealing, NULL, NULL);
+    }
+}
+
+static void ParentJob(void* contextPtr)
+{
+    size_t i;
+
+    for (i = 0; i < NUM_CHILD_JOBS; i++)
+    {
+        le_workQueue_Submit(ChildJob, ChildJobDone, (void*)i);
+    }
+}
+
+static void StartStealingTest(void)
+{
+    LE_INFO("---- Submit from a job ----");
+
+    le_workQueue_Submit(ParentJob, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Jobs don't need a completion function.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t NoCompletionJobsRun;
+
+static void Finish(void* param1Ptr, void* param2Ptr)
+{
+    LE_TEST(NoCompletionJobsRun == NUM_JOBS);
+
+    LE_TEST_SUMMARY;
+}
+
+static void NoCompletionJob(void* contextPtr)
+{
+    if (__atomic_add_fetch(&NoCompletionJobsRun, 1, __ATOMIC_ACQ_REL) == NUM_JOBS)
+    {
+        le_event_QueueFunctionToThread(MainThreadRef, Finish, NULL, NULL);
+    }
+}
+
+static void StartNoCompletionTest(void)
+{
+    size_t i;
+
+    LE_INFO("---- No completion function ----");
+
+    for (i = 0; i < NUM_JOBS; i++)
+    {
+        le_workQueue_Submit(NoCompletionJob, NULL, NULL);
+    }
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_INIT;
+
+    LE_INFO("====  Unit test for the Work Queue API. ====");
+
+    MainThreadRef = le_thread_GetCurrent();
+
+    // The pool is sized when it is first used.
+    LE_ASSERT(setenv("LE_WORKQUEUE_THREADS", "4", true) == 0);
+    LE_TEST(le_workQueue_GetNumWorkers() == NUM_WORKERS);
+
+    StartSubmitTest();
+}
@@ -588,8 +588,20 @@ TestAHandlerRef_t AddTestAHandler
     // Range check values, if appropriate
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(void*);
+    size_t _responseSize = 0;
+    _responseSize += sizeof(_result);
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_AddTestAHandler;
     _msgBufPtr = _msgPtr->buffer;
@@ -609,7 +621,8 @@ TestAHandlerRef_t AddTestAHandler
     _UNLOCK
     _msgBufPtr = PackData( _msgBufPtr, &contextPtr, sizeof(void*) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -662,8 +675,19 @@ void RemoveTestAHandler
     // Range check values, if appropriate
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(TestAHandlerRef_t);
+    size_t _responseSize = 0;
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_RemoveTestAHandler;
     _msgBufPtr = _msgPtr->buffer;
@@ -681,7 +705,8 @@ void RemoveTestAHandler
     le_mem_Release(clientDataPtr);
     _msgBufPtr = PackData( _msgBufPtr, &addHandlerRef, sizeof(TestAHandlerRef_t) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -759,8 +784,19 @@ void allParameters
     if ( strlen(label) > 20 ) LE_FATAL("strlen(label) > 20");
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(common_EnumExample_t) + sizeof(size_t) + dataNumElements*sizeof(uint32_t) + sizeof(size_t) + sizeof(uint32_t) + strlen(label) + sizeof(size_t) + sizeof(size_t);
+    size_t _responseSize = sizeof(uint32_t) + sizeof(size_t) + *outputNumElementsPtr*sizeof(uint32_t) + sizeof(uint32_t) + responseNumElements + sizeof(uint32_t) + moreNumElements;
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_allParameters;
     _msgBufPtr = _msgPtr->buffer;
@@ -774,7 +810,8 @@ void allParameters
     _msgBufPtr = PackData( _msgBufPtr, &responseNumElements, sizeof(size_t) );
     _msgBufPtr = PackData( _msgBufPtr, &moreNumElements, sizeof(size_t) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -824,8 +861,19 @@ void FileTest
     // Range check values, if appropriate
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = 0;
+    size_t _responseSize = 0;
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_FileTest;
     _msgBufPtr = _msgPtr->buffer;
@@ -833,7 +881,8 @@ void FileTest
     // Pack the input parameters
     le_msg_SetFd(_msgRef, dataFile);
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -876,8 +925,19 @@ void TriggerTestA
     // Range check values, if appropriate
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = 0;
+    size_t _responseSize = 0;
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_TriggerTestA;
     _msgBufPtr = _msgPtr->buffer;
@@ -885,7 +945,8 @@ void TriggerTestA
     // Pack the input parameters
 
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -987,8 +1048,20 @@ BugTestHandlerRef_t AddBugTestHandler
     if ( strlen(newPathPtr) > 512 ) LE_FATAL("strlen(newPathPtr) > 512");
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(uint32_t) + strlen(newPathPtr) + sizeof(void*);
+    size_t _responseSize = 0;
+    _responseSize += sizeof(_result);
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_AddBugTestHandler;
     _msgBufPtr = _msgPtr->buffer;
@@ -1009,7 +1082,8 @@ BugTestHandlerRef_t AddBugTestHandler
     _UNLOCK
     _msgBufPtr = PackData( _msgBufPtr, &contextPtr, sizeof(void*) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -1062,8 +1136,19 @@ void RemoveBugTestHandler
     // Range check values, if appropriate
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(BugTestHandlerRef_t);
+    size_t _responseSize = 0;
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_RemoveBugTestHandler;
     _msgBufPtr = _msgPtr->buffer;
@@ -1081,7 +1166,8 @@ void RemoveBugTestHandler
     le_mem_Release(clientDataPtr);
     _msgBufPtr = PackData( _msgBufPtr, &addHandlerRef, sizeof(BugTestHandlerRef_t) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -1195,8 +1281,20 @@ int32_t TestCallback
     if ( dataArrayNumElements > 5 ) LE_FATAL("dataArrayNumElements > 5");
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(uint32_t) + sizeof(size_t) + dataArrayNumElements*sizeof(uint8_t) + sizeof(void*);
+    size_t _responseSize = 0;
+    _responseSize += sizeof(_result);
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_TestCallback;
     _msgBufPtr = _msgPtr->buffer;
@@ -1219,7 +1317,8 @@ int32_t TestCallback
     _UNLOCK
     _msgBufPtr = PackData( _msgBufPtr, &contextPtr, sizeof(void*) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -1266,8 +1365,19 @@ void TriggerCallbackTest
     // Range check values, if appropriate
 
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = sizeof(uint32_t);
+    size_t _responseSize = 0;
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_TriggerCallbackTest;
     _msgBufPtr = _msgPtr->buffer;
@@ -1275,7 +1385,8 @@ void TriggerCallbackTest
     // Pack the input parameters
     _msgBufPtr = PackData( _msgBufPtr, &data, sizeof(uint32_t) );
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
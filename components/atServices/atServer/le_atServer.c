@@ -2049,7 +2049,7 @@ COMPONENT_INIT
     SubscribedCmdRefMap = le_ref_CreateMap("SubscribedCmdRefMap", CMD_POOL_SIZE);
     CmdHashMap = le_hashmap_Create("CmdHashMap",
                                     CMD_POOL_SIZE,
-                                    le_hashmap_HashString,
+                                    le_hashmap_HashStringFast,
                                     le_hashmap_EqualsString
                                    );
     EventIdPool = le_mem_CreatePool("ATServerEventIdPool", sizeof(EventIdList_t));
@@ -0,0 +1,253 @@
+/**
+ * @page c_arena Arena Allocator API
+ *
+ * @ref le_arena.h "API Reference"
+ *
+ * <HR>
+ *
+ * An arena (also called a region or bump allocator) hands out memory by advancing a pointer
+ * through large chunks, and releases everything it has handed out all at once.  Allocating from
+ * an arena costs little more than an addition and a comparison, and there is no per-object
+ * bookkeeping, so it is a good fit for the many small, short-lived objects that are created while
+ * doing a single piece of work (parsing a document, building up a transaction, etc.) and that all
+ * become garbage at the same time when that work is done.
+ *
+ * Arenas are <b>not</b> a replacement for @ref c_memory "memory pools".  Objects allocated from an
+ * arena can't be individually released, aren't reference counted, and don't have destructors.
+ * Use a pool when objects have independent lifetimes.
+ *
+ *
+ * @section arena_creating Creating and Deleting an Arena
+ *
+ * An arena is created by calling le_arena_Create() and deleted by calling le_arena_Delete().
+ * Deleting an arena releases all of the memory allocated from it.
+ *
+ * @code
+ * le_arena_Ref_t arena = le_arena_Create("Parse Tree");
+ * @endcode
+ *
+ * The arena name is only used for diagnostics.
+ *
+ *
+ * @section arena_allocating Allocating From an Arena
+ *
+ * Memory is allocated from an arena using le_arena_Alloc().  The returned memory is suitably
+ * aligned for any of the C basic types and is @b not initialized.  le_arena_StrDup() is provided
+ * for the common case of copying a string into an arena.
+ *
+ * @code
+ * MyNode_t* nodePtr = le_arena_Alloc(arena, sizeof(MyNode_t));
+ * nodePtr->namePtr = le_arena_StrDup(arena, name);
+ * @endcode
+ *
+ * Like le_mem_ForceAlloc(), le_arena_Alloc() never returns NULL.  If the system is out of memory,
+ * the process is terminated.
+ *
+ * The arena gets its memory from the framework in fixed-size chunks.  An allocation that doesn't
+ * fit into a chunk is given its own block of memory, which is released along with the rest of the
+ * arena.
+ *
+ *
+ * @section arena_resetting Resetting an Arena
+ *
+ * le_arena_Reset() releases everything that was allocated from an arena in one step, but keeps the
+ * arena's chunks so that the next round of work doesn't need to fetch them again.  The cost of a
+ * reset does not depend on the number of objects that were allocated from the arena.
+ *
+ * @code
+ * for (;;)
+ * {
+ *     ProcessRequest(arena, GetNextRequest());
+ *     le_arena_Reset(arena);
+ * }
+ * @endcode
+ *
+ *
+ * @section arena_marks Marks
+ *
+ * When allocations follow a stack discipline (e.g., recursive descent), le_arena_GetMark() can be
+ * used to remember the arena's current position and le_arena_Rewind() can be used to
+ * release everything that was allocated since that mark was taken.
+ *
+ * @code
+ * le_arena_Mark_t mark = le_arena_GetMark(arena);
+ *
+ * char* scratchPtr = le_arena_Alloc(arena, bufferSize);
+ * ...
+ * le_arena_Rewind(arena, mark);
+ * @endcode
+ *
+ * Rewinding to a mark invalidates all marks that were taken after it.  Resetting the arena
+ * invalidates all marks.
+ *
+ *
+ * @section arena_scratch Scratch Arenas
+ *
+ * Each thread has its own scratch arena that can be fetched using le_arena_GetScratch().  It is
+ * created the first time it is needed and deleted automatically when the thread dies.  Since the
+ * scratch arena is shared by everything that runs in the thread, it must only be used with marks,
+ * and everything that is allocated from it must be given back (using le_arena_Rewind()) before
+ * returning to the event loop.
+ *
+ * @code
+ * le_arena_Ref_t scratch = le_arena_GetScratch();
+ * le_arena_Mark_t mark = le_arena_GetMark(scratch);
+ *
+ * char* pathPtr = le_arena_Alloc(scratch, PATH_MAX);
+ * ...
+ * le_arena_Rewind(scratch, mark);
+ * @endcode
+ *
+ *
+ * @section arena_threading Multi-Threading
+ *
+ * Arenas are @b not thread-safe.  An arena must only be used by one thread at a time.  Creating
+ * and deleting arenas is thread-safe.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+//--------------------------------------------------------------------------------------------------
+/** @file le_arena.h
+ *
+ * Legato @ref c_arena include file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_ARENA_INCLUDE_GUARD
+#define LEGATO_ARENA_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to an arena.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_arena* le_arena_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position within an arena, as returned by le_arena_GetMark().
+ *
+ * The members of this structure must not be accessed directly.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*   chunkPtr;       ///< Chunk that was being allocated from.
+    size_t  offset;         ///< Offset of the next free byte in that chunk.
+    void*   largeBlockPtr;  ///< Most recently allocated large block.
+}
+le_arena_Mark_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an empty arena.
+ *
+ * @return Reference to the arena.
+ */
+//--------------------------------------------------------------------------------------------------
+le_arena_Ref_t le_arena_Create
+(
+    const char* name        ///< [IN] Name of the arena (used for diagnostics only).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes an arena, releasing all memory allocated from it.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_arena_Delete
+(
+    le_arena_Ref_t arena    ///< [IN] The arena.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a block of memory from an arena.  The block is aligned for any of the C basic types
+ * and its contents are not initialized.
+ *
+ * @return Pointer to the block (never NULL).
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_arena_Alloc
+(
+    le_arena_Ref_t arena,   ///< [IN] The arena.
+    size_t size             ///< [IN] Number of bytes to allocate.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a null-terminated string into an arena.
+ *
+ * @return Pointer to the copy (never NULL).
+ */
+//--------------------------------------------------------------------------------------------------
+char* le_arena_StrDup
+(
+    le_arena_Ref_t arena,   ///< [IN] The arena.
+    const char* strPtr      ///< [IN] The string to copy.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases everything that has been allocated from an arena.  The arena's chunks are kept for
+ * re-use.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_arena_Reset
+(
+    le_arena_Ref_t arena    ///< [IN] The arena.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current position of an arena, for later use with le_arena_Rewind().
+ *
+ * @return The mark.
+ */
+//--------------------------------------------------------------------------------------------------
+le_arena_Mark_t le_arena_GetMark
+(
+    le_arena_Ref_t arena    ///< [IN] The arena.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases everything that has been allocated from an arena since a given mark was taken.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_arena_Rewind
+(
+    le_arena_Ref_t arena,   ///< [IN] The arena.
+    le_arena_Mark_t mark    ///< [IN] Mark obtained from le_arena_GetMark().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's scratch arena.  See @ref arena_scratch.
+ *
+ * @return Reference to the arena.
+ */
+//--------------------------------------------------------------------------------------------------
+le_arena_Ref_t le_arena_GetScratch
+(
+    void
+);
+
+
+#endif // LEGATO_ARENA_INCLUDE_GUARD
@@ -0,0 +1,188 @@
+/**
+ * @page c_cond Condition Variable API
+ *
+ * @ref le_cond.h "API Reference"
+ *
+ * <HR>
+ *
+ * A condition variable lets a thread wait, without holding a @ref c_mutex "mutex", until another
+ * thread has changed some data that the mutex protects.  These condition variables can be shared
+ * by threads within the same process, but can't be shared by threads in different processes.
+ *
+ * @section c_cond_create Creating a Condition Variable
+ *
+ * le_cond_Create() creates a condition variable, returning a reference to it (of type
+ * le_cond_Ref_t).  All condition variables have names, required for diagnostic purposes.  See
+ * @ref c_cond_diagnostics below.
+ *
+ * @section c_cond_using Using a Condition Variable
+ *
+ * A thread waits by calling le_cond_Wait() or le_cond_WaitWithTimeOut() while holding the mutex.
+ * The mutex is unlocked while the thread waits, and is locked again before the function returns.
+ * Another thread wakes up one of the waiting threads by calling le_cond_Signal(), or all of them
+ * by calling le_cond_Broadcast(), after changing the data.
+ *
+ * Threads can be woken up when nothing has changed, and another thread can get to the data first,
+ * so always check the condition again after waking up:
+ *
+ * @code
+ * static le_mutex_Ref_t QueueMutex;
+ * static le_cond_Ref_t QueueNotEmpty;
+ *
+ * static Job_t* GetJob(void)
+ * {
+ *     le_mutex_Lock(QueueMutex);
+ *
+ *     while (le_sls_IsEmpty(&JobQueue))
+ *     {
+ *         le_cond_Wait(QueueNotEmpty, QueueMutex);
+ *     }
+ *
+ *     Job_t* jobPtr = CONTAINER_OF(le_sls_Pop(&JobQueue), Job_t, link);
+ *
+ *     le_mutex_Unlock(QueueMutex);
+ *
+ *     return jobPtr;
+ * }
+ *
+ * static void AddJob(Job_t* jobPtr)
+ * {
+ *     le_mutex_Lock(QueueMutex);
+ *     le_sls_Queue(&JobQueue, &jobPtr->link);
+ *     le_cond_Signal(QueueNotEmpty);
+ *     le_mutex_Unlock(QueueMutex);
+ * }
+ * @endcode
+ *
+ * The mutex must be locked exactly once by the waiting thread (a recursive mutex can't be locked
+ * more than once), because it has to be completely unlocked while the thread waits.
+ *
+ * le_cond_WaitWithTimeOut() gives up waiting after a given amount of time, which is measured
+ * using the monotonic clock (see le_clk_GetRelativeTime()), so it isn't affected by changes to the
+ * time of day.  The deadline is fixed when the call is made, so signals delivered to the waiting
+ * thread don't extend it.  The timeout applies to each call, though, so a thread that has to wait
+ * again after a wake-up should work out how much of its time is left.
+ *
+ * Signalling a condition variable that no thread is waiting on costs a single atomic operation.
+ *
+ * @section c_cond_delete Deleting a Condition Variable
+ *
+ * When you are finished with a condition variable, you must delete it by calling le_cond_Delete().
+ * No thread can be waiting on it when it is deleted.
+ *
+ * @section c_cond_diagnostics Diagnostics
+ *
+ * The command-line diagnostic tool @ref toolsTarget_inspect can be used to list the condition
+ * variables that currently exist inside a given process, with the number of threads waiting on
+ * each one and the number of waits, time-outs and signals so far.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file le_cond.h
+ *
+ * Legato @ref c_cond include file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_COND_INCLUDE_GUARD
+#define LEGATO_COND_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a condition variable.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_cond* le_cond_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a condition variable.
+ *
+ * @return  Returns a reference to the condition variable.
+ *
+ * @note Terminates the process on failure, no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_cond_Ref_t le_cond_Create
+(
+    const char* nameStr     ///< [in] Name of the condition variable.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a condition variable.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Delete
+(
+    le_cond_Ref_t condRef   ///< [in] Condition variable reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait on a condition variable.
+ *
+ * The mutex must be locked (once) by the calling thread.  It is unlocked while waiting and locked
+ * again before this function returns.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Wait
+(
+    le_cond_Ref_t   condRef,    ///< [in] Condition variable reference.
+    le_mutex_Ref_t  mutexRef    ///< [in] Mutex protecting the condition.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait on a condition variable with a limit on how long to wait.
+ *
+ * The mutex must be locked (once) by the calling thread.  It is unlocked while waiting and locked
+ * again before this function returns, even if it timed out.
+ *
+ * @return
+ *      - LE_OK         Woken up (check the condition).
+ *      - LE_TIMEOUT    timeToWait elapsed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_cond_WaitWithTimeOut
+(
+    le_cond_Ref_t   condRef,    ///< [in] Condition variable reference.
+    le_mutex_Ref_t  mutexRef,   ///< [in] Mutex protecting the condition.
+    le_clk_Time_t   timeToWait  ///< [in] Time to wait.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wake up one of the threads waiting on a condition variable, if any are.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Signal
+(
+    le_cond_Ref_t condRef   ///< [in] Condition variable reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wake up all of the threads waiting on a condition variable.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Broadcast
+(
+    le_cond_Ref_t condRef   ///< [in] Condition variable reference.
+);
+
+
+#endif // LEGATO_COND_INCLUDE_GUARD
@@ -0,0 +1,317 @@
+/**
+ * @page c_coro Coroutine API
+ *
+ * @ref le_coro.h "API Reference"
+ *
+ * <HR>
+ *
+ * A coroutine is a function that runs on its own stack inside a thread, and that can stop part
+ * way through to wait for something (an IPC response, a timer, a file descriptor becoming ready)
+ * while the thread's @ref c_eventLoop carries on handling other events.  When the thing it is
+ * waiting for happens, the coroutine carries on from where it left off.
+ *
+ * This makes it possible to write a sequence of steps that each have to wait as straight-line code,
+ * like a thread would, without tying up a whole thread for each sequence and without chopping the
+ * sequence up into callbacks.  A thread can have any number of coroutines waiting at once.
+ *
+ * Coroutines are not threads.  Only one coroutine (or the Event Loop itself) runs at a time in a
+ * given thread, and a coroutine only stops running when it calls one of the waiting functions in
+ * this API (or a function that uses one of them).  So, data that is only used by the coroutines
+ * and handlers of one thread doesn't need a mutex, but it can change whenever a coroutine waits.
+ *
+ *
+ * @section coro_creating Creating and Starting a Coroutine
+ *
+ * A coroutine is created by calling le_coro_Create(), and is started by calling le_coro_Start().
+ * le_coro_Start() doesn't run the coroutine straight away.  It runs when the calling thread's
+ * Event Loop gets to it, like a function queued with le_event_QueueFunction().
+ *
+ * @code
+ * static void ReadSensor(void* contextPtr)
+ * {
+ *     Sensor_t* sensorPtr = contextPtr;
+ *
+ *     for (;;)
+ *     {
+ *         le_coro_SleepMs(1000);
+ *         Report(sensorPtr, ReadValue(sensorPtr));
+ *     }
+ * }
+ *
+ * le_coro_Ref_t coroRef = le_coro_Create("sensor", ReadSensor, sensorPtr);
+ * le_coro_Start(coroRef);
+ * @endcode
+ *
+ * A coroutine belongs to the thread that created it, and always runs in that thread.  It ends when
+ * its function returns, at which point its reference is no longer valid.
+ *
+ * Each coroutine has a stack of its own, which is 64 KB unless le_coro_SetStackSize() is called
+ * before the coroutine is started.  The stack is backed by memory that is only committed as it is
+ * used, and is followed by a guard page so that a stack overflow causes a segmentation fault
+ * rather than corrupting memory.
+ *
+ *
+ * @section coro_waiting Waiting in a Coroutine
+ *
+ * The following functions can only be called from inside a coroutine.  Each of them lets the
+ * thread's Event Loop run until the thing being waited for has happened:
+ *
+ * - le_coro_SleepMs() waits for a number of milliseconds.
+ * - le_coro_AwaitFd() waits for a file descriptor to become readable, writeable, etc.  The file
+ *   descriptor must not have an FD Monitor of its own.
+ * - le_coro_Yield() just lets everything that is already waiting in the Event Queue run first.
+ * - le_msg_RequestSyncResponse() sends an IPC request and waits for the response, without putting
+ *   the session's socket into blocking mode.  The generated client-side IPC API functions use it,
+ *   so calling an IPC API function from a coroutine only holds up that coroutine (see
+ *   @ref coro_ipc).
+ *
+ * For anything else, a coroutine can call le_coro_Suspend() to wait until some handler calls
+ * le_coro_Resume() for it.  le_coro_Suspend() can return before the thing being waited for has
+ * happened (e.g., if le_coro_Resume() was called for some other reason), so it should be called
+ * in a loop that checks for it, like a condition variable:
+ *
+ * @code
+ * static void JobDoneHandler(void* contextPtr)
+ * {
+ *     Job_t* jobPtr = contextPtr;
+ *
+ *     jobPtr->isDone = true;
+ *     le_coro_Resume(jobPtr->coroRef);
+ * }
+ *
+ * static void RunJob(void* contextPtr)
+ * {
+ *     Job_t* jobPtr = contextPtr;
+ *
+ *     jobPtr->coroRef = le_coro_GetCurrent();
+ *     StartJob(jobPtr, JobDoneHandler);
+ *
+ *     while (!jobPtr->isDone)
+ *     {
+ *         le_coro_Suspend();
+ *     }
+ *     ...
+ * }
+ * @endcode
+ *
+ * If le_coro_Resume() is called while the coroutine is still running, the next call to
+ * le_coro_Suspend() returns straight away, so the wake-up isn't lost.
+ *
+ * le_coro_Resume() must be called from the thread that the coroutine belongs to.  A handler in
+ * another thread can use le_event_QueueFunctionToThread() to get there.
+ *
+ *
+ * @section coro_ipc IPC in a Coroutine
+ *
+ * When le_msg_RequestSyncResponse() is called from a coroutine, it sends the request using
+ * le_msg_RequestResponse() and suspends the coroutine until the response arrives (or the session
+ * closes, in which case it returns NULL as usual).  Messages that arrive on the session in the
+ * meantime are handled by the Event Loop in the order they arrive.  Several coroutines of the same
+ * thread can be waiting for responses on the same session at the same time.
+ *
+ * Outside of a coroutine, le_msg_RequestSyncResponse() blocks the thread as it always has.
+ *
+ * @code
+ * static void ConnectData(void* contextPtr)
+ * {
+ *     // Only this coroutine waits while the data connection is set up.
+ *     le_data_RequestObjRef_t requestRef = le_data_Request();
+ *     ...
+ * }
+ * @endcode
+ *
+ *
+ * @section coro_restrictions Restrictions
+ *
+ * - le_event_RunLoop() and le_event_ServiceLoop() must not be called from a coroutine.
+ * - le_event_GetContextPtr(), le_fdMonitor_GetMonitor() and similar functions that give
+ *   information about the handler that is running don't mean anything inside a coroutine.
+ *   Pass what the coroutine needs through its context pointer instead.
+ * - Blocking calls (e.g., le_sem_Wait() or read() on a blocking fd) in a coroutine block the
+ *   whole thread, just like they would in a handler.
+ * - Switching between coroutines uses swapcontext(), which costs a system call to save and restore
+ *   the signal mask.  That is far cheaper than a thread context switch, but coroutines are not
+ *   meant for switching millions of times per second.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+//--------------------------------------------------------------------------------------------------
+/** @file le_coro.h
+ *
+ * Legato @ref c_coro include file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_CORO_INCLUDE_GUARD
+#define LEGATO_CORO_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_coro* le_coro_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Coroutine main function prototype.
+ *
+ * @param contextPtr Context pointer that was passed to le_coro_Create().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*le_coro_Func_t)
+(
+    void* contextPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a coroutine in the calling thread.  It won't run until le_coro_Start() is called.
+ *
+ * @return Reference to the coroutine (doesn't return if it fails).
+ */
+//--------------------------------------------------------------------------------------------------
+le_coro_Ref_t le_coro_Create
+(
+    const char* name,           ///< [IN] Name of the coroutine (used for diagnostics only).
+    le_coro_Func_t mainFunc,    ///< [IN] Function to run in the coroutine.
+    void* contextPtr            ///< [IN] Value to pass to mainFunc.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the size of a coroutine's stack.  Must be called before le_coro_Start().
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_SetStackSize
+(
+    le_coro_Ref_t coroRef,      ///< [IN] The coroutine.
+    size_t size                 ///< [IN] Stack size, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a coroutine.  It will run the next time the Event Loop gets to it.
+ *
+ * Must be called from the thread that created the coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Start
+(
+    le_coro_Ref_t coroRef       ///< [IN] The coroutine.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the coroutine that is running.
+ *
+ * @return Reference to the coroutine, or NULL if not called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+le_coro_Ref_t le_coro_GetCurrent
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the name of a coroutine.
+ *
+ * @return The name.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* le_coro_GetName
+(
+    le_coro_Ref_t coroRef       ///< [IN] The coroutine.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Suspends the running coroutine until le_coro_Resume() is called for it.  Returns straight away
+ * if le_coro_Resume() was called since the coroutine last suspended.  See @ref coro_waiting.
+ *
+ * Must be called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Suspend
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wakes up a coroutine that is suspended in le_coro_Suspend().  The coroutine will carry on the
+ * next time the Event Loop gets to it.  If the coroutine is running, its next call to
+ * le_coro_Suspend() will return straight away.  If it is already waiting to carry on, this does
+ * nothing.
+ *
+ * Must be called from the thread that the coroutine belongs to.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Resume
+(
+    le_coro_Ref_t coroRef       ///< [IN] The coroutine.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lets the Event Loop handle everything that is already in the thread's Event Queue before the
+ * running coroutine carries on.
+ *
+ * Must be called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Yield
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits for a number of milliseconds.
+ *
+ * Must be called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_SleepMs
+(
+    uint32_t ms                 ///< [IN] Number of milliseconds to wait for.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits for events on a file descriptor.  The file descriptor must not have an FD Monitor of its
+ * own.
+ *
+ * Must be called from inside a coroutine.
+ *
+ * @return The events that happened (POLLIN, POLLOUT, POLLPRI, POLLRDHUP, POLLERR, POLLHUP).
+ *         POLLERR and POLLHUP are always reported, even if they weren't asked for.
+ */
+//--------------------------------------------------------------------------------------------------
+short le_coro_AwaitFd
+(
+    int fd,                     ///< [IN] The file descriptor.
+    short events                ///< [IN] Events to wait for (POLLIN, POLLOUT, etc.).
+);
+
+
+#endif // LEGATO_CORO_INCLUDE_GUARD
@@ -23,8 +23,10 @@
  *
  * @ref c_event_deferredFunctionCalls <br>
  * @ref c_event_dispatchingToOtherThreads <br>
+ * @ref c_event_urgentFunctions <br>
  * @ref c_event_publishSubscribe <br>
  * @ref c_event_layeredPublishSubscribe <br>
+ * @ref c_event_zeroCopyReports <br>
  *
  * Other Legato C Runtime Library APIs using the event loop include:
  *
@@ -175,6 +177,29 @@
  * }
  * @endcode
  *
+ * @section c_event_urgentFunctions Urgent Functions and Batching
+ *
+ * An Event Loop doesn't run everything on its Event Queue before checking its file descriptors
+ * again.  It runs a limited batch of queued functions and event handlers (64 by default), then
+ * checks for fd events (such as IPC messages and timer expiries), then runs the next batch.
+ * This stops a thread with a lot of queued work from ignoring its file descriptors for a long time.
+ * A thread can change the size of its batches by calling @c le_event_SetBatchSize().  Smaller
+ * batches mean fd events are picked up sooner, at the cost of more system calls; a batch size of
+ * zero means no limit.
+ *
+ * Queued functions still run in the order they were queued, though, so a function that must run
+ * soon can be stuck behind a lot of bulk work.  Functions queued using
+ * @c le_event_QueueFunctionUrgent() or @c le_event_QueueFunctionToThreadUrgent() go on a separate
+ * urgent queue instead, which the Event Loop checks in between every function or handler taken
+ * from the normal Event Queue.  Urgent functions run in the order they were queued, ahead of
+ * anything on the normal Event Queue.  Use them sparingly; the more urgent work there is, the less
+ * it helps.  (The handlers for fd events from the @ref c_fdMonitor aren't queued at all.  The
+ * Event Loop calls them as soon as it finds out about the events, before running the next batch.)
+ *
+ * @code
+ * le_event_QueueFunctionToThreadUrgent(WorkerThreadRef, CancelRequest, requestPtr, NULL);
+ * @endcode
+ *
  * @section c_event_publishSubscribe Publish-Subscribe Events
  *
  * In the publish-subscribe pattern, someone publishes information and if anyone cares about
@@ -234,6 +259,10 @@
  * - Reports the payload was deleted on return, so the handler
  * function must copy any contents to keep.
  *
+ * @note The payload is only copied once, no matter how many handlers there are, and all the
+ *       handlers are passed a pointer to the same copy.  So handler functions must not modify
+ *       the payload.
+ *
  * @code
  * static void MyHandlerFunc
  * (
@@ -437,6 +466,24 @@
  *
  * @endcode
  *
+ * @section c_event_zeroCopyReports Zero-Copy Event Reports
+ *
+ * le_event_Report() copies the payload from the reporter's buffer.  For events with large
+ * payloads, the reporter can avoid that copy by building the payload directly in a buffer
+ * allocated by @c le_event_AllocPayload(), and then handing that buffer over to
+ * @c le_event_ReportZeroCopy():
+ *
+ * @code
+ * MyEventReport_t* reportPtr = le_event_AllocPayload(EventId);
+ * ...     // Fill in the event report.
+ * le_event_ReportZeroCopy(EventId, reportPtr);
+ * @endcode
+ *
+ * The handlers see no difference between the two; they are passed a pointer to the payload, which
+ * they must not modify or release.  The reporter must not touch the buffer after passing it to
+ * le_event_ReportZeroCopy().  A buffer that turns out not to be needed can be freed using
+ * le_mem_Release() instead.
+ *
  * @section c_event_miscThreadingTopics Miscellaneous Multithreading Topics
  *
  * All functions in this API are thread safe.
@@ -480,6 +527,48 @@
  * the caller's responsibility to check the return code from le_event_ServiceLoop() and keep
  * calling until it indicates that there is no more work to be done.
  *
+ * @section c_event_ioUring Using io_uring Instead of epoll
+ *
+ * By default, each thread's Event Loop waits for file descriptor events using epoll(7).  On
+ * Linux 5.13 and later, it can use io_uring(7) instead, by setting the @c LE_EVENT_BACKEND
+ * environment variable to @c io_uring before starting the process (@c epoll selects the default).
+ * If the kernel doesn't support everything that is needed, the process logs a warning and uses
+ * epoll.
+ *
+ * With io_uring, the file descriptors that became ready during a pass of the Event Loop are
+ * re-armed together in the same system call that waits for the next events, and enabling or
+ * disabling events on an FD Monitor (e.g., using le_fdMonitor_Enable()) costs no system call at
+ * all.  This can save a lot of system calls in processes that handle a lot of IPC.  Nothing else
+ * changes: FD Monitor handlers are called in the same way for both backends, and events are still
+ * level-triggered (unless edge-triggered mode has been chosen for an FD Monitor using
+ * le_fdMonitor_SetEdgeTriggered()).  One difference is that io_uring holds on to a file
+ * descriptor's file until its FD Monitor has been deleted, so an FD Monitor must always be deleted
+ * when its file descriptor is closed (which is good practice anyway).
+ *
+ * The file descriptor returned by le_event_GetFd() is the io_uring file descriptor in this case.
+ * It can be used with poll() and select() in the same way.
+ *
+ * @section c_event_stats Event Loop Statistics
+ *
+ * The Event Loops of a process can keep statistics about what they are doing, which the
+ * @c inspect tool can display while the process runs (<tt>inspect events PID</tt> for each thread,
+ * and <tt>inspect events handlers PID</tt> for each of their handlers).  This costs a few reads of
+ * the clock per event, so it is off by default.  To turn it on for every thread in a process, set
+ * the @c LE_EVENT_STATS environment variable (to any value) before starting the process.
+ *
+ * For each thread, the statistics include:
+ *  - the number of times the Event Loop has been woken up by epoll (or io_uring), in total and
+ *    in the last second;
+ *  - a histogram of the time from event reports (and queued functions) being queued to being
+ *    processed;
+ *  - a histogram of the time taken by each handler, by handler name.  FD Monitor handlers are
+ *    listed under the FD Monitor's name, and queued functions under their function's address.
+ *    Handlers with the same name share an entry.  The first 31 names get an entry each, and
+ *    everything after that shares one called "(others)".
+ *
+ * The highest number of reports ever waiting on each thread's Event Queue and urgent queue is
+ * always kept, whether or not @c LE_EVENT_STATS is set.
+ *
  * @section c_event_troubleshooting Troubleshooting
  *
  * A logging keyword can be enabled to view a given thread's event handling activity.  The keyword name
@@ -487,8 +576,8 @@
  * For example, the keyword "P/T/events" controls logging for a thread named "T" running inside
  * a process named "P".
  *
- * @todo Add a reference to the Process Inspector and its capabilities for inspecting Event Queues,
- * Event Loops, Handlers and Event Report statistics.
+ * The @c inspect tool can show what each thread's Event Loop has been doing.  See
+ * @ref c_event_stats.
 
  * <HR>
  *
@@ -728,6 +817,40 @@ void le_event_Report
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a payload buffer for an event, to be filled in and passed to
+ * le_event_ReportZeroCopy().  See @ref c_event_zeroCopyReports.
+ *
+ * @return Pointer to a buffer of the payload size given to le_event_CreateId().  Its contents
+ *         are undefined.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_event_AllocPayload
+(
+    le_event_Id_t   eventId     ///< [in] Event ID created using le_event_CreateId().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report an Event without copying its payload.  See @ref c_event_zeroCopyReports.
+ *
+ * Queues an Event Report to any and all event loops that have handlers for that event.
+ *
+ * @note Takes ownership of the payload buffer, which must have been allocated using
+ *       le_event_AllocPayload() for the same Event ID.  Don't access the buffer after calling this.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_ReportZeroCopy
+(
+    le_event_Id_t   eventId,    ///< [in] Event ID created using le_event_CreateId().
+    void*           payloadPtr  ///< [in] Payload buffer from le_event_AllocPayload().
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sends an Event Report with a pointer to a reference-counted object as its payload.
@@ -809,6 +932,53 @@ void le_event_QueueFunctionToThread
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a function onto the calling thread's urgent Event Queue.  It will be called by the
+ * calling thread's Event Loop ahead of anything on the normal Event Queue.
+ *
+ * See @ref c_event_urgentFunctions for more information.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_QueueFunctionUrgent
+(
+    le_event_DeferredFunc_t func,       ///< [in] Function to be called later.
+    void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
+    void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a function onto a specific thread's urgent Event Queue.  It will be called by that
+ * thread's Event Loop ahead of anything on its normal Event Queue.
+ *
+ * See @ref c_event_urgentFunctions for more information.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_QueueFunctionToThreadUrgent
+(
+    le_thread_Ref_t         thread,     ///< [in] Thread to queue the function to.
+    le_event_DeferredFunc_t func,       ///< [in] The function.
+    void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
+    void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the maximum number of queued functions and event handlers that the calling thread's Event
+ * Loop will run before it checks its file descriptors again.
+ *
+ * See @ref c_event_urgentFunctions for more information.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_SetBatchSize
+(
+    size_t batchSize    ///< [in] Maximum number of reports per batch (0 = no limit).
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Runs the event loop for the calling thread.
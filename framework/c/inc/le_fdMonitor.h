@@ -247,6 +247,58 @@ static void ConnectionEventHandler(int fd, int event)
  * @endcode
  *
  *
+ * @section c_fdMonitorEdgeTriggered Edge-Triggered Monitoring
+ *
+ * By default, the handler keeps being called for as long as an enabled event's trigger condition
+ * is true, once per pass of the Event Loop.  A handler that reads only part of what is waiting
+ * will simply be called again.
+ *
+ * For fds that receive a lot of data in small pieces (busy sockets, serial ports and other tty
+ * devices), le_fdMonitor_SetEdgeTriggered() can be used to have the handler called only when
+ * an event's trigger condition becomes true (e.g., when more data arrives).  The handler then must
+ * "drain" the fd: it must keep reading until @c read() fails with @c EAGAIN (or @c EWOULDBLOCK),
+ * because it won't be called again for data that was already waiting when it returned.  The
+ * same goes for writing and @c POLLOUT.  The fd must therefore be non-blocking (@c O_NONBLOCK).
+ *
+ * @code
+
+static void SerialPortHandler(int fd, short events)
+{
+    if (events & POLLIN)
+    {
+        char buff[MY_BUFF_SIZE];
+        ssize_t bytesRead;
+
+        while ((bytesRead = read(fd, buff, sizeof(buff))) > 0)
+        {
+            ProcessData(buff, bytesRead);
+        }
+
+        if ((bytesRead < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            ...
+        }
+    }
+    ...
+}
+
+COMPONENT_INIT
+{
+    int fd = open("/dev/ttyS0", O_RDWR|O_NONBLOCK);
+    LE_FATAL_IF(fd == -1, "open failed with errno %d (%m)", errno);
+
+    le_fdMonitor_Ref_t fdMonitor =
+        le_fdMonitor_Create("Serial Port", fd, SerialPortHandler, POLLIN);
+    le_fdMonitor_SetEdgeTriggered(fdMonitor, true);
+}
+
+ * @endcode
+ *
+ * A handler that needs to stop before the fd is drained (to let other handlers run, say) can
+ * queue a function (see le_event_QueueFunction()) to carry on later.  Disabling and re-enabling
+ * an event also gets it reported again if its trigger condition is still true.
+ *
+ *
  * @section c_fdMonitorPowerManagement Power Management
  *
  * If your process has the privilege of being able to block the system from going to sleep,
@@ -443,6 +495,25 @@ void le_fdMonitor_SetDeferrable
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets if events on a given fd are edge-triggered (the handler is called when the fd becomes
+ * ready, and not again until it has stopped being ready and become ready again) or level-triggered
+ * (the handler is called for as long as the fd is ready).  FD Monitors are level-triggered when
+ * they are created.
+ *
+ * The handler of an edge-triggered FD Monitor must keep reading from (or writing to) the fd until
+ * it fails with EAGAIN or EWOULDBLOCK, so the fd must be non-blocking.  See
+ * @ref c_fdMonitorEdgeTriggered.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_fdMonitor_SetEdgeTriggered
+(
+    le_fdMonitor_Ref_t monitorRef,      ///< [in] Reference to the File Descriptor Monitor object.
+    bool               isEdgeTriggered  ///< [in] true (edge-triggered) or false (level-triggered).
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the Context Pointer for File Descriptor Monitor's handler function.  This can be retrieved
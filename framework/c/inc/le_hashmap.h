@@ -15,13 +15,66 @@
  * type of key that you intend to store. It's unwise to mix types in a single table because
  * implementation of the table has no way to detect this behaviour.
  *
- * Choose the initial size should carefully as the index size remains fixed. The best
- * choice for the initial size is a prime number slightly larger than the
- * maximum expected capacity. If a too small size is chosen, there will be an
- * increase in collisions that degrade performance over time.
+ * The capacity passed to le_hashmap_Create() is a hint for the number of entries the map is
+ * expected to hold.  The map grows automatically when it becomes more than 3/4 full, so a capacity
+ * that is too small costs some resizing work but doesn't degrade lookups over time.  Choosing a
+ * capacity close to the expected number of entries avoids the resizing altogether.
+ *
+ * Resizing is incremental: a new bucket array is allocated and the existing entries are moved into
+ * it a few buckets at a time by subsequent calls to le_hashmap_Put() and le_hashmap_Remove(), so
+ * no single call has to move every entry in the map.  Entries are not moved while the map's
+ * iterator is positioned on an entry (see @ref c_hashmap_iterating).
+ *
+ * By default, a map never gives back its buckets.  Call le_hashmap_SetAutoShrink() to allow a map
+ * to shrink when it becomes less than 1/8 full.  A map never shrinks below the number of buckets
+ * it was created with.
  *
  * All hashmaps have names for diagnostic purposes.
  *
+ * @section c_hashmap_flat Flat HashMaps
+ *
+ * le_hashmap_Create() makes a map that stores each key-value pair in its own block from a memory
+ * pool, on a linked list per bucket.  Looking up a key means following the list links, which
+ * usually costs a cache miss per link.
+ *
+ * le_hashmap_CreateFlat() takes the same parameters, but makes a map that stores its keys, values
+ * and hashes in a single array, along with an array of one-byte tags taken from the key hashes.
+ * Lookups compare a key's tag with the tags of 16 slots at a time (using SSE2 or NEON instructions
+ * where available), and only call the equality function for slots whose tag matches, so they
+ * usually touch only one or two cache lines.  Flat maps also use less memory per key.
+ *
+ * Flat maps are used through the same functions as other maps, with the following differences:
+ *  - A flat map is rebuilt in a single step when it needs to grow, rather than incrementally.
+ *  - The order of iteration is the order of the slots, not of the buckets.
+ *  - If a flat map has to grow while its iterator is positioned on an entry (which is put off
+ *    until the map is completely full), the iterator is reset to the start of the map and
+ *    le_hashmap_NextNode() will return keys that were already visited.
+ *
+ * Prefer a flat map for maps that are looked up much more often than they are changed.
+ *
+ * @section c_hashmap_concurrent Concurrent HashMaps
+ *
+ * Other maps must not be used by more than one thread at a time; maps shared between threads have
+ * to be protected by a mutex, which makes every lookup wait for every other lookup.
+ *
+ * le_hashmap_CreateConcurrent() takes the same parameters, but makes a map that any number of
+ * threads can use at the same time without any locking by the caller:
+ *  - le_hashmap_Get(), le_hashmap_GetWithHash(), le_hashmap_GetStoredKey() and
+ *    le_hashmap_ContainsKey() never block or wait for one another.
+ *  - le_hashmap_Put() and le_hashmap_Remove() lock just one of several locks, chosen by the key's
+ *    hash, so threads changing different keys rarely get in each other's way.
+ *
+ * Entries removed from a concurrent map are not released until every thread that might have been
+ * looking at them is done with them.  However, the map can't do the same for the keys and values
+ * themselves.  A value that has been removed from a concurrent map (or replaced by
+ * le_hashmap_Put()) may still be returned by a lookup in another thread that was running at the
+ * same time, so the caller must make sure that values stay valid for as long as other threads might
+ * use them.
+ *
+ * Concurrent maps support le_hashmap_ForEach(), which may or may not visit keys that other threads
+ * put or remove while it runs, but they don't support iterators (le_hashmap_GetIterator(),
+ * le_hashmap_GetFirstNode() and le_hashmap_GetNodeAfter()).  Concurrent maps never shrink.
+ *
  * @section c_hashmap_insert Adding key-value pairs
  *
  * Key-value pairs are added using le_hashmap_Put(). For example:
@@ -56,6 +109,28 @@
  * storing. The hash function should provide a good distribution of values. It
  * is not required that they be unique.
  *
+ * Two string hash functions are provided.  le_hashmap_HashStringFast() reads the string once, a
+ * word at a time, and is faster and better distributed than le_hashmap_HashString(), which is kept
+ * for maps whose layout must not change.  New maps with string keys should use
+ * le_hashmap_HashStringFast().
+ *
+ * @subsection c_hashmap_prehash Looking up with a precomputed hash
+ *
+ * If the same key is looked up many times, or in several maps that use the same hash function,
+ * its hash can be calculated once by calling the map's hash function directly and passed to
+ * le_hashmap_GetWithHash().  The hash passed must be the value the map's own hash function
+ * returns for the key; any other value will make the lookup fail.
+ *
+ * @code
+ * size_t hash = le_hashmap_HashStringFast(nameStr);
+ *
+ * void* valuePtr = le_hashmap_GetWithHash(firstMap, nameStr, hash);
+ * if (valuePtr == NULL)
+ * {
+ *     valuePtr = le_hashmap_GetWithHash(secondMap, nameStr, hash);
+ * }
+ * @endcode
+ *
  * @section c_hashmap_iterating Iterating over a map
  *
  * This API allows the user of the map to iterate over the entire
@@ -114,6 +189,13 @@
  * will be iterated over.  It's very possible that the newly added item is added in
  * an earlier location than the iterator is curently pointed at.
  *
+ * The entries of a map that is being resized are not moved while its iterator is positioned on an
+ * entry, so an iteration never skips or repeats entries because of a resize.  Once the iterator
+ * has run off either end of the map (or le_hashmap_GetIterator() is called again), resizing
+ * resumes.  If so many entries are added during an iteration that the map has to grow again
+ * before then, the resize is finished at once and the iterator is reset to the start of the map,
+ * as for a flat map.
+ *
  * When removing items during an iteration you also have to keep in mind that the
  * iterator's current item may be the one removed.  If this is the case,
  * le_hashmap_GetKey, and le_hashmap_GetValue will return NULL until either,
@@ -240,8 +322,8 @@ typedef bool (*le_hashmap_ForEachHandler_t)
 /**
  * Create a HashMap.
  *
- * If you create a hashmap with a smaller capacity than you actually use, then
- * the map will continue to work, but performance will degrade the more you put in the map.
+ * If you create a hashmap with a smaller capacity than you actually use, then the map will grow
+ * as you put more into it.
  *
  * @return  Returns a reference to the map.
  *
@@ -256,6 +338,42 @@ le_hashmap_Ref_t le_hashmap_Create
     le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] Equality function
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a flat HashMap, which stores its entries in an array instead of on per-bucket lists.
+ * See @ref c_hashmap_flat.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateFlat
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] Hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] Equality function
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a concurrent HashMap, which can be used by several threads at the same time.
+ * See @ref c_hashmap_concurrent.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateConcurrent
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] Hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] Equality function
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a key-value pair to a HashMap. If the key already exists in the map, the previous value
@@ -288,6 +406,23 @@ void* le_hashmap_Get
     const void* keyPtr         ///< [in] Pointer to the key to be retrieved.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve a value from a HashMap, using a hash of the key that has already been calculated.
+ * See @ref c_hashmap_prehash.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+void* le_hashmap_GetWithHash
+(
+    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map.
+    const void* keyPtr,        ///< [in] Pointer to the key to be retrieved.
+    size_t keyHash             ///< [in] Value returned by the map's hash function for the key.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Retrieve a stored key from a HashMap.
@@ -528,6 +663,20 @@ size_t le_hashmap_CountCollisions
     le_hashmap_Ref_t mapRef     ///< [in] Reference to the map.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allows or prevents a HashMap from shrinking its bucket array when entries are removed.
+ *
+ * A shrinkable map halves its bucket array when it becomes less than 1/8 full, but never goes
+ * below the number of buckets it was created with.  Maps are not shrinkable by default.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_hashmap_SetAutoShrink
+(
+    le_hashmap_Ref_t mapRef,    ///< [in] Reference to the map
+    bool isShrinkable           ///< [in] true to allow the map to shrink, false to prevent it
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * String hashing function. Can be used as a parameter to le_hashmap_Create() if the key to
@@ -543,6 +692,21 @@ size_t le_hashmap_HashString
     const void* stringToHashPtr    ///< [in] Pointer to the string to be hashed.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Single-pass string hashing function. Can be used as a parameter to le_hashmap_Create() if the
+ * key to the table is a string.  Faster than le_hashmap_HashString(), but gives different values.
+ *
+ * @return  Returns the hash value of the string pointed to by stringToHash.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+size_t le_hashmap_HashStringFast
+(
+    const void* stringToHashPtr    ///< [in] Pointer to the string to be hashed.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * String equality function. Can be used as a parameter to le_hashmap_Create() if the key to
@@ -151,6 +151,24 @@
  *     printf("Point is at position (%d, %d).\n", pointPtr->x, pointPtr->y);
  * @endcode
  *
+ * @section mem_batches Allocating and Releasing in Batches
+ *
+ * Code that needs several objects from the same pool at once (e.g., one per recipient of a
+ * broadcast) can get them all with a single call to @c le_mem_AllocBatch(), which behaves like
+ * calling @c le_mem_ForceAlloc() that many times.  Likewise, @c le_mem_ReleaseBatch() releases a
+ * whole array of objects (which may come from different pools), just like calling
+ * @c le_mem_Release() on each of them in turn.  The batch versions do the pool bookkeeping once
+ * per batch instead of once per object, so they are cheaper when objects are allocated or
+ * released in bulk.
+ *
+ * @code
+ *     void* reportPtrs[NUM_LISTENERS];
+ *
+ *     le_mem_AllocBatch(ReportPool, NUM_LISTENERS, reportPtrs);
+ *     ...
+ *     le_mem_ReleaseBatch(reportPtrs, NUM_LISTENERS);
+ * @endcode
+ *
  *
  * @section mem_ref_counting Reference Counting
  *
@@ -295,6 +313,28 @@
  * the data structure, then the mutex must be held by the thread that calls le_mem_Release() to
  * ensure there's no other thread accessing the data structure when the destructor runs.
  *
+ * @subsection mem_concurrent Lock-Free Pools
+ *
+ * Most allocations and releases are served from a small per-thread cache of free objects, but
+ * every so often a thread has to take the memory pool module's lock to refill or drain its cache.
+ * If a low-priority thread is preempted while holding that lock, a high-priority (e.g., real-time)
+ * thread that needs the lock has to wait for it.
+ *
+ * For pools that are shared by design between threads of different priorities, calling
+ * @c le_mem_SetConcurrent() right after creating the pool makes allocating objects from it and
+ * releasing objects back into it lock-free.  Such a pool keeps its free objects on a single
+ * lock-free stack instead of in per-thread caches, so it is somewhat slower when uncontended.
+ *
+ * @code
+ * MyPool = le_mem_CreatePool("MyPool", sizeof(MyObj_t));
+ * le_mem_SetConcurrent(MyPool);
+ * le_mem_ExpandPool(MyPool, MY_POOL_SIZE);
+ * @endcode
+ *
+ * Expanding the pool (including when @c le_mem_ForceAlloc() has to expand it) still takes the
+ * lock, so pools used by real-time threads should be expanded to their full size up-front.
+ * Concurrent pools can't be trimmed and can't have sub-pools.
+ *
  * @section mem_pool_sizes Managing Pool Sizes
  *
  * We know it's possible to have pools automatically expand
@@ -382,6 +422,35 @@
  * @note You can't create sub-pools of sub-pools (i.e., sub-pools that get their blocks from another
  * sub-pool).
  *
+ * @section mem_trimming Returning Memory to the System
+ *
+ * A pool's memory is allocated from the system in chunks (slabs) that each hold a number of
+ * objects, one chunk every time the pool is expanded.  By default this memory stays in the pool
+ * for the life of the process, so a process that needs many objects during a short burst of
+ * activity keeps that memory afterwards.
+ *
+ * Calling @c le_mem_SetTrimWatermarks() makes a pool @a trimmable.  Memory for a trimmable pool is
+ * mapped directly from the system in whole pages (any room left over in the last page is filled
+ * with extra objects), and when @c le_mem_ForceAlloc() expands it, it grows by half of its current
+ * size (up to a limit) rather than by the number of objects set using
+ * @c le_mem_SetNumObjsToForce(), if that is larger.  Whenever the number of free objects in a
+ * trimmable pool goes above its high watermark, it is trimmed automatically, until its number of
+ * free objects is down to its low watermark (or as close to it as possible).
+ *
+ * Calling @c le_mem_Trim() releases every chunk of a trimmable pool's memory that doesn't hold any
+ * allocated objects back to the system, reducing the pool's size accordingly.
+ *
+ * Only memory added to a pool after it was made trimmable can be released, so call
+ * @c le_mem_SetTrimWatermarks() before expanding the pool.
+ *
+ * @code
+ * // Keep up to 50 free objects around, but trim whenever there are more than 200 of them.
+ * le_mem_SetTrimWatermarks(pool, 50, 200);
+ * @endcode
+ *
+ * Trimming can only release chunks that don't hold any allocated objects, so it works best for
+ * pools whose objects are short-lived.
+ *
  * <HR>
  *
  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
@@ -646,6 +715,27 @@ le_mem_PoolRef_t le_mem_ExpandPool
 #endif
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a number of objects from a pool, expanding the pool if it doesn't have enough free
+ * objects (like le_mem_ForceAlloc() does).
+ *
+ * See @ref mem_batches for more information.
+ *
+ * @return  Nothing.
+ *
+ * @note    On failure, the process exits, so you don't have to worry about checking the returned
+ *          pointers for validity.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_AllocBatch
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool from which the objects are to be allocated.
+    size_t              numObjects, ///< [IN] Number of objects to allocate.
+    void*               objPtrs[]   ///< [OUT] Array that receives pointers to the objects.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the number of objects that are added when le_mem_ForceAlloc expands the pool.
@@ -665,6 +755,73 @@ void le_mem_SetNumObjsToForce
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes a pool trimmable, so that memory is given back to the system automatically when the pool
+ * has too many free objects.
+ *
+ * When the number of free objects in the pool grows above the high watermark, memory that holds
+ * nothing but free objects is released until no more than the low watermark number of free
+ * objects are left.
+ *
+ * See @ref mem_trimming for more information.
+ *
+ * @return
+ *      Nothing.
+ *
+ * @note
+ *      Sub-pools can't be made trimmable.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_SetTrimWatermarks
+(
+    le_mem_PoolRef_t    pool,           ///< [IN] The pool.
+    size_t              lowWatermark,   ///< [IN] Number of free objects to keep when trimming.
+    size_t              highWatermark   ///< [IN] Number of free objects above which to trim.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes allocating objects from and releasing objects to a pool lock-free.  Must be called before
+ * the pool is used by more than one thread.
+ *
+ * See @ref mem_concurrent for more information.
+ *
+ * @return
+ *      Nothing.
+ *
+ * @note
+ *      Sub-pools, trimmable pools and pools that have sub-pools can't be made concurrent.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_SetConcurrent
+(
+    le_mem_PoolRef_t    pool            ///< [IN] The pool.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases all of a trimmable pool's memory that doesn't hold any allocated objects back to the
+ * system.
+ *
+ * See @ref mem_trimming for more information.
+ *
+ * @return
+ *      The number of free objects that were removed from the pool.
+ *
+ * @note
+ *      Only trimmable pools can be trimmed (zero is returned for other pools).  Sub-pools can't be
+ *      trimmed either.  Trim their super-pool instead.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_mem_Trim
+(
+    le_mem_PoolRef_t    pool        ///< [IN] The pool to be trimmed.
+);
+
+
 #ifndef LE_MEM_TRACE
     //----------------------------------------------------------------------------------------------
     /**
@@ -701,6 +858,26 @@ void le_mem_SetNumObjsToForce
 #endif
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a number of objects, as if le_mem_Release() was called on each of them in order.
+ *
+ * See @ref mem_batches for more information.
+ *
+ * @return
+ *      Nothing.
+ *
+ * @warning
+ *      The same warnings apply as for le_mem_Release().
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_ReleaseBatch
+(
+    void*   objPtrs[],  ///< [IN] Array of pointers to the objects to be released.
+    size_t  numObjects  ///< [IN] Number of objects in the array.
+);
+
+
 #ifndef LE_MEM_TRACE
     //----------------------------------------------------------------------------------------------
     /**
@@ -141,6 +141,19 @@
  *     msgPayloadPtr->... = ...; // <-- Populate message payload...
  * @endcode
  *
+ * A message created using le_msg_CreateMsg() is big enough to hold the largest message in the
+ * session's protocol.  If the client knows that a message (and the server's response to it) will
+ * fit into a smaller payload buffer, it can use le_msg_CreateMsgWithSize() instead, which allows
+ * the message to be allocated from a pool of smaller messages.  See
+ * @ref c_messagingMemoryManagement.
+ *
+ * @code
+ *     msgRef = le_msg_CreateMsgWithSize(sessionRef, sizeof(MyRequest_t));
+ * @endcode
+ *
+ * @warning The server responds using the same payload buffer that held the request, so the size
+ *          passed to le_msg_CreateMsgWithSize() must be large enough for the response too.
+ *
  * If no response is required from the server, the client sends the message using le_msg_Send().
  * At this point, the client has handed off the message to the messaging system, and the messaging
  * system will delete the message automatically once it has finished sending it.
@@ -175,6 +188,9 @@
  * blocked and would therefore be unable to receive the request and respond to it, resulting in
  * a deadlock.
  *
+ * When le_msg_RequestSyncResponse() is called from inside a @ref c_coro "coroutine", only the
+ * coroutine waits for the response, and the thread's other event handlers carry on running.
+ *
  * When the client is finished with it, the <b> client must release its reference
  * to the response message </b> by calling le_msg_ReleaseMsg().
  *
@@ -679,6 +695,15 @@
  * From this, they obtain a protocol reference that they provide to sessions when they create
  * them.
  *
+ * Most messages are much smaller than the largest message in their protocol, so each protocol's
+ * messages are allocated from a small number of pools of different sizes (size classes).
+ * le_msg_CreateMsgWithSize() picks the smallest size class that the message will fit into, and
+ * messages received from a socket are put into the smallest size class that will hold them.
+ * Messages that are too big for any of a protocol's size classes are allocated from overflow
+ * pools that are shared by all protocols, so that memory for large messages doesn't have to be
+ * set aside separately for every protocol.  le_msg_GetMaxPayloadSize() reports the size of a
+ * particular message's payload buffer.
+ *
  * @section c_messagingSecurity Security
  *
  * Security is provided in the form of authentication and access control.
@@ -1267,6 +1292,26 @@ le_msg_MessageRef_t le_msg_CreateMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer that is at least a
+ * given size.  This can be much smaller than the largest message in the session's protocol.
+ *
+ * @return  Message reference.
+ *
+ * @note
+ * - Function never returns on failure, there's no need to check the return code.
+ * - If a response is expected, the payload buffer must also be large enough to hold the response.
+ * - It is a fatal error to ask for more than the protocol's maximum message size.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateMsgWithSize
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t payloadSize              ///< [in] Minimum size of the payload buffer, in bytes.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Adds to the reference count on a message object.
@@ -1327,7 +1372,8 @@ void* le_msg_GetPayloadPtr
 /**
  * Gets the size, in bytes, of the message payload memory buffer.
  *
- * @return The size, in bytes.
+ * @return The size, in bytes.  This is never more than the protocol's maximum message size, but
+ *         can be less, depending on how the message was created.
  */
 //--------------------------------------------------------------------------------------------------
 size_t le_msg_GetMaxPayloadSize
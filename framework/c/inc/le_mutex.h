@@ -70,6 +70,10 @@
  * that currently exist inside a given process.  The state of each mutex can be
  * seen, including a list of any threads that might be waiting for that mutex.
  *
+ * Keeping track of this costs very little.  Locking a mutex that nobody holds takes a single
+ * atomic operation, as it would for a plain pthreads mutex; threads are only added to a mutex's
+ * waiting list when they actually have to wait.
+ *
  * <HR>
  *
  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
@@ -0,0 +1,440 @@
+/**
+ * @page c_rbtree Red/Black Tree API
+ *
+ * @ref le_rbtree.h "API Reference"
+ *
+ * <HR>
+ *
+ * A red/black tree is a self-balancing binary search tree.  It keeps its nodes sorted by key, so
+ * that nodes can be inserted, removed and searched for in O(log n) time, and the nodes can be
+ * visited in key order.  Use it instead of a hand-sorted @ref c_doublyLinkedList "linked list"
+ * when the list may get long, or instead of a @ref c_hashmap "hashmap" when the entries are needed
+ * in order or when the entry nearest to a key is needed.
+ *
+ * Like the linked lists, the tree is @e intrusive: the tree module does not allocate any memory.
+ * The user's node contains a @c le_rbtree_Node_t member, and it is that member that is put in
+ * the tree.  The user is responsible for allocating and freeing memory for all nodes (normally
+ * from a @ref c_memory "memory pool"), and a node must be removed from the tree before its memory
+ * can be freed.
+ *
+ * @section rbtree_createTree Creating and Initializing Trees
+ *
+ * A tree is a @c le_rbtree_Tree_t, which must be initialized by calling le_rbtree_InitTree()
+ * before it is used.  The tree is given a function that compares two keys, which must return a
+ * value less than, equal to, or greater than zero if the first key is less than, equal to, or
+ * greater than the second key, in the same way as @c strcmp().
+ *
+ * @code
+ * static int CompareKeys(const void* key1Ptr, const void* key2Ptr)
+ * {
+ *     return strcmp(key1Ptr, key2Ptr);
+ * }
+ *
+ * le_rbtree_Tree_t MyTree;
+ *
+ * le_rbtree_InitTree(&MyTree, CompareKeys);
+ * @endcode
+ *
+ * <b> Elements of le_rbtree_Tree_t MUST NOT be accessed directly by the user. </b>
+ *
+ * @section rbtree_createNode Creating and Accessing Nodes
+ *
+ * Nodes can contain any data in any format.  The only requirement is that the node contains a
+ * @c le_rbtree_Node_t member, which must be initialized by calling le_rbtree_InitNode() with a
+ * pointer to the node's key.  The key is usually part of the node itself.  The key must not
+ * change while the node is in the tree.
+ *
+ * @code
+ * typedef struct
+ * {
+ *     char name[32];
+ *     ...
+ *     le_rbtree_Node_t treeNode;
+ * }
+ * MyNodeClass_t;
+ *
+ * void foo (void)
+ * {
+ *     MyNodeClass_t* myNodePtr = le_mem_ForceAlloc(MyNodePool);
+ *
+ *     le_utf8_Copy(myNodePtr->name, "bar", sizeof(myNodePtr->name), NULL);
+ *     le_rbtree_InitNode(&myNodePtr->treeNode, myNodePtr->name);
+ *
+ *     le_rbtree_Insert(&MyTree, &myNodePtr->treeNode);
+ * }
+ * @endcode
+ *
+ * To get the user's node from a tree node, use the @c CONTAINER_OF macro defined in le_basics.h:
+ *
+ * @code
+ * le_rbtree_Node_t* treeNodePtr = le_rbtree_Find(&MyTree, "bar");
+ *
+ * if (treeNodePtr != NULL)
+ * {
+ *     MyNodeClass_t* myNodePtr = CONTAINER_OF(treeNodePtr, MyNodeClass_t, treeNode);
+ * }
+ * @endcode
+ *
+ * <b> Elements of le_rbtree_Node_t MUST NOT be accessed directly by the user. </b>
+ *
+ * @section rbtree_add Adding and Removing Nodes
+ *
+ * - @c le_rbtree_Insert() - Adds a node to the tree.
+ * - @c le_rbtree_Remove() - Removes a node from the tree.
+ *
+ * The tree may hold more than one node with the same key.  A node is inserted after any nodes
+ * that are already in the tree with an equal key, so nodes with equal keys are visited in the
+ * order they were inserted.  If keys must be unique, use le_rbtree_Find() before inserting.
+ *
+ * @section rbtree_find Searching for Nodes
+ *
+ * - @c le_rbtree_Find() - Gets the first node with a key equal to a given key.
+ * - @c le_rbtree_LowerBound() - Gets the first node with a key greater than or equal to a given
+ *                               key.
+ * - @c le_rbtree_UpperBound() - Gets the first node with a key greater than a given key.
+ *
+ * @section rbtree_iterate Visiting Nodes in Order
+ *
+ * - @c le_rbtree_GetFirst() - Gets the node with the smallest key.  This takes constant time.
+ * - @c le_rbtree_GetLast() - Gets the node with the largest key.
+ * - @c le_rbtree_GetNext() - Gets the node after a given node.
+ * - @c le_rbtree_GetPrev() - Gets the node before a given node.
+ *
+ * @code
+ * le_rbtree_Node_t* treeNodePtr = le_rbtree_GetFirst(&MyTree);
+ *
+ * while (treeNodePtr != NULL)
+ * {
+ *     MyNodeClass_t* myNodePtr = CONTAINER_OF(treeNodePtr, MyNodeClass_t, treeNode);
+ *     ...
+ *     treeNodePtr = le_rbtree_GetNext(&MyTree, treeNodePtr);
+ * }
+ * @endcode
+ *
+ * To remove nodes while iterating, get the next node before removing the current one.
+ *
+ * @section rbtree_query Querying Tree Status
+ *
+ * - @c le_rbtree_IsEmpty() - Checks if the tree is empty.
+ * - @c le_rbtree_NumNodes() - Gets the number of nodes in the tree.
+ * - @c le_rbtree_IsInTree() - Checks if a node is in a tree.
+ * - @c le_rbtree_GetKey() - Gets a node's key.
+ *
+ * @section rbtree_synch Thread Safety and Re-Entrancy
+ *
+ * All tree functions are re-entrant, but if a tree is shared by multiple threads, a
+ * @ref c_mutex "mutex" or some other form of thread synchronization must be used to ensure only one
+ * thread accesses the tree at a time.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+
+ /** @file le_rbtree.h
+  *
+  * Legato @ref c_rbtree include file.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#ifndef LEGATO_RBTREE_INCLUDE_GUARD
+#define LEGATO_RBTREE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Colour of a tree node.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LE_RBTREE_NOT_IN_TREE,      ///< Node is not in a tree.
+    LE_RBTREE_RED,
+    LE_RBTREE_BLACK
+}
+le_rbtree_Color_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This node object must be included in each user node, and initialized by calling
+ * le_rbtree_InitNode().
+ *
+ * @warning The structure's content MUST NOT be accessed directly.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_rbtree_Node
+{
+    const void*             keyPtr;     ///< The node's key.
+    struct le_rbtree_Node*  parentPtr;  ///< Parent node, or NULL for the root.
+    struct le_rbtree_Node*  leftPtr;    ///< Child with a smaller key, or NULL.
+    struct le_rbtree_Node*  rightPtr;   ///< Child with a larger (or equal) key, or NULL.
+    le_rbtree_Color_t       color;      ///< Node colour.
+}
+le_rbtree_Node_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype for functions that compare two keys.
+ *
+ * @return
+ *      - Less than zero if the first key is less than the second.
+ *      - Zero if the keys are equal.
+ *      - Greater than zero if the first key is greater than the second.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef int (*le_rbtree_CompareFunc_t)
+(
+    const void* key1Ptr,    ///< [IN] First key.
+    const void* key2Ptr     ///< [IN] Second key.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This is the tree object.  It must be initialized by calling le_rbtree_InitTree().
+ *
+ * @warning User MUST NOT access the contents of this structure directly.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_rbtree_Node_t*       rootPtr;        ///< Root node, or NULL if the tree is empty.
+    le_rbtree_Node_t*       firstPtr;       ///< Node with the smallest key, or NULL.
+    size_t                  numNodes;       ///< Number of nodes in the tree.
+    le_rbtree_CompareFunc_t compareFuncPtr; ///< Key comparison function.
+}
+le_rbtree_Tree_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes a tree.  The tree is empty afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_InitTree
+(
+    le_rbtree_Tree_t* treePtr,                  ///< [IN] Tree to initialize.
+    le_rbtree_CompareFunc_t compareFuncPtr      ///< [IN] Key comparison function.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes a node.  This must be done before the node is inserted in a tree, and the key must
+ * not change while the node is in a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_InitNode
+(
+    le_rbtree_Node_t* nodePtr,                  ///< [IN] Node to initialize.
+    const void* keyPtr                          ///< [IN] Pointer to the node's key.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Inserts a node in the tree.  If the tree already has nodes with an equal key, the new node is
+ * put after them.  The node must not already be in a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_Insert
+(
+    le_rbtree_Tree_t* treePtr,                  ///< [IN] Tree to insert into.
+    le_rbtree_Node_t* nodePtr                   ///< [IN] Node to insert.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a node from the tree.  Ensure the node is in the tree otherwise the behaviour of this
+ * function is undefined.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_Remove
+(
+    le_rbtree_Tree_t* treePtr,                  ///< [IN] Tree to remove from.
+    le_rbtree_Node_t* nodePtr                   ///< [IN] Node to remove.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first node with a key equal to a given key.
+ *
+ * @return
+ *      The node, or NULL if there is no node with an equal key.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_Find
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree to search.
+    const void* keyPtr                          ///< [IN] Key to search for.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first node with a key greater than or equal to a given key.
+ *
+ * @return
+ *      The node, or NULL if all keys in the tree are less than the given key.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_LowerBound
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree to search.
+    const void* keyPtr                          ///< [IN] Key to search for.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first node with a key greater than a given key.
+ *
+ * @return
+ *      The node, or NULL if no key in the tree is greater than the given key.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_UpperBound
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree to search.
+    const void* keyPtr                          ///< [IN] Key to search for.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node with the smallest key (the first of them, if there are several).
+ *
+ * @return
+ *      The node, or NULL if the tree is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_rbtree_Node_t* le_rbtree_GetFirst
+(
+    const le_rbtree_Tree_t* treePtr             ///< [IN] The tree.
+)
+{
+    return treePtr->firstPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node with the largest key (the last of them, if there are several).
+ *
+ * @return
+ *      The node, or NULL if the tree is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_GetLast
+(
+    const le_rbtree_Tree_t* treePtr             ///< [IN] The tree.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node after a given node.  Ensure the node is in the tree otherwise the behaviour of
+ * this function is undefined.
+ *
+ * @return
+ *      The next node, or NULL if the given node is the last one.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_GetNext
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree containing the node.
+    const le_rbtree_Node_t* nodePtr             ///< [IN] The node.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node before a given node.  Ensure the node is in the tree otherwise the behaviour of
+ * this function is undefined.
+ *
+ * @return
+ *      The previous node, or NULL if the given node is the first one.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_GetPrev
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree containing the node.
+    const le_rbtree_Node_t* nodePtr             ///< [IN] The node.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a node's key.
+ *
+ * @return
+ *      The key pointer that the node was initialized with.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline const void* le_rbtree_GetKey
+(
+    const le_rbtree_Node_t* nodePtr             ///< [IN] The node.
+)
+{
+    return nodePtr->keyPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if a tree is empty.
+ *
+ * @return
+ *      true if empty, false if not empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool le_rbtree_IsEmpty
+(
+    const le_rbtree_Tree_t* treePtr             ///< [IN] The tree.
+)
+{
+    return (treePtr->rootPtr == NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of nodes in a tree.
+ *
+ * @return
+ *      Number of nodes.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t le_rbtree_NumNodes
+(
+    const le_rbtree_Tree_t* treePtr             ///< [IN] The tree.
+)
+{
+    return treePtr->numNodes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if a node is in a tree.  The node must have been initialized.
+ *
+ * @return
+ *      true if the node is in a tree, false if not.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool le_rbtree_IsInTree
+(
+    const le_rbtree_Node_t* nodePtr             ///< [IN] The node.
+)
+{
+    return (nodePtr->color != LE_RBTREE_NOT_IN_TREE);
+}
+
+
+#endif  // LEGATO_RBTREE_INCLUDE_GUARD
@@ -0,0 +1,187 @@
+/**
+ * @page c_rwlock Reader-Writer Lock API
+ *
+ * @ref le_rwlock.h "API Reference"
+ *
+ * <HR>
+ *
+ * A reader-writer lock protects data that is read a lot more often than it is changed (cached
+ * modem state, the latest position fix, etc.).  Any number of threads can hold the lock for
+ * reading at the same time, but a thread that holds it for writing has it to itself.  Like
+ * @ref c_mutex "mutexes", these locks can be shared by threads within the same process, but can't
+ * be shared by threads in different processes.
+ *
+ * @section c_rwlock_create Creating a Reader-Writer Lock
+ *
+ * le_rwlock_Create() creates a reader-writer lock, returning a reference to it (of type
+ * le_rwlock_Ref_t).  All reader-writer locks have names, required for diagnostic purposes.  See
+ * @ref c_rwlock_diagnostics below.
+ *
+ * @section c_rwlock_locking Using a Reader-Writer Lock
+ *
+ * Functions for locking and unlocking reader-writer locks:
+ *  - @c le_rwlock_ReadLock()
+ *  - @c le_rwlock_TryReadLock()
+ *  - @c le_rwlock_WriteLock()
+ *  - @c le_rwlock_TryWriteLock()
+ *  - @c le_rwlock_Unlock()
+ *
+ * @code
+ * static le_rwlock_Ref_t CacheLock;
+ * static CellInfo_t CellInfoCache;
+ *
+ * static void GetCellInfo(CellInfo_t* infoPtr)
+ * {
+ *     le_rwlock_ReadLock(CacheLock);
+ *     *infoPtr = CellInfoCache;
+ *     le_rwlock_Unlock(CacheLock);
+ * }
+ *
+ * static void UpdateCellInfo(const CellInfo_t* infoPtr)
+ * {
+ *     le_rwlock_WriteLock(CacheLock);
+ *     CellInfoCache = *infoPtr;
+ *     le_rwlock_Unlock(CacheLock);
+ * }
+ * @endcode
+ *
+ * The locks prefer writers: once a thread is waiting to write, threads that ask to read have to
+ * wait until it has had its turn, so a steady stream of readers can't keep a writer waiting
+ * forever.  A consequence is that these locks are not recursive.  A thread that already holds a
+ * lock must not lock it again, for reading or for writing; if a writer started waiting in between,
+ * that would deadlock.  Re-locking a lock that the thread already holds, or unlocking one that it
+ * doesn't hold, is detected, logged as a fatal error, and terminates the process.
+ *
+ * @section c_rwlock_delete Deleting a Reader-Writer Lock
+ *
+ * When you are finished with a reader-writer lock, you must delete it by calling
+ * le_rwlock_Delete().  There must not be anyone holding or waiting for the lock when it is
+ * deleted.
+ *
+ * @section c_rwlock_diagnostics Diagnostics
+ *
+ * The command-line diagnostic tool @ref toolsTarget_inspect can be used to list the reader-writer
+ * locks that currently exist inside a given process.  The number of readers, the writer, and the
+ * threads that are waiting for each lock can be seen, along with the number of times that readers
+ * and writers have had to wait for it.  Locking a reader-writer lock that is free costs a single
+ * atomic operation; the waiting lists and counters are only updated by threads that have to wait.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file le_rwlock.h
+ *
+ * Legato @ref c_rwlock include file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_RWLOCK_INCLUDE_GUARD
+#define LEGATO_RWLOCK_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a reader-writer lock.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_rwlock* le_rwlock_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a reader-writer lock.
+ *
+ * @return  Returns a reference to the lock.
+ *
+ * @note Terminates the process on failure, no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rwlock_Ref_t le_rwlock_Create
+(
+    const char* nameStr     ///< [in] Name of the lock.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a reader-writer lock.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_Delete
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock a reader-writer lock for reading, waiting if another thread holds it for writing or is
+ * waiting to.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_ReadLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Try to lock a reader-writer lock for reading.
+ *
+ * @return
+ *  - LE_OK if the lock was locked for reading.
+ *  - LE_WOULD_BLOCK if another thread holds the lock for writing or is waiting to.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_rwlock_TryReadLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock a reader-writer lock for writing, waiting until no other thread holds it.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_WriteLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Try to lock a reader-writer lock for writing.
+ *
+ * @return
+ *  - LE_OK if the lock was locked for writing.
+ *  - LE_WOULD_BLOCK if another thread holds the lock.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_rwlock_TryWriteLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unlock a reader-writer lock that the calling thread holds, for reading or for writing.
+ *
+ * @note Terminates the process if the calling thread doesn't hold the lock.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_Unlock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+);
+
+
+#endif // LEGATO_RWLOCK_INCLUDE_GUARD
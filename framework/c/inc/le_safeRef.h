@@ -54,7 +54,20 @@
  * A <b> Reference Map </b> object can be used to create Safe References and keep track of the
  * mappings from Safe References to pointers.  At start-up, a Reference Map is
  * created by calling @c le_ref_CreateMap().  It takes a single argument, the maximum number
- * of mappings expected to track of at any time.
+ * of mappings expected to track of at any time.  The map grows if more are needed.
+ *
+ * Creating, looking up and deleting a Safe Reference all take constant time.  A Safe Reference
+ * that has been deleted is never valid again, even if its map has re-used the storage it
+ * occupied for a newer Safe Reference.
+ *
+ * @section c_safeRef_iterate Iterate Over a Reference Map
+ *
+ * @c le_ref_GetIterator() returns the map's iterator, positioned before the first Safe Reference.
+ * Each call to @c le_ref_NextNode() moves it on to the next one, which can be read with
+ * @c le_ref_GetSafeRef() and @c le_ref_GetValue().  The Safe Reference the iterator is on may be
+ * deleted during iteration; after that, @c le_ref_GetSafeRef() and @c le_ref_GetValue() return
+ * NULL until the iterator is moved on.  Safe References created during iteration may or may not
+ * be visited.
  *
  * @section c_safeRef_multithreading Multithreading
  *
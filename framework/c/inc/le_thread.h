@@ -33,7 +33,7 @@
  *   -# For diagnostics.
  *
  * Threads are created in a suspended state.  In this state, attributes like
- * scheduling priority and stack size can use the appropriate "Set" functions.
+ * scheduling priority, stack size and CPU affinity can use the appropriate "Set" functions.
  * All attributes have default values so it is not necessary to set any
  * attributes (other than the name and main function address, which are passed into
  * le_thread_Create() ).  When all attributes have been set, the thread can be started by calling
@@ -44,6 +44,18 @@
  *          to set any attributes of @e T2 or try to start it.
  *
  *
+ * @section threadAffinity CPU Affinity
+ *
+ * On a multi-core system, le_thread_SetCpuAffinity() restricts a thread to a subset of the CPUs,
+ * for example to keep a latency-sensitive thread away from the CPUs used by bulk workers.  Unlike
+ * the other attributes, it can also be changed after the thread has started.  The CPUs must be
+ * within those allowed to the process as a whole, which can be limited for a whole application
+ * or for individual processes using the @c cpuSet section of the application's .adef file.
+ *
+ * The CPU time used by each thread so far can be seen using the @ref toolsTarget_inspect tool's
+ * @c threads command.
+ *
+ *
  * @section threadTerminating Terminating a Thread
  *
  * Threads can terminate themselves by:
@@ -326,6 +338,26 @@ le_result_t le_thread_SetStackSize
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the CPUs that a thread is allowed to run on.  Bit @e n of the mask stands for CPU @e n.
+ *
+ * Can be called before or after the thread has been started.  By default, a thread can run on
+ * any CPU that its process is allowed to run on (see the @c cpuSet section in the .adef).
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_OUT_OF_RANGE if none of the CPUs in the mask exist or are available to the process.
+ *      - LE_FAULT if the thread's affinity couldn't be changed for some other reason.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_thread_SetCpuAffinity
+(
+    le_thread_Ref_t     thread,     ///< [IN]
+    uint64_t            cpuMask     ///< [IN] Bit mask of the CPUs that the thread may run on.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Makes a thread "joinable", meaning that when it finishes, it will remain in existence until
@@ -22,6 +22,7 @@
  *  - @ref le_timer_SetInterval
  *  - @ref le_timer_SetRepeat
  *  - @ref le_timer_SetContextPtr
+ *  - @ref le_timer_SetSlack
  *
  * The repeat count defaults to 1, so that the timer is initially a one-shot timer. All the other
  * attributes must be explicitly set.  At a minimum, the interval must be set before the timer can be
@@ -61,6 +62,22 @@
  * The number of times that a timer has expired can be retrieved by @ref le_timer_GetExpiryCount. This
  * count is independent of whether there is an expiry handler for the timer.
  *
+ * @section le_timer_slack Timer Slack
+ *
+ * Each thread has a single system timer, which is set to wake the thread up when its next timer
+ * expires.  Timers that expire a few milliseconds apart therefore wake the thread up a few
+ * milliseconds apart, which costs CPU time and power.
+ *
+ * For timers whose expiry time doesn't need to be exact (polling, retries, statistics, etc.),
+ * @ref le_timer_SetSlack allows the timer to expire up to a given number of milliseconds late.
+ * The thread's system timer is then set to the latest time that is within the slack of all the
+ * timers that would have expired by then, and all those timers expire together.  Slack never makes
+ * a timer expire early.  A repeating timer's later expiries are still based on its interval, so
+ * slack does not make it drift.
+ *
+ * @ref le_timer_GetWakeupCounts gets the number of timer wakeups in the process, and how many
+ * wakeups were saved by expiring timers with different expiry times together.
+ *
  * @section le_timer_thread Thread Support
  *
  * A timer should only be used by the thread that created it. It's not safe for a thread to use
@@ -89,6 +106,7 @@
  *     - @ref le_timer_SetHandler
  *     - @ref le_timer_SetInterval
  *     - @ref le_timer_SetRepeat
+ *     - @ref le_timer_SetSlack
  *     - @ref le_timer_Start
  *     - @ref le_timer_Stop
  *     - @ref le_timer_Restart
@@ -236,6 +254,28 @@ le_result_t le_timer_SetMsInterval
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer slack in milliseconds.
+ *
+ * Timer may expire up to this much later than its interval, so that it can expire together with
+ * other timers.  The default is 0.  See @ref le_timer_slack.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetSlack
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set slack for this timer object.
+    uint32_t slack               ///< [IN] Timer slack in milliseconds.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set how many times the timer will repeat.
@@ -389,5 +429,18 @@ bool le_timer_IsRunning
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of timer wakeups in this process, and how many wakeups were saved by expiring
+ * timers with different expiry times together.  Either pointer may be NULL.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_timer_GetWakeupCounts
+(
+    uint64_t* wakeupCountPtr,       ///< [OUT] Number of timer wakeups.
+    uint64_t* savedWakeupCountPtr   ///< [OUT] Number of timer wakeups saved.
+);
+
+
 #endif // LEGATO_TIMER_INCLUDE_GUARD
 
@@ -0,0 +1,142 @@
+/**
+ * @page c_workQueue Work Queue API
+ *
+ * @ref le_workQueue.h "API Reference"
+ *
+ * <HR>
+ *
+ * The Work Queue runs CPU-bound jobs (decoding, compression, hashing, etc.) on a pool of worker
+ * threads, so they can use all of the CPU cores and don't hold up the Event Loop of the thread
+ * that needs them done.  When a job is finished, a completion function is called back in the
+ * thread that submitted it, from that thread's Event Loop.
+ *
+ * @code
+ * static void CompressJob(void* contextPtr)
+ * {
+ *     // Runs in a worker thread.
+ *     Batch_t* batchPtr = contextPtr;
+ *     batchPtr->compressedSize = Compress(batchPtr->data, batchPtr->size, batchPtr->compressed);
+ * }
+ *
+ * static void CompressDone(void* contextPtr)
+ * {
+ *     // Runs in the thread that called le_workQueue_Submit(), from its Event Loop.
+ *     Batch_t* batchPtr = contextPtr;
+ *     Upload(batchPtr->compressed, batchPtr->compressedSize);
+ * }
+ *
+ * le_workQueue_Submit(CompressJob, CompressDone, batchPtr);
+ * @endcode
+ *
+ * The completion function is queued to the submitting thread as if by
+ * le_event_QueueFunctionToThread(), so that thread must run its Event Loop.  If nothing needs to
+ * be done when the job is finished, the completion function can be NULL.
+ *
+ * A job can submit more jobs (e.g., to split its work up).  Those jobs go on the worker's own
+ * queue, where idle workers can steal them.  Since worker threads don't run an Event Loop, the
+ * completion function of a job that was submitted by another job is called in the worker thread
+ * that ran the job, straight after it.
+ *
+ * Jobs must not block for long (on I/O, IPC, semaphores, etc.), because that ties up a worker
+ * that could be running other jobs.  Use a thread of your own for that.
+ *
+ *
+ * @section workQueue_sizing Number of Workers
+ *
+ * All of the components in a process share one pool of workers, which is started the first time a
+ * job is submitted.  By default, there is one worker per CPU core.  This can be changed for a
+ * process by setting the LE_WORKQUEUE_THREADS environment variable in the process's section of
+ * its @c .adef file:
+ *
+ * @code
+ * processes:
+ * {
+ *     run:
+ *     {
+ *         (assetDataDaemon)
+ *     }
+ *
+ *     envVars:
+ *     {
+ *         LE_WORKQUEUE_THREADS = 2
+ *     }
+ * }
+ * @endcode
+ *
+ * le_workQueue_GetNumWorkers() gives the number of workers.
+ *
+ *
+ * @section workQueue_stealing Work Stealing
+ *
+ * Each worker has its own queue (a Chase-Lev deque).  A worker takes jobs from the back of its own
+ * queue without any locking, most recently submitted first, which keeps the data that a job just
+ * produced in that core's cache for the jobs that it submitted.  Jobs submitted from outside the
+ * pool go on a shared queue.  A worker with nothing left in either queue steals the oldest job
+ * from another worker's queue before going to sleep.
+ *
+ * Jobs are started roughly, but not exactly, in the order they are submitted.  If jobs need to
+ * be run in order, submit the next one from the completion function of the one before.
+ *
+ * <HR>
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+//--------------------------------------------------------------------------------------------------
+/** @file le_workQueue.h
+ *
+ * Legato @ref c_workQueue include file.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_WORKQUEUE_INCLUDE_GUARD
+#define LEGATO_WORKQUEUE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype of job functions, which run in a worker thread, and of completion functions, which
+ * run in the thread that submitted the job.
+ *
+ * @param contextPtr Context pointer that was passed to le_workQueue_Submit().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*le_workQueue_JobFunc_t)
+(
+    void* contextPtr
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submits a job to be run by a worker thread.
+ *
+ * Can be called from any thread, including from inside a job.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_workQueue_Submit
+(
+    le_workQueue_JobFunc_t jobFunc,         ///< [IN] Function to run in a worker thread.
+    le_workQueue_JobFunc_t completionFunc,  ///< [IN] Function to call in this thread when the job
+                                            ///       is done (NULL if none).
+    void* contextPtr                        ///< [IN] Value to pass to both functions.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of worker threads (starting them, if they haven't been started yet).
+ *
+ * @return The number of worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_workQueue_GetNumWorkers
+(
+    void
+);
+
+
+#endif // LEGATO_WORKQUEUE_INCLUDE_GUARD
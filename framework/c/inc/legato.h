@@ -13,6 +13,7 @@
  * @subpage c_le_build_cfg <br>
  * @subpage c_basics <br>
  * @subpage c_args <br>
+ * @subpage c_arena <br>
  * @subpage c_dir <br>
  * @subpage c_doublyLinkedList <br>
  * @subpage c_memory <br>
@@ -28,13 +29,18 @@
  * @subpage c_path <br>
  * @subpage c_pathIter <br>
  * @subpage c_print <br>
+ * @subpage c_rbtree <br>
+ * @subpage c_rwlock <br>
  * @subpage c_safeRef <br>
  * @subpage c_semaphore <br>
  * @subpage c_signals <br>
  * @subpage c_singlyLinkedList <br>
  * @subpage c_clock <br>
+ * @subpage c_cond <br>
+ * @subpage c_coro <br>
  * @subpage c_threading <br>
  * @subpage c_timer <br>
+ * @subpage c_workQueue <br>
  * @subpage c_test <br>
  * @subpage c_utf8 <br>
  * @subpage c_tty
@@ -184,16 +190,22 @@ extern "C" {
 #include "le_basics.h"
 #include "le_doublyLinkedList.h"
 #include "le_singlyLinkedList.h"
+#include "le_rbtree.h"
 #include "le_utf8.h"
 #include "le_log.h"
 #include "le_mem.h"
+#include "le_arena.h"
 #include "le_mutex.h"
 #include "le_clock.h"
 #include "le_semaphore.h"
+#include "le_rwlock.h"
+#include "le_cond.h"
 #include "le_safeRef.h"
 #include "le_thread.h"
 #include "le_eventLoop.h"
 #include "le_fdMonitor.h"
+#include "le_coro.h"
+#include "le_workQueue.h"
 #include "le_hashmap.h"
 #include "le_signals.h"
 #include "le_args.h"
@@ -0,0 +1,474 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file arena.c Implementation of the Arena Allocator API.
+ *
+ * An arena keeps a list of fixed-size chunks, allocated from the Chunk Pool.  Allocation just
+ * advances an offset through the current chunk, moving on to the next chunk in the list (or
+ * fetching a new one from the pool) when the current one fills up.  Resetting an arena moves it
+ * back to the start of its first chunk, without giving any chunks back, so the chunks get re-used
+ * by the next round of allocations.
+ *
+ * Allocations that are too big to fit in a chunk get their own block from the heap.  These
+ * "large blocks" are kept on a stack so they can be freed in reverse order of allocation when
+ * rewinding to a mark, or all at once when the arena is reset or deleted.
+ *
+ * Each thread's scratch arena is kept in thread-local storage and deleted by the thread-local
+ * data key's destructor when the thread dies.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.  Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "arena.h"
+#include "limit.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes in a chunk (including the chunk header).
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_BYTES 4096
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Alignment of blocks returned by le_arena_Alloc().  Must be a power of two.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ALIGNMENT 8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Round a number up to the next multiple of ALIGNMENT.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ALIGN_UP(n) (((n) + (ALIGNMENT - 1)) & ~((uintptr_t)(ALIGNMENT - 1)))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunk of memory that an arena allocates from.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;     ///< Used to link into the arena's chunk list.
+    uint8_t data[];         ///< Start of the allocatable space.
+}
+Chunk_t;
+
+
+/// Number of bytes that can be allocated from a chunk.
+#define CHUNK_CAPACITY (CHUNK_BYTES - sizeof(Chunk_t))
+
+/// Largest allocation that is guaranteed to fit in a chunk, regardless of the alignment of the
+/// chunk's data.  Anything bigger than this gets a large block of its own.
+#define MAX_CHUNK_ALLOC (CHUNK_CAPACITY - ALIGNMENT)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of a large block.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct LargeBlock
+{
+    struct LargeBlock* prevPtr;     ///< Previously allocated large block (NULL if none).
+}
+LargeBlock_t;
+
+
+/// Offset of the allocatable space in a large block.
+#define LARGE_BLOCK_HEADER_BYTES ALIGN_UP(sizeof(LargeBlock_t))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Arena object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_arena
+{
+    char name[LIMIT_MAX_MEM_POOL_NAME_BYTES];   ///< Name of the arena (for diagnostics).
+    le_sls_List_t chunkList;        ///< All chunks owned by the arena, in the order they are used.
+    Chunk_t* currentChunkPtr;       ///< Chunk being allocated from (NULL if none yet).
+    size_t offset;                  ///< Offset of the next free byte in the current chunk.
+    LargeBlock_t* largeBlockPtr;    ///< Top of the stack of large blocks (NULL if empty).
+}
+Arena_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Arena objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ArenaPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which chunks are allocated.  Shared by all arenas.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ChunkPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread-local data key for the thread's scratch arena.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t ScratchKey;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Frees large blocks from the top of an arena's large block stack until a given block is on top.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FreeLargeBlocks
+(
+    Arena_t* arenaPtr,
+    LargeBlock_t* stopPtr   ///< Block to stop at (NULL to free them all).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (arenaPtr->largeBlockPtr != stopPtr)
+    {
+        LE_ASSERT(arenaPtr->largeBlockPtr != NULL);
+
+        LargeBlock_t* blockPtr = arenaPtr->largeBlockPtr;
+        arenaPtr->largeBlockPtr = blockPtr->prevPtr;
+        free(blockPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a large block and pushes it onto an arena's large block stack.
+ *
+ * @return Pointer to the allocatable space in the block.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* AllocLarge
+(
+    Arena_t* arenaPtr,
+    size_t size
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LargeBlock_t* blockPtr = malloc(LARGE_BLOCK_HEADER_BYTES + size);
+
+    LE_ASSERT(blockPtr != NULL);
+
+    blockPtr->prevPtr = arenaPtr->largeBlockPtr;
+    arenaPtr->largeBlockPtr = blockPtr;
+
+    return ((uint8_t*)blockPtr) + LARGE_BLOCK_HEADER_BYTES;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves an arena on to the next chunk in its chunk list, adding a new chunk to the end of the list
+ * if there are no more.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NextChunk
+(
+    Arena_t* arenaPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr;
+
+    if (arenaPtr->currentChunkPtr == NULL)
+    {
+        linkPtr = le_sls_Peek(&arenaPtr->chunkList);
+    }
+    else
+    {
+        linkPtr = le_sls_PeekNext(&arenaPtr->chunkList, &arenaPtr->currentChunkPtr->link);
+    }
+
+    if (linkPtr == NULL)
+    {
+        Chunk_t* chunkPtr = le_mem_ForceAlloc(ChunkPool);
+        chunkPtr->link = LE_SLS_LINK_INIT;
+        le_sls_Queue(&arenaPtr->chunkList, &chunkPtr->link);
+        linkPtr = &chunkPtr->link;
+    }
+
+    arenaPtr->currentChunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+    arenaPtr->offset = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes the offset of the first suitably aligned byte at or after a given offset in a chunk.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t AlignOffset
+(
+    Chunk_t* chunkPtr,
+    size_t offset
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uintptr_t addr = (uintptr_t)(chunkPtr->data + offset);
+
+    return offset + (ALIGN_UP(addr) - addr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread-local data destructor for scratch arenas.  Called when a thread dies.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ScratchDestructor
+(
+    void* arenaPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_arena_Delete(arenaPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the arena module.
+ *
+ * This should be called by liblegato's init.c module at start-up.
+ */
+//--------------------------------------------------------------------------------------------------
+void arena_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ArenaPool = le_mem_CreatePool("Arena", sizeof(Arena_t));
+    ChunkPool = le_mem_CreatePool("ArenaChunk", CHUNK_BYTES);
+
+    // Chunks are big, and arenas tend to be used in bursts, so let idle chunks go back to
+    // the system.
+    le_mem_SetTrimWatermarks(ChunkPool, 4, 16);
+
+    LE_ASSERT(pthread_key_create(&ScratchKey, ScratchDestructor) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an empty arena.
+ *
+ * @return Reference to the arena.
+ */
+//--------------------------------------------------------------------------------------------------
+le_arena_Ref_t le_arena_Create
+(
+    const char* name        ///< [IN] Name of the arena (used for diagnostics only).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Arena_t* arenaPtr = le_mem_ForceAlloc(ArenaPool);
+
+    if (le_utf8_Copy(arenaPtr->name, name, sizeof(arenaPtr->name), NULL) == LE_OVERFLOW)
+    {
+        LE_WARN("Arena name '%s' truncated to '%s'.", name, arenaPtr->name);
+    }
+
+    arenaPtr->chunkList = LE_SLS_LIST_INIT;
+    arenaPtr->currentChunkPtr = NULL;
+    arenaPtr->offset = 0;
+    arenaPtr->largeBlockPtr = NULL;
+
+    return arenaPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes an arena, releasing all memory allocated from it.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_arena_Delete
+(
+    le_arena_Ref_t arena    ///< [IN] The arena.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    FreeLargeBlocks(arena, NULL);
+
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&arena->chunkList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Chunk_t, link));
+    }
+
+    le_mem_Release(arena);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a block of memory from an arena.  The block is aligned for any of the C basic types
+ * and its contents are not initialized.
+ *
+ * @return Pointer to the block (never NULL).
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_arena_Alloc
+(
+    le_arena_Ref_t arena,   ///< [IN] The arena.
+    size_t size             ///< [IN] Number of bytes to allocate.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (size > MAX_CHUNK_ALLOC)
+    {
+        return AllocLarge(arena, size);
+    }
+
+    if (arena->currentChunkPtr == NULL)
+    {
+        NextChunk(arena);
+    }
+
+    size_t start = AlignOffset(arena->currentChunkPtr, arena->offset);
+
+    if (start + size > CHUNK_CAPACITY)
+    {
+        NextChunk(arena);
+        start = AlignOffset(arena->currentChunkPtr, 0);
+    }
+
+    arena->offset = start + size;
+
+    return arena->currentChunkPtr->data + start;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies a null-terminated string into an arena.
+ *
+ * @return Pointer to the copy (never NULL).
+ */
+//--------------------------------------------------------------------------------------------------
+char* le_arena_StrDup
+(
+    le_arena_Ref_t arena,   ///< [IN] The arena.
+    const char* strPtr      ///< [IN] The string to copy.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t size = strlen(strPtr) + 1;
+    char* copyPtr = le_arena_Alloc(arena, size);
+
+    memcpy(copyPtr, strPtr, size);
+
+    return copyPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases everything that has been allocated from an arena.  The arena's chunks are kept for
+ * re-use.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_arena_Reset
+(
+    le_arena_Ref_t arena    ///< [IN] The arena.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    FreeLargeBlocks(arena, NULL);
+
+    // The next allocation will start over at the first chunk in the list.
+    arena->currentChunkPtr = NULL;
+    arena->offset = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current position of an arena, for later use with le_arena_Rewind().
+ *
+ * @return The mark.
+ */
+//--------------------------------------------------------------------------------------------------
+le_arena_Mark_t le_arena_GetMark
+(
+    le_arena_Ref_t arena    ///< [IN] The arena.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_arena_Mark_t mark =
+    {
+        .chunkPtr = arena->currentChunkPtr,
+        .offset = arena->offset,
+        .largeBlockPtr = arena->largeBlockPtr
+    };
+
+    return mark;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases everything that has been allocated from an arena since a given mark was taken.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_arena_Rewind
+(
+    le_arena_Ref_t arena,   ///< [IN] The arena.
+    le_arena_Mark_t mark    ///< [IN] Mark obtained from le_arena_GetMark().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    FreeLargeBlocks(arena, mark.largeBlockPtr);
+
+    // Chunks after the marked one stay on the chunk list and will be moved on to again when
+    // the marked one fills up.
+    arena->currentChunkPtr = mark.chunkPtr;
+    arena->offset = mark.offset;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's scratch arena.  See @ref arena_scratch.
+ *
+ * @return Reference to the arena.
+ */
+//--------------------------------------------------------------------------------------------------
+le_arena_Ref_t le_arena_GetScratch
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_arena_Ref_t arena = pthread_getspecific(ScratchKey);
+
+    if (arena == NULL)
+    {
+        arena = le_arena_Create("Scratch");
+
+        LE_ASSERT(pthread_setspecific(ScratchKey, arena) == 0);
+    }
+
+    return arena;
+}
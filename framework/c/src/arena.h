@@ -0,0 +1,27 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file arena.h
+ *
+ * Interfaces exported by the arena allocator to other modules inside the Legato framework
+ * implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc.  Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef ARENA_H_INCLUDE_GUARD
+#define ARENA_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the arena module.
+ *
+ * Must be called exactly once at start-up before any other arena functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void arena_Init
+(
+    void
+);
+
+#endif // ARENA_H_INCLUDE_GUARD
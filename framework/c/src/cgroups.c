@@ -19,7 +19,16 @@
  * Cgroup sub-system names.
  */
 //--------------------------------------------------------------------------------------------------
-static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] = {"cpu,cpuacct", "memory", "freezer"};
+static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] =
+    {"cpu,cpuacct", "memory", "freezer", "cpuset"};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sub-systems that the system can do without.  Not all kernels are built with cpuset support.
+ */
+//--------------------------------------------------------------------------------------------------
+static const bool IsSubSysOptional[CGRP_NUM_SUBSYSTEMS] = {false, false, false, true};
 
 
 //--------------------------------------------------------------------------------------------------
@@ -71,6 +80,15 @@ static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] = {"cpu,cpuacct", "memory", "
 #define FREEZE_STATE_FILENAME       "freezer.state"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cpuset CPUs and memory nodes files.  Both must be set before processes can be added to a cpuset.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CPUSET_CPUS_FILENAME        "cpuset.cpus"
+#define CPUSET_MEMS_FILENAME        "cpuset.mems"
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum digits in a cgroup integer value.
@@ -89,10 +107,18 @@ static const char* SubSysName[CGRP_NUM_SUBSYSTEMS] = {"cpu,cpuacct", "memory", "
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Checks if all cgroup subsystems are mounted.
+ * Maximum number of bytes in a cpuset's list of CPUs or memory nodes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_CPUSET_LIST_BYTES       256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if all the required cgroup subsystems are mounted.
  *
  * @return
- *      true if all subsystems are mounted.
+ *      true if all required subsystems are mounted.
  *      false otherwise.
  */
 //--------------------------------------------------------------------------------------------------
@@ -105,6 +131,11 @@ static bool IsAllSubSysMounted
 
     for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
     {
+        if (IsSubSysOptional[subSys])
+        {
+            continue;
+        }
+
         char dir[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
 
         LE_ASSERT(le_path_Concat("/", dir, sizeof(dir), SubSysName[subSys], (char*)NULL) == LE_OK);
@@ -121,7 +152,7 @@ static bool IsAllSubSysMounted
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Setup a separate cgroup hierarchy for each supported subsystem.
+ * Setup a separate cgroup hierarchy for each supported subsystem that isn't already mounted.
  */
 //--------------------------------------------------------------------------------------------------
 static void MountSubSys
@@ -137,10 +168,21 @@ static void MountSubSys
 
         LE_ASSERT(le_path_Concat("/", dir, sizeof(dir), SubSysName[subSys], (char*)NULL) == LE_OK);
 
+        if (fs_IsMounted(SubSysName[subSys], dir))
+        {
+            continue;
+        }
+
         LE_ASSERT(le_dir_Make(dir, S_IRWXU) != LE_FAULT);
 
-        LE_FATAL_IF(mount(SubSysName[subSys], dir, "cgroup", 0, SubSysName[subSys]) != 0,
-                    "Could not mount cgroup subsystem '%s'.  %m.", SubSysName[subSys]);
+        if (mount(SubSysName[subSys], dir, "cgroup", 0, SubSysName[subSys]) != 0)
+        {
+            LE_FATAL_IF(!IsSubSysOptional[subSys],
+                        "Could not mount cgroup subsystem '%s'.  %m.", SubSysName[subSys]);
+
+            LE_WARN("Could not mount optional cgroup subsystem '%s'.  %m.", SubSysName[subSys]);
+            continue;
+        }
 
         LE_INFO("Mounted cgroup hierarchy for subsystem '%s'.", SubSysName[subSys]);
     }
@@ -184,6 +226,11 @@ void cgrp_Init
 
             MountSubSys();
         }
+        else
+        {
+            // Mount any optional subsystems that weren't mounted before.
+            MountSubSys();
+        }
     }
 }
 
@@ -431,6 +478,55 @@ static void RemoveTrailingWhiteSpace
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives a newly created cpuset the same CPUs and memory nodes as its parent.  A new cpuset starts
+ * out with none, and no process can be added to it until it has some.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t InitCpuset
+(
+    const char* cgroupNamePtr       ///< [IN] Name of the new cgroup.
+)
+{
+    // The parent of a top-level cgroup is the root of the hierarchy.
+    char parentName[LIMIT_MAX_PATH_BYTES];
+    LE_ASSERT(le_utf8_Copy(parentName, cgroupNamePtr, sizeof(parentName), NULL) == LE_OK);
+
+    char* lastSepPtr = strrchr(parentName, '/');
+    if (lastSepPtr != NULL)
+    {
+        *lastSepPtr = '\0';
+    }
+    else
+    {
+        parentName[0] = '\0';
+    }
+
+    static const char* fileNames[] = {CPUSET_CPUS_FILENAME, CPUSET_MEMS_FILENAME};
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(fileNames); i++)
+    {
+        char value[MAX_CPUSET_LIST_BYTES];
+
+        if (   (GetValue(CGRP_SUBSYS_CPUSET, parentName, fileNames[i], value, sizeof(value))
+                    != LE_OK)
+            || (WriteToFile(CGRP_SUBSYS_CPUSET, cgroupNamePtr, fileNames[i], value) != LE_OK) )
+        {
+            LE_ERROR("Could not copy %s to cpuset '%s'.", fileNames[i], cgroupNamePtr);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a cgroup with the specified name in the specified sub-system.  If the cgroup already
@@ -441,6 +537,8 @@ static void RemoveTrailingWhiteSpace
  * that is a sub-group of "Students".  Note that all parent groups must first exist before a
  * sub-group can be created.
  *
+ * A new cpuset is given all of its parent's CPUs and memory nodes.
+ *
  * @return
  *      LE_OK if successful.
  *      LE_DUPLICATE if the cgroup already exists.
@@ -472,6 +570,11 @@ le_result_t cgrp_Create
         return LE_FAULT;
     }
 
+    if (subsystem == CGRP_SUBSYS_CPUSET)
+    {
+        return InitCpuset(cgroupNamePtr);
+    }
+
     return LE_OK;
 }
 
@@ -790,6 +893,34 @@ const char* cgrp_SubSysName
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a sub-system can be used.  Optional sub-systems may not be available, the others
+ * always are once cgrp_Init() has been called.
+ *
+ * @return
+ *      true if cgroups can be created in the sub-system.
+ *      false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cgrp_IsSubSysAvailable
+(
+    cgrp_SubSys_t subsystem         ///< [IN] Sub-system.
+)
+{
+    if (!IsSubSysOptional[subsystem])
+    {
+        return true;
+    }
+
+    char dir[LIMIT_MAX_PATH_BYTES] = ROOT_PATH;
+
+    LE_ASSERT(le_path_Concat("/", dir, sizeof(dir), SubSysName[subsystem], (char*)NULL) == LE_OK);
+
+    return fs_IsMounted(SubSysName[subsystem], dir);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the cpu share of a cgroup.
@@ -898,6 +1029,33 @@ page rounding or memory availability.", cgroupNamePtr, readLimitStr, limitStr);
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the CPUs that the processes in a cgroup can run on.
+ *
+ * The CPUs must be a subset of those allowed to the parent cgroup.  A newly created cgroup is
+ * allowed to use all of its parent's CPUs.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_cpuset_SetCpus
+(
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup to set the CPUs for.
+    const char* cpuListPtr          ///< [IN] List of CPUs in the kernel's format (e.g., "0-1,3").
+)
+{
+    if (WriteToFile(CGRP_SUBSYS_CPUSET, cgroupNamePtr, CPUSET_CPUS_FILENAME, cpuListPtr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Freezes all the tasks in a cgroup.  This is an asynchronous function call that returns
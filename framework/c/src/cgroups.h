@@ -49,6 +49,10 @@
  * On system start-up the cgrp_Init() function must be called to setup the hierarchies.  Cgroups are
  * by default non-persistent so cgrp_Init() must called every time the system starts.
  *
+ * The cpuset sub-system is optional because not all kernels are built with it.  If it can't be
+ * mounted a warning is logged and cgrp_IsSubSysAvailable() returns false for it, in which case no
+ * cgroups should be created in it.
+ *
  *
  * @section c_cgrp_create Creating cgroups
  *
@@ -73,6 +77,13 @@
  *
  *      // Set the memory limit for the cgroup in the memory sub-system.
  *      cgrp_mem_SetLimit("MyApp", 100);
+ *
+ *      // Restrict the cgroup in the cpuset sub-system to the first two CPUs.
+ *      if (cgrp_IsSubSysAvailable(CGRP_SUBSYS_CPUSET))
+ *      {
+ *          cgrp_Create(CGRP_SUBSYS_CPUSET, "MyApp");
+ *          cgrp_cpuset_SetCpus("MyApp", "0-1");
+ *      }
  * @endcode
  *
  *
@@ -114,6 +125,7 @@ typedef enum
     CGRP_SUBSYS_CPU = 0,        ///< CPU sub-system.
     CGRP_SUBSYS_MEM,            ///< Memory sub-system.
     CGRP_SUBSYS_FREEZE,         ///< Freezer sub-system.
+    CGRP_SUBSYS_CPUSET,         ///< Cpuset sub-system (optional, see cgrp_IsSubSysAvailable()).
     CGRP_NUM_SUBSYSTEMS         ///< Number of sub-systems.  Must be the last item in this enum.
 }
 cgrp_SubSys_t;
@@ -295,6 +307,22 @@ const char* cgrp_SubSysName
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a sub-system can be used.  Optional sub-systems (see @ref c_cgrp_init) may not be
+ * available, the others always are once cgrp_Init() has been called.
+ *
+ * @return
+ *      true if cgroups can be created in the sub-system.
+ *      false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool cgrp_IsSubSysAvailable
+(
+    cgrp_SubSys_t subsystem         ///< [IN] Sub-system.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the cpu share of a cgroup.
@@ -358,6 +386,25 @@ le_result_t cgrp_mem_SetLimit
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the CPUs that the processes in a cgroup can run on.
+ *
+ * The CPUs must be a subset of those allowed to the parent cgroup.  A newly created cgroup is
+ * allowed to use all of its parent's CPUs.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t cgrp_cpuset_SetCpus
+(
+    const char* cgroupNamePtr,      ///< [IN] Name of the cgroup to set the CPUs for.
+    const char* cpuListPtr          ///< [IN] List of CPUs in the kernel's format (e.g., "0-1,3").
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Freezes all the tasks in a cgroup.  This is an asynchronous function call that returns
@@ -0,0 +1,462 @@
+/** @file cond.c
+ *
+ * Legato @ref c_cond implementation.
+ *
+ * Each condition variable is represented by a <b> Condition Variable object </b>.  They are
+ * dynamically allocated from the <b> Condition Variable Pool </b> and are stored on the
+ * <b> Condition Variable List </b> (for the diagnostic tools) until they are destroyed.
+ *
+ * The waiting is done directly on a futex.  The futex word is a sequence number that every signal
+ * and broadcast increments.  A waiting thread:
+ *  -# increments the number of waiters,
+ *  -# reads the sequence number,
+ *  -# unlocks the mutex,
+ *  -# waits on the futex for as long as the sequence number hasn't changed,
+ *  -# decrements the number of waiters, and locks the mutex again.
+ *
+ * A signalling thread increments the sequence number and then, only if there are any waiters,
+ * wakes up one of them (or all of them, for a broadcast).  Because the waiter counts itself before
+ * it reads the sequence number, and the signaller changes the sequence number before it looks at
+ * the count, either the signaller sees the waiter, or the waiter sees the new sequence number and
+ * doesn't go to sleep.  A signal is never lost, although some wake-ups may be spurious.
+ *
+ * le_cond_WaitWithTimeOut() works out an absolute CLOCK_MONOTONIC deadline once, up front, and
+ * waits with FUTEX_WAIT_BITSET, which takes an absolute timeout.  So it isn't affected by changes
+ * to the time of day, and a wait that has to be restarted (e.g., after a signal handler ran)
+ * doesn't get a fresh timeout.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include "limit.h"
+#include "cond.h"
+#include "mutex.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+
+// ==============================
+//  PRIVATE DATA
+// ==============================
+
+/// Number of objects in the Condition Variable Pool to start with.
+#define DEFAULT_POOL_SIZE 4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A counter that increments every time a change is made to the Condition Variable List.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CondListChangeCount = 0;
+static size_t* CondListChangeCountRef = &CondListChangeCount;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Condition Variable Pool.
+ *
+ * Memory pool from which Condition Variable objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CondPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Condition Variable List.
+ *
+ * List on which all Condition Variable objects in the process are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t CondList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Condition Variable List Mutex.
+ *
+ * Basic pthreads mutex used to protect the Condition Variable List from multi-threaded race
+ * conditions.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t CondListMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+// ==============================
+//  PRIVATE FUNCTIONS
+// ==============================
+
+/// Lock the Condition Variable List Mutex.
+#define LOCK_COND_LIST()    LE_ASSERT(pthread_mutex_lock(&CondListMutex) == 0)
+
+/// Unlock the Condition Variable List Mutex.
+#define UNLOCK_COND_LIST()  LE_ASSERT(pthread_mutex_unlock(&CondListMutex) == 0)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether an absolute CLOCK_MONOTONIC deadline has passed.
+ *
+ * @return true if it has passed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsDeadlinePassed
+(
+    const struct timespec*  deadlinePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec now;
+
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &now) == 0);
+
+    return (   (now.tv_sec > deadlinePtr->tv_sec)
+            || ((now.tv_sec == deadlinePtr->tv_sec) && (now.tv_nsec >= deadlinePtr->tv_nsec)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits on a condition variable's futex for as long as its sequence number is still the one given.
+ *
+ * @return
+ *      - LE_OK         Woken up, or the sequence number had already changed.
+ *      - LE_TIMEOUT    The deadline passed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FutexWait
+(
+    Cond_t*                 condPtr,
+    uint32_t                seq,
+    const struct timespec*  deadlinePtr ///< Absolute CLOCK_MONOTONIC deadline, or NULL to wait
+                                        ///< forever.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (;;)
+    {
+        if (syscall(SYS_futex,
+                    &condPtr->seq,
+                    FUTEX_WAIT_BITSET_PRIVATE,
+                    seq,
+                    deadlinePtr,
+                    NULL,
+                    FUTEX_BITSET_MATCH_ANY) == 0)
+        {
+            break;
+        }
+
+        if (errno == ETIMEDOUT)
+        {
+            return LE_TIMEOUT;
+        }
+        else if (errno == EINTR)
+        {
+            // Interrupted by a signal handler.  Unless the sequence number has changed, go back
+            // to sleep; the kernel returns ETIMEDOUT straight away if the deadline has passed.
+            if (__atomic_load_n(&condPtr->seq, __ATOMIC_SEQ_CST) == seq)
+            {
+                continue;
+            }
+            break;
+        }
+        else if (errno == EAGAIN)
+        {
+            // The sequence number changed before this thread went to sleep.
+            break;
+        }
+        else
+        {
+            LE_FATAL("Futex wait on condition variable '%s' failed (%m).", condPtr->name);
+        }
+    }
+
+    // Woken up, but if that happened too late, report the timeout.
+    if ((deadlinePtr != NULL) && IsDeadlinePassed(deadlinePtr))
+    {
+        return LE_TIMEOUT;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wakes up to a given number of threads waiting on a condition variable.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Wake
+(
+    Cond_t* condPtr,
+    int     numToWake
+)
+//--------------------------------------------------------------------------------------------------
+{
+    __atomic_add_fetch(&condPtr->seq, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&condPtr->numWaiters, __ATOMIC_SEQ_CST) != 0)
+    {
+        __atomic_add_fetch(&condPtr->signalCount, 1, __ATOMIC_RELAXED);
+
+        if (syscall(SYS_futex, &condPtr->seq, FUTEX_WAKE_PRIVATE, numToWake, NULL, NULL, 0) < 0)
+        {
+            LE_FATAL("Futex wake on condition variable '%s' failed (%m).", condPtr->name);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits on a condition variable, with the mutex unlocked.
+ *
+ * @return
+ *      - LE_OK         Woken up.
+ *      - LE_TIMEOUT    The timeout elapsed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Wait
+(
+    Cond_t*                 condPtr,
+    Mutex_t*                mutexPtr,
+    const struct timespec*  deadlinePtr ///< Absolute CLOCK_MONOTONIC deadline, or NULL to wait
+                                        ///< forever.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((mutexPtr->lockingThreadRef != le_thread_GetCurrent()) || (mutexPtr->lockCount != 1))
+    {
+        LE_FATAL("Thread '%s' waiting on condition variable '%s' must hold mutex '%s'"
+                 " exactly once.",
+                 le_thread_GetMyName(),
+                 condPtr->name,
+                 mutexPtr->name);
+    }
+
+    __atomic_add_fetch(&condPtr->waitCount, 1, __ATOMIC_RELAXED);
+
+    // Count this thread as a waiter before reading the sequence number (see the top of the file).
+    __atomic_add_fetch(&condPtr->numWaiters, 1, __ATOMIC_SEQ_CST);
+    uint32_t seq = __atomic_load_n(&condPtr->seq, __ATOMIC_SEQ_CST);
+
+    le_mutex_Unlock(mutexPtr);
+
+    le_result_t result = FutexWait(condPtr, seq, deadlinePtr);
+
+    __atomic_sub_fetch(&condPtr->numWaiters, 1, __ATOMIC_SEQ_CST);
+
+    le_mutex_Lock(mutexPtr);
+
+    if (result == LE_TIMEOUT)
+    {
+        __atomic_add_fetch(&condPtr->timeoutCount, 1, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+
+// ==============================
+//  INTRA-FRAMEWORK FUNCTIONS
+// ==============================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the condition variable list; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* cond_GetCondList
+(
+    void
+)
+{
+    return (&CondList);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the condition variable list change counter; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t** cond_GetCondListChgCntRef
+(
+    void
+)
+{
+    return (&CondListChangeCountRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Condition Variable module.
+ *
+ * This function must be called exactly once at process start-up before any other condition
+ * variable module functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void cond_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CondPoolRef = le_mem_CreatePool("cond", sizeof(Cond_t));
+    le_mem_ExpandPool(CondPoolRef, DEFAULT_POOL_SIZE);
+}
+
+
+// ==============================
+//  PUBLIC API FUNCTIONS
+// ==============================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a condition variable.
+ *
+ * @return  Returns a reference to the condition variable.
+ *
+ * @note Terminates the process on failure, no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_cond_Ref_t le_cond_Create
+(
+    const char* nameStr     ///< [in] Name of the condition variable.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Cond_t* condPtr = le_mem_ForceAlloc(CondPoolRef);
+    condPtr->condListLink = LE_DLS_LINK_INIT;
+    condPtr->seq = 0;
+    condPtr->numWaiters = 0;
+    condPtr->waitCount = 0;
+    condPtr->timeoutCount = 0;
+    condPtr->signalCount = 0;
+    if (le_utf8_Copy(condPtr->name, nameStr, sizeof(condPtr->name), NULL) == LE_OVERFLOW)
+    {
+        LE_WARN("Condition variable name '%s' truncated to '%s'.", nameStr, condPtr->name);
+    }
+
+    // Add the condition variable to the process's Condition Variable List.
+    LOCK_COND_LIST();
+    le_dls_Queue(&CondList, &condPtr->condListLink);
+    CondListChangeCount++;
+    UNLOCK_COND_LIST();
+
+    return condPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a condition variable.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Delete
+(
+    le_cond_Ref_t condRef   ///< [in] Condition variable reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (__atomic_load_n(&condRef->numWaiters, __ATOMIC_SEQ_CST) != 0)
+    {
+        LE_FATAL("Condition variable '%s' deleted while threads are still waiting on it!",
+                 condRef->name);
+    }
+
+    // Remove the Condition Variable object from the Condition Variable List.
+    LOCK_COND_LIST();
+    le_dls_Remove(&CondList, &condRef->condListLink);
+    CondListChangeCount++;
+    UNLOCK_COND_LIST();
+
+    le_mem_Release(condRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait on a condition variable.
+ *
+ * The mutex must be locked (once) by the calling thread.  It is unlocked while waiting and locked
+ * again before this function returns.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Wait
+(
+    le_cond_Ref_t   condRef,    ///< [in] Condition variable reference.
+    le_mutex_Ref_t  mutexRef    ///< [in] Mutex protecting the condition.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    (void)Wait(condRef, mutexRef, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait on a condition variable with a limit on how long to wait.
+ *
+ * The mutex must be locked (once) by the calling thread.  It is unlocked while waiting and locked
+ * again before this function returns, even if it timed out.
+ *
+ * @return
+ *      - LE_OK         Woken up (check the condition).
+ *      - LE_TIMEOUT    timeToWait elapsed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_cond_WaitWithTimeOut
+(
+    le_cond_Ref_t   condRef,    ///< [in] Condition variable reference.
+    le_mutex_Ref_t  mutexRef,   ///< [in] Mutex protecting the condition.
+    le_clk_Time_t   timeToWait  ///< [in] Time to wait.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec deadline;
+
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &deadline) == 0);
+
+    deadline.tv_sec += timeToWait.sec;
+    deadline.tv_nsec += timeToWait.usec * 1000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec += deadline.tv_nsec / 1000000000;
+        deadline.tv_nsec %= 1000000000;
+    }
+
+    return Wait(condRef, mutexRef, &deadline);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wake up one of the threads waiting on a condition variable, if any are.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Signal
+(
+    le_cond_Ref_t condRef   ///< [in] Condition variable reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Wake(condRef, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wake up all of the threads waiting on a condition variable.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_cond_Broadcast
+(
+    le_cond_Ref_t condRef   ///< [in] Condition variable reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Wake(condRef, INT_MAX);
+}
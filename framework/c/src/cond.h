@@ -0,0 +1,68 @@
+/** @file cond.h
+ *
+ * Condition variable module's intra-framework header file.  This file exposes type definitions and
+ * function interfaces to other modules inside the framework implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#ifndef LEGATO_SRC_COND_H_INCLUDE_GUARD
+#define LEGATO_SRC_COND_H_INCLUDE_GUARD
+
+#include "limit.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Condition Variable object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_cond
+{
+    le_dls_Link_t   condListLink;   ///< Used to link onto the process's Condition Variable List.
+    uint32_t        seq;            ///< Futex word.  Incremented by every signal and broadcast.
+    uint32_t        numWaiters;     ///< Number of threads waiting (or about to).
+    size_t          waitCount;      ///< Number of waits.
+    size_t          timeoutCount;   ///< Number of waits that timed out.
+    size_t          signalCount;    ///< Number of signals and broadcasts that had waiters to wake.
+    char            name[LIMIT_MAX_COND_NAME_BYTES]; ///< The name of the condition variable.
+}
+Cond_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the condition variable list; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* cond_GetCondList
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the condition variable list change counter; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t** cond_GetCondListChgCntRef
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Condition Variable module.
+ *
+ * This function must be called exactly once at process start-up before any other condition
+ * variable module functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void cond_Init
+(
+    void
+);
+
+
+#endif /* LEGATO_SRC_COND_H_INCLUDE_GUARD */
@@ -294,6 +294,7 @@ void dstr_Init
 
     DynamicStringPoolRef = le_mem_CreatePool(CFG_DSTR_POOL_NAME, sizeof(Dstr_t));
     le_mem_SetNumObjsToForce(DynamicStringPoolRef, 100);    // Grow in chunks of 100 blocks.
+    le_mem_SetTrimWatermarks(DynamicStringPoolRef, 3000, 6000);  // Give back memory after bursts.
 
     // For now (until pool config is added to the framework), set a minimum size.
     if (le_mem_GetObjectCount(DynamicStringPoolRef) != 0)
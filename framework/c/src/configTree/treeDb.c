@@ -68,6 +68,13 @@
  *  Shadow Trees don't have handlers, request queues, write iterator references or read iterator
  *  counts.
  *
+ *  Shadow nodes are short-lived and are all thrown away together, so rather than coming from the
+ *  node pool they are allocated from an arena owned by their shadow tree.  The arena is created
+ *  along with the shadow tree, and its reference is kept next to the shadow root node.
+ *  "Releasing" a shadow node just runs the node destructor on it (to drop its strings and children
+ *  and unlink it from its parent).  The memory itself is reclaimed in one go by deleting the arena
+ *  when the shadow tree is released.
+ *
  *  <b>Event Handler Registration:</b>
  *
  *  The config tree allows clients to register callbacks to be notified if certian sections of a
@@ -277,6 +284,21 @@ Node_t;
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  The root node of a shadow tree, along with the arena that all of that tree's nodes come from.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct
+{
+    Node_t node;                     ///< The root node itself.
+    le_arena_Ref_t arenaRef;         ///< The arena that the shadow tree's nodes come from.
+}
+ShadowRoot_t;
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Structure used to keep track of the trees loaded in the configTree daemon.
@@ -544,20 +566,17 @@ static void ClearDeletedFlag
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Allocate a new node and fill out it's default information.
+ *  Fill out a freshly allocated node with it's default information.
  *
- *  @return The newly created node.
+ *  @return The node that was passed in.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t NewNode
+static tdb_NodeRef_t InitNode
 (
-    void
+    tdb_NodeRef_t newNodeRef  ///< [IN] The node to initialize.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Create a new blank node.
-    tdb_NodeRef_t newNodeRef = le_mem_ForceAlloc(NodePoolRef);
-
     newNodeRef->parentRef = NULL;
     newNodeRef->type = LE_CFG_TYPE_EMPTY;
     ClearFlags(newNodeRef);
@@ -572,6 +591,59 @@ static tdb_NodeRef_t NewNode
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Allocate a new node and fill out it's default information.  Shadow nodes come from their shadow
+ *  tree's arena, all others come from the node pool.
+ *
+ *  @note The caller is responsible for setting the shadow flag on shadow nodes.
+ *
+ *  @return The newly created node.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t NewNode
+(
+    le_arena_Ref_t arenaRef  ///< [IN] The shadow tree's arena, or NULL for a regular node.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (arenaRef != NULL)
+    {
+        return InitNode(le_arena_Alloc(arenaRef, sizeof(Node_t)));
+    }
+
+    return InitNode(le_mem_ForceAlloc(NodePoolRef));
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Find the arena that a shadow node was allocated from, by way of the root of its shadow tree.
+ *
+ *  @return The shadow tree's arena.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_arena_Ref_t GetShadowArena
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] A node in the shadow tree.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(IsShadow(nodeRef));
+
+    while (nodeRef->parentRef != NULL)
+    {
+        nodeRef = nodeRef->parentRef;
+    }
+
+    return CONTAINER_OF(nodeRef, ShadowRoot_t, node)->arenaRef;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  The node destructor function.  This will take care of freeing a node's string values and any
@@ -616,7 +688,16 @@ static void NodeDestructor
                 {
                     tdb_NodeRef_t nextChildRef = tdb_GetNextSiblingNode(childRef);
 
-                    le_mem_Release(childRef);
+                    // Children of a shadow node are shadow nodes too, and don't belong to the
+                    // node pool.
+                    if (IsShadow(childRef))
+                    {
+                        NodeDestructor(childRef);
+                    }
+                    else
+                    {
+                        le_mem_Release(childRef);
+                    }
                     childRef = nextChildRef;
                 }
             }
@@ -638,20 +719,43 @@ static void NodeDestructor
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Allocate a new node from our pool, and turn it into a shadow of an existing node.
- *
- *  @return A new node that shadows the existing node.
+ *  Free a node, along with its strings and children.  Shadow nodes are only destructed here, their
+ *  memory goes back when their shadow tree's arena is deleted.
  */
 // -------------------------------------------------------------------------------------------------
-static tdb_NodeRef_t NewShadowNode
+static void ReleaseNode
 (
-    tdb_NodeRef_t nodeRef  ///< [IN] The node to shadow.
+    tdb_NodeRef_t nodeRef  ///< [IN] The node to free.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Allocate a new blank node.
-    tdb_NodeRef_t newShadowRef = NewNode();
+    if (IsShadow(nodeRef))
+    {
+        NodeDestructor(nodeRef);
+    }
+    else
+    {
+        le_mem_Release(nodeRef);
+    }
+}
 
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Turn a blank node into a shadow of an existing node.
+ *
+ *  @return The node that now shadows the existing node.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t MakeShadowNode
+(
+    tdb_NodeRef_t newShadowRef,  ///< [IN] The blank node to turn into a shadow.
+    tdb_NodeRef_t nodeRef        ///< [IN] The node to shadow.
+)
+// -------------------------------------------------------------------------------------------------
+{
     // Turn it into a shadow of the original node.  It's possible for nodeRef to be NULL.  We could
     // be creating a shadow node for which no original exists.  Which is the case when creating a
     // new path that didn't exist in the original tree.
@@ -677,6 +781,50 @@ static tdb_NodeRef_t NewShadowNode
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Allocate a new node from a shadow tree's arena, and turn it into a shadow of an existing node.
+ *
+ *  @return A new node that shadows the existing node.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t NewShadowNode
+(
+    le_arena_Ref_t arenaRef,  ///< [IN] The arena of the shadow tree the node will belong to.
+    tdb_NodeRef_t nodeRef     ///< [IN] The node to shadow.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    return MakeShadowNode(NewNode(arenaRef), nodeRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Create a new arena for a shadow tree, and allocate the tree's root node from it.
+ *
+ *  @return A new root node that shadows the existing root node.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t NewShadowRootNode
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The root node to shadow.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_arena_Ref_t arenaRef = le_arena_Create("shadowNodes");
+    ShadowRoot_t* rootPtr = le_arena_Alloc(arenaRef, sizeof(ShadowRoot_t));
+
+    rootPtr->arenaRef = arenaRef;
+
+    return MakeShadowNode(InitNode(&rootPtr->node), nodeRef);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Create a new node and insert it into the given node's children collection.
@@ -699,7 +847,7 @@ static tdb_NodeRef_t NewChildNode
     LE_ASSERT(nodeRef->type == LE_CFG_TYPE_STEM);
 
     // Create a new node.  Then set it's parent to the given node
-    tdb_NodeRef_t newRef = NewNode();
+    tdb_NodeRef_t newRef = NewNode(IsShadow(nodeRef) ? GetShadowArena(nodeRef) : NULL);
 
     newRef->parentRef = nodeRef;
     newRef->type = LE_CFG_TYPE_EMPTY;
@@ -770,11 +918,12 @@ static void ShadowChildren
 
     // Simply iterate through the original collection and add a new shadow child to our own
     // collection.
+    le_arena_Ref_t arenaRef = GetShadowArena(shadowParentRef);
     tdb_NodeRef_t originalChildRef = tdb_GetFirstChildNode(originalRef);
 
     while (originalChildRef != NULL)
     {
-        tdb_NodeRef_t newShadowRef = NewShadowNode(originalChildRef);
+        tdb_NodeRef_t newShadowRef = NewShadowNode(arenaRef, originalChildRef);
         newShadowRef->parentRef = shadowParentRef;
 
         le_dls_Queue(&shadowParentRef->info.children, &newShadowRef->siblingList);
@@ -901,7 +1050,7 @@ static tdb_NodeRef_t CreateNamedChild
         // new node.  So in that case free the node and return NULL.
         if (tdb_SetNodeName(childRef, nameRef) != LE_OK)
         {
-            le_mem_Release(childRef);
+            ReleaseNode(childRef);
             childRef = NULL;
         }
     }
@@ -1582,7 +1731,7 @@ tdb_TreeRef_t NewTree
     treeRef->isDeletePending = false;
     treeRef->originalTreeRef = NULL;
     treeRef->revisionId = 0;
-    treeRef->rootNodeRef = (rootNodeRef != NULL) ? rootNodeRef : NewNode();
+    treeRef->rootNodeRef = (rootNodeRef != NULL) ? rootNodeRef : NewNode(NULL);
     treeRef->activeReadCount = 0;
     treeRef->activeWriteIterRef = NULL;
     treeRef->requestList = LE_SLS_LIST_INIT;
@@ -1606,10 +1755,24 @@ static void TreeDestructor
 {
     tdb_TreeRef_t treeRef = (tdb_TreeRef_t)objectPtr;
 
+    // A shadow tree's nodes all live in its own arena, so look that up before the root goes.
+    le_arena_Ref_t arenaRef = NULL;
+
+    if (treeRef->originalTreeRef != NULL)
+    {
+        arenaRef = GetShadowArena(treeRef->rootNodeRef);
+    }
+
     // Kill the root node.
-    le_mem_Release(treeRef->rootNodeRef);
+    ReleaseNode(treeRef->rootNodeRef);
     treeRef->rootNodeRef = NULL;
 
+    // Nothing is using the shadow nodes anymore, so give all of their memory back at once.
+    if (arenaRef != NULL)
+    {
+        le_arena_Delete(arenaRef);
+    }
+
     // Sanity check, is the tree actually ready to clean up?
     LE_ASSERT(treeRef->activeReadCount == 0);
     LE_ASSERT(treeRef->activeWriteIterRef == NULL);
@@ -2477,7 +2640,7 @@ static void LoadTree
     // If this tree has no root, create it now.
     if (treeRef->rootNodeRef == NULL)
     {
-        treeRef->rootNodeRef = NewNode();
+        treeRef->rootNodeRef = NewNode(NULL);
     }
 
     // Ok, if we found a valid revision of the tree in the fs, try to load it now.
@@ -2510,7 +2673,7 @@ static void LoadTree
             {
                 LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
                 le_mem_Release(treeRef->rootNodeRef);
-                treeRef->rootNodeRef = NewNode();
+                treeRef->rootNodeRef = NewNode(NULL);
             }
 
             int retVal = -1;
@@ -2772,6 +2935,7 @@ void tdb_Init
     NodePoolRef = le_mem_CreatePool(CFG_NODE_POOL_NAME, sizeof(Node_t));
     le_mem_SetDestructor(NodePoolRef, NodeDestructor);
     le_mem_SetNumObjsToForce(NodePoolRef, 50);    // Grow in chunks of 50 blocks.
+    le_mem_SetTrimWatermarks(NodePoolRef, 1000, 2000);  // Give back memory after big deletes.
 
     // For now (until pool config is added to the framework), set a minimum size.
     if (le_mem_GetObjectCount(NodePoolRef) != 0)
@@ -2924,7 +3088,7 @@ tdb_TreeRef_t tdb_ShadowTree
 // -------------------------------------------------------------------------------------------------
 {
     LE_ASSERT(treeRef->originalTreeRef == NULL);
-    tdb_TreeRef_t shadowRef = NewTree(treeRef->name, NewShadowNode(treeRef->rootNodeRef));
+    tdb_TreeRef_t shadowRef = NewTree(treeRef->name, NewShadowRootNode(treeRef->rootNodeRef));
     shadowRef->originalTreeRef = treeRef;
 
     return shadowRef;
@@ -3719,7 +3883,7 @@ void tdb_SetEmpty
 
             // We don't remove the child from the list explicitly, because the destructor will take
             // care of that for us.
-            le_mem_Release(childRef);
+            ReleaseNode(childRef);
             childRef = nextChildRef;
         }
 
@@ -0,0 +1,666 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file coro.c Implementation of the Coroutine API.
+ *
+ * Each coroutine has its own stack, mapped with mmap() so that the memory is only committed as it
+ * is touched, with a guard page below it.  Switching between a coroutine and the Event Loop is done
+ * with swapcontext().
+ *
+ * Coroutines only ever run from a function that has been queued to the thread's Event Queue
+ * (RunCoroutine()), and always switch back to that same function when they stop.  So the
+ * thread's own stack is always at the top level of the Event Loop while a coroutine is running,
+ * and one coroutine never runs on top of another, or on top of a handler that is half way through
+ * changing something (e.g., a completion callback called while purging a session's transaction
+ * list).  This is why le_coro_Resume() queues the coroutine rather than switching to it directly.
+ *
+ * A coroutine's state moves like this:
+ *
+ *  - NEW -> READY when it is started,
+ *  - READY -> RUNNING when RunCoroutine() switches to it,
+ *  - RUNNING -> SUSPENDED when it calls le_coro_Suspend() (unless a resume is pending),
+ *  - RUNNING -> READY when it calls le_coro_Yield(),
+ *  - SUSPENDED -> READY when le_coro_Resume() is called for it,
+ *  - RUNNING -> DONE when its function returns, after which RunCoroutine() deletes it.
+ *
+ * Only coroutines in the READY state have a RunCoroutine() call in the Event Queue, and there is
+ * only ever one, so a coroutine can't be deleted while a call is queued for it.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.  Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "coro.h"
+#include "limit.h"
+#include "thread.h"
+
+#include <sys/mman.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default size of a coroutine's stack, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_STACK_SIZE  (64 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * When built with ThreadSanitizer, it has to be told about each stack switch, or it gets very
+ * confused about what each thread is doing.
+ */
+//--------------------------------------------------------------------------------------------------
+#if defined(__SANITIZE_THREAD__)
+void* __tsan_get_current_fiber(void);
+void* __tsan_create_fiber(unsigned flags);
+void __tsan_destroy_fiber(void* fiberPtr);
+void __tsan_switch_to_fiber(void* fiberPtr, unsigned flags);
+#define TSAN_GET_CURRENT_FIBER()        __tsan_get_current_fiber()
+#define TSAN_CREATE_FIBER()             __tsan_create_fiber(0)
+#define TSAN_DESTROY_FIBER(fiberPtr)    __tsan_destroy_fiber(fiberPtr)
+#define TSAN_SWITCH_TO_FIBER(fiberPtr)  __tsan_switch_to_fiber((fiberPtr), 0)
+#else
+#define TSAN_GET_CURRENT_FIBER()        NULL
+#define TSAN_CREATE_FIBER()             NULL
+#define TSAN_DESTROY_FIBER(fiberPtr)
+#define TSAN_SWITCH_TO_FIBER(fiberPtr)
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Coroutine object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_coro
+{
+    le_dls_Link_t link;                 ///< Used to link into the thread's coroutine list.
+    char name[LIMIT_MAX_COROUTINE_NAME_BYTES];  ///< Name of the coroutine (for diagnostics).
+    le_coro_Func_t mainFunc;            ///< Function to run in the coroutine.
+    void* contextPtr;                   ///< Value to pass to mainFunc.
+    le_thread_Ref_t threadRef;          ///< Thread that the coroutine belongs to.
+
+    enum
+    {
+        CORO_STATE_NEW,                 ///< Not started yet.
+        CORO_STATE_READY,               ///< RunCoroutine() has been queued for it.
+        CORO_STATE_RUNNING,             ///< Running.
+        CORO_STATE_SUSPENDED,           ///< Waiting for le_coro_Resume().
+        CORO_STATE_DONE                 ///< Its function has returned.
+    }
+    state;
+
+    bool isResumePending;               ///< le_coro_Resume() was called while it was running.
+
+    size_t stackSize;                   ///< Usable size of the stack, in bytes.
+    void* mapPtr;                       ///< Start of the stack's mapping (the guard page).
+    size_t mapSize;                     ///< Size of the stack's mapping, in bytes.
+    ucontext_t context;                 ///< Where the coroutine left off.
+    void* fiberPtr;                     ///< ThreadSanitizer's handle for the coroutine's stack.
+
+    le_timer_Ref_t timerRef;            ///< Timer used by le_coro_SleepMs() (NULL if none yet).
+    bool isTimerExpired;                ///< The timer has expired since the sleep started.
+
+    le_fdMonitor_Ref_t fdMonitorRef;    ///< FD Monitor used by le_coro_AwaitFd() (NULL if none).
+    short fdEvents;                     ///< Events reported to the FD Monitor (0 if none yet).
+}
+Coro_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Coroutine objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CoroPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a memory page, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t PageSize;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the running coroutine, which there must be.
+ *
+ * @return Pointer to the coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+static Coro_t* GetCurrentCoro
+(
+    const char* funcName    ///< [IN] Name of the API function that needs it (for error messages).
+)
+{
+    Coro_t* coroPtr = thread_GetCoroRecPtr()->currentRef;
+
+    LE_FATAL_IF(coroPtr == NULL, "%s() called from outside of a coroutine.", funcName);
+
+    return coroPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Switches from the running coroutine back to the Event Loop.  Returns when the coroutine is next
+ * run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SwitchToLoop
+(
+    Coro_t* coroPtr         ///< [IN] The running coroutine.
+)
+{
+    coro_ThreadRec_t* recPtr = thread_GetCoroRecPtr();
+
+    recPtr->currentRef = NULL;
+
+    TSAN_SWITCH_TO_FIBER(recPtr->loopFiberPtr);
+    LE_ASSERT(swapcontext(&coroPtr->context, &recPtr->loopContext) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry point of every coroutine's stack.  Runs the coroutine's function, then switches back to
+ * the Event Loop for the last time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoroMain
+(
+    void
+)
+{
+    Coro_t* coroPtr = thread_GetCoroRecPtr()->currentRef;
+
+    coroPtr->mainFunc(coroPtr->contextPtr);
+
+    coroPtr->state = CORO_STATE_DONE;
+    SwitchToLoop(coroPtr);
+
+    LE_FATAL("Coroutine '%s' was run after it finished.", coroPtr->name);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes a coroutine that isn't running, along with its stack, timer and FD Monitor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteCoro
+(
+    Coro_t* coroPtr
+)
+{
+    if (coroPtr->timerRef != NULL)
+    {
+        le_timer_Delete(coroPtr->timerRef);
+    }
+
+    if (coroPtr->fdMonitorRef != NULL)
+    {
+        le_fdMonitor_Delete(coroPtr->fdMonitorRef);
+    }
+
+    if (coroPtr->mapPtr != NULL)
+    {
+        TSAN_DESTROY_FIBER(coroPtr->fiberPtr);
+        LE_ASSERT(munmap(coroPtr->mapPtr, coroPtr->mapSize) == 0);
+    }
+
+    le_dls_Remove(&thread_GetCoroRecPtr()->coroList, &coroPtr->link);
+
+    le_mem_Release(coroPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs a coroutine until it next stops.  Called from the Event Loop, as a queued function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCoroutine
+(
+    void* param1Ptr,        ///< The coroutine.
+    void* param2Ptr         ///< Not used.
+)
+{
+    Coro_t* coroPtr = param1Ptr;
+    coro_ThreadRec_t* recPtr = thread_GetCoroRecPtr();
+
+    LE_ASSERT(coroPtr->state == CORO_STATE_READY);
+    LE_ASSERT(recPtr->currentRef == NULL);
+
+    coroPtr->state = CORO_STATE_RUNNING;
+    recPtr->currentRef = coroPtr;
+
+    TSAN_SWITCH_TO_FIBER(coroPtr->fiberPtr);
+    LE_ASSERT(swapcontext(&recPtr->loopContext, &coroPtr->context) == 0);
+
+    if (coroPtr->state == CORO_STATE_DONE)
+    {
+        DeleteCoro(coroPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Puts a coroutine in the READY state and queues it to run.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MakeReady
+(
+    Coro_t* coroPtr
+)
+{
+    coroPtr->state = CORO_STATE_READY;
+    le_event_QueueFunction(RunCoroutine, coroPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer expiry handler for le_coro_SleepMs().
+ */
+//--------------------------------------------------------------------------------------------------
+static void SleepTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    Coro_t* coroPtr = le_timer_GetContextPtr(timerRef);
+
+    coroPtr->isTimerExpired = true;
+    le_coro_Resume(coroPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * FD Monitor handler for le_coro_AwaitFd().
+ */
+//--------------------------------------------------------------------------------------------------
+static void AwaitFdHandler
+(
+    int fd,
+    short events
+)
+{
+    Coro_t* coroPtr = le_fdMonitor_GetContextPtr();
+
+    // The FD Monitor has done its job.  Deleting it now also stops a level-triggered fd from
+    // being reported again and again before the coroutine gets to run.
+    le_fdMonitor_Delete(coroPtr->fdMonitorRef);
+    coroPtr->fdMonitorRef = NULL;
+
+    coroPtr->fdEvents = events;
+    le_coro_Resume(coroPtr);
+}
+
+
+// =======================================
+//  PROTECTED (INTER-MODULE) FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the coroutine module.
+ *
+ * Must be called exactly once at start-up before any other coroutine functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void coro_Init
+(
+    void
+)
+{
+    CoroPool = le_mem_CreatePool("Coroutines", sizeof(Coro_t));
+
+    PageSize = sysconf(_SC_PAGESIZE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the calling thread's coroutine record.
+ */
+//--------------------------------------------------------------------------------------------------
+void coro_InitThread
+(
+    void
+)
+{
+    coro_ThreadRec_t* recPtr = thread_GetCoroRecPtr();
+
+    recPtr->loopFiberPtr = NULL;
+    recPtr->currentRef = NULL;
+    recPtr->coroList = LE_DLS_LIST_INIT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete all of the calling thread's coroutines.  Called when the thread is dying.
+ */
+//--------------------------------------------------------------------------------------------------
+void coro_DestructThread
+(
+    void
+)
+{
+    coro_ThreadRec_t* recPtr = thread_GetCoroRecPtr();
+    le_dls_Link_t* linkPtr;
+
+    LE_FATAL_IF(recPtr->currentRef != NULL,
+                "Thread exited from inside coroutine '%s'.", recPtr->currentRef->name);
+
+    while ((linkPtr = le_dls_Peek(&recPtr->coroList)) != NULL)
+    {
+        DeleteCoro(CONTAINER_OF(linkPtr, Coro_t, link));
+    }
+}
+
+
+// =======================================
+//  PUBLIC API FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a coroutine in the calling thread.  It won't run until le_coro_Start() is called.
+ *
+ * @return Reference to the coroutine (doesn't return if it fails).
+ */
+//--------------------------------------------------------------------------------------------------
+le_coro_Ref_t le_coro_Create
+(
+    const char* name,           ///< [IN] Name of the coroutine (used for diagnostics only).
+    le_coro_Func_t mainFunc,    ///< [IN] Function to run in the coroutine.
+    void* contextPtr            ///< [IN] Value to pass to mainFunc.
+)
+{
+    LE_ASSERT(mainFunc != NULL);
+
+    Coro_t* coroPtr = le_mem_ForceAlloc(CoroPool);
+
+    if (le_utf8_Copy(coroPtr->name, name, sizeof(coroPtr->name), NULL) == LE_OVERFLOW)
+    {
+        LE_WARN("Coroutine name '%s' truncated to '%s'.", name, coroPtr->name);
+    }
+
+    coroPtr->link = LE_DLS_LINK_INIT;
+    coroPtr->mainFunc = mainFunc;
+    coroPtr->contextPtr = contextPtr;
+    coroPtr->threadRef = le_thread_GetCurrent();
+    coroPtr->state = CORO_STATE_NEW;
+    coroPtr->isResumePending = false;
+    coroPtr->stackSize = DEFAULT_STACK_SIZE;
+    coroPtr->mapPtr = NULL;
+    coroPtr->mapSize = 0;
+    coroPtr->fiberPtr = NULL;
+    coroPtr->timerRef = NULL;
+    coroPtr->isTimerExpired = false;
+    coroPtr->fdMonitorRef = NULL;
+    coroPtr->fdEvents = 0;
+
+    le_dls_Queue(&thread_GetCoroRecPtr()->coroList, &coroPtr->link);
+
+    return coroPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the size of a coroutine's stack.  Must be called before le_coro_Start().
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_SetStackSize
+(
+    le_coro_Ref_t coroRef,      ///< [IN] The coroutine.
+    size_t size                 ///< [IN] Stack size, in bytes.
+)
+{
+    LE_FATAL_IF(coroRef->state != CORO_STATE_NEW,
+                "Stack size of coroutine '%s' set after it was started.", coroRef->name);
+    LE_FATAL_IF(size < PTHREAD_STACK_MIN,
+                "Stack size %zu of coroutine '%s' is below the minimum (%zu).",
+                size, coroRef->name, (size_t)PTHREAD_STACK_MIN);
+
+    coroRef->stackSize = size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a coroutine.  It will run the next time the Event Loop gets to it.
+ *
+ * Must be called from the thread that created the coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Start
+(
+    le_coro_Ref_t coroRef       ///< [IN] The coroutine.
+)
+{
+    LE_FATAL_IF(coroRef->threadRef != le_thread_GetCurrent(),
+                "Coroutine '%s' started by a thread it doesn't belong to.", coroRef->name);
+    LE_FATAL_IF(coroRef->state != CORO_STATE_NEW,
+                "Coroutine '%s' started twice.", coroRef->name);
+
+    // Map the stack, rounded up to a whole number of pages, plus a guard page below it.
+    size_t stackSize = (coroRef->stackSize + PageSize - 1) & ~(PageSize - 1);
+
+    coroRef->mapSize = stackSize + PageSize;
+    coroRef->mapPtr = mmap(NULL,
+                           coroRef->mapSize,
+                           PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK,
+                           -1,
+                           0);
+    LE_FATAL_IF(coroRef->mapPtr == MAP_FAILED,
+                "Failed to map %zu byte stack for coroutine '%s' (%m).",
+                coroRef->mapSize, coroRef->name);
+    LE_ASSERT(mprotect(coroRef->mapPtr, PageSize, PROT_NONE) == 0);
+
+    LE_ASSERT(getcontext(&coroRef->context) == 0);
+    coroRef->context.uc_stack.ss_sp = (uint8_t*)coroRef->mapPtr + PageSize;
+    coroRef->context.uc_stack.ss_size = stackSize;
+    coroRef->context.uc_link = NULL;
+    makecontext(&coroRef->context, CoroMain, 0);
+
+    coro_ThreadRec_t* recPtr = thread_GetCoroRecPtr();
+    if (recPtr->loopFiberPtr == NULL)
+    {
+        recPtr->loopFiberPtr = TSAN_GET_CURRENT_FIBER();
+    }
+    coroRef->fiberPtr = TSAN_CREATE_FIBER();
+
+    MakeReady(coroRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the coroutine that is running.
+ *
+ * @return Reference to the coroutine, or NULL if not called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+le_coro_Ref_t le_coro_GetCurrent
+(
+    void
+)
+{
+    return thread_GetCoroRecPtr()->currentRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the name of a coroutine.
+ *
+ * @return The name.
+ */
+//--------------------------------------------------------------------------------------------------
+const char* le_coro_GetName
+(
+    le_coro_Ref_t coroRef       ///< [IN] The coroutine.
+)
+{
+    return coroRef->name;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Suspends the running coroutine until le_coro_Resume() is called for it.  Returns straight away
+ * if le_coro_Resume() was called since the coroutine last suspended.
+ *
+ * Must be called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Suspend
+(
+    void
+)
+{
+    Coro_t* coroPtr = GetCurrentCoro(__func__);
+
+    if (coroPtr->isResumePending)
+    {
+        coroPtr->isResumePending = false;
+        return;
+    }
+
+    coroPtr->state = CORO_STATE_SUSPENDED;
+    SwitchToLoop(coroPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wakes up a coroutine that is suspended in le_coro_Suspend().
+ *
+ * Must be called from the thread that the coroutine belongs to.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Resume
+(
+    le_coro_Ref_t coroRef       ///< [IN] The coroutine.
+)
+{
+    LE_FATAL_IF(coroRef->threadRef != le_thread_GetCurrent(),
+                "Coroutine '%s' resumed by a thread it doesn't belong to.", coroRef->name);
+
+    switch (coroRef->state)
+    {
+        case CORO_STATE_SUSPENDED:
+            MakeReady(coroRef);
+            break;
+
+        case CORO_STATE_RUNNING:
+            coroRef->isResumePending = true;
+            break;
+
+        case CORO_STATE_READY:
+            // Already on its way.
+            break;
+
+        default:
+            LE_FATAL("Coroutine '%s' resumed before it was started.", coroRef->name);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lets the Event Loop handle everything that is already in the thread's Event Queue before the
+ * running coroutine carries on.
+ *
+ * Must be called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_Yield
+(
+    void
+)
+{
+    Coro_t* coroPtr = GetCurrentCoro(__func__);
+
+    // The coroutine is going to run again anyway, which takes care of any pending resume.
+    coroPtr->isResumePending = false;
+
+    MakeReady(coroPtr);
+    SwitchToLoop(coroPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits for a number of milliseconds.
+ *
+ * Must be called from inside a coroutine.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_coro_SleepMs
+(
+    uint32_t ms                 ///< [IN] Number of milliseconds to wait for.
+)
+{
+    Coro_t* coroPtr = GetCurrentCoro(__func__);
+
+    if (coroPtr->timerRef == NULL)
+    {
+        coroPtr->timerRef = le_timer_Create(coroPtr->name);
+        LE_ASSERT(le_timer_SetHandler(coroPtr->timerRef, SleepTimerHandler) == LE_OK);
+        LE_ASSERT(le_timer_SetContextPtr(coroPtr->timerRef, coroPtr) == LE_OK);
+    }
+
+    LE_ASSERT(le_timer_SetMsInterval(coroPtr->timerRef, ms) == LE_OK);
+
+    coroPtr->isTimerExpired = false;
+    LE_ASSERT(le_timer_Start(coroPtr->timerRef) == LE_OK);
+
+    while (!coroPtr->isTimerExpired)
+    {
+        le_coro_Suspend();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits for events on a file descriptor.  The file descriptor must not have an FD Monitor of its
+ * own.
+ *
+ * Must be called from inside a coroutine.
+ *
+ * @return The events that happened (POLLIN, POLLOUT, POLLPRI, POLLRDHUP, POLLERR, POLLHUP).
+ */
+//--------------------------------------------------------------------------------------------------
+short le_coro_AwaitFd
+(
+    int fd,                     ///< [IN] The file descriptor.
+    short events                ///< [IN] Events to wait for (POLLIN, POLLOUT, etc.).
+)
+{
+    Coro_t* coroPtr = GetCurrentCoro(__func__);
+
+    coroPtr->fdEvents = 0;
+    coroPtr->fdMonitorRef = le_fdMonitor_Create(coroPtr->name, fd, AwaitFdHandler, events);
+    le_fdMonitor_SetContextPtr(coroPtr->fdMonitorRef, coroPtr);
+
+    while (coroPtr->fdEvents == 0)
+    {
+        le_coro_Suspend();
+    }
+
+    return coroPtr->fdEvents;
+}
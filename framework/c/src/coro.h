@@ -0,0 +1,76 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file coro.h
+ *
+ * Interfaces exported by the coroutine module to other modules inside the Legato framework
+ * implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc.  Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef CORO_H_INCLUDE_GUARD
+#define CORO_H_INCLUDE_GUARD
+
+#include <ucontext.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Coroutine Thread Record.
+ *
+ * This structure is to be stored as a member in each Thread object.  The coroutine module uses
+ * the function thread_GetCoroRecPtr() to fetch a pointer to one of these records for a given
+ * thread.
+ *
+ * @warning
+ *      No code outside of the coroutine module (coro.c) should ever access members of this
+ *      structure.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ucontext_t      loopContext;    ///< Where the Event Loop left off to run a coroutine.
+    void*           loopFiberPtr;   ///< ThreadSanitizer's handle for the thread's own stack.
+    le_coro_Ref_t   currentRef;     ///< Coroutine that is running, or NULL.
+    le_dls_List_t   coroList;       ///< All of the thread's coroutines.
+}
+coro_ThreadRec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the coroutine module.
+ *
+ * Must be called exactly once at start-up before any other coroutine functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void coro_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the calling thread's coroutine record.
+ */
+//--------------------------------------------------------------------------------------------------
+void coro_InitThread
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete all of the calling thread's coroutines.  Called when the thread is dying.
+ */
+//--------------------------------------------------------------------------------------------------
+void coro_DestructThread
+(
+    void
+);
+
+
+#endif // CORO_H_INCLUDE_GUARD
@@ -18,14 +18,19 @@
  *
  *  - <b> Events </b> - One per Event ID, these keep track of the ID and what Handlers are
  *                  registered against them.  They also each have a pool from which their
- *                  Reports are allocated.  Note: Events are never deleted.
+ *                  Payloads are allocated.  Note: Events are never deleted.
  *
  *  - <b> Handlers </b> - One per registered handler function.  These keep track of the function,
  *                  the diagnostic name, the context pointer, and what thread is supposed to run
  *                  the handler.
  *
- *  - <b> Reports </b> - Objects containing actual event report payload.  These objects are what
- *                  get queued onto a thread's Event Queue.
+ *  - <b> Reports </b> - Small objects that get queued onto a thread's Event Queue.  One is
+ *                  queued for each Handler that an event is reported to.
+ *
+ *  - <b> Payloads </b> - Objects containing the actual event report payload.  These are
+ *                  reference counted, and all the Reports for one call to le_event_Report()
+ *                  share a single Payload, so the payload is only copied once no matter how
+ *                  many Handlers there are.
  *
  * In addition, thread-specific data structures are kept in a special <b> Per-Thread Record </b>,
  * which the thread module keeps inside the Thread object on our behalf (we can fetch a pointer
@@ -33,7 +38,7 @@
  *
  * @verbatim
  *
- *      Thread ---> Per-Thread Record --+--> Event Queue --+--> Report
+ *      Thread ---> Per-Thread Record --+--> Event Queue --+--> Report ---> Payload
  *         ^                            |
  *         |                            +--> Handler List --+---------+
  *         |                                                          |
@@ -46,7 +51,7 @@
  *                                |
  *                                +--> ID
  *                                |
- *                                +--> Report Pool
+ *                                +--> Payload Pool
  * @endverbatim
  *
  * @section eventLoop_LinuxImplementation    Linux Event Loop Implementation
@@ -54,31 +59,66 @@
  * There are two types of Event Report that can be added to an Event Queue:
  *
  *  - Queued Function
- *  - Publish-Subscribe Event Report - Different size objects, depending on what payload they
- *                                     carry.
+ *  - Publish-Subscribe Event Report - Points to a shared Payload, or to a reference-counted
+ *                                     object for events created by
+ *                                     le_event_CreateIdWithRefCounting().
  *
  * All the different types of Event Report all have the same base structure.  Their payload
  * is different, though.
  *
- * The Event Loop for each thread uses an epoll fd to test for events (see 'man epoll').
+ * The Event Loop for each thread uses an epoll fd to test for events (see 'man epoll').  If the
+ * process has been told to use io_uring instead (see @ref c_event_ioUring), the thread gets an
+ * io_uring instance in place of its epoll fd (see ioUring.c), which event_Ctl() and
+ * WaitForEvents() hide from the rest of the Event Loop and from the FD Monitor module.
  *
  * Included in the set of file descriptors that are being monitored by epoll is an eventfd
  * (see 'man eventfd') monitored in "level-triggered" mode.
  *
- * Whenever an Event Report is added to the Event Queue for a thread, the number 1 is written to
- * that thread's eventfd.  When Event Reports are popped off a thread's Event Queue, that thread's
- * eventfd is read to decrement it.  As long as the eventfd's value is greater than 0, epoll_wait()
- * will return immediately, reporting that there is something to read from that fd.
+ * Each thread's Event Queue is in two parts:
+ *
+ *  - The <b> incoming queue </b> is a lock-free singly-linked stack that any thread can push
+ *    Event Reports onto using an atomic compare-and-swap on its head pointer.  Because it is a
+ *    stack, it holds the reports newest first.
+ *  - The <b> Event Queue </b> proper is an ordinary le_sls list that only the thread itself
+ *    touches.  The thread takes the whole incoming queue at once (by atomically swapping its head
+ *    pointer with NULL), reverses it and adds it to the end of the Event Queue.  It then pops
+ *    reports off the Event Queue in the order in which they were pushed.
+ *
+ * When an Event Report is pushed onto an empty incoming queue, the number 1 is written to the
+ * thread's eventfd.  Reports pushed onto a non-empty incoming queue don't touch the eventfd,
+ * because the thread has already been woken up and will pick them up along with the first one.
+ * The thread reads the eventfd (resetting it to zero) just before it empties the incoming queue,
+ * so anything pushed after that will find the incoming queue empty and write the eventfd again.
+ * A burst of reports sent to a thread therefore costs one write() and one read(), no matter how
+ * many reports are in it, and nobody has to lock the Mutex to add to an Event Queue.
+ *
+ * Each thread actually has two Event Queues like this: the normal one, and an urgent one for
+ * functions queued using le_event_QueueFunctionUrgent().  Both share the one eventfd.
  *
  * The Event Loop is an infinite loop that calls epoll_wait() and then responds to any fd events
- * that epoll_wait() reports.  If epoll_wait() reports an event on the eventfd, then an Event Report
- * is popped off the Event Queue and processed.  If epoll_wait() reports an event on any other fd,
- * FD Event Reports are created and pushed onto Event Queues according to what handlers are
- * registered for those events.  All pending Event Reports are processed until the Event Queue is
- * empty before returning to epoll_wait().  (NOTE: This choice was made to save system call
- * overhead in times of heavy load.  Unfortunately, it also means that if event handlers always add
- * new events to the queue, then epoll_wait() will never be called and therefore fd events will
- * never be detected.)
+ * that epoll_wait() reports.  If epoll_wait() reports an event on any fd other than the eventfd,
+ * the FD Monitor module is told about it (see fdMon_Report()), and it calls the FD Monitor's
+ * handler right there.  Then the incoming queues are taken and a batch of reports is
+ * processed before returning to epoll_wait():  everything on the urgent queue, followed by up to
+ * the thread's batch size (see le_event_SetBatchSize()) worth of reports from the normal Event
+ * Queue.  Urgent reports that arrive during the batch are processed between normal reports.
+ * Reports that are pushed by the event handlers while this is happening go onto the incoming
+ * queues and wait for the next pass, and reports left on the normal Event Queue at the end of a
+ * batch wait until epoll_wait() has been called again (with a zero timeout).  So neither event
+ * handlers that keep queueing more events nor a big burst of reports from other threads can stop
+ * epoll_wait() from being called and starve the fds.
+ *
+ * ----
+ *
+ * @section eventLoop_Statistics    Statistics
+ *
+ * If the LE_EVENT_STATS environment variable is set, each thread's Per-Thread Record points to a
+ * statistics record (see event_Stats_t), which only that thread writes to and which the inspect
+ * tool reads from outside the process.  Reports are time-stamped as they are pushed, so the time
+ * they spend queued can be measured when they are popped.  Handlers cache a pointer to their
+ * entry in the statistics, and so do FD Monitors, whose handlers are called by the FD Monitor
+ * module (see fdMonitor.c), which sets currentHandlerPtr to tell the Event Loop who it ran.  FD
+ * Monitor handlers aren't queued, so they add nothing to the dispatch latency.
  *
  * ----
  *
@@ -86,7 +126,8 @@
  *
  * Everything can be shared between multiple threads, and therefore must be protected from
  * multithreaded race conditions.  A Mutex is provided for that purpose, and it can be locked
- * and unlocked using the functions Lock() and Unlock().
+ * and unlocked using the functions Lock() and Unlock().  The incoming queues are the exception;
+ * they are lock-free (see above).
  *
  * ----
  *
@@ -99,6 +140,7 @@
 #include "fdMonitor.h"
 #include "limit.h"
 #include "fileDescriptor.h"
+#include "ioUring.h"
 
 #include <pthread.h>
 #include <sys/eventfd.h>
@@ -115,9 +157,20 @@
 /// @todo Make this configurable.
 #define DEFAULT_QUEUED_FUNCTION_POOL_SIZE 10
 
-/// The default number of objects in a per-Event-ID Report Pool.
+/// The default number of objects in the process-wide Publish-Subscribe Report Pool.
+/// @todo Make this configurable.
+#define DEFAULT_REPORT_POOL_SIZE 10
+
+/// The default number of objects in a per-Event-ID Payload Pool.
 /// @todo Make this configurable.
-#define DEFAULT_REPORT_POOL_SIZE 1
+#define DEFAULT_PAYLOAD_POOL_SIZE 1
+
+/// The default maximum number of Event Reports processed by a thread's Event Loop before it checks
+/// its file descriptors again.  See le_event_SetBatchSize().
+#define DEFAULT_BATCH_SIZE 64
+
+/// The maximum number of Event Reports allocated at once when reporting an event to its handlers.
+#define REPORT_BATCH_SIZE 16
 
 /// The default number of objects in the process-wide Handler Pool, from which all Handler objects
 /// are allocated.
@@ -138,6 +191,9 @@
  * creates a new Event ID.  They store the name of the event and the ID.  They also keep the
  * list of all Handlers that have been registered for that event.
  *
+ * Events created using le_event_CreateIdWithRefCounting() don't have a Payload Pool, because
+ * their payload is the reporter's own reference-counted object.
+ *
  * @warning Once this has been placed in the Event List, it can be accessed by multiple threads.
  *          After that, the Mutex must be used to protect it and everything in it from races.
  *
@@ -149,8 +205,11 @@ typedef struct
     le_sls_Link_t       link;                   ///< Used to link into the Event List.
     void*               id;                     ///< The Event ID (safe ref) assigned to this event.
     le_dls_List_t       handlerList;            ///< List of Handlers registered for this event.
+    size_t              handlerCount;           ///< Number of Handlers on the list.  Only changed
+                                                ///  with the Mutex held, but le_event_Report()
+                                                ///  reads it without the Mutex.
     char                name[LIMIT_MAX_EVENT_NAME_BYTES]; ///< The name of the event.
-    le_mem_PoolRef_t    reportPoolRef;          ///< Pool for this event's Report objects.
+    le_mem_PoolRef_t    payloadPoolRef;         ///< Pool for this event's Payloads (or NULL).
     size_t              payloadSize;            ///< Size of the Report payload, in bytes.
     bool                isRefCounted;           ///< true = payload is a ref-counted object pointer.
 }
@@ -203,9 +262,11 @@ typedef struct
     le_dls_Link_t           threadLink; ///< Used to link onto a thread's Handler List.
     event_PerThreadRec_t*   threadRecPtr;///< Ptr to per-thread rec of thread that will run this.
     Event_t*                eventPtr;   ///< Ptr to the Event obj for the event that this handles.
-    void*                   contextPtr; ///< The context pointer for this handler.
+    void*                   contextPtr; ///< The context pointer for this handler (atomic).
     void*                   safeRef;    ///< Safe Reference for this object.
     char                    name[LIMIT_MAX_EVENT_HANDLER_NAME_BYTES];///< UTF-8 name of the handler.
+    event_HandlerStats_t*   statsPtr;   ///< Entry in the thread's statistics (NULL if not used
+                                        ///< yet).
 
     le_event_LayeredHandlerFunc_t   firstLayerFunc;     ///< First-layer handler function.
     void*                           secondLayerFunc;    ///< Second-layer handler function.
@@ -260,6 +321,8 @@ typedef struct
 {
     le_sls_Link_t           link;       ///< Used to link onto an Event Queue.
     EventReportType_t       type;       ///< Indicates what type of event report this is.
+    uint64_t                queuedUsec; ///< When the report was queued (only set if statistics
+                                        ///  are being kept).
 }
 Report_t;
 
@@ -268,18 +331,29 @@ Report_t;
 /**
  * Publish-Subscribe Event Report.
  *
- * Each Handler has its own pool from which these types of Event Reports are allocated.
+ * These are allocated from the process-wide Publish-Subscribe Report Pool.  Each one holds one
+ * reference to its payload object, which is either a Payload allocated from the Event's Payload
+ * Pool (LE_EVENT_REPORT_PLAIN) or the reporter's reference-counted object
+ * (LE_EVENT_REPORT_COUNTED_REF).
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
     Report_t                baseClass;  ///< Part that is common to all types of report.
     le_event_HandlerRef_t   handlerRef; ///< Safe Reference to the handler for this event.
-    void*                   payload[0]; ///< If the report has payload, it comes at the end.
+    void*                   payloadPtr; ///< The payload object.
 }
 PubSubEventReport_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Publish-Subscribe Event Reports are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t PubSubReportPool;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Queued Function.
@@ -307,22 +381,28 @@ static le_mem_PoolRef_t QueuedFunctionPool;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * The Safe Reference Map to be used to create Safe References to use as Event IDs.
+ * Map from the Safe References used as Event IDs to Event objects, and the next Safe Reference
+ * value to be assigned.
  *
- * @warning This can be accessed by multiple threads.  Use the Mutex to protect it from races.
+ * This is a concurrent hashmap, so it can be used by multiple threads without holding the Mutex.
+ * Like the Safe References made by le_ref_CreateRef(), the keys are always odd numbers so that
+ * they can't be mistaken for pointers.
  */
 //--------------------------------------------------------------------------------------------------
-static le_ref_MapRef_t EventRefMap;
+static le_hashmap_Ref_t EventRefMap;
+static ssize_t NextEventRefNum = 0x10000001;
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * The Safe Reference Map to be used to create Handler References.
+ * Map from Handler References to Handler objects, and the next Handler Reference value to be
+ * assigned.
  *
- * @warning This can be accessed by multiple threads.  Use the Mutex to protect it from races.
+ * This is a concurrent hashmap, so it can be used by multiple threads without holding the Mutex.
  */
 //--------------------------------------------------------------------------------------------------
-static le_ref_MapRef_t HandlerRefMap;
+static le_hashmap_Ref_t HandlerRefMap;
+static ssize_t NextHandlerRefNum = 0x10000001;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -337,12 +417,12 @@ static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // POSIX "Fast" mute
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Guards against thread cancellation and locks the mutex.
+ * Guards against thread cancellation.
  *
  * @return Old state of cancelability.
  **/
 //--------------------------------------------------------------------------------------------------
-static int Lock
+static int DisableCancel
 (
     void
 )
@@ -354,6 +434,43 @@ static int Lock
 
     LE_FATAL_IF(err != 0, "pthread_setcancelstate() failed (%s)", strerror(err));
 
+    return oldState;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases the thread cancellation guard created by DisableCancel().
+ **/
+//--------------------------------------------------------------------------------------------------
+static void RestoreCancel
+(
+    int restoreTo   ///< Old state of cancellability to be restored.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int junk;
+
+    int err = pthread_setcancelstate(restoreTo, &junk);
+    LE_FATAL_IF(err != 0, "pthread_setcancelstate() failed (%s)", strerror(err));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Guards against thread cancellation and locks the mutex.
+ *
+ * @return Old state of cancelability.
+ **/
+//--------------------------------------------------------------------------------------------------
+static int Lock
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int oldState = DisableCancel();
+
     LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
 
     return oldState;
@@ -371,12 +488,9 @@ static void Unlock
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int junk;
-
     LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
 
-    int err = pthread_setcancelstate(restoreTo, &junk);
-    LE_FATAL_IF(err != 0, "pthread_setcancelstate() failed (%s)", strerror(err));
+    RestoreCancel(restoreTo);
 }
 
 
@@ -392,10 +506,61 @@ static le_log_TraceRef_t TraceRef;
 #define TRACE(...) LE_TRACE(TraceRef, ##__VA_ARGS__)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if threads' Event Loops should use io_uring instead of epoll.  Set at start-up from the
+ * LE_EVENT_BACKEND environment variable.  See @ref c_event_ioUring.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool UseIoUring = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if threads' Event Loops should keep statistics.  Set at start-up from the LE_EVENT_STATS
+ * environment variable.  See @ref c_event_stats.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool KeepStats = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which threads' statistics records are allocated (only created if KeepStats is true).
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StatsPool;
+
+
 // ==============================================
 //  PRIVATE FUNCTIONS
 // ==============================================
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a Safe Reference in one of the concurrent reference maps.  Can be called by any thread
+ * without holding the Mutex.
+ *
+ * @return The Safe Reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* CreateSafeRef
+(
+    le_hashmap_Ref_t    mapRef,         ///< [in] EventRefMap or HandlerRefMap.
+    ssize_t*            nextRefNumPtr,  ///< [in,out] The map's next Safe Reference value.
+    void*               ptr             ///< [in] Pointer that the Safe Reference will map to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Increment by 2 to keep it odd.
+    void* safeRef = (void*)__atomic_fetch_add(nextRefNumPtr, 2, __ATOMIC_RELAXED);
+
+    le_hashmap_Put(mapRef, safeRef, ptr);
+
+    return safeRef;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a new Event object.
@@ -419,6 +584,7 @@ static Event_t* CreateEvent
 
     eventPtr->link = LE_SLS_LINK_INIT;
     eventPtr->handlerList = LE_DLS_LIST_INIT;
+    eventPtr->handlerCount = 0;
 
     result = le_utf8_Copy(eventPtr->name, name, sizeof(eventPtr->name), NULL);
     if(result == LE_OVERFLOW)
@@ -429,32 +595,41 @@ static Event_t* CreateEvent
     eventPtr->payloadSize = payloadSize;
     eventPtr->isRefCounted = isRefCounted;
 
-    // Create the memory pool from which reports for this event are to be allocated.
+    // Create the memory pool from which payloads for this event are to be allocated.
     // Note: We can't delete pools, so we don't allow Event Ids to be deleted.
     /// @todo Make this configurable.
-    char poolNameStr[LIMIT_MAX_EVENT_NAME_BYTES + 8];
-    size_t bytesCopied;
-    le_utf8_Copy(poolNameStr, eventPtr->name, sizeof(poolNameStr), &bytesCopied);
-    if (LE_OVERFLOW == le_utf8_Copy(poolNameStr + bytesCopied,
-                                    "-reports",
-                                    sizeof(poolNameStr) - bytesCopied,
-                                    NULL) )
+    if (isRefCounted)
     {
-        LE_WARN("Event report pool name truncated for '%s' events.", name);
+        eventPtr->payloadPoolRef = NULL;
+    }
+    else
+    {
+        char poolNameStr[LIMIT_MAX_EVENT_NAME_BYTES + 9];
+        size_t bytesCopied;
+        le_utf8_Copy(poolNameStr, eventPtr->name, sizeof(poolNameStr), &bytesCopied);
+        if (LE_OVERFLOW == le_utf8_Copy(poolNameStr + bytesCopied,
+                                        "-payloads",
+                                        sizeof(poolNameStr) - bytesCopied,
+                                        NULL) )
+        {
+            LE_WARN("Event payload pool name truncated for '%s' events.", name);
+        }
+        eventPtr->payloadPoolRef = le_mem_CreatePool(poolNameStr, payloadSize);
+        // Payloads are typically allocated in one thread and released in another, possibly of
+        // very different priorities, so don't let payload allocation block on the pool lock.
+        le_mem_SetConcurrent(eventPtr->payloadPoolRef);
+        le_mem_ExpandPool(eventPtr->payloadPoolRef, DEFAULT_PAYLOAD_POOL_SIZE);
     }
-    eventPtr->reportPoolRef = le_mem_CreatePool(poolNameStr,
-                                              offsetof(PubSubEventReport_t, payload) + payloadSize);
-    le_mem_ExpandPool(eventPtr->reportPoolRef, DEFAULT_REPORT_POOL_SIZE);
+
+    // Create a Safe Reference to be used as the Event ID.
+    eventPtr->id = CreateSafeRef(EventRefMap, &NextEventRefNum, eventPtr);
 
     // Up until now, we have not accessed anything that is available to anyone else; except for
-    // the EventPool, but that is thread-safe.  But, now we need to touch the Safe Reference Map
-    // and the Event List, and those are shared by other threads.  So, it's time to lock the Mutex.
+    // the EventPool and the Event Reference Map, but those are thread-safe.  But, now we need to
+    // touch the Event List, and that is shared by other threads.  So, it's time to lock the Mutex.
 
     int oldState = Lock();
 
-    // Create a Safe Reference to be used as the Event ID.
-    eventPtr->id = le_ref_CreateRef(EventRefMap, eventPtr);
-
     // Add the Event object to the Event List.
     le_sls_Queue(&EventList, &eventPtr->link);
 
@@ -478,17 +653,171 @@ static void DeleteHandler
 //--------------------------------------------------------------------------------------------------
 {
     le_dls_Remove(&handlerPtr->eventPtr->handlerList, &handlerPtr->eventLink);
+    __atomic_store_n(&handlerPtr->eventPtr->handlerCount,
+                     handlerPtr->eventPtr->handlerCount - 1,
+                     __ATOMIC_RELAXED);
     le_dls_Remove(&handlerPtr->threadRecPtr->handlerList, &handlerPtr->threadLink);
-    le_ref_DeleteRef(HandlerRefMap, handlerPtr->safeRef);
+    le_hashmap_Remove(HandlerRefMap, handlerPtr->safeRef);
     le_mem_Release(handlerPtr);
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the monotonic clock, for keeping statistics.
+ *
+ * @return The time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetMicroseconds
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec now;
+
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &now) == 0);
+
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a time to a histogram.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordTime
+(
+    event_Histogram_t* histogramPtr,    ///< [in] The histogram.
+    uint64_t usec                       ///< [in] The time, in microseconds.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // The bucket number is the number of significant bits in the time.
+    size_t bucket = (usec == 0 ? 0 : 64 - __builtin_clzll(usec));
+
+    if (bucket >= EVENT_STATS_HISTOGRAM_BUCKETS)
+    {
+        bucket = EVENT_STATS_HISTOGRAM_BUCKETS - 1;
+    }
+
+    histogramPtr->buckets[bucket]++;
+    histogramPtr->count++;
+    histogramPtr->totalUsec += usec;
+    if (usec > histogramPtr->maxUsec)
+    {
+        histogramPtr->maxUsec = usec;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds an entry to a thread's per-handler statistics.  Once they are full, the last entry is
+ * shared by everything else.
+ *
+ * @return Pointer to the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static event_HandlerStats_t* AddHandlerStats
+(
+    event_Stats_t* statsPtr,    ///< [in] The calling thread's statistics.
+    const char* name,           ///< [in] Name of the handler.
+    void* funcPtr               ///< [in] Address of the queued function, or NULL.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    event_HandlerStats_t* entryPtr;
+
+    if (statsPtr->numHandlers < EVENT_STATS_MAX_HANDLERS - 1)
+    {
+        entryPtr = &statsPtr->handlers[statsPtr->numHandlers];
+        statsPtr->numHandlers++;
+    }
+    else
+    {
+        entryPtr = &statsPtr->handlers[EVENT_STATS_MAX_HANDLERS - 1];
+        if (statsPtr->numHandlers == EVENT_STATS_MAX_HANDLERS)
+        {
+            return entryPtr;
+        }
+        statsPtr->numHandlers++;
+        name = "(others)";
+        funcPtr = NULL;
+    }
+
+    (void)le_utf8_Copy(entryPtr->name, name, sizeof(entryPtr->name), NULL);
+    entryPtr->funcPtr = funcPtr;
+
+    return entryPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the entry for a queued function in the calling thread's statistics, adding it if
+ * necessary.  Queued functions are named after their addresses.
+ *
+ * @return Pointer to the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static event_HandlerStats_t* GetFunctionStats
+(
+    event_Stats_t* statsPtr,    ///< [in] The calling thread's statistics.
+    void* funcPtr               ///< [in] Address of the queued function.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char name[LIMIT_MAX_EVENT_HANDLER_NAME_BYTES];
+    size_t i;
+
+    for (i = 0; i < statsPtr->numHandlers; i++)
+    {
+        if (statsPtr->handlers[i].funcPtr == funcPtr)
+        {
+            return &statsPtr->handlers[i];
+        }
+    }
+
+    snprintf(name, sizeof(name), "<%p>", funcPtr);
+
+    return AddHandlerStats(statsPtr, name, funcPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts a wake-up of the calling thread's Event Loop in its statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordWakeup
+(
+    event_Stats_t* statsPtr     ///< [in] The calling thread's statistics.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t second = GetMicroseconds() / 1000000;
+
+    if (second != statsPtr->wakeupSecond)
+    {
+        statsPtr->prevWakeupSecond = statsPtr->wakeupSecond;
+        statsPtr->wakeupsInPrevSecond = statsPtr->wakeupsInSecond;
+        statsPtr->wakeupSecond = second;
+        statsPtr->wakeupsInSecond = 0;
+    }
+
+    statsPtr->wakeupsInSecond++;
+    statsPtr->wakeupCount++;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Write to a thread's Event File Descriptor.  This increments it by one.
  *
- * This must be done exactly once for each Event Report pushed onto the thread's Event Queue.
+ * This must be done whenever an Event Report is pushed onto an empty incoming queue.
  */
 //--------------------------------------------------------------------------------------------------
 static void WriteEventFd
@@ -523,12 +852,44 @@ static void WriteEventFd
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates Event Reports for a batch of an Event's handlers, starting at a given handler.
+ *
+ * @return The number of reports allocated (no more than REPORT_BATCH_SIZE).
+ *
+ * @note Must be called with the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t AllocReports
+(
+    Event_t* eventPtr,          ///< [in] The Event being reported.
+    le_dls_Link_t* linkPtr,     ///< [in] Link of the first handler in the batch.
+    void* reportPtrs[]          ///< [out] Array of REPORT_BATCH_SIZE pointers to fill in.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t numReports = 0;
+
+    while ((linkPtr != NULL) && (numReports < REPORT_BATCH_SIZE))
+    {
+        numReports++;
+        linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
+    }
+
+    le_mem_AllocBatch(PubSubReportPool, numReports, reportPtrs);
+
+    return numReports;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read a thread's Event File Descriptor.  This fetches the value of the Event FD (which is
- * the number of event reports on the Event Queue) and resets the Event FD value to zero.
+ * the number of times the thread's incoming queue has become non-empty since the last read) and
+ * resets the Event FD value to zero.
  *
- * @return The number of Event Reports on the thread's Event Queue.
+ * @return The value of the Event FD (0 if it was already zero).
  */
 //--------------------------------------------------------------------------------------------------
 static uint64_t ReadEventFd
@@ -547,6 +908,11 @@ static uint64_t ReadEventFd
         {
             return readBuff;
         }
+        else if ((readSize == -1) && (errno == EAGAIN))
+        {
+            // The eventfd is non-blocking, and its value was zero.
+            return 0;
+        }
         else
         {
             if ((readSize == -1) && (errno != EINTR))
@@ -564,34 +930,227 @@ static uint64_t ReadEventFd
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Process one event report from the calling thread's Event Queue.
- **/
+ * Push an Event Report onto one of a thread's incoming queues, and wake the thread up if the queue
+ * was empty.  Can be called by any thread, with or without the Mutex locked.
+ *
+ * @warning Assumes the calling thread is protected from cancellation.  Otherwise, it could be
+ *          cancelled after pushing onto an empty queue but before writing to the eventfd, which
+ *          would leave the thread asleep with reports waiting for it.
+ */
 //--------------------------------------------------------------------------------------------------
-static void ProcessOneEventReport
+static void PushEventReport
+(
+    event_PerThreadRec_t*   perThreadRecPtr,    ///< [in] Ptr to the thread's per-thread record.
+    event_Queue_t*          queuePtr,           ///< [in] The thread's normal or urgent queue.
+    Report_t*               reportPtr           ///< [in] The report to be pushed.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* headPtr = __atomic_load_n(&queuePtr->incomingPtr, __ATOMIC_RELAXED);
+
+    if (KeepStats)
+    {
+        reportPtr->queuedUsec = GetMicroseconds();
+    }
+
+    do
+    {
+        reportPtr->link.nextPtr = headPtr;
+    }
+    while (!__atomic_compare_exchange_n(&queuePtr->incomingPtr,
+                                        &headPtr,
+                                        &reportPtr->link,
+                                        true,
+                                        __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED));
+
+    // Only the push that makes the queue non-empty has to wake the thread up.
+    if (headPtr == NULL)
+    {
+        WriteEventFd(perThreadRecPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take everything off one of the calling thread's incoming queues and add it to the end of the
+ * queue's list, oldest first.
+ *
+ * @note Doesn't reset the eventfd.  See FetchEventReports().
+ */
+//--------------------------------------------------------------------------------------------------
+static void TakeIncomingReports
+(
+    event_Queue_t* queuePtr     ///< [in] One of the calling thread's queues.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr = __atomic_exchange_n(&queuePtr->incomingPtr, NULL, __ATOMIC_ACQUIRE);
+
+    // The incoming queue is newest first.  Adding each link right after the old tail of the
+    // list (or at the head, if it was empty) puts them back into oldest first order.
+    le_sls_Link_t* tailLinkPtr = le_sls_PeekTail(&queuePtr->list);
+
+    while (linkPtr != NULL)
+    {
+        le_sls_Link_t* nextLinkPtr = linkPtr->nextPtr;
+
+        if (tailLinkPtr == NULL)
+        {
+            le_sls_Stack(&queuePtr->list, linkPtr);
+        }
+        else
+        {
+            le_sls_AddAfter(&queuePtr->list, tailLinkPtr, linkPtr);
+        }
+
+        queuePtr->length++;
+        linkPtr = nextLinkPtr;
+    }
+
+    if (queuePtr->length > queuePtr->maxLength)
+    {
+        queuePtr->maxLength = queuePtr->length;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take everything off the calling thread's incoming queues.
+ *
+ * The eventfd is reset first, so that anything that is pushed after the incoming queues have been
+ * emptied here will write to the eventfd again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FetchEventReports
 (
     event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_sls_Link_t* linkPtr;
-    Report_t* reportObjPtr;
-    Handler_t* handlerPtr;
+    (void)ReadEventFd(perThreadRecPtr);
+
+    TakeIncomingReports(&perThreadRecPtr->urgentQueue);
+    TakeIncomingReports(&perThreadRecPtr->eventQueue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether one of a thread's queues is completely empty.
+ *
+ * @return true if there is nothing on the queue's list or on its incoming queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsQueueEmpty
+(
+    event_Queue_t* queuePtr     ///< [in] One of the calling thread's queues.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (   le_sls_IsEmpty(&queuePtr->list)
+            && (__atomic_load_n(&queuePtr->incomingPtr, __ATOMIC_RELAXED) == NULL));
+}
+
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues a Publish-Subscribe Event Report to each of an Event's handlers.  Each report gets its
+ * own reference to the payload object; the caller keeps its reference.
+ *
+ * @warning Assumes the mutex is NOT locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueReports
+(
+    Event_t*            eventPtr,   ///< [in] The Event being reported.
+    EventReportType_t   type,       ///< [in] LE_EVENT_REPORT_PLAIN or LE_EVENT_REPORT_COUNTED_REF.
+    void*               payloadPtr  ///< [in] The payload object.
+)
+//--------------------------------------------------------------------------------------------------
+{
     int oldState = Lock();
 
-    // Pop an Event Report off the head of the Event Queue (inside a critical section).
-    linkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue);
+    TRACE("Reporting event '%s'...", eventPtr->name);
+
+    // For each Handler registered for this Event,
+    le_dls_Link_t* linkPtr = le_dls_Peek(&eventPtr->handlerList);
+    void* reportPtrs[REPORT_BATCH_SIZE];
+    size_t numReports = 0;
+    size_t reportIndex = 0;
+    while (linkPtr != NULL)
+    {
+        Handler_t* handlerPtr = CONTAINER_OF(linkPtr, Handler_t, eventLink);
+
+        TRACE("  ...to handler '%s'.", handlerPtr->name);
+
+        // Get the reports for the next batch of handlers, if this batch has been used up.
+        if (reportIndex == numReports)
+        {
+            numReports = AllocReports(eventPtr, linkPtr, reportPtrs);
+            reportIndex = 0;
+        }
+
+        // Queue a report to the handler's thread's Event Queue.
+        PubSubEventReport_t* reportObjPtr = reportPtrs[reportIndex++];
+        reportObjPtr->baseClass.link = LE_SLS_LINK_INIT;
+        reportObjPtr->baseClass.type = type;
+        reportObjPtr->handlerRef = handlerPtr->safeRef;
+        reportObjPtr->payloadPtr = payloadPtr;
+        le_mem_AddRef(payloadPtr);
+        PushEventReport(handlerPtr->threadRecPtr,
+                        &handlerPtr->threadRecPtr->eventQueue,
+                        &reportObjPtr->baseClass);
+
+        linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
+    }
 
     Unlock(oldState);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process one event report from one of the calling thread's Event Queues.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ProcessOneEventReport
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    event_Queue_t* queuePtr                 ///< [in] The thread's normal or urgent queue.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr;
+    Report_t* reportObjPtr;
+    Handler_t* handlerPtr;
+    event_Stats_t* statsPtr = perThreadRecPtr->statsPtr;
+    event_HandlerStats_t* handlerStatsPtr = NULL;
+    uint64_t startUsec = 0;
+
+    // Pop an Event Report off the head of the queue's list.  Only this thread uses the list,
+    // so there's no need to lock the Mutex.
+    linkPtr = le_sls_Pop(&queuePtr->list);
 
     if (linkPtr == NULL)
     {
         return;
     }
 
+    queuePtr->length--;
+
     // Convert the link pointer into a pointer to the Report base class.
     reportObjPtr = CONTAINER_OF(linkPtr, Report_t, link);
 
+    if (statsPtr != NULL)
+    {
+        startUsec = GetMicroseconds();
+        RecordTime(&statsPtr->dispatchLatency, startUsec - reportObjPtr->queuedUsec);
+        statsPtr->currentHandlerPtr = NULL;
+    }
+
     // If it's a queued function report,
     if (reportObjPtr->type == LE_EVENT_REPORT_QUEUED_FUNC)
     {
@@ -603,6 +1162,16 @@ static void ProcessOneEventReport
         queuedFuncReportPtr->function(queuedFuncReportPtr->param1Ptr,
                                       queuedFuncReportPtr->param2Ptr);
 
+        // Functions that call handlers on behalf of other modules (such as the FD Monitor
+        // module's) say which handler they called, otherwise the time goes to the function.
+        if (statsPtr != NULL)
+        {
+            handlerStatsPtr = statsPtr->currentHandlerPtr;
+            if (handlerStatsPtr == NULL)
+            {
+                handlerStatsPtr = GetFunctionStats(statsPtr, queuedFuncReportPtr->function);
+            }
+        }
     }
     // If it's a publish-subscribe event report,
     else
@@ -612,51 +1181,53 @@ static void ProcessOneEventReport
         PubSubEventReport_t* pubSubReportPtr;
         pubSubReportPtr = CONTAINER_OF(reportObjPtr, PubSubEventReport_t, baseClass);
 
-        oldState = Lock();
-
         // Get a pointer to the Handler object for this Event Report; unless it has been removed.
-        handlerPtr = le_ref_Lookup(HandlerRefMap, pubSubReportPtr->handlerRef);
+        // Handlers are only ever deleted by the thread that they belong to, which is this one,
+        // so there's no need to hold the Mutex while the Handler object is used.
+        handlerPtr = le_hashmap_Get(HandlerRefMap, pubSubReportPtr->handlerRef);
         if (handlerPtr == NULL)
         {
-            // The handler has been removed, so this report should be discarded.
-            Unlock(oldState);
-
-            // If its payload is a pointer to a reference-counted memory pool object,
-            // then that has to be released.
-            if (reportObjPtr->type == LE_EVENT_REPORT_COUNTED_REF)
-            {
-                le_mem_Release(pubSubReportPtr->payload[0]);
-            }
+            // The handler has been removed, so this report should be discarded, along with its
+            // reference to the payload object.
+            le_mem_Release(pubSubReportPtr->payloadPtr);
         }
         else
         {
             // The handler still exists, so grab the info we need from it and call
-            // the first-layer handler function.
-            perThreadRecPtr->contextPtr = handlerPtr->contextPtr;
+            // the first-layer handler function.  The context pointer can be changed by other
+            // threads (see le_event_SetContextPtr()).
+            perThreadRecPtr->contextPtr = __atomic_load_n(&handlerPtr->contextPtr,
+                                                          __ATOMIC_RELAXED);
 
             le_event_LayeredHandlerFunc_t firstLayerFunc = handlerPtr->firstLayerFunc;
             void* secondLayerFunc = handlerPtr->secondLayerFunc;
 
-            // If it's a reference-counted report, then the payload is a pointer to the
-            // report.  Otherwise, the report itself is in the payload.
-            void* reportPtr;
-            if (reportObjPtr->type == LE_EVENT_REPORT_COUNTED_REF)
+            if (statsPtr != NULL)
             {
-                reportPtr = pubSubReportPtr->payload[0];
-            }
-            else
-            {
-                reportPtr = pubSubReportPtr->payload;
+                if (handlerPtr->statsPtr == NULL)
+                {
+                    handlerPtr->statsPtr = event_GetHandlerStats(statsPtr, handlerPtr->name);
+                }
+                handlerStatsPtr = handlerPtr->statsPtr;
             }
 
-            Unlock(oldState);  // Unlock the mutex before calling the handler function.
-                               // Don't access the Handler object anymore after this.
+            // Don't access the Handler object anymore after this.  The handler function could
+            // delete it.
+            firstLayerFunc(pubSubReportPtr->payloadPtr, secondLayerFunc);
 
-            firstLayerFunc(reportPtr, secondLayerFunc);
+            // The handler takes over the report's reference to a reference-counted object.
+            // A shared Payload belongs to us, though.
+            if (reportObjPtr->type == LE_EVENT_REPORT_PLAIN)
+            {
+                le_mem_Release(pubSubReportPtr->payloadPtr);
+            }
         }
     }
 
-    // NOTE: The Mutex should be unlocked by this point.
+    if (handlerStatsPtr != NULL)
+    {
+        RecordTime(&handlerStatsPtr->execTime, GetMicroseconds() - startUsec);
+    }
 
     // We are done with this report.
     le_mem_Release(reportObjPtr);
@@ -665,7 +1236,30 @@ static void ProcessOneEventReport
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Process Event Reports from the calling thread's Event Queue until the queue is empty.
+ * Process all the reports that have been taken off the calling thread's urgent queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessUrgentReports
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (!le_sls_IsEmpty(&perThreadRecPtr->urgentQueue.list))
+    {
+        ProcessOneEventReport(perThreadRecPtr, &perThreadRecPtr->urgentQueue);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process a batch of Event Reports from the calling thread's Event Queues.
+ *
+ * Everything on the urgent queue is processed first, followed by up to the thread's batch size
+ * worth of reports from the normal Event Queue.  Between normal reports, any urgent reports that
+ * have arrived in the meantime are processed.  Anything left on the normal Event Queue after that
+ * waits until epoll_wait() has been called again.
  */
 //--------------------------------------------------------------------------------------------------
 static void ProcessEventReports
@@ -674,17 +1268,82 @@ static void ProcessEventReports
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Read the eventfd to fetch the number of Reports on the Event Queue and reset the count
-    // to zero.
-    uint64_t numReports = ReadEventFd(perThreadRecPtr);
-
-    // Process only those event reports that are already on the queue.  Anything reported by the
-    // event handlers will have to wait until next time ProcessEventReports() is called.
-    // This approach ensures that event handlers that re-queue events to the event
-    // queue don't cause fd events to be starved.
-    for (; numReports > 0; numReports--)
+    size_t numLeft = perThreadRecPtr->batchSize;
+
+    // Take the whole incoming queues in one go.
+    FetchEventReports(perThreadRecPtr);
+
+    ProcessUrgentReports(perThreadRecPtr);
+
+    // Process only those event reports that were already queued, and no more than the batch size.
+    // Anything reported by the event handlers goes onto the incoming queue and will have to wait
+    // until next time ProcessEventReports() is called.  This approach ensures that event handlers
+    // that re-queue events to the event queue, or a burst of reports from other threads, don't
+    // cause fd events to be starved.
+    while ((numLeft > 0) && !le_sls_IsEmpty(&perThreadRecPtr->eventQueue.list))
     {
-        ProcessOneEventReport(perThreadRecPtr);
+        ProcessOneEventReport(perThreadRecPtr, &perThreadRecPtr->eventQueue);
+        numLeft--;
+
+        // Don't keep urgent reports waiting until the end of the batch.  Any reports these
+        // queue to the urgent queue will wait until after the next normal report.
+        if (__atomic_load_n(&perThreadRecPtr->urgentQueue.incomingPtr, __ATOMIC_RELAXED) != NULL)
+        {
+            TakeIncomingReports(&perThreadRecPtr->urgentQueue);
+            ProcessUrgentReports(perThreadRecPtr);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatch the fd events reported by epoll_wait() (or the io_uring equivalent) to the handlers of
+ * the calling thread's FD Monitors.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DispatchFdEvents
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Ptr to the calling thread's per-thread record.
+    const struct epoll_event* eventListPtr, ///< [in] Events reported.
+    int numEvents                           ///< [in] Number of events in the list.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    event_Stats_t* statsPtr = perThreadRecPtr->statsPtr;
+    int i;
+
+    for (i = 0; i < numEvents; i++)
+    {
+        // Get the pointer that we registered with epoll_ctl(2) along with this fd.
+        // The value of this pointer will either be NULL or a Safe Reference for an
+        // FD Monitor object.  If it is NULL, then the Event Queue's eventfd is the
+        // fd that experienced the event, which is dealt with by the caller.
+        void* safeRef = eventListPtr[i].data.ptr;
+
+        if (safeRef == NULL)
+        {
+            continue;
+        }
+
+        if (statsPtr == NULL)
+        {
+            fdMon_Report(safeRef, eventListPtr[i].events);
+        }
+        else
+        {
+            uint64_t startUsec = GetMicroseconds();
+            statsPtr->currentHandlerPtr = NULL;
+
+            fdMon_Report(safeRef, eventListPtr[i].events);
+
+            // The FD Monitor module says which handler it called, if it called one.
+            if (statsPtr->currentHandlerPtr != NULL)
+            {
+                RecordTime(&statsPtr->currentHandlerPtr->execTime,
+                           GetMicroseconds() - startUsec);
+            }
+        }
     }
 }
 
@@ -718,12 +1377,13 @@ static void PubSubHandlerFunc
  * Queue a function onto a specific thread's Event Queue (could belong to the calling thread or
  * could belong to some other thread).
  *
- * @warning Assumes the mutex is locked and the thread is protected from cancellation.
+ * @warning Assumes the thread is protected from cancellation.
  */
 //--------------------------------------------------------------------------------------------------
 static void QueueFunction
 (
     event_PerThreadRec_t*   perThreadRecPtr, ///< [in] Pointer to the thread's event data record.
+    bool                    isUrgent,   ///< [in] true = queue to the thread's urgent queue.
     le_event_DeferredFunc_t func,       ///< [in] The function to be called later.
     void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
     void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
@@ -740,11 +1400,10 @@ static void QueueFunction
     reportPtr->param1Ptr = param1Ptr;
     reportPtr->param2Ptr = param2Ptr;
 
-    // Queue it to the Event Queue.
-    le_sls_Queue(&perThreadRecPtr->eventQueue, &reportPtr->baseClass.link);
-
-    // Write to the eventfd to notify the Event Loop that there is something on the queue.
-    WriteEventFd(perThreadRecPtr);
+    // Push it onto the thread's incoming queue, waking the thread up if necessary.
+    PushEventReport(perThreadRecPtr,
+                    isUrgent ? &perThreadRecPtr->urgentQueue : &perThreadRecPtr->eventQueue,
+                    &reportPtr->baseClass);
 }
 
 
@@ -767,6 +1426,67 @@ void CallComponentInitializer
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Selects the backend used by threads' Event Loops to wait for file descriptor events, from the
+ * LE_EVENT_BACKEND environment variable, if present.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadBackendFromEnv
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* envStrPtr = getenv("LE_EVENT_BACKEND");
+
+    if ((envStrPtr == NULL) || (strcmp(envStrPtr, "epoll") == 0))
+    {
+        return;
+    }
+
+    if (strcmp(envStrPtr, "io_uring") == 0)
+    {
+        UseIoUring = ioUring_Init();
+
+        if (!UseIoUring)
+        {
+            LE_WARN("io_uring not supported by this kernel.  Using epoll.");
+        }
+    }
+    else
+    {
+        LE_ERROR("LE_EVENT_BACKEND environment variable has invalid value '%s'.", envStrPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Waits for events on the file descriptors monitored by a thread's Event Loop, using whichever
+ * backend the thread is using.
+ *
+ * @return The number of events put in the list, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static int WaitForEvents
+(
+    event_PerThreadRec_t* perThreadRecPtr,
+    struct epoll_event* eventListPtr,   ///< [out] Events that occurred.
+    int maxEvents,                      ///< [in] Number of entries in the event list.
+    int timeout                         ///< [in] 0 to return immediately, -1 to wait forever.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (perThreadRecPtr->ringRef != NULL)
+    {
+        return ioUring_Wait(perThreadRecPtr->ringRef, eventListPtr, maxEvents, timeout);
+    }
+
+    return epoll_wait(perThreadRecPtr->epollFd, eventListPtr, maxEvents, timeout);
+}
+
+
 // ==============================================
 //  INTER-MODULE FUNCTIONS
 // ==============================================
@@ -788,8 +1508,15 @@ void event_Init
     // Create the Queued Function Pool from which all Queued Function objects are allocated.
     /// @todo Make this configurable.
     QueuedFunctionPool = le_mem_CreatePool("QueuedFunction", sizeof(QueuedFunctionReport_t));
+    le_mem_SetConcurrent(QueuedFunctionPool);   // Often queued from one thread to another.
     le_mem_ExpandPool(QueuedFunctionPool, DEFAULT_QUEUED_FUNCTION_POOL_SIZE);
 
+    // Create the Publish-Subscribe Report Pool.
+    /// @todo Make this configurable.
+    PubSubReportPool = le_mem_CreatePool("EventReport", sizeof(PubSubEventReport_t));
+    le_mem_SetConcurrent(PubSubReportPool);     // Allocated and released by different threads.
+    le_mem_ExpandPool(PubSubReportPool, DEFAULT_REPORT_POOL_SIZE);
+
     // Create the Handler Pool from which all Handler objects are to be allocated.
     /// @todo Make this configurable.
     HandlerPool = le_mem_CreatePool("EventHandler", sizeof(Handler_t));
@@ -802,14 +1529,31 @@ void event_Init
 
     // Create the Safe Reference Maps.
     /// @todo Make this configurable.
-    EventRefMap = le_ref_CreateMap("Events", DEFAULT_EVENT_POOL_SIZE);
-    HandlerRefMap = le_ref_CreateMap("EventHandlers", DEFAULT_HANDLER_POOL_SIZE);
+    EventRefMap = le_hashmap_CreateConcurrent("refEvents",
+                                              DEFAULT_EVENT_POOL_SIZE,
+                                              le_hashmap_HashVoidPointer,
+                                              le_hashmap_EqualsVoidPointer);
+    HandlerRefMap = le_hashmap_CreateConcurrent("refEventHandlers",
+                                                DEFAULT_HANDLER_POOL_SIZE,
+                                                le_hashmap_HashVoidPointer,
+                                                le_hashmap_EqualsVoidPointer);
 
     // Get a reference to the trace keyword that is used to control tracing in this module.
     TraceRef = le_log_GetTraceRef("eventLoop");
 
     // Initialize the FD Monitor module.
     fdMon_Init();
+
+    // Choose between epoll and io_uring.
+    ReadBackendFromEnv();
+
+    // Keep statistics for the inspect tool, if asked to.
+    if (getenv("LE_EVENT_STATS") != NULL)
+    {
+        KeepStats = true;
+        StatsPool = le_mem_CreatePool("EventLoopStats", sizeof(event_Stats_t));
+        le_mem_SetConcurrent(StatsPool);    // Threads allocate and release their own.
+    }
 }
 
 
@@ -838,28 +1582,52 @@ void event_InitThread
     event_PerThreadRec_t* recPtr = thread_GetEventRecPtr();
 
     // Initialize the various thread-specific lists and queues.
-    recPtr->eventQueue = LE_SLS_LIST_INIT;
+    recPtr->eventQueue.incomingPtr = NULL;
+    recPtr->eventQueue.list = LE_SLS_LIST_INIT;
+    recPtr->urgentQueue.incomingPtr = NULL;
+    recPtr->urgentQueue.list = LE_SLS_LIST_INIT;
+    recPtr->eventQueue.length = 0;
+    recPtr->eventQueue.maxLength = 0;
+    recPtr->urgentQueue.length = 0;
+    recPtr->urgentQueue.maxLength = 0;
+    recPtr->batchSize = DEFAULT_BATCH_SIZE;
     recPtr->handlerList = LE_DLS_LIST_INIT;
     recPtr->fdMonitorList = LE_DLS_LIST_INIT;
 
-    // Create the epoll file descriptor for this thread.  This will be used to monitor for
-    // events on various file descriptors.
-    recPtr->epollFd = epoll_create1(0);
-    LE_FATAL_IF(recPtr->epollFd < 0, "epoll_create1(0) failed with errno %d (%m).", errno);
+    // Create the io_uring instance or epoll file descriptor for this thread.  This will be used
+    // to monitor for events on various file descriptors.
+    recPtr->ringRef = NULL;
+    recPtr->epollFd = -1;
+    if (UseIoUring)
+    {
+        recPtr->ringRef = ioUring_Create();
+    }
+    if (recPtr->ringRef == NULL)
+    {
+        recPtr->epollFd = epoll_create1(0);
+        LE_FATAL_IF(recPtr->epollFd < 0, "epoll_create1(0) failed with errno %d (%m).", errno);
+    }
 
     // Open an eventfd for this thread.  This will be uses to signal to the epoll fd that there
-    // are Event Reports on the Event Queue.
-    recPtr->eventQueueFd = eventfd(0, 0);
+    // are Event Reports on the Event Queue.  It is non-blocking so that it can be reset whether
+    // or not it has been written to.
+    recPtr->eventQueueFd = eventfd(0, EFD_NONBLOCK);
     LE_FATAL_IF(recPtr->eventQueueFd < 0, "eventfd() failed with errno %d (%m).", errno);
 
-    // Add the eventfd to the list of file descriptors to wait for using epoll_wait().
+    // Add the eventfd to the list of file descriptors to wait for using epoll_wait().  io_uring
+    // watches it edge-triggered, so that its poll request stays armed in the kernel; every write
+    // to it is a change of state.
     struct epoll_event ev;
     memset(&ev, 0, sizeof(ev));
     ev.events = EPOLLIN | EPOLLWAKEUP;
+    if (recPtr->ringRef != NULL)
+    {
+        ev.events |= EPOLLET;
+    }
     ev.data.ptr = NULL;     // This being set to NULL is what tells the main event loop that this
                             // is the Event Queue FD, rather than another FD that is being
                             // monitored.
-    if (epoll_ctl(recPtr->epollFd, EPOLL_CTL_ADD, recPtr->eventQueueFd, &ev) == -1)
+    if (event_Ctl(recPtr, EPOLL_CTL_ADD, recPtr->eventQueueFd, &ev) == -1)
     {
         LE_FATAL(   "epoll_ctl(ADD) failed for fd %d. errno = %d (%m)",
                     recPtr->eventQueueFd,
@@ -869,6 +1637,15 @@ void event_InitThread
     // Set the context pointer to NULL for safety's sake.
     recPtr->contextPtr = NULL;
 
+    // Start keeping statistics, if asked to.
+    recPtr->statsPtr = NULL;
+    if (KeepStats)
+    {
+        recPtr->statsPtr = le_mem_ForceAlloc(StatsPool);
+        memset(recPtr->statsPtr, 0, sizeof(*recPtr->statsPtr));
+        recPtr->statsPtr->startSecond = GetMicroseconds() / 1000000;
+    }
+
     // Initialize the FD Monitor module's thread-specific stuff.
     fdMon_InitThread(recPtr);
 
@@ -946,28 +1723,43 @@ void event_DestructThread
     fdMon_DestructThread(perThreadRecPtr);
 
     // Discard everything on the Event Queue.
-    while (NULL != (singleLinkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue)))
+    FetchEventReports(perThreadRecPtr);
+    while (   (NULL != (singleLinkPtr = le_sls_Pop(&perThreadRecPtr->urgentQueue.list)))
+           || (NULL != (singleLinkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue.list))) )
     {
         Report_t* reportPtr = CONTAINER_OF(singleLinkPtr, Report_t, link);
 
-        // If it is carrying a pointer to a reference-counted object from a memory pool,
-        // release that thing first.
-        if (reportPtr->type == LE_EVENT_REPORT_COUNTED_REF)
+        // If it is carrying a reference to a payload object, release that first.
+        if (reportPtr->type != LE_EVENT_REPORT_QUEUED_FUNC)
         {
             PubSubEventReport_t* pubSubReportPtr = CONTAINER_OF(reportPtr,
                                                                 PubSubEventReport_t,
                                                                 baseClass);
-            le_mem_Release(pubSubReportPtr->payload[0]);
+            le_mem_Release(pubSubReportPtr->payloadPtr);
         }
 
         le_mem_Release(reportPtr);
     }
 
-    // Close the epoll file descriptor.
-    fd_Close(perThreadRecPtr->epollFd);
+    // Close the io_uring instance or epoll file descriptor.
+    if (perThreadRecPtr->ringRef != NULL)
+    {
+        ioUring_Delete(perThreadRecPtr->ringRef);
+        perThreadRecPtr->ringRef = NULL;
+    }
+    else
+    {
+        fd_Close(perThreadRecPtr->epollFd);
+    }
 
     // Close the eventfd for the Event Queue.
     fd_Close(perThreadRecPtr->eventQueueFd);
+
+    if (perThreadRecPtr->statsPtr != NULL)
+    {
+        le_mem_Release(perThreadRecPtr->statsPtr);
+        perThreadRecPtr->statsPtr = NULL;
+    }
 }
 
 
@@ -991,6 +1783,63 @@ void event_SetCurrentContextPtr
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds, modifies or removes a file descriptor in the set monitored by a thread's Event Loop.
+ *
+ * Works like epoll_ctl(2), whichever backend the thread is using (see @ref c_event_ioUring).
+ *
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int event_Ctl
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] The thread's Event Loop record.
+    int op,                                 ///< [in] EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL.
+    int fd,                                 ///< [in] File descriptor.
+    struct epoll_event* evPtr               ///< [in] Events and data pointer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (perThreadRecPtr->ringRef != NULL)
+    {
+        return ioUring_Ctl(perThreadRecPtr->ringRef, op, fd, evPtr);
+    }
+
+    return epoll_ctl(perThreadRecPtr->epollFd, op, fd, evPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the entry for a handler name in a thread's Event Loop statistics, adding it if necessary.
+ * Must only be called by the thread itself.
+ *
+ * @return Pointer to the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+event_HandlerStats_t* event_GetHandlerStats
+(
+    event_Stats_t* statsPtr,                ///< [in] The thread's statistics.
+    const char* name                        ///< [in] Handler name.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    for (i = 0; i < statsPtr->numHandlers; i++)
+    {
+        if (   (statsPtr->handlers[i].funcPtr == NULL)
+            && (strncmp(statsPtr->handlers[i].name, name, sizeof(statsPtr->handlers[i].name)) == 0))
+        {
+            return &statsPtr->handlers[i];
+        }
+    }
+
+    return AddHandlerStats(statsPtr, name, NULL);
+}
+
+
 // ==============================================
 //  PUBLIC API FUNCTIONS
 // ==============================================
@@ -1091,11 +1940,7 @@ le_event_HandlerRef_t le_event_AddLayeredHandler
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = Lock();
-
-    Event_t* eventPtr = le_ref_Lookup(EventRefMap, eventId);
-
-    Unlock(oldState);
+    Event_t* eventPtr = le_hashmap_Get(EventRefMap, eventId);
 
     LE_ASSERT(eventPtr != NULL);
 
@@ -1111,6 +1956,7 @@ le_event_HandlerRef_t le_event_AddLayeredHandler
     handlerPtr->threadRecPtr = threadRecPtr;
     handlerPtr->eventPtr = eventPtr;
     handlerPtr->contextPtr = NULL;
+    handlerPtr->statsPtr = NULL;
     handlerPtr->firstLayerFunc = firstLayerFunc;
     handlerPtr->secondLayerFunc = secondLayerFunc;
     if (le_utf8_Copy(handlerPtr->name, name, sizeof(handlerPtr->name), NULL) == LE_OVERFLOW)
@@ -1121,17 +1967,18 @@ le_event_HandlerRef_t le_event_AddLayeredHandler
     // Put it on the Thread's Handler List.
     le_dls_Queue(&threadRecPtr->handlerList, &handlerPtr->threadLink);
 
+    // Create a Safe Reference for the Handler.
+    le_event_HandlerRef_t handlerRef = CreateSafeRef(HandlerRefMap, &NextHandlerRefNum, handlerPtr);
+    handlerPtr->safeRef = handlerRef;
+
     // NOTE: We are about to access structures that are shared by multiple threads.
     // Protect this critical section using the mutex.
 
-    oldState = Lock();
+    int oldState = Lock();
 
     // Put it on the Event's Handler List.
     le_dls_Queue(&eventPtr->handlerList, &handlerPtr->eventLink);
-
-    // Create a Safe Reference for the Handler.
-    le_event_HandlerRef_t handlerRef = le_ref_CreateRef(HandlerRefMap, handlerPtr);
-    handlerPtr->safeRef = handlerRef;
+    __atomic_store_n(&eventPtr->handlerCount, eventPtr->handlerCount + 1, __ATOMIC_RELAXED);
 
     Unlock(oldState);
 
@@ -1152,22 +1999,57 @@ void le_event_RemoveHandler
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = Lock();
-
-    Handler_t* handlerPtr = le_ref_Lookup(HandlerRefMap, handlerRef);
+    Handler_t* handlerPtr = le_hashmap_Get(HandlerRefMap, handlerRef);
     LE_FATAL_IF(handlerPtr == NULL, "Handler %p not found.", handlerPtr);
 
     // To prevent races, only the thread that registered the handler can deregister it.
+    // That also means nobody else can delete it between the lookup and here.
     LE_FATAL_IF(handlerPtr->threadRecPtr != thread_GetEventRecPtr(),
                 "Thread '%s' tried to remove a handler owned by another thread.",
                 le_thread_GetMyName());
 
+    int oldState = Lock();
+
     DeleteHandler(handlerPtr);
 
     Unlock(oldState);
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up the Event object for an Event ID that is about to be reported.
+ *
+ * @return Pointer to the Event object.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+static Event_t* GetEventForReport
+(
+    le_event_Id_t   eventId,        ///< [in] The event ID.
+    bool            isRefCounted    ///< [in] true = the report will be a ref-counted object.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Event objects are never deleted, and everything checked here is set when they are created,
+    // so there's no need to lock the Mutex.
+    Event_t* eventPtr = le_hashmap_Get(EventRefMap, eventId);
+
+    LE_FATAL_IF(eventPtr == NULL, "No such event %p.", eventId);
+
+    LE_FATAL_IF(eventPtr->isRefCounted && !isRefCounted,
+                "Attempt to use Event ID (%s) created using le_event_CreateIdWithRefCounting().",
+                eventPtr->name);
+
+    LE_FATAL_IF(!eventPtr->isRefCounted && isRefCounted,
+                "Attempt to use Event ID (%s) created using le_event_CreateId().",
+                eventPtr->name);
+
+    return eventPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Report an Event
@@ -1186,15 +2068,7 @@ void le_event_Report
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = Lock();
-
-    Event_t* eventPtr = le_ref_Lookup(EventRefMap, eventId);
-
-    LE_FATAL_IF(eventPtr == NULL, "No such event %p.", eventId);
-
-    LE_FATAL_IF(eventPtr->isRefCounted,
-                "Attempt to use Event ID (%s) created using le_event_CreateIdWithRefCounting().",
-                eventPtr->name);
+    Event_t* eventPtr = GetEventForReport(eventId, false);
 
     LE_FATAL_IF(eventPtr->payloadSize < payloadSize,
                 "Payload size too big for event '%s' (%zu > %zu).",
@@ -1202,35 +2076,67 @@ void le_event_Report
                 payloadSize,
                 eventPtr->payloadSize);
 
-    TRACE("Reporting event '%s'...", eventPtr->name);
-
-    // For each Handler registered for this Event,
-    le_dls_Link_t* linkPtr = le_dls_Peek(&eventPtr->handlerList);
-    while (linkPtr != NULL)
+    // Nobody is listening, so don't bother copying the payload.  A handler that is being added
+    // by another thread right now would have missed this report anyway, had it come a moment
+    // earlier.
+    if (__atomic_load_n(&eventPtr->handlerCount, __ATOMIC_RELAXED) == 0)
     {
-        Handler_t* handlerPtr = CONTAINER_OF(linkPtr, Handler_t, eventLink);
+        TRACE("No handlers for event '%s'.", eventPtr->name);
+        return;
+    }
 
-        event_PerThreadRec_t* perThreadRecPtr = handlerPtr->threadRecPtr;
+    // Copy the payload once, before locking the Mutex.  All the handlers will share this copy.
+    void* sharedPayloadPtr = le_mem_ForceAlloc(eventPtr->payloadPoolRef);
+    memcpy(sharedPayloadPtr, payloadPtr, payloadSize);
+    memset((uint8_t*)sharedPayloadPtr + payloadSize, 0, eventPtr->payloadSize - payloadSize);
 
-        TRACE("  ...to handler '%s'.", handlerPtr->name);
+    QueueReports(eventPtr, LE_EVENT_REPORT_PLAIN, sharedPayloadPtr);
 
-        // Queue a report to the handler's thread's Event Queue.
-        PubSubEventReport_t* reportObjPtr = le_mem_ForceAlloc(eventPtr->reportPoolRef);
-        reportObjPtr->baseClass.link = LE_SLS_LINK_INIT;
-        reportObjPtr->baseClass.type = LE_EVENT_REPORT_PLAIN;
-        reportObjPtr->handlerRef = handlerPtr->safeRef;
-        memset(reportObjPtr->payload, 0, eventPtr->payloadSize);
-        memcpy(reportObjPtr->payload, payloadPtr, payloadSize);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
+    // Each report has its own reference to the payload now, so drop ours.
+    le_mem_Release(sharedPayloadPtr);
+}
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        WriteEventFd(perThreadRecPtr);
 
-        linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a payload buffer for an event, to be filled in and passed to le_event_ReportZeroCopy().
+ *
+ * @return Pointer to a buffer of the payload size given to le_event_CreateId().  Its contents
+ *         are undefined.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_event_AllocPayload
+(
+    le_event_Id_t   eventId     ///< [in] The event ID.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return le_mem_ForceAlloc(GetEventForReport(eventId, false)->payloadPoolRef);
+}
 
-    Unlock(oldState);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report an Event without copying its payload.
+ *
+ * Does the same thing as le_event_Report(), except that the payload buffer (which must have been
+ * allocated using le_event_AllocPayload() for the same Event ID) is handed over to the Event Loop
+ * API instead of being copied.  The caller must not access the buffer after this.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_ReportZeroCopy
+(
+    le_event_Id_t   eventId,    ///< [in] The event ID.
+    void*           payloadPtr  ///< [in] Payload buffer from le_event_AllocPayload().
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Event_t* eventPtr = GetEventForReport(eventId, false);
+
+    QueueReports(eventPtr, LE_EVENT_REPORT_PLAIN, payloadPtr);
+
+    // Release the reference that the caller handed over to us.
+    le_mem_Release(payloadPtr);
 }
 
 
@@ -1253,45 +2159,9 @@ void le_event_ReportWithRefCounting
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = Lock();
-
-    Event_t* eventPtr = le_ref_Lookup(EventRefMap, eventId);
-
-    LE_FATAL_IF(eventPtr == NULL, "No such event %p.", eventId);
-
-    LE_FATAL_IF(eventPtr->isRefCounted == false,
-                "Attempt to use Event ID (%s) created using le_event_CreateId().",
-                eventPtr->name);
-
-    TRACE("Reporting event '%s'...", eventPtr->name);
-
-    // For each Handler registered for this Event,
-    le_dls_Link_t* linkPtr = le_dls_Peek(&eventPtr->handlerList);
-    while (linkPtr != NULL)
-    {
-        Handler_t* handlerPtr = CONTAINER_OF(linkPtr, Handler_t, eventLink);
-
-        event_PerThreadRec_t* perThreadRecPtr = handlerPtr->threadRecPtr;
-
-        TRACE("  ...to handler '%s'.", handlerPtr->name);
-
-        // Queue a report to the handler's thread's Event Queue.
-        PubSubEventReport_t* reportObjPtr = le_mem_ForceAlloc(eventPtr->reportPoolRef);
-        reportObjPtr->baseClass.link = LE_SLS_LINK_INIT;
-        reportObjPtr->baseClass.type = LE_EVENT_REPORT_COUNTED_REF;
-        reportObjPtr->handlerRef = handlerPtr->safeRef;
-        reportObjPtr->payload[0] = objectPtr;
-        le_mem_AddRef(objectPtr);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
+    Event_t* eventPtr = GetEventForReport(eventId, true);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        WriteEventFd(perThreadRecPtr);
-
-        linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
-    }
-
-    Unlock(oldState);
+    QueueReports(eventPtr, LE_EVENT_REPORT_COUNTED_REF, objectPtr);
 
     // Release our original reference that the caller passed us.
     // Note: It's best to do this outside the critical section so that we don't accidentally
@@ -1318,10 +2188,11 @@ void le_event_SetContextPtr
 {
     int oldState = Lock();
 
-    Handler_t* handlerPtr = le_ref_Lookup(HandlerRefMap, handlerRef);
+    // Hold the Mutex so that the owning thread can't delete the Handler while it's being changed.
+    Handler_t* handlerPtr = le_hashmap_Get(HandlerRefMap, handlerRef);
     LE_FATAL_IF(handlerPtr == NULL, "Handler %p not found.", handlerPtr);
 
-    handlerPtr->contextPtr = contextPtr;
+    __atomic_store_n(&handlerPtr->contextPtr, contextPtr, __ATOMIC_RELAXED);
 
     Unlock(oldState);
 }
@@ -1366,11 +2237,12 @@ void le_event_QueueFunction
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = Lock();
+    // The Event Queues are lock-free, so the Mutex isn't needed.
+    int oldState = DisableCancel();
 
-    QueueFunction(thread_GetEventRecPtr(), func, param1Ptr, param2Ptr);
+    QueueFunction(thread_GetEventRecPtr(), false, func, param1Ptr, param2Ptr);
 
-    Unlock(oldState);
+    RestoreCancel(oldState);
 }
 
 
@@ -1389,11 +2261,73 @@ void le_event_QueueFunctionToThread
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = Lock();
+    // The Event Queues are lock-free, so the Mutex isn't needed.
+    int oldState = DisableCancel();
 
-    QueueFunction(thread_GetOtherEventRecPtr(thread), func, param1Ptr, param2Ptr);
+    QueueFunction(thread_GetOtherEventRecPtr(thread), false, func, param1Ptr, param2Ptr);
 
-    Unlock(oldState);
+    RestoreCancel(oldState);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a function onto the calling thread's urgent Event Queue.  It will be called by the calling
+ * thread's Event Loop ahead of anything on the normal Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_QueueFunctionUrgent
+(
+    le_event_DeferredFunc_t func,       ///< [in] The function to be called later.
+    void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
+    void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int oldState = DisableCancel();
+
+    QueueFunction(thread_GetEventRecPtr(), true, func, param1Ptr, param2Ptr);
+
+    RestoreCancel(oldState);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a function onto a specific thread's urgent Event Queue.  It will be called by that
+ * thread's Event Loop ahead of anything on its normal Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_QueueFunctionToThreadUrgent
+(
+    le_thread_Ref_t         thread,     ///< [in] The thread to queue the function to.
+    le_event_DeferredFunc_t func,       ///< [in] The function.
+    void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
+    void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int oldState = DisableCancel();
+
+    QueueFunction(thread_GetOtherEventRecPtr(thread), true, func, param1Ptr, param2Ptr);
+
+    RestoreCancel(oldState);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the maximum number of Event Reports that the calling thread's Event Loop will process
+ * before it checks its file descriptors again.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_event_SetBatchSize
+(
+    size_t batchSize    ///< [in] Maximum number of reports per batch (0 = no limit).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    thread_GetEventRecPtr()->batchSize = (batchSize == 0 ? SIZE_MAX : batchSize);
 }
 
 
@@ -1417,7 +2351,6 @@ void le_event_RunLoop
 //--------------------------------------------------------------------------------------------------
 {
     event_PerThreadRec_t* perThreadRecPtr = thread_GetEventRecPtr();
-    int epollFd = perThreadRecPtr->epollFd;
     struct epoll_event epollEventList[MAX_EPOLL_EVENTS];
 
     // Make sure nobody calls this function more than once in the same thread.
@@ -1430,35 +2363,31 @@ void le_event_RunLoop
     for (;;)
     {
         // Wait for something to happen on one of the file descriptors that we are monitoring
-        // using our epoll fd.
-        int result = epoll_wait(epollFd, epollEventList, NUM_ARRAY_MEMBERS(epollEventList), -1);
-
-        // If something happened on one or more of the monitored file descriptors,
-        if (result > 0)
+        // using our epoll fd.  If the last batch didn't empty the Event Queue, just check
+        // them without waiting, because the eventfd may not be readable anymore.
+        int timeout = (le_sls_IsEmpty(&perThreadRecPtr->eventQueue.list) ? -1 : 0);
+        int result = WaitForEvents(perThreadRecPtr,
+                                   epollEventList,
+                                   NUM_ARRAY_MEMBERS(epollEventList),
+                                   timeout);
+
+        if ((result > 0) && (perThreadRecPtr->statsPtr != NULL))
         {
-            int i;
+            RecordWakeup(perThreadRecPtr->statsPtr);
+        }
 
+        // If something happened on one or more of the monitored file descriptors, or there's
+        // still work left over from the last batch,
+        if ((result > 0) || ((result == 0) && (timeout == 0)))
+        {
             // Check if someone has cancelled the thread and terminate the thread now, if so.
             pthread_testcancel();
 
-            // For each fd event reported by epoll_wait(), if it is any file descriptor other
-            // than the eventfd (which is used to indicate that there is something on the
-            // Event Queue), queue an Event Report to the Event Queue for that fd.
-            for (i = 0; i < result; i++)
-            {
-                // Get the pointer that we registered with epoll_ctl(2) along with this fd.
-                // The value of this pointer will either be NULL or a Safe Reference for an
-                // FD Monitor object.  If it is NULL, then the Event Queue's eventfd is the
-                // fd that experienced the event.
-                void* safeRef = epollEventList[i].data.ptr;
-
-                if (safeRef != NULL)
-                {
-                    fdMon_Report(safeRef, epollEventList[i].events);
-                }
-            }
+            // Call the handlers for any fd events reported by epoll_wait(), other than on the
+            // eventfd (which is used to indicate that there is something on the Event Queue).
+            DispatchFdEvents(perThreadRecPtr, epollEventList, result);
 
-            // Process all the Event Reports on the Event Queue.
+            // Process a batch of Event Reports from the Event Queues.
             ProcessEventReports(perThreadRecPtr);
         }
         // Otherwise, if an epoll_wait() reported an error, hopefully it's just an interruption
@@ -1502,7 +2431,16 @@ int le_event_GetFd
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return thread_GetEventRecPtr()->epollFd;
+    event_PerThreadRec_t* perThreadRecPtr = thread_GetEventRecPtr();
+
+    if (perThreadRecPtr->ringRef != NULL)
+    {
+        ioUring_Submit(perThreadRecPtr->ringRef);
+
+        return ioUring_GetFd(perThreadRecPtr->ringRef);
+    }
+
+    return perThreadRecPtr->epollFd;
 }
 
 
@@ -1528,37 +2466,35 @@ le_result_t le_event_ServiceLoop
 //--------------------------------------------------------------------------------------------------
 {
     event_PerThreadRec_t* perThreadRecPtr = thread_GetEventRecPtr();
-    int epollFd = perThreadRecPtr->epollFd;
     struct epoll_event epollEventList[MAX_EPOLL_EVENTS];
 
+    // Event handlers must run on the thread's own stack, not on top of a coroutine.
+    LE_FATAL_IF(le_coro_GetCurrent() != NULL,
+                "Event Loop serviced from inside coroutine '%s'.",
+                le_coro_GetName(le_coro_GetCurrent()));
+
     // Ask epoll what, if anything, has happened on any of the file descriptors that we are
     // monitoring using our epoll fd.  (NOTE: This is non-blocking.)
-    int result = epoll_wait(epollFd, epollEventList, NUM_ARRAY_MEMBERS(epollEventList), 0);
+    int result = WaitForEvents(perThreadRecPtr,
+                               epollEventList,
+                               NUM_ARRAY_MEMBERS(epollEventList),
+                               0);
+
+    if ((result > 0) && (perThreadRecPtr->statsPtr != NULL))
+    {
+        RecordWakeup(perThreadRecPtr->statsPtr);
+    }
 
     // If something happened on one or more of the monitored file descriptors,
     if (result > 0)
     {
-        int i;
-
         // Check if someone has cancelled the thread and terminate the thread now, if so.
         pthread_testcancel();
 
-        // For each fd event reported by epoll_wait(), if it is any file descriptor other
-        // than the eventfd (which is used to indicate that there is something on the
-        // Event Queue), queue an Event Report to the Event Queue for that fd.
-        for (i = 0; i < result; i++)
-        {
-            // Get the pointer that we registered with epoll_ctl(2) along with this fd.
-            // The value of this pointer will either be NULL or a Safe Reference for an
-            // FD Monitor object.  If it is NULL, then the Event Queue's eventfd is the
-            // fd that experienced the event, which we will deal with later in this function.
-            void* safeRef = epollEventList[i].data.ptr;
-
-            if (safeRef != NULL)
-            {
-                fdMon_Report(safeRef, epollEventList[i].events);
-            }
-        }
+        // Call the handlers for any fd events reported by epoll_wait(), other than on the
+        // eventfd (which is used to indicate that there is something on the Event Queue, and
+        // which we will deal with later in this function).
+        DispatchFdEvents(perThreadRecPtr, epollEventList, result);
     }
     // Otherwise, if an epoll_wait() reported an error, hopefully it's just an interruption
     // by a signal (EINTR).  Anything else is a fatal error.
@@ -1576,39 +2512,52 @@ le_result_t le_event_ServiceLoop
     // Otherwise, if epoll_wait() returned zero, then either this function was called without
     // waiting for the eventfd to be readable, or the eventfd was readable momentarily, but
     // something changed between the time the application code detected the readable condition
-    // and now that made the eventfd not readable anymore.
-    else
+    // and now that made the eventfd not readable anymore.  Reports left over from the last time
+    // the incoming queue was taken still need processing, though.
+    else if (   le_sls_IsEmpty(&perThreadRecPtr->eventQueue.list)
+             && le_sls_IsEmpty(&perThreadRecPtr->urgentQueue.list))
     {
         LE_DEBUG("epoll_wait() returned zero.");
 
+        // io_uring's fd only becomes readable for polls that have actually been submitted.
+        if (perThreadRecPtr->ringRef != NULL)
+        {
+            ioUring_Submit(perThreadRecPtr->ringRef);
+        }
+
         return LE_WOULD_BLOCK;
     }
 
-    // Read the eventfd to reset it to zero so epoll stops telling us about it until more
-    // are added.
-    (void)ReadEventFd(perThreadRecPtr);
-
-    // If there is something on the Event Queue, process one thing.
-    int oldState = Lock();
-
-    if (!le_sls_IsEmpty(&perThreadRecPtr->eventQueue))
+    // If everything taken off the incoming queues last time has been processed, take them again.
+    // This also resets the eventfd so epoll stops telling us about it until more are added.
+    // Urgent reports are always taken as soon as they arrive.
+    if (le_sls_IsEmpty(&perThreadRecPtr->eventQueue.list))
     {
-        Unlock(oldState);
-
-        ProcessOneEventReport(perThreadRecPtr); // This function assumes the mutex is NOT locked.
+        FetchEventReports(perThreadRecPtr);
+    }
+    else
+    {
+        TakeIncomingReports(&perThreadRecPtr->urgentQueue);
+    }
 
-        oldState = Lock();
+    // If there is something on the Event Queues, process one thing, urgent things first.
+    if (!le_sls_IsEmpty(&perThreadRecPtr->urgentQueue.list))
+    {
+        ProcessOneEventReport(perThreadRecPtr, &perThreadRecPtr->urgentQueue);
+    }
+    else if (!le_sls_IsEmpty(&perThreadRecPtr->eventQueue.list))
+    {
+        ProcessOneEventReport(perThreadRecPtr, &perThreadRecPtr->eventQueue);
     }
 
-    // The caller needs to know if there is more stuff waiting on the Event Queue.
+    // The caller needs to know if there is more stuff waiting on the Event Queues.
     le_result_t returnCode = LE_OK;
-    if (le_sls_IsEmpty(&perThreadRecPtr->eventQueue))
+    if (   IsQueueEmpty(&perThreadRecPtr->eventQueue)
+        && IsQueueEmpty(&perThreadRecPtr->urgentQueue))
     {
         returnCode = LE_WOULD_BLOCK;
     }
 
-    Unlock(oldState);
-
     return returnCode;
 }
 
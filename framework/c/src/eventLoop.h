@@ -12,6 +12,9 @@
 #ifndef LEGATO_SRC_EVENTLOOP_H_INCLUDE_GUARD
 #define LEGATO_SRC_EVENTLOOP_H_INCLUDE_GUARD
 
+#include "ioUring.h"
+#include "limit.h"
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -38,6 +41,97 @@ typedef enum
 event_LoopState_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * One of a thread's Event Queues.  See eventLoop.c for how the two parts are used.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t*      incomingPtr;        ///< Reports pushed by any thread, newest first
+                                            ///  (atomic).
+    le_sls_List_t       list;               ///< Reports taken off the incoming queue, oldest first.
+                                            ///  Only accessed by the thread itself.
+    size_t              length;             ///< Number of reports on the list.
+    size_t              maxLength;          ///< Most reports there have ever been on the list.
+}
+event_Queue_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of buckets in each of the time histograms kept in a thread's Event Loop statistics.
+ * Bucket 0 counts times under 1 microsecond and bucket n counts times from 2^(n-1) up to (but not
+ * including) 2^n microseconds.  The last bucket also counts anything longer than that.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_STATS_HISTOGRAM_BUCKETS   24
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of handlers whose execution times are kept separately in a thread's Event Loop
+ * statistics.  The last entry is shared by all the handlers that don't get one of their own.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_STATS_MAX_HANDLERS        32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Histogram of times, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t            count;              ///< Number of times recorded.
+    uint64_t            totalUsec;          ///< Sum of all the times recorded.
+    uint64_t            maxUsec;            ///< Longest time recorded.
+    uint32_t            buckets[EVENT_STATS_HISTOGRAM_BUCKETS]; ///< See
+                                                                ///< EVENT_STATS_HISTOGRAM_BUCKETS.
+}
+event_Histogram_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Execution time statistics for the handlers with a given name.  Queued functions don't have
+ * names, so they are kept by function address instead.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char                name[LIMIT_MAX_EVENT_HANDLER_NAME_BYTES]; ///< Handler (or FD Monitor) name.
+    void*               funcPtr;            ///< Queued function address (NULL for named handlers).
+    event_Histogram_t   execTime;           ///< How long the handlers took to run.
+}
+event_HandlerStats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A thread's Event Loop statistics.  These are only kept if the LE_EVENT_STATS environment
+ * variable is set (see @ref c_event_stats), and are only ever written by the thread itself.  The
+ * inspect tool reads them from outside the process.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t            wakeupCount;        ///< Number of times the thread has been woken up.
+    uint64_t            wakeupSecond;       ///< CLOCK_MONOTONIC second of the latest wake-up.
+    uint32_t            wakeupsInSecond;    ///< Number of wake-ups in that second.
+    uint64_t            prevWakeupSecond;   ///< The second before that with any wake-ups.
+    uint32_t            wakeupsInPrevSecond;///< Number of wake-ups in that second.
+    uint64_t            startSecond;        ///< CLOCK_MONOTONIC second when the stats started.
+    event_Histogram_t   dispatchLatency;    ///< Time from reports being queued to being processed.
+    event_HandlerStats_t* currentHandlerPtr;///< Stats for the FD Monitor handler running now, if
+                                            ///  any (set by the FD Monitor module).
+    size_t              numHandlers;        ///< Number of entries used in the handler list.
+    event_HandlerStats_t handlers[EVENT_STATS_MAX_HANDLERS]; ///< Per-handler execution times.
+}
+event_Stats_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event Loop's per-thread record.
@@ -51,13 +145,17 @@ event_LoopState_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_sls_List_t       eventQueue;         ///< The thread's event queue.
+    event_Queue_t       eventQueue;         ///< The thread's event queue.
+    event_Queue_t       urgentQueue;        ///< Queue for le_event_QueueFunctionUrgent().
+    size_t              batchSize;          ///< Max. Event Reports processed per epoll_wait().
     le_dls_List_t       handlerList;        ///< List of handlers registered with this thread.
     le_dls_List_t       fdMonitorList;      ///< List of FD Monitors created by this thread.
-    int                 epollFd;            ///< epoll(7) file descriptor.
+    int                 epollFd;            ///< epoll(7) file descriptor (-1 if using io_uring).
+    ioUring_Ref_t       ringRef;            ///< io_uring instance (NULL if using epoll).
     int                 eventQueueFd;       ///< eventfd(2) file descriptor for the Event Queue.
     void*               contextPtr;         ///< Context pointer from last Handler called.
     event_LoopState_t   state;              ///< Current state of the event loop.
+    event_Stats_t*      statsPtr;           ///< Statistics (NULL if not being kept).
 }
 event_PerThreadRec_t;
 
@@ -137,6 +235,38 @@ void event_SetCurrentContextPtr
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds, modifies or removes a file descriptor in the set monitored by a thread's Event Loop.
+ *
+ * Works like epoll_ctl(2), whichever backend the thread is using (see @ref c_event_ioUring).
+ *
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int event_Ctl
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] The thread's Event Loop record.
+    int op,                                 ///< [in] EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL.
+    int fd,                                 ///< [in] File descriptor.
+    struct epoll_event* evPtr               ///< [in] Events and data pointer.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the entry for a handler name in a thread's Event Loop statistics, adding it if necessary.
+ * Must only be called by the thread itself.
+ *
+ * @return Pointer to the entry.
+ */
+//--------------------------------------------------------------------------------------------------
+event_HandlerStats_t* event_GetHandlerStats
+(
+    event_Stats_t* statsPtr,                ///< [in] The thread's statistics.
+    const char* name                        ///< [in] Handler name.
+);
+
 
 
 #endif // LEGATO_SRC_EVENTLOOP_H_INCLUDE_GUARD
@@ -12,10 +12,13 @@
  *
  * When a file descriptor event is detected by the Event Loop, fdMon_Report() is called with
  * the FD Monitor Reference (a safe reference) and a bit map containing the events that were
- * detected.  fdMon_Report() queues a function call (DispatchToHandler()) to the calling thread.
- * When that function gets called, it does a look-up of the safe reference.  If it finds an
- * FD Monitor object matching that reference (it could have been deleted in the meantime), then
- * it calls its registered handler function for that event.
+ * detected.  Because an FD Monitor always belongs to the thread whose Event Loop is monitoring its
+ * fd, fdMon_Report() calls DispatchToHandler() straight away, from the Event Loop's pass over the
+ * epoll_wait() results, rather than queueing an Event Report for it.  So fd events aren't held
+ * up behind other queued work, and don't cost a memory pool allocation and an eventfd write each.
+ * DispatchToHandler() does a look-up of the safe reference.  If it finds an FD Monitor object
+ * matching that reference (it could have been deleted by the handler of an fd that epoll_wait()
+ * reported before this one), then it calls its registered handler function for that event.
  *
  * The reason it was decided not to use Publish-Subscribe Events for this feature is that Event IDs
  * can't be deleted, and yet FD Monitors can.
@@ -23,12 +26,18 @@
  * In some cases (e.g., with regular files), the fd doesn't support epoll().  In those cases, we
  * treat the fd as if it is always ready to be read from and written to.  If either EPOLLIN or
  * EPOLLOUT are enabled in the epoll events set for such an fd, DispatchToHandler() is immediately
- * queued to the thread's Event Queue
+ * queued to the thread's normal Event Queue (rather than the urgent one, which it would
+ * otherwise keep permanently busy)
  *  - When the FD Monitor is created,
  *  - When DispatchToHandler() finishes running the handler function and the FD Monitor has not been
  *      deleted and still has at least one of EPOLLIN or EPOLLOUT enabled.
  *  - When le_fdMonitor_Enable() is called for an FD Monitor from outside that FD Monitor's handler.
  *
+ * An FD Monitor can be switched to edge-triggered mode (see le_fdMonitor_SetEdgeTriggered()), in
+ * which case EPOLLET is added to its epoll events set.  Nothing else changes in here; it is up to
+ * the handler to drain the fd.  Because both epoll and io_uring only let the triggering mode be
+ * chosen when an fd is added, the fd is deleted from the thread's set and added again to switch.
+ *
  * @section fdMonitor_Threads Threads
  *
  * Only the thread that creates an FD Monitor is allowed to perform operations on that FD Monitor,
@@ -90,6 +99,8 @@ typedef struct FdMonitor
 
     le_fdMonitor_HandlerFunc_t  handlerFunc;    ///< Handler function.
     void*                       contextPtr;     ///< The context pointer for this handler.
+    event_HandlerStats_t*       statsPtr;       ///< Entry in the thread's Event Loop statistics
+                                                ///  (NULL if not used yet).
 
     char        name[MAX_FD_MONITOR_NAME_BYTES];            ///< UTF-8 name of this object.
 }
@@ -320,7 +331,7 @@ static void StopMonitoringFd
           fdMonitorPtr->fd,
           fdMonitorPtr->name);
 
-    if (epoll_ctl(fdMonitorPtr->threadRecPtr->epollFd, EPOLL_CTL_DEL, fdMonitorPtr->fd, NULL) == -1)
+    if (event_Ctl(fdMonitorPtr->threadRecPtr, EPOLL_CTL_DEL, fdMonitorPtr->fd, NULL) == -1)
     {
         if (errno == EBADF)
         {
@@ -448,6 +459,18 @@ static void DispatchToHandler
     // Set the thread's event loop Context Pointer.
     event_SetCurrentContextPtr(fdMonitorPtr->contextPtr);
 
+    // If the thread's Event Loop is keeping statistics, have it count the time spent in here
+    // against this FD Monitor's name.
+    event_Stats_t* statsPtr = fdMonitorPtr->threadRecPtr->statsPtr;
+    if (statsPtr != NULL)
+    {
+        if (fdMonitorPtr->statsPtr == NULL)
+        {
+            fdMonitorPtr->statsPtr = event_GetHandlerStats(statsPtr, fdMonitorPtr->name);
+        }
+        statsPtr->currentHandlerPtr = fdMonitorPtr->statsPtr;
+    }
+
     // Call the handler function.
     fdMonitorPtr->handlerFunc(fdMonitorPtr->fd, pollEvents);
 
@@ -460,7 +483,9 @@ static void DispatchToHandler
     // when one of them is re-enabled.
     if ((fdMonitorPtr->isAlwaysReady) && (fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT)))
     {
-        fdMon_Report(fdMonitorPtr->safeRef, fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT));
+        le_event_QueueFunction(DispatchToHandler,
+                               fdMonitorPtr->safeRef,
+                               (void*)(ssize_t)(fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT)));
     }
 
     // Release our reference.  We don't need the Monitor object anymore.
@@ -489,9 +514,7 @@ static void UpdateEpollFd
     ev.events = monitorPtr->epollEvents;
     ev.data.ptr = monitorPtr->safeRef;
 
-    int epollFd = monitorPtr->threadRecPtr->epollFd;
-
-    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, monitorPtr->fd, &ev) == -1)
+    if (event_Ctl(monitorPtr->threadRecPtr, EPOLL_CTL_MOD, monitorPtr->fd, &ev) == -1)
     {
         if (errno == EBADF)
         {
@@ -571,7 +594,8 @@ void fdMon_InitThread
  * Report FD Events.
  *
  * This is called by the Event Loop when it detects events on a file descriptor that is being
- * monitored.
+ * monitored.  The FD Monitor's handler is called before this returns (unless the FD Monitor has
+ * been deleted, or all of the events have been disabled).
  */
 //--------------------------------------------------------------------------------------------------
 void fdMon_Report
@@ -581,7 +605,7 @@ void fdMon_Report
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_event_QueueFunction(DispatchToHandler, safeRef, (void*)(ssize_t)eventFlags);
+    DispatchToHandler(safeRef, (void*)(ssize_t)eventFlags);
 }
 
 
@@ -665,6 +689,7 @@ le_fdMonitor_Ref_t le_fdMonitor_Create
     fdMonitorPtr->threadRecPtr = perThreadRecPtr;
     fdMonitorPtr->handlerFunc = handlerFunc;
     fdMonitorPtr->contextPtr = NULL;
+    fdMonitorPtr->statsPtr = NULL;
 
     // Copy the name into it.
     if (le_utf8_Copy(fdMonitorPtr->name, name, sizeof(fdMonitorPtr->name), NULL) == LE_OVERFLOW)
@@ -685,7 +710,7 @@ le_fdMonitor_Ref_t le_fdMonitor_Create
     memset(&ev, 0, sizeof(ev));
     ev.events = fdMonitorPtr->epollEvents;
     ev.data.ptr = fdMonitorPtr->safeRef;
-    if (epoll_ctl(perThreadRecPtr->epollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+    if (event_Ctl(perThreadRecPtr, EPOLL_CTL_ADD, fd, &ev) == -1)
     {
         if (errno == EPERM)
         {
@@ -696,7 +721,9 @@ le_fdMonitor_Ref_t le_fdMonitor_Create
             uint32_t epollEvents = fdMonitorPtr->epollEvents & (EPOLLIN | EPOLLOUT);
             if (epollEvents != 0)
             {
-                fdMon_Report(fdMonitorPtr->safeRef, epollEvents);
+                le_event_QueueFunction(DispatchToHandler,
+                                       fdMonitorPtr->safeRef,
+                                       (void*)(ssize_t)epollEvents);
             }
         }
         else
@@ -775,7 +802,9 @@ void le_fdMonitor_Enable
         if ((handlerMonitorPtr == NULL) || (handlerMonitorPtr->safeRef == monitorRef))
         {
             // Queue up DispatchToHandler() for this fd.
-            fdMon_Report(monitorRef, epollEvents & (EPOLLIN | EPOLLOUT));
+            le_event_QueueFunction(DispatchToHandler,
+                                   monitorRef,
+                                   (void*)(ssize_t)(epollEvents & (EPOLLIN | EPOLLOUT)));
         }
     }
 
@@ -886,6 +915,79 @@ void le_fdMonitor_SetDeferrable
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets if events on a given fd are edge-triggered (the handler is called when the fd becomes
+ * ready, and not again until it has stopped being ready and become ready again) or level-triggered
+ * (the handler is called for as long as the fd is ready).  FD Monitors are level-triggered when
+ * they are created.
+ *
+ * The handler of an edge-triggered FD Monitor must keep reading from (or writing to) the fd until
+ * it fails with EAGAIN or EWOULDBLOCK, so the fd must be non-blocking.  See
+ * @ref c_fdMonitorEdgeTriggered.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_fdMonitor_SetEdgeTriggered
+(
+    le_fdMonitor_Ref_t monitorRef,      ///< [in] Reference to the File Descriptor Monitor object.
+    bool               isEdgeTriggered  ///< [in] true (edge-triggered) or false (level-triggered).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Look up the File Descriptor Monitor object using the safe reference provided.
+    // Note that the safe reference map is shared by all threads in the process, so it
+    // must be protected using the mutex.  The File Descriptor Monitor objects, on the other
+    // hand, are only allowed to be accessed by the one thread that created them, so it is
+    // safe to unlock the mutex after doing the safe reference lookup.
+    LOCK
+    FdMonitor_t* monitorPtr = le_ref_Lookup(FdMonitorRefMap, monitorRef);
+    UNLOCK
+
+    LE_FATAL_IF(monitorPtr == NULL, "File Descriptor Monitor %p doesn't exist!", monitorRef);
+    LE_FATAL_IF(thread_GetEventRecPtr() != monitorPtr->threadRecPtr,
+                "FD Monitor '%s' (fd %d) is owned by another thread.",
+                monitorPtr->name,
+                monitorPtr->fd);
+
+    if (isEdgeTriggered == ((monitorPtr->epollEvents & EPOLLET) != 0))
+    {
+        return;
+    }
+
+    // Set/clear the EPOLLET flag in the FD Monitor's epoll(7) flags set.
+    if (isEdgeTriggered)
+    {
+        monitorPtr->epollEvents |= EPOLLET;
+    }
+    else
+    {
+        monitorPtr->epollEvents &= ~EPOLLET;
+    }
+
+    // An fd that doesn't support epoll is treated as always ready, whatever the mode.
+    if (monitorPtr->isAlwaysReady)
+    {
+        return;
+    }
+
+    // The mode can't be changed using EPOLL_CTL_MOD with io_uring, so delete the fd from the
+    // thread's set and add it again.  If it is ready now, that will be reported in the new mode.
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = monitorPtr->epollEvents;
+    ev.data.ptr = monitorPtr->safeRef;
+
+    if (   (event_Ctl(monitorPtr->threadRecPtr, EPOLL_CTL_DEL, monitorPtr->fd, NULL) == -1)
+        || (event_Ctl(monitorPtr->threadRecPtr, EPOLL_CTL_ADD, monitorPtr->fd, &ev) == -1) )
+    {
+        LE_FATAL("Failed to change triggering mode of fd %d on monitor '%s'. Errno %d (%m)",
+                 monitorPtr->fd,
+                 monitorPtr->name,
+                 errno);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the Context Pointer for File Descriptor Monitor's handler function.  This can be retrieved
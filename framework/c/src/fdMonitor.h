@@ -58,7 +58,8 @@ void fdMon_InitThread
  * Report FD Events.
  *
  * This is called by the Event Loop when it detects events on a file descriptor that is being
- * monitored.
+ * monitored.  The FD Monitor's handler is called before this returns (unless the FD Monitor has
+ * been deleted, or all of the events have been disabled).
  */
 //--------------------------------------------------------------------------------------------------
 void fdMon_Report
@@ -37,20 +37,32 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Calculate a hash. First this calls the user-supplied hash function.
- * Then it does some defensive coding to avoid bad hashes from outside hash functions
+ * Number of old buckets that are migrated into the new bucket array by each operation that
+ * modifies the map while it is being resized.  This must be large enough that a resize is always
+ * finished before the map can fill up enough to need another one.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define MIGRATE_STEP_BUCKETS    8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish a hash calculated by the user-supplied hash function. This does some defensive coding to
+ * avoid bad hashes from outside hash functions
  *
  * @param map A pointer to the hashmap instance
- * @param key A pointer to the key to hash
+ * @param h The value returned by the map's hash function
  * @return  Returns a new hash
  *
  */
 //--------------------------------------------------------------------------------------------------
-static inline size_t HashKey(Hashmap_t* map, const void* key) {
-    size_t h = map->hashFuncPtr(key);
-
-    // If the Hseih hash has been used then we can just return h
-    if (map->hashFuncPtr == &le_hashmap_HashString) return h;
+static inline size_t FinishHash(Hashmap_t* map, size_t h) {
+    // If one of our own string hashes has been used then we can just return h
+    if ((map->hashFuncPtr == &le_hashmap_HashString) ||
+        (map->hashFuncPtr == &le_hashmap_HashStringFast))
+    {
+        return h;
+    }
 
     // We apply this secondary hashing discovered by Doug Lea to defend
     // against bad hashes. This is important for user-supplied hash fns
@@ -62,6 +74,21 @@ static inline size_t HashKey(Hashmap_t* map, const void* key) {
     return h;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calculate a hash. First this calls the user-supplied hash function.
+ * Then it does some defensive coding to avoid bad hashes from outside hash functions
+ *
+ * @param map A pointer to the hashmap instance
+ * @param key A pointer to the key to hash
+ * @return  Returns a new hash
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t HashKey(Hashmap_t* map, const void* key) {
+    return FinishHash(map, map->hashFuncPtr(key));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a new entry to put in the map. Allocates the entry from the pool which was created
@@ -79,7 +106,7 @@ static inline size_t HashKey(Hashmap_t* map, const void* key) {
 static Entry_t* CreateEntry
 (
     const void* newKeyPtr,
-    int newHash,
+    size_t newHash,
     const void* newValuePtr,
     le_mem_PoolRef_t poolRef
 )
@@ -140,6 +167,427 @@ static inline bool EqualKeys
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the total number of buckets in the map.
+ *
+ * While the map is being resized, the buckets of the old bucket array come first (indices
+ * 0 to oldBucketCount - 1), followed by the buckets of the new bucket array.  When the map isn't
+ * being resized, oldBucketCount is zero, so bucket indices are just indices into bucketsPtr.
+ *
+ * @return The number of buckets.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t TotalBucketCount
+(
+    Hashmap_t* mapPtr
+)
+{
+    return mapPtr->oldBucketCount + mapPtr->bucketCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a bucket's list of entries, given the bucket's index (see TotalBucketCount()).
+ *
+ * @return Pointer to the list.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_dls_List_t* BucketAt
+(
+    Hashmap_t* mapPtr,
+    size_t index
+)
+{
+    if (index < mapPtr->oldBucketCount)
+    {
+        return &(mapPtr->oldBucketsPtr[index]);
+    }
+
+    return &(mapPtr->bucketsPtr[index - mapPtr->oldBucketCount]);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a bucket's chain length counter, given the bucket's index (see TotalBucketCount()).
+ *
+ * @return Pointer to the counter.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t* ChainLengthAt
+(
+    Hashmap_t* mapPtr,
+    size_t index
+)
+{
+    if (index < mapPtr->oldBucketCount)
+    {
+        return &(mapPtr->oldChainLengthPtr[index]);
+    }
+
+    return &(mapPtr->chainLengthPtr[index - mapPtr->oldBucketCount]);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the index of the bucket that holds (or would hold) the entry for a given hash.
+ *
+ * Old buckets are migrated whole, so an entry is in the old bucket array if its old bucket has not
+ * been migrated yet, and in the new bucket array otherwise.
+ *
+ * @return The bucket index (see TotalBucketCount()).
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t BucketIndex
+(
+    Hashmap_t* mapPtr,
+    size_t hash
+)
+{
+    if (mapPtr->oldBucketCount > 0)
+    {
+        size_t oldIndex = CalculateIndex(mapPtr->oldBucketCount, hash);
+
+        if (oldIndex >= mapPtr->migrateIndex)
+        {
+            return oldIndex;
+        }
+    }
+
+    return mapPtr->oldBucketCount + CalculateIndex(mapPtr->bucketCount, hash);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates and initializes a map's bucket array and chain length array.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AllocBuckets
+(
+    Hashmap_t* mapPtr,
+    size_t bucketCount      ///< Must be a power of 2.
+)
+{
+    mapPtr->bucketCount = bucketCount;
+    mapPtr->bucketsPtr = malloc(bucketCount * sizeof(le_dls_List_t));
+    LE_ASSERT(mapPtr->bucketsPtr);
+    mapPtr->chainLengthPtr = malloc(bucketCount * sizeof(size_t));
+    LE_ASSERT(mapPtr->chainLengthPtr);
+
+    size_t i;
+    for (i = 0; i < bucketCount; i++)
+    {
+        mapPtr->bucketsPtr[i] = LE_DLS_LIST_INIT;
+        mapPtr->chainLengthPtr[i] = 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Frees the old bucket array once all of its entries have been migrated (or released).
+ */
+//--------------------------------------------------------------------------------------------------
+static void FreeOldBuckets
+(
+    Hashmap_t* mapPtr
+)
+{
+    free(mapPtr->oldBucketsPtr);
+    free(mapPtr->oldChainLengthPtr);
+    mapPtr->oldBucketsPtr = NULL;
+    mapPtr->oldChainLengthPtr = NULL;
+    mapPtr->oldBucketCount = 0;
+    mapPtr->migrateIndex = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts resizing a map.  The current bucket array becomes the old bucket array and a new, empty
+ * bucket array is allocated.  The entries are then moved over a few buckets at a time by
+ * MigrateBuckets() as the map is modified, so no single operation has to pay for moving them all.
+ *
+ * Bucket indices of the old buckets are unchanged by this, so an iterator that is positioned in
+ * the map stays valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartResize
+(
+    Hashmap_t* mapPtr,
+    size_t newBucketCount   ///< Must be a power of 2.
+)
+{
+    LE_ASSERT(mapPtr->oldBucketCount == 0);
+
+    HASHMAP_TRACE(
+        mapPtr,
+        "Hashmap %s: Resizing from %zu to %zu buckets (%zu entries)",
+        mapPtr->nameStr,
+        mapPtr->bucketCount,
+        newBucketCount,
+        mapPtr->size
+    );
+
+    mapPtr->oldBucketsPtr = mapPtr->bucketsPtr;
+    mapPtr->oldChainLengthPtr = mapPtr->chainLengthPtr;
+    mapPtr->oldBucketCount = mapPtr->bucketCount;
+    mapPtr->migrateIndex = 0;
+
+    AllocBuckets(mapPtr, newBucketCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the entries of up to a given number of old buckets into the new bucket array, and frees
+ * the old bucket array when it is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MoveOldBuckets
+(
+    Hashmap_t* mapPtr,
+    size_t maxCount
+)
+{
+    size_t count;
+    for (count = 0;
+         (count < maxCount) && (mapPtr->migrateIndex < mapPtr->oldBucketCount);
+         count++)
+    {
+        le_dls_List_t* oldListPtr = &(mapPtr->oldBucketsPtr[mapPtr->migrateIndex]);
+        le_dls_Link_t* linkPtr;
+
+        while ((linkPtr = le_dls_Pop(oldListPtr)) != NULL)
+        {
+            Entry_t* entryPtr = CONTAINER_OF(linkPtr, Entry_t, entryListLink);
+            size_t index = CalculateIndex(mapPtr->bucketCount, entryPtr->hash);
+
+            le_dls_Queue(&(mapPtr->bucketsPtr[index]), linkPtr);
+            mapPtr->chainLengthPtr[index]++;
+        }
+        mapPtr->oldChainLengthPtr[mapPtr->migrateIndex] = 0;
+
+        mapPtr->migrateIndex++;
+    }
+
+    if (mapPtr->migrateIndex >= mapPtr->oldBucketCount)
+    {
+        HASHMAP_TRACE(
+            mapPtr,
+            "Hashmap %s: Finished resizing to %zu buckets",
+            mapPtr->nameStr,
+            mapPtr->bucketCount
+        );
+
+        FreeOldBuckets(mapPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the entries of up to MIGRATE_STEP_BUCKETS old buckets into the new bucket array, and
+ * frees the old bucket array when it is empty.
+ *
+ * Nothing is moved while the map's iterator is positioned in the map, because moving entries
+ * between buckets would make it skip or repeat entries.  Lookups work the same either way.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MigrateBuckets
+(
+    Hashmap_t* mapPtr
+)
+{
+    if ((mapPtr->oldBucketCount == 0) || mapPtr->iteratorPtr->isPositioned)
+    {
+        return;
+    }
+
+    MoveOldBuckets(mapPtr, MIGRATE_STEP_BUCKETS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves all of the remaining old buckets into the new bucket array at once, even if the map's
+ * iterator is positioned in the map.  Bucket indices change when the old bucket array goes away,
+ * so the iterator has to start again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishResize
+(
+    Hashmap_t* mapPtr
+)
+{
+    MoveOldBuckets(mapPtr, mapPtr->oldBucketCount);
+
+    if (mapPtr->iteratorPtr->isPositioned)
+    {
+        mapPtr->iteratorPtr->currentIndex = -1;
+        mapPtr->iteratorPtr->isPositioned = false;
+        mapPtr->iteratorPtr->isValueValid = false;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts growing a map if an entry was just added and the map is more than 3/4 full, or starts
+ * shrinking a shrinkable map if an entry was just removed and the map is less than 1/8 full.
+ *
+ * Nothing is done if the map is still finishing a previous resize, unless that resize has been held
+ * up by a positioned iterator for so long that the map needs to grow again.  In that case the
+ * previous resize is finished first (see FinishResize()), so that an iteration which is abandoned
+ * part way through can't stop the map from growing.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckLoad
+(
+    Hashmap_t* mapPtr
+)
+{
+    if (mapPtr->oldBucketCount != 0)
+    {
+        if (mapPtr->size <= (mapPtr->bucketCount / 4) * 3)
+        {
+            return;
+        }
+
+        FinishResize(mapPtr);
+    }
+
+    if (mapPtr->size > (mapPtr->bucketCount / 4) * 3)
+    {
+        StartResize(mapPtr, mapPtr->bucketCount * 2);
+    }
+    else if (   mapPtr->isShrinkable
+             && (mapPtr->bucketCount > mapPtr->minBucketCount)
+             && (mapPtr->size < mapPtr->bucketCount / 8) )
+    {
+        StartResize(mapPtr, mapPtr->bucketCount / 2);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the iterator of a flat map to a given slot, or off the end of the map if the slot index
+ * is negative (see hashmapFlat_NextFull() and hashmapFlat_PrevFull()).
+ *
+ * @return LE_OK if the iterator is on a slot, LE_NOT_FOUND if it went off the end of the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlatMoveIterator
+(
+    le_hashmap_It_Ref_t iteratorRef,
+    ssize_t index
+)
+{
+    if (index < 0)
+    {
+        iteratorRef->isValueValid = false;
+        iteratorRef->isPositioned = false;
+        return LE_NOT_FOUND;
+    }
+
+    iteratorRef->currentIndex = index;
+    iteratorRef->isValueValid = true;
+    iteratorRef->isPositioned = true;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the key and value in the slot after the one holding a given key, in a flat map.
+ *
+ * @return  LE_OK, LE_NOT_FOUND if the key is in the last slot, or LE_BAD_PARAMETER if the key is
+ *          not in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlatGetNodeAfter
+(
+    Hashmap_t* mapPtr,
+    const void* keyPtr,
+    void **nextKeyPtr,
+    void **nextValuePtr
+)
+{
+    FlatSlot_t* slotPtr = hashmapFlat_Find(mapPtr, keyPtr, HashKey(mapPtr, keyPtr));
+
+    if (slotPtr == NULL)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    ssize_t index = hashmapFlat_NextFull(mapPtr, (slotPtr - mapPtr->flat.slotsPtr) + 1);
+
+    if (index < 0)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    slotPtr = &(mapPtr->flat.slotsPtr[index]);
+    *nextKeyPtr = (void *)slotPtr->keyPtr;
+    if (NULL != nextValuePtr)
+    {
+        *nextValuePtr = (void *)slotPtr->valuePtr;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a map and its iterator, and sets up everything except the storage for the entries.
+ *
+ * @return Pointer to the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static Hashmap_t* AllocMap
+(
+    const char*                nameStr,
+    le_hashmap_HashFunc_t      hashFunc,
+    le_hashmap_EqualsFunc_t    equalsFunc
+)
+{
+    LE_ASSERT(hashFunc);
+    LE_ASSERT(equalsFunc);
+
+    // It is ok to use malloc here as we will not be destroying the map
+    le_hashmap_Ref_t mapRef = malloc(sizeof(Hashmap_t));
+    LE_ASSERT(mapRef);
+
+    memset(mapRef, 0, sizeof(Hashmap_t));
+
+    mapRef->traceRef = NULL;
+    mapRef->hashFuncPtr = hashFunc;
+    mapRef->equalsFuncPtr = equalsFunc;
+    mapRef->nameStr = nameStr;
+    mapRef->isShrinkable = false;
+    mapRef->isFlat = false;
+
+    mapRef->iteratorPtr = malloc(sizeof(HashmapIt_t));
+    LE_ASSERT(mapRef->iteratorPtr);
+
+    memset(mapRef->iteratorPtr, 0, sizeof(HashmapIt_t));
+    mapRef->iteratorPtr->theMapPtr = mapRef;
+    mapRef->iteratorPtr->isValueValid = true;
+
+    return mapRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the Hash Map module.  This function must be called at start-up, before any other
+ * Hash Map functions are called.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmap_Init
+(
+    void
+)
+{
+    hashmapConcurrent_InitModule();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a HashMap
@@ -157,14 +605,7 @@ le_hashmap_Ref_t le_hashmap_Create
     le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
 )
 {
-    LE_ASSERT(hashFunc);
-    LE_ASSERT(equalsFunc);
-
-    // It is ok to use malloc here as we will not be destroying the map
-    le_hashmap_Ref_t mapRef = malloc(sizeof(Hashmap_t));
-    LE_ASSERT(mapRef);
-
-    mapRef->traceRef = NULL;
+    le_hashmap_Ref_t mapRef = AllocMap(nameStr, hashFunc, equalsFunc);
 
     /**
      * 0.75 load factor. We have more buckets than expected keys as we want
@@ -174,10 +615,10 @@ le_hashmap_Ref_t le_hashmap_Create
      */
     capacity = (capacity < 3)? 3 : capacity;
     size_t minimumBucketCount = capacity * 4 / 3;
-    mapRef->bucketCount = 1;
-    while (mapRef->bucketCount <= minimumBucketCount) {
+    size_t bucketCount = 1;
+    while (bucketCount <= minimumBucketCount) {
         // Bucket count must be power of 2.
-        mapRef->bucketCount <<= 1;
+        bucketCount <<= 1;
     }
 
     /**
@@ -190,32 +631,66 @@ le_hashmap_Ref_t le_hashmap_Create
     le_utf8_Append(poolName, nameStr, sizeof(poolName), NULL);
     mapRef->entryPoolRef = le_mem_ExpandPool(le_mem_CreatePool(poolName,
                                                                sizeof(Entry_t)),
-                                                               mapRef->bucketCount / 2);
-    le_mem_SetNumObjsToForce(mapRef->entryPoolRef, mapRef->bucketCount / 8);
+                                                               bucketCount / 2);
+    le_mem_SetNumObjsToForce(mapRef->entryPoolRef, bucketCount / 8);
 
-    mapRef->bucketsPtr = malloc(mapRef->bucketCount * sizeof(le_dls_List_t));
-    LE_ASSERT(mapRef->bucketsPtr);
-    mapRef->chainLengthPtr = malloc(mapRef->bucketCount * sizeof(size_t));
-    LE_ASSERT(mapRef->chainLengthPtr);
-    mapRef->iteratorPtr = malloc(sizeof(HashmapIt_t));
-    LE_ASSERT(mapRef->iteratorPtr);
+    /**
+     * The bucket array is replaced by a bigger one when the map fills up past the load factor
+     * (see CheckLoad()), so the capacity is only a hint.  Shrinking is off by default, and never
+     * goes below the bucket count the map was created with.
+     */
+    AllocBuckets(mapRef, bucketCount);
+    mapRef->minBucketCount = bucketCount;
 
-    uint32_t i = 0;
-    for (i=0; i<mapRef->bucketCount; i++)
-    {
-        mapRef->bucketsPtr[i] = LE_DLS_LIST_INIT;
-        mapRef->chainLengthPtr[i] = 0;
-    }
+    return mapRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a flat HashMap.  See @ref c_hashmap_flat.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateFlat
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+{
+    le_hashmap_Ref_t mapRef = AllocMap(nameStr, hashFunc, equalsFunc);
 
-    mapRef->size = 0;
+    mapRef->isFlat = true;
+    hashmapFlat_Init(mapRef, capacity);
 
-    mapRef->hashFuncPtr = hashFunc;
-    mapRef->equalsFuncPtr = equalsFunc;
-    mapRef->nameStr = nameStr;
+    return mapRef;
+}
 
-    memset(mapRef->iteratorPtr, 0, sizeof(HashmapIt_t));
-    mapRef->iteratorPtr->theMapPtr = mapRef;
-    mapRef->iteratorPtr->isValueValid = true;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a concurrent HashMap.  See @ref c_hashmap_concurrent.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t le_hashmap_CreateConcurrent
+(
+    const char*                nameStr,          ///< [in] Name of the HashMap
+    size_t                     capacity,         ///< [in] Expected capacity of the map
+    le_hashmap_HashFunc_t      hashFunc,         ///< [in] The hash function
+    le_hashmap_EqualsFunc_t    equalsFunc        ///< [in] The equality function
+)
+{
+    le_hashmap_Ref_t mapRef = AllocMap(nameStr, hashFunc, equalsFunc);
+
+    mapRef->isConcurrent = true;
+    hashmapConcurrent_Init(mapRef, capacity);
 
     return mapRef;
 }
@@ -237,8 +712,20 @@ void* le_hashmap_Put
     const void* valuePtr       ///< [in] Pointer to the value to be stored
 )
 {
+    if (mapRef->isConcurrent)
+    {
+        return hashmapConcurrent_Put(mapRef, keyPtr, HashKey(mapRef, keyPtr), valuePtr);
+    }
+
+    if (mapRef->isFlat)
+    {
+        return hashmapFlat_Put(mapRef, keyPtr, HashKey(mapRef, keyPtr), valuePtr);
+    }
+
+    MigrateBuckets(mapRef);
+
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = BucketIndex(mapRef, hash);
 
     HASHMAP_TRACE(
         mapRef,
@@ -248,7 +735,7 @@ void* le_hashmap_Put
         (int)hash
     );
 
-    le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
 
     if (le_dls_NumLinks(listHeadPtr) == 0)
     {
@@ -265,7 +752,9 @@ void* le_hashmap_Put
             mapRef->size
         );
 
-        mapRef->chainLengthPtr[index]++;
+        (*ChainLengthAt(mapRef, index))++;
+
+        CheckLoad(mapRef);
 
         return NULL;
     }
@@ -312,16 +801,18 @@ void* le_hashmap_Put
                     mapRef->size
                 );
 
-                mapRef->chainLengthPtr[index]++;
+                (*ChainLengthAt(mapRef, index))++;
 
                 HASHMAP_TRACE(
                     mapRef,
                     "Hashmap %s: Bucket now contains %zu entries (%zu)",
                     mapRef->nameStr,
                     le_dls_NumLinks(listHeadPtr),
-                    mapRef->chainLengthPtr[index]
+                    *ChainLengthAt(mapRef, index)
                 );
 
+                CheckLoad(mapRef);
+
                 return NULL;
             }
 
@@ -346,8 +837,41 @@ void* le_hashmap_Get
     const void* keyPtr         ///< [in] Pointer to the key to be retrieved
 )
 {
-    size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    return le_hashmap_GetWithHash(mapRef, keyPtr, mapRef->hashFuncPtr(keyPtr));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve a value from a HashMap, using a hash of the key that the caller has already calculated.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+void* le_hashmap_GetWithHash
+(
+    le_hashmap_Ref_t mapRef,   ///< [in] Reference to the map
+    const void* keyPtr,        ///< [in] Pointer to the key to be retrieved
+    size_t keyHash             ///< [in] Value returned by the map's hash function for the key
+)
+{
+    size_t hash = FinishHash(mapRef, keyHash);
+
+    if (mapRef->isConcurrent)
+    {
+        const void* valuePtr = NULL;
+        hashmapConcurrent_Find(mapRef, keyPtr, hash, NULL, &valuePtr);
+        return (void*)valuePtr;
+    }
+
+    if (mapRef->isFlat)
+    {
+        FlatSlot_t* slotPtr = hashmapFlat_Find(mapRef, keyPtr, hash);
+        return (slotPtr == NULL) ? NULL : (void*)slotPtr->valuePtr;
+    }
+
+    size_t index = BucketIndex(mapRef, hash);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Generated index of %zu for hash %zu",
@@ -356,7 +880,7 @@ void* le_hashmap_Get
         hash
     );
 
-    le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Looked up list contains %zu links",
@@ -409,7 +933,21 @@ void* le_hashmap_GetStoredKey
 )
 {
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+
+    if (mapRef->isConcurrent)
+    {
+        const void* storedKeyPtr = NULL;
+        hashmapConcurrent_Find(mapRef, keyPtr, hash, &storedKeyPtr, NULL);
+        return (void*)storedKeyPtr;
+    }
+
+    if (mapRef->isFlat)
+    {
+        FlatSlot_t* slotPtr = hashmapFlat_Find(mapRef, keyPtr, hash);
+        return (slotPtr == NULL) ? NULL : (void*)slotPtr->keyPtr;
+    }
+
+    size_t index = BucketIndex(mapRef, hash);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Generated index of %zu for hash %zu",
@@ -418,7 +956,7 @@ void* le_hashmap_GetStoredKey
         hash
     );
 
-    le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Looked up list contains %zu links",
@@ -473,8 +1011,20 @@ void* le_hashmap_Remove
    const void* keyPtr       ///< [in] Pointer to the key to be removed
 )
 {
+    if (mapRef->isConcurrent)
+    {
+        return hashmapConcurrent_Remove(mapRef, keyPtr, HashKey(mapRef, keyPtr));
+    }
+
+    if (mapRef->isFlat)
+    {
+        return hashmapFlat_Remove(mapRef, keyPtr, HashKey(mapRef, keyPtr));
+    }
+
+    MigrateBuckets(mapRef);
+
     int hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = BucketIndex(mapRef, hash);
 
     HASHMAP_TRACE(
         mapRef,
@@ -484,7 +1034,7 @@ void* le_hashmap_Remove
         hash
     );
 
-    le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
     le_dls_Link_t* theLinkPtr = le_dls_Peek(listHeadPtr);
 
     while (theLinkPtr != NULL) {
@@ -506,7 +1056,9 @@ void* le_hashmap_Remove
             le_dls_Remove(listHeadPtr, theLinkPtr);
             le_mem_Release( currentEntryPtr );
             mapRef->size--;
-            mapRef->chainLengthPtr[index]--;
+            (*ChainLengthAt(mapRef, index))--;
+
+            CheckLoad(mapRef);
 
             HASHMAP_TRACE(
                 mapRef,
@@ -542,7 +1094,7 @@ bool le_hashmap_isEmpty
     le_hashmap_Ref_t mapRef    ///< [in] Reference to the map
 )
 {
-    return (mapRef->size == 0);
+    return (le_hashmap_Size(mapRef) == 0);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -559,6 +1111,11 @@ size_t le_hashmap_Size
     le_hashmap_Ref_t mapRef    ///< [in] Reference to the map
 )
 {
+    if (mapRef->isConcurrent)
+    {
+        return hashmapConcurrent_Size(mapRef);
+    }
+
     return mapRef->size;
 }
 
@@ -577,8 +1134,18 @@ bool le_hashmap_ContainsKey
     const void* keyPtr        ///< [in] Pointer to the key to be searched for
 )
 {
+    if (mapRef->isConcurrent)
+    {
+        return hashmapConcurrent_Find(mapRef, keyPtr, HashKey(mapRef, keyPtr), NULL, NULL);
+    }
+
+    if (mapRef->isFlat)
+    {
+        return (hashmapFlat_Find(mapRef, keyPtr, HashKey(mapRef, keyPtr)) != NULL);
+    }
+
     int hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = BucketIndex(mapRef, hash);
 
     HASHMAP_TRACE(
         mapRef,
@@ -588,7 +1155,7 @@ bool le_hashmap_ContainsKey
         hash
     );
 
-    le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
     le_dls_Link_t* theLinkPtr = le_dls_Peek(listHeadPtr);
 
     while (theLinkPtr != NULL) {
@@ -640,10 +1207,23 @@ void le_hashmap_RemoveAll
     mapRef->iteratorPtr->currentListPtr = NULL;
     mapRef->iteratorPtr->currentLinkPtr = NULL;
     mapRef->iteratorPtr->currentEntryPtr = NULL;
+    mapRef->iteratorPtr->isPositioned = false;
+
+    if (mapRef->isConcurrent)
+    {
+        hashmapConcurrent_RemoveAll(mapRef);
+        return;
+    }
 
-    uint32_t i;
-    for (i = 0; i < mapRef->bucketCount; i++) {
-        le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[i]);
+    if (mapRef->isFlat)
+    {
+        hashmapFlat_RemoveAll(mapRef);
+        return;
+    }
+
+    size_t i;
+    for (i = 0; i < TotalBucketCount(mapRef); i++) {
+        le_dls_List_t* listHeadPtr = BucketAt(mapRef, i);
         le_dls_Link_t* theLinkPtr = le_dls_Peek(listHeadPtr);
 
         while (theLinkPtr != NULL) {
@@ -653,11 +1233,17 @@ void le_hashmap_RemoveAll
             le_dls_Remove(listHeadPtr, linkPtrToRemove);
             le_mem_Release( currentEntryPtr );
         }
-        mapRef->bucketsPtr[i] = LE_DLS_LIST_INIT;
-        mapRef->chainLengthPtr[i] = 0;
+        *listHeadPtr = LE_DLS_LIST_INIT;
+        *ChainLengthAt(mapRef, i) = 0;
     }
     mapRef->size=0;
 
+    // Nothing is left to migrate, so any resize in progress is finished.
+    if (mapRef->oldBucketCount != 0)
+    {
+        FreeOldBuckets(mapRef);
+    }
+
     HASHMAP_TRACE(
        mapRef,
        "Hashmap %s: All entries deleted from map",
@@ -682,9 +1268,30 @@ void le_hashmap_ForEach
     void* context                            ///< [in] Pointer to a context to be supplied to the callback
 )
 {
-    uint32_t i;
-    for (i = 0; i < mapRef->bucketCount; i++) {
-        le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[i]);
+    if (mapRef->isConcurrent)
+    {
+        hashmapConcurrent_ForEach(mapRef, forEachFn, context);
+        return;
+    }
+
+    if (mapRef->isFlat)
+    {
+        ssize_t index = hashmapFlat_NextFull(mapRef, 0);
+
+        while (index >= 0)
+        {
+            FlatSlot_t* slotPtr = &(mapRef->flat.slotsPtr[index]);
+            if (!forEachFn(slotPtr->keyPtr, slotPtr->valuePtr, context)) {
+                return;
+            }
+            index = hashmapFlat_NextFull(mapRef, index + 1);
+        }
+        return;
+    }
+
+    size_t i;
+    for (i = 0; i < TotalBucketCount(mapRef); i++) {
+        le_dls_List_t* listHeadPtr = BucketAt(mapRef, i);
         le_dls_Link_t* theLinkPtr = le_dls_Peek(listHeadPtr);
 
         while (theLinkPtr != NULL) {
@@ -714,8 +1321,12 @@ le_hashmap_It_Ref_t le_hashmap_GetIterator
     le_hashmap_Ref_t mapRef                 ///< [in] Reference to the map
 )
 {
+    LE_FATAL_IF(mapRef->isConcurrent,
+                "Hashmap %s: Iterators can't be used on concurrent maps.", mapRef->nameStr);
+
     // Set the counter to -1 so that we know the iterator is at the start
     mapRef->iteratorPtr->currentIndex = -1;
+    mapRef->iteratorPtr->isPositioned = false;
     // Mark the iterator as valid
     mapRef->iteratorPtr->isValueValid = true;
 
@@ -743,9 +1354,17 @@ le_result_t le_hashmap_NextNode
     if (le_hashmap_isEmpty(iteratorRef->theMapPtr))
     {
         iteratorRef->isValueValid = false;
+        iteratorRef->isPositioned = false;
         return LE_NOT_FOUND;
     }
 
+    if (iteratorRef->theMapPtr->isFlat)
+    {
+        return FlatMoveIterator(iteratorRef,
+                                hashmapFlat_NextFull(iteratorRef->theMapPtr,
+                                                     iteratorRef->currentIndex + 1));
+    }
+
     le_dls_Link_t* theLinkPtr = NULL;
 
     // -1 indicates the iterator is new
@@ -759,10 +1378,11 @@ le_result_t le_hashmap_NextNode
         // Find the next list head
         for (
                iteratorRef->currentIndex = iteratorRef->currentIndex + 1;
-               iteratorRef->currentIndex < iteratorRef->theMapPtr->bucketCount;
+               iteratorRef->currentIndex < TotalBucketCount(iteratorRef->theMapPtr);
                iteratorRef->currentIndex++ )
         {
-            le_dls_List_t* listHeadPtr = &(iteratorRef->theMapPtr->bucketsPtr[iteratorRef->currentIndex]);
+            le_dls_List_t* listHeadPtr = BucketAt(iteratorRef->theMapPtr,
+                                                  iteratorRef->currentIndex);
             theLinkPtr = le_dls_Peek(listHeadPtr);
 
             if (NULL != theLinkPtr)
@@ -771,6 +1391,7 @@ le_result_t le_hashmap_NextNode
                 iteratorRef->currentLinkPtr = theLinkPtr;
                 iteratorRef->currentEntryPtr = currentEntryPtr;
                 iteratorRef->currentListPtr = listHeadPtr;
+                iteratorRef->isPositioned = true;
 
                 HASHMAP_TRACE(
                     iteratorRef->theMapPtr,
@@ -787,6 +1408,7 @@ le_result_t le_hashmap_NextNode
         iteratorRef->currentLinkPtr = theLinkPtr;
         iteratorRef->currentEntryPtr = currentEntryPtr;
         // No change to the current list head pointer as we're in the same list
+        iteratorRef->isPositioned = true;
 
         HASHMAP_TRACE(
             iteratorRef->theMapPtr,
@@ -799,6 +1421,7 @@ le_result_t le_hashmap_NextNode
 
     // At the end without finding another entry, need to invalidate the iterator
     iteratorRef->isValueValid = false;
+    iteratorRef->isPositioned = false;
     return LE_NOT_FOUND;
 }
 
@@ -827,11 +1450,38 @@ le_result_t le_hashmap_PrevNode
        )
     {
         iteratorRef->isValueValid = false;
+        iteratorRef->isPositioned = false;
         return LE_NOT_FOUND;
     }
 
-    le_dls_Link_t* theLinkPtr = le_dls_PeekPrev(iteratorRef->currentListPtr,
-                                                iteratorRef->currentLinkPtr);
+    if (iteratorRef->theMapPtr->isFlat)
+    {
+        // If the iterator has run off the end of the map, start again from the last slot.
+        ssize_t index = iteratorRef->isPositioned ?
+                            iteratorRef->currentIndex - 1 :
+                            (ssize_t)iteratorRef->theMapPtr->flat.slotCount - 1;
+
+        if (FlatMoveIterator(iteratorRef, hashmapFlat_PrevFull(iteratorRef->theMapPtr, index))
+            != LE_OK)
+        {
+            iteratorRef->currentIndex = -1;
+            return LE_NOT_FOUND;
+        }
+        return LE_OK;
+    }
+
+    le_dls_Link_t* theLinkPtr = NULL;
+
+    if (iteratorRef->isPositioned)
+    {
+        theLinkPtr = le_dls_PeekPrev(iteratorRef->currentListPtr, iteratorRef->currentLinkPtr);
+    }
+    else
+    {
+        // The iterator has run off the end of the map, and the entry it was last on may have been
+        // migrated to another bucket since, so start again from the tail of the last bucket.
+        iteratorRef->currentIndex = TotalBucketCount(iteratorRef->theMapPtr);
+    }
 
     if (NULL == theLinkPtr)
     {
@@ -841,7 +1491,8 @@ le_result_t le_hashmap_PrevNode
                iteratorRef->currentIndex >= 0;
                iteratorRef->currentIndex-- )
         {
-            le_dls_List_t* listHeadPtr = &(iteratorRef->theMapPtr->bucketsPtr[iteratorRef->currentIndex]);
+            le_dls_List_t* listHeadPtr = BucketAt(iteratorRef->theMapPtr,
+                                                  iteratorRef->currentIndex);
             theLinkPtr = le_dls_PeekTail(listHeadPtr);
 
             if (NULL != theLinkPtr)
@@ -850,6 +1501,7 @@ le_result_t le_hashmap_PrevNode
                 iteratorRef->currentLinkPtr = theLinkPtr;
                 iteratorRef->currentEntryPtr = currentEntryPtr;
                 iteratorRef->currentListPtr = listHeadPtr;
+                iteratorRef->isPositioned = true;
 
                 HASHMAP_TRACE(
                     iteratorRef->theMapPtr,
@@ -866,6 +1518,7 @@ le_result_t le_hashmap_PrevNode
         iteratorRef->currentLinkPtr = theLinkPtr;
         iteratorRef->currentEntryPtr = currentEntryPtr;
         // No change to the current list head pointer as we're in the same list
+        iteratorRef->isPositioned = true;
 
         HASHMAP_TRACE(
             iteratorRef->theMapPtr,
@@ -878,6 +1531,7 @@ le_result_t le_hashmap_PrevNode
 
     // At the beginning, without finding another entry, need to invalidate the iterator.
     iteratorRef->isValueValid = false;
+    iteratorRef->isPositioned = false;
     return LE_NOT_FOUND;
 }
 
@@ -897,6 +1551,11 @@ const void* le_hashmap_GetKey
 {
     if (!iteratorRef->isValueValid || (iteratorRef->currentIndex == -1)) return NULL;
 
+    if (iteratorRef->theMapPtr->isFlat)
+    {
+        return iteratorRef->theMapPtr->flat.slotsPtr[iteratorRef->currentIndex].keyPtr;
+    }
+
     return iteratorRef->currentEntryPtr->keyPtr;
 }
 
@@ -916,6 +1575,11 @@ void* le_hashmap_GetValue
     if (!iteratorRef->isValueValid || (iteratorRef->currentIndex == -1)) return NULL;
 
     // Need to cast away the const
+    if (iteratorRef->theMapPtr->isFlat)
+    {
+        return (void*)iteratorRef->theMapPtr->flat.slotsPtr[iteratorRef->currentIndex].valuePtr;
+    }
+
     return (void*)iteratorRef->currentEntryPtr->valuePtr;
 }
 
@@ -939,6 +1603,9 @@ le_result_t le_hashmap_GetFirstNode
     void **firstValuePtr       ///> [out] Pointer to the first value
 )
 {
+    LE_FATAL_IF(mapRef->isConcurrent,
+                "Hashmap %s: Iterators can't be used on concurrent maps.", mapRef->nameStr);
+
     // If the map is empty immediately return LE_NOT_FOUND
     if (le_hashmap_isEmpty(mapRef))
     {
@@ -952,14 +1619,25 @@ le_result_t le_hashmap_GetFirstNode
         return LE_BAD_PARAMETER;
     }
 
+    if (mapRef->isFlat)
+    {
+        FlatSlot_t* slotPtr = &(mapRef->flat.slotsPtr[hashmapFlat_NextFull(mapRef, 0)]);
+        *firstKeyPtr = (void *)slotPtr->keyPtr;
+        if (NULL != firstValuePtr)
+        {
+            *firstValuePtr = (void *)slotPtr->valuePtr;
+        }
+        return LE_OK;
+    }
+
     // Find the first list head
     size_t index = 0;
     for (
            ;
-           index < mapRef->bucketCount;
+           index < TotalBucketCount(mapRef);
            index++ )
     {
-        le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+        le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
         le_dls_Link_t* theLinkPtr = le_dls_Peek(listHeadPtr);
 
         if (NULL != theLinkPtr)
@@ -995,6 +1673,9 @@ le_result_t le_hashmap_GetNodeAfter
     void **nextValuePtr        ///> [out] Pointer to the first value
 )
 {
+    LE_FATAL_IF(mapRef->isConcurrent,
+                "Hashmap %s: Iterators can't be used on concurrent maps.", mapRef->nameStr);
+
     // If the map is empty or the key is invalid
     if (
           (le_hashmap_isEmpty(mapRef)) ||
@@ -1005,9 +1686,14 @@ le_result_t le_hashmap_GetNodeAfter
         return LE_BAD_PARAMETER;
     }
 
+    if (mapRef->isFlat)
+    {
+        return FlatGetNodeAfter(mapRef, keyPtr, nextKeyPtr, nextValuePtr);
+    }
+
     // Find the node pointed to by the key
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = BucketIndex(mapRef, hash);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Generated index of %zu for hash %zu",
@@ -1016,7 +1702,7 @@ le_result_t le_hashmap_GetNodeAfter
         hash
     );
 
-    le_dls_List_t* listHeadPtr = &(mapRef->bucketsPtr[index]);
+    le_dls_List_t* listHeadPtr = BucketAt(mapRef, index);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Looked up list contains %zu links",
@@ -1047,10 +1733,10 @@ le_result_t le_hashmap_GetNodeAfter
                 // Find the next list head
                 for (
                        index++;
-                       index < mapRef->bucketCount;
+                       index < TotalBucketCount(mapRef);
                        index++ )
                 {
-                    listHeadPtr = &(mapRef->bucketsPtr[index]);
+                    listHeadPtr = BucketAt(mapRef, index);
                     theLinkPtr = le_dls_Peek(listHeadPtr);
 
                     if (NULL != theLinkPtr)
@@ -1101,16 +1787,45 @@ size_t le_hashmap_CountCollisions
     le_hashmap_Ref_t mapRef     ///< [in] Reference to the map
 )
 {
+    if (mapRef->isConcurrent)
+    {
+        return hashmapConcurrent_CountCollisions(mapRef);
+    }
+
+    if (mapRef->isFlat)
+    {
+        return hashmapFlat_CountCollisions(mapRef);
+    }
+
     size_t i, collCount = 0;
-    for (i = 0; i < mapRef->bucketCount; i++) {
-        if (mapRef->chainLengthPtr[i] > 1) {
-            collCount += mapRef->chainLengthPtr[i] - 1;
+    for (i = 0; i < TotalBucketCount(mapRef); i++) {
+        size_t chainLength = *ChainLengthAt(mapRef, i);
+        if (chainLength > 1) {
+            collCount += chainLength - 1;
         }
     }
     return collCount;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allows or prevents a HashMap from shrinking its bucket array when entries are removed.
+ *
+ * A shrinkable map halves its bucket array when it becomes less than 1/8 full, but never goes
+ * below the number of buckets it was created with.  Maps are not shrinkable by default.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_hashmap_SetAutoShrink
+(
+    le_hashmap_Ref_t mapRef,    ///< [in] Reference to the map
+    bool isShrinkable           ///< [in] true to allow the map to shrink, false to prevent it
+)
+{
+    mapRef->isShrinkable = isShrinkable;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * String hashing function. This can be used as a parameter to le_hashmap_Create if the key to
@@ -1130,6 +1845,169 @@ size_t le_hashmap_HashString
     return SuperFastHash(stringToHashPtr, len);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Constants used by le_hashmap_HashStringFast().  These are the odd 64-bit primes used by wyhash.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FAST_HASH_P0    UINT64_C(0xa0761d6478bd642f)
+#define FAST_HASH_P1    UINT64_C(0xe7037ed1a0b428db)
+#define FAST_HASH_P2    UINT64_C(0x8ebc6af09c88c6e3)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Multiplies two 64-bit values and folds the 128-bit product into 64 bits by XORing its halves.
+ *
+ * @return  The folded product.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t FastHashMix
+(
+    uint64_t a,
+    uint64_t b
+)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t product = (__uint128_t)a * b;
+
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    // No 128-bit type (32-bit targets), so build the product from 32-bit partial products.
+    uint64_t aHi = a >> 32, aLo = (uint32_t)a;
+    uint64_t bHi = b >> 32, bLo = (uint32_t)b;
+    uint64_t hiHi = aHi * bHi;
+    uint64_t hiLo = aHi * bLo;
+    uint64_t loHi = aLo * bHi;
+    uint64_t loLo = aLo * bLo;
+    uint64_t lo = loLo + (hiLo << 32);
+    uint64_t carry = (lo < loLo);
+    uint64_t sum = lo + (loHi << 32);
+
+    carry += (sum < lo);
+
+    return sum ^ (hiHi + (hiLo >> 32) + (loHi >> 32) + carry);
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads up to eight bytes of a string, one byte at a time, stopping at the null terminator.
+ * Bytes are packed little-endian so that the result is the same as an eight-byte load on a
+ * little-endian machine.
+ *
+ * @return  The number of non-null bytes read (8 if no terminator was found).
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t FastHashReadBytes
+(
+    const uint8_t* bytePtr,     ///< [in] Bytes to read.
+    uint64_t* wordPtr           ///< [out] The bytes read, zero-padded.
+)
+{
+    uint64_t word = 0;
+    size_t count;
+
+    for (count = 0; (count < 8) && (bytePtr[count] != '\0'); count++)
+    {
+        word |= (uint64_t)bytePtr[count] << (8 * count);
+    }
+
+    *wordPtr = word;
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads up to eight bytes of a string, stopping at the null terminator.
+ *
+ * On little-endian machines this is done with a single eight-byte load, as long as the load
+ * can't cross into the next page.  Those loads may read past the terminator, but never into memory
+ * that isn't mapped, and the extra bytes are masked off before they are used.
+ *
+ * @return  The number of non-null bytes read (8 if no terminator was found).
+ */
+//--------------------------------------------------------------------------------------------------
+#if defined(__SANITIZE_ADDRESS__)
+__attribute__((no_sanitize_address))
+#endif
+static inline size_t FastHashReadWord
+(
+    const uint8_t* bytePtr,     ///< [in] Bytes to read.
+    uint64_t* wordPtr           ///< [out] The bytes read, zero-padded.
+)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) && \
+    !defined(__SANITIZE_ADDRESS__)
+    // Smallest page size on any supported target.
+    const uintptr_t pageSize = 4096;
+
+    if (((uintptr_t)bytePtr & (pageSize - 1)) <= (pageSize - sizeof(uint64_t)))
+    {
+        const uint64_t ones = UINT64_C(0x0101010101010101);
+        const uint64_t highs = UINT64_C(0x8080808080808080);
+        uint64_t word;
+
+        memcpy(&word, bytePtr, sizeof(word));
+
+        // Sets the high bit of the first zero byte (and possibly some after it).
+        uint64_t zeroBits = (word - ones) & ~word & highs;
+        if (zeroBits == 0)
+        {
+            *wordPtr = word;
+            return 8;
+        }
+
+        size_t count = __builtin_ctzll(zeroBits) / 8;
+        *wordPtr = (count == 0) ? 0 : (word & (UINT64_MAX >> (64 - 8 * count)));
+        return count;
+    }
+#endif
+
+    return FastHashReadBytes(bytePtr, wordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Single-pass string hashing function.  Can be used as a parameter to le_hashmap_Create() in place
+ * of le_hashmap_HashString().
+ *
+ * The string is read eight bytes at a time and its length is found along the way, so each byte is
+ * only visited once.  The mixing is that of wyhash (multiply-and-fold), which distributes short,
+ * similar keys (service names, AT commands, paths) well.
+ *
+ * @return  Returns the hash value of the string pointed to by stringToHash
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+size_t le_hashmap_HashStringFast
+(
+    const void* stringToHashPtr    ///< [in] Pointer to the string to be hashed
+)
+{
+    const uint8_t* bytePtr = stringToHashPtr;
+    uint64_t hash = FAST_HASH_P0;
+    uint64_t len = 0;
+    uint64_t word;
+    size_t count;
+
+    do
+    {
+        count = FastHashReadWord(bytePtr, &word);
+        if (count > 0)
+        {
+            hash = FastHashMix(word ^ FAST_HASH_P1, hash ^ FAST_HASH_P0);
+        }
+        bytePtr += count;
+        len += count;
+    }
+    while (count == 8);
+
+    hash = FastHashMix(hash ^ len, FAST_HASH_P2);
+
+    return (size_t)(hash ^ (hash >> 32));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * String equality function. This can be used as a paramter to le_hashmap_Create if the key to
@@ -1250,7 +2128,7 @@ void le_hashmap_MakeTraceable
         mapRef->traceRef,
         "Hashmap %s: Bucket count calculated as %zd",
         mapRef->nameStr,
-        mapRef->bucketCount
+        mapRef->isFlat ? mapRef->flat.slotCount : mapRef->bucketCount
     );
 }
 
@@ -20,6 +20,43 @@ struct Entry {
     le_dls_Link_t entryListLink;
 };
 
+/**
+ * A slot in the slot array of a flat hashmap.
+ */
+typedef struct
+{
+    const void* keyPtr;
+    const void* valuePtr;
+    size_t hash;
+}
+FlatSlot_t;
+
+/**
+ * Storage for a flat (open addressing) hashmap.  The slots are divided into groups of
+ * FLAT_GROUP_SIZE, and each slot has a control byte that says whether it is empty, deleted, or full
+ * (in which case it holds 7 bits of the key's hash), so that a whole group can be checked for a
+ * key with a few vector instructions.
+ */
+typedef struct
+{
+    int8_t* ctrlPtr;                ///< Control byte of each slot.
+    FlatSlot_t* slotsPtr;           ///< Keys, values and hashes, in the same order as ctrlPtr.
+    size_t slotCount;               ///< Number of slots (a power of 2, at least FLAT_GROUP_SIZE).
+    size_t emptyCount;              ///< Number of slots whose control byte is CTRL_EMPTY.
+    size_t minSlotCount;            ///< Slot count the map was created with.
+}
+HashmapFlat_t;
+
+/**
+ * Storage for a concurrent hashmap (defined in hashmapConcurrent.c).
+ */
+typedef struct HashmapConcurrent HashmapConcurrent_t;
+
+/**
+ * Number of slots in a flat hashmap group.
+ */
+#define FLAT_GROUP_SIZE 16
+
 /**
  * A hashmap iterator
  */
@@ -30,6 +67,7 @@ typedef struct le_hashmap_It {
     le_dls_Link_t* currentLinkPtr;
     Entry_t* currentEntryPtr;
     bool isValueValid;
+    bool isPositioned;              ///< true while the iterator refers to a bucket in the map.
 }
 HashmapIt_t;
 
@@ -47,6 +85,16 @@ typedef struct le_hashmap {
     const char* nameStr;
     HashmapIt_t* iteratorPtr;
     le_log_TraceRef_t traceRef;
+    le_dls_List_t* oldBucketsPtr;   ///< Buckets being migrated out of while resizing (or NULL).
+    size_t* oldChainLengthPtr;      ///< Chain lengths of the buckets being migrated out of.
+    size_t oldBucketCount;          ///< Number of old buckets (0 if not resizing).
+    size_t migrateIndex;            ///< Index of the next old bucket to be migrated.
+    size_t minBucketCount;          ///< Bucket count the map was created with.
+    bool isShrinkable;              ///< true if the map gives back buckets when it empties out.
+    bool isFlat;                    ///< true if created by le_hashmap_CreateFlat().
+    HashmapFlat_t flat;             ///< Slot storage, if isFlat (the bucket fields are unused).
+    bool isConcurrent;              ///< true if created by le_hashmap_CreateConcurrent().
+    HashmapConcurrent_t* concPtr;   ///< Storage, if isConcurrent (the bucket fields are unused).
 }
 Hashmap_t;
 
@@ -62,4 +110,236 @@ void hashmap_Init
     void
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up the slot storage of a flat hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapFlat_Init
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    size_t capacity         ///< [in] Expected number of entries.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a key-value pair to a flat hashmap, or replaces the value if the key is already there.
+ *
+ * @return The replaced value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapFlat_Put
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash,            ///< [in] Hash of the key.
+    const void* valuePtr    ///< [in] The value.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up a key in a flat hashmap.
+ *
+ * @return Pointer to the slot holding the key, or NULL if the key is not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+FlatSlot_t* hashmapFlat_Find
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash             ///< [in] Hash of the key.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a key from a flat hashmap.
+ *
+ * @return The key's value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapFlat_Remove
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash             ///< [in] Hash of the key.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes all keys from a flat hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapFlat_RemoveAll
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first full slot of a flat hashmap at or after a given slot index.
+ *
+ * @return The index of the slot, or -1 if there are no more full slots.
+ **/
+//--------------------------------------------------------------------------------------------------
+ssize_t hashmapFlat_NextFull
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    size_t index            ///< [in] Index of the first slot to check.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the last full slot of a flat hashmap at or before a given slot index.
+ *
+ * @return The index of the slot, or -1 if there are no more full slots.
+ **/
+//--------------------------------------------------------------------------------------------------
+ssize_t hashmapFlat_PrevFull
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    ssize_t index           ///< [in] Index of the first slot to check.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts the collisions in a flat hashmap (keys whose probe sequences start at the same group).
+ *
+ * @return The number of collisions.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t hashmapFlat_CountCollisions
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the concurrent hashmap storage module.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_InitModule
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up the storage of a concurrent hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_Init
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    size_t capacity         ///< [in] Expected number of entries.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up a key in a concurrent hashmap.  Doesn't block.
+ *
+ * @return true if the key was found.
+ **/
+//--------------------------------------------------------------------------------------------------
+bool hashmapConcurrent_Find
+(
+    Hashmap_t* mapPtr,          ///< [in] The map.
+    const void* keyPtr,         ///< [in] The key.
+    size_t hash,                ///< [in] Hash of the key.
+    const void** storedKeyPtrPtr,   ///< [out] The key that was stored in the map (can be NULL).
+    const void** valuePtrPtr    ///< [out] The key's value (can be NULL).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a key-value pair to a concurrent hashmap, or replaces the value if the key is already there.
+ *
+ * @return The replaced value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapConcurrent_Put
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash,            ///< [in] Hash of the key.
+    const void* valuePtr    ///< [in] The value.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a key from a concurrent hashmap.
+ *
+ * @return The key's value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapConcurrent_Remove
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash             ///< [in] Hash of the key.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes all keys from a concurrent hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_RemoveAll
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of keys in a concurrent hashmap.
+ *
+ * @return The number of keys.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t hashmapConcurrent_Size
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a function for each key-value pair in a concurrent hashmap, until it returns false.  Keys
+ * that are put or removed by other threads while this is going on may or may not be visited.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_ForEach
+(
+    Hashmap_t* mapPtr,                      ///< [in] The map.
+    le_hashmap_ForEachHandler_t forEachFn,  ///< [in] The function.
+    void* contextPtr                        ///< [in] Context pointer to pass to the function.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts the collisions in a concurrent hashmap (keys that share a bucket with another key).
+ *
+ * @return The number of collisions.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t hashmapConcurrent_CountCollisions
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+);
+
 #endif // _LEGATO_HASHMAP_H_INCLUDE_GUARD
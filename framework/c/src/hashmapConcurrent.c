@@ -0,0 +1,959 @@
+/** @file hashmapConcurrent.c
+ *
+ * Storage for hash maps created using le_hashmap_CreateConcurrent(), which can be used by several
+ * threads at once.
+ *
+ * Entries are kept in bucket chains hanging off a table, like the chained maps, except that the
+ * chains are singly linked and are only ever changed by storing a single pointer.  Readers don't
+ * take any lock: they follow the chains using acquire loads, so they always see a chain either
+ * before or after a writer's change, never half way through.  Writers take one of STRIPE_COUNT
+ * stripe locks, selected by the low bits of the key's hash.  The bucket count is always a
+ * multiple of STRIPE_COUNT, so all the keys in a bucket are covered by the same stripe lock.
+ *
+ * A node that has been unlinked from its chain may still be in use by a reader that was walking
+ * the chain at the time, so it can't be released right away.  Instead, it is retired and released
+ * later, once all such readers are done (epoch-based reclamation):
+ *  - There is a global epoch number.
+ *  - Each thread that reads a concurrent map publishes the global epoch it saw when it started
+ *    reading, and clears it when it is done.
+ *  - A retired node is tagged with the global epoch at the time it was retired.
+ *  - The global epoch is only moved forward when every thread that is reading has seen the current
+ *    value, so while a reader is active the global epoch can't get more than one ahead of it.
+ *  - A node retired at epoch E can therefore be released once the global epoch reaches E + 2.
+ *
+ * The table is replaced by one twice the size when any stripe fills up past the load factor.  The
+ * writer doing this holds all the stripe locks, copies every entry into new nodes on the new table,
+ * switches readers over to the new table, and retires the old table along with all of its nodes.
+ * Concurrent maps never shrink.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include "limit.h"
+#include "hashmap.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of stripe locks per map.  Must be a power of 2.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define STRIPE_COUNT            16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of nodes a stripe lets pile up on its retired list before it tries to release them.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define RECLAIM_BATCH           16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a cache line.  Each stripe gets its own so that writers using different stripes don't
+ * slow each other down.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define CACHE_LINE_BYTES        64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A key-value pair in a bucket chain.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct ConcurrentNode
+{
+    const void* keyPtr;
+    const void* valuePtr;                   ///< Accessed atomically (may be replaced by Put).
+    size_t hash;
+    struct ConcurrentNode* nextPtr;         ///< Next node in the chain.  Accessed atomically.
+    struct ConcurrentNode* retiredNextPtr;  ///< Next node on the stripe's retired list.
+    uint64_t retiredEpoch;                  ///< Global epoch when the node was retired.
+}
+Node_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A table of bucket chains.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct ConcurrentTable
+{
+    struct ConcurrentTable* retiredNextPtr; ///< Next table on the map's retired list.
+    uint64_t retiredEpoch;                  ///< Global epoch when the table was retired.
+    size_t bucketCount;                     ///< Number of buckets (a power of 2).
+    Node_t* buckets[];                      ///< First node of each chain.  Accessed atomically.
+}
+Table_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A stripe lock, and the writer state it protects.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pthread_mutex_t mutex;
+    size_t count;                   ///< Number of keys in this stripe.  Read atomically by Size.
+    Node_t* retiredHeadPtr;         ///< Oldest retired node not yet released.
+    Node_t* retiredTailPtr;         ///< Newest retired node not yet released.
+    size_t retiredCount;            ///< Number of nodes on the retired list.
+}
+__attribute__((aligned(CACHE_LINE_BYTES)))
+Stripe_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Storage for a concurrent hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+struct HashmapConcurrent
+{
+    Stripe_t stripes[STRIPE_COUNT];
+    Table_t* tablePtr;              ///< Current table.  Accessed atomically.
+    Table_t* retiredTablesPtr;      ///< Old tables not yet released (only used with all stripes
+                                    ///  locked).
+    le_mem_PoolRef_t nodePool;      ///< Pool of Node_t.
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Per-thread reader record, used to hold back the global epoch while the thread is reading.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;             ///< Link in the ReaderList.
+    uint64_t state;                 ///< (epoch << 1) | 1 while reading, 0 otherwise.  Accessed
+                                    ///  atomically.
+    unsigned int nestCount;         ///< Number of nested reads in progress.
+}
+ReaderRec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Global epoch.  Accessed atomically.
+ **/
+//--------------------------------------------------------------------------------------------------
+static uint64_t GlobalEpoch = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the reader records of all threads that have read a concurrent map, and the mutex that
+ * protects it.
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t ReaderList = LE_DLS_LIST_INIT;
+static pthread_mutex_t ReaderListMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread-local data key for the calling thread's reader record, and the pool the records come from.
+ **/
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t ReaderRecKey;
+static le_mem_PoolRef_t ReaderRecPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a thread's reader record from the ReaderList when the thread dies.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ReaderRecDestructor
+(
+    void* recPtr
+)
+{
+    ReaderRec_t* readerRecPtr = recPtr;
+
+    LE_ASSERT(pthread_mutex_lock(&ReaderListMutex) == 0);
+    le_dls_Remove(&ReaderList, &readerRecPtr->link);
+    LE_ASSERT(pthread_mutex_unlock(&ReaderListMutex) == 0);
+
+    le_mem_Release(readerRecPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's reader record, creating it the first time.
+ **/
+//--------------------------------------------------------------------------------------------------
+static ReaderRec_t* GetReaderRec
+(
+    void
+)
+{
+    ReaderRec_t* recPtr = pthread_getspecific(ReaderRecKey);
+
+    if (recPtr == NULL)
+    {
+        recPtr = le_mem_ForceAlloc(ReaderRecPool);
+        recPtr->link = LE_DLS_LINK_INIT;
+        recPtr->state = 0;
+        recPtr->nestCount = 0;
+
+        LE_ASSERT(pthread_mutex_lock(&ReaderListMutex) == 0);
+        le_dls_Queue(&ReaderList, &recPtr->link);
+        LE_ASSERT(pthread_mutex_unlock(&ReaderListMutex) == 0);
+
+        LE_ASSERT(pthread_setspecific(ReaderRecKey, recPtr) == 0);
+    }
+
+    return recPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a read.  Nothing that is retired after this is released until EndRead() is called.
+ *
+ * @return The calling thread's reader record, to pass to EndRead().
+ **/
+//--------------------------------------------------------------------------------------------------
+static ReaderRec_t* StartRead
+(
+    void
+)
+{
+    ReaderRec_t* recPtr = GetReaderRec();
+
+    if (recPtr->nestCount++ == 0)
+    {
+        // Keep publishing the global epoch until it is still current after publishing it.  Once
+        // that's true, the global epoch can't move more than one step past this thread's epoch
+        // until this thread is done reading.
+        uint64_t epoch = __atomic_load_n(&GlobalEpoch, __ATOMIC_SEQ_CST);
+        for (;;)
+        {
+            __atomic_store_n(&recPtr->state, (epoch << 1) | 1, __ATOMIC_SEQ_CST);
+
+            uint64_t newEpoch = __atomic_load_n(&GlobalEpoch, __ATOMIC_SEQ_CST);
+            if (newEpoch == epoch)
+            {
+                break;
+            }
+            epoch = newEpoch;
+        }
+    }
+
+    return recPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ends a read started by StartRead().
+ **/
+//--------------------------------------------------------------------------------------------------
+static void EndRead
+(
+    ReaderRec_t* recPtr
+)
+{
+    if (--recPtr->nestCount == 0)
+    {
+        __atomic_store_n(&recPtr->state, 0, __ATOMIC_RELEASE);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the global epoch forward, if every thread that is reading has seen its current value.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void TryAdvanceEpoch
+(
+    void
+)
+{
+    uint64_t epoch = __atomic_load_n(&GlobalEpoch, __ATOMIC_SEQ_CST);
+    bool canAdvance = true;
+
+    LE_ASSERT(pthread_mutex_lock(&ReaderListMutex) == 0);
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ReaderList);
+    while (linkPtr != NULL)
+    {
+        ReaderRec_t* recPtr = CONTAINER_OF(linkPtr, ReaderRec_t, link);
+        uint64_t state = __atomic_load_n(&recPtr->state, __ATOMIC_SEQ_CST);
+
+        if (((state & 1) != 0) && ((state >> 1) != epoch))
+        {
+            canAdvance = false;
+            break;
+        }
+
+        linkPtr = le_dls_PeekNext(&ReaderList, linkPtr);
+    }
+
+    LE_ASSERT(pthread_mutex_unlock(&ReaderListMutex) == 0);
+
+    if (canAdvance)
+    {
+        // Somebody else may have got there first, which is just as good.
+        __atomic_compare_exchange_n(&GlobalEpoch, &epoch, epoch + 1, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current global epoch, for tagging something that has just been unlinked.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t RetireEpoch
+(
+    void
+)
+{
+    // Make sure the unlinking is visible before the epoch is read.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    return __atomic_load_n(&GlobalEpoch, __ATOMIC_SEQ_CST);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether something retired at a given epoch can no longer be seen by any reader.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline bool IsReleasable
+(
+    uint64_t retiredEpoch
+)
+{
+    return (__atomic_load_n(&GlobalEpoch, __ATOMIC_SEQ_CST) >= retiredEpoch + 2);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the stripe that covers a given hash.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline Stripe_t* StripeOf
+(
+    HashmapConcurrent_t* concPtr,
+    size_t hash
+)
+{
+    return &concPtr->stripes[hash & (STRIPE_COUNT - 1)];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates an empty table.
+ **/
+//--------------------------------------------------------------------------------------------------
+static Table_t* AllocTable
+(
+    size_t bucketCount          ///< A power of 2, at least STRIPE_COUNT.
+)
+{
+    Table_t* tablePtr = calloc(1, sizeof(Table_t) + bucketCount * sizeof(Node_t*));
+    LE_ASSERT(tablePtr);
+
+    tablePtr->bucketCount = bucketCount;
+
+    return tablePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a table and all the nodes that are still on its chains.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void FreeTable
+(
+    Table_t* tablePtr
+)
+{
+    size_t i;
+
+    for (i = 0; i < tablePtr->bucketCount; i++)
+    {
+        Node_t* nodePtr = tablePtr->buckets[i];
+
+        while (nodePtr != NULL)
+        {
+            Node_t* nextPtr = nodePtr->nextPtr;
+            le_mem_Release(nodePtr);
+            nodePtr = nextPtr;
+        }
+    }
+
+    free(tablePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases the retired tables that can no longer be seen by any reader.
+ *
+ * @warning Must be called with all the stripes locked.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ReleaseTables
+(
+    HashmapConcurrent_t* concPtr
+)
+{
+    Table_t** tablePtrPtr = &concPtr->retiredTablesPtr;
+
+    // Newest first, so once one table can be released, so can all the ones after it.
+    while ((*tablePtrPtr != NULL) && !IsReleasable((*tablePtrPtr)->retiredEpoch))
+    {
+        tablePtrPtr = &(*tablePtrPtr)->retiredNextPtr;
+    }
+
+    Table_t* tablePtr = *tablePtrPtr;
+    *tablePtrPtr = NULL;
+
+    while (tablePtr != NULL)
+    {
+        Table_t* nextPtr = tablePtr->retiredNextPtr;
+        FreeTable(tablePtr);
+        tablePtr = nextPtr;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Switches readers over to a new table and retires the old one.
+ *
+ * @warning Must be called with all the stripes locked.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ReplaceTable
+(
+    HashmapConcurrent_t* concPtr,
+    Table_t* newTablePtr
+)
+{
+    Table_t* oldTablePtr = concPtr->tablePtr;
+
+    __atomic_store_n(&concPtr->tablePtr, newTablePtr, __ATOMIC_RELEASE);
+
+    oldTablePtr->retiredEpoch = RetireEpoch();
+    oldTablePtr->retiredNextPtr = concPtr->retiredTablesPtr;
+    concPtr->retiredTablesPtr = oldTablePtr;
+
+    TryAdvanceEpoch();
+    ReleaseTables(concPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Locks all of a map's stripes, in order.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void LockAllStripes
+(
+    HashmapConcurrent_t* concPtr
+)
+{
+    size_t i;
+
+    for (i = 0; i < STRIPE_COUNT; i++)
+    {
+        LE_ASSERT(pthread_mutex_lock(&concPtr->stripes[i].mutex) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unlocks all of a map's stripes.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void UnlockAllStripes
+(
+    HashmapConcurrent_t* concPtr
+)
+{
+    size_t i;
+
+    for (i = STRIPE_COUNT; i > 0; i--)
+    {
+        LE_ASSERT(pthread_mutex_unlock(&concPtr->stripes[i - 1].mutex) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replaces a map's table with one twice the size, unless somebody else already has.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void Grow
+(
+    HashmapConcurrent_t* concPtr,
+    Table_t* fullTablePtr       ///< The table that was found to be full.
+)
+{
+    LockAllStripes(concPtr);
+
+    Table_t* oldTablePtr = concPtr->tablePtr;
+
+    if (oldTablePtr == fullTablePtr)
+    {
+        Table_t* newTablePtr = AllocTable(oldTablePtr->bucketCount * 2);
+        size_t newMask = newTablePtr->bucketCount - 1;
+        size_t i;
+
+        // Readers may still be walking the old chains, so the nodes are copied rather than moved.
+        for (i = 0; i < oldTablePtr->bucketCount; i++)
+        {
+            Node_t* nodePtr = oldTablePtr->buckets[i];
+
+            while (nodePtr != NULL)
+            {
+                Node_t* copyPtr = le_mem_ForceAlloc(concPtr->nodePool);
+                Node_t** headPtr = &newTablePtr->buckets[nodePtr->hash & newMask];
+
+                copyPtr->keyPtr = nodePtr->keyPtr;
+                copyPtr->valuePtr = nodePtr->valuePtr;
+                copyPtr->hash = nodePtr->hash;
+                copyPtr->nextPtr = *headPtr;
+                *headPtr = copyPtr;
+
+                nodePtr = nodePtr->nextPtr;
+            }
+        }
+
+        ReplaceTable(concPtr, newTablePtr);
+    }
+
+    UnlockAllStripes(concPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Puts an unlinked node on its stripe's retired list, and releases the retired nodes that can no
+ * longer be seen by any reader.
+ *
+ * @warning Must be called with the stripe locked.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void RetireNode
+(
+    Stripe_t* stripePtr,
+    Node_t* nodePtr
+)
+{
+    nodePtr->retiredEpoch = RetireEpoch();
+    nodePtr->retiredNextPtr = NULL;
+
+    if (stripePtr->retiredTailPtr == NULL)
+    {
+        stripePtr->retiredHeadPtr = nodePtr;
+    }
+    else
+    {
+        stripePtr->retiredTailPtr->retiredNextPtr = nodePtr;
+    }
+    stripePtr->retiredTailPtr = nodePtr;
+    stripePtr->retiredCount++;
+
+    if (stripePtr->retiredCount < RECLAIM_BATCH)
+    {
+        return;
+    }
+
+    TryAdvanceEpoch();
+
+    // Oldest first, so stop at the first one that can't be released yet.
+    while (   (stripePtr->retiredHeadPtr != NULL)
+           && IsReleasable(stripePtr->retiredHeadPtr->retiredEpoch) )
+    {
+        Node_t* releasePtr = stripePtr->retiredHeadPtr;
+
+        stripePtr->retiredHeadPtr = releasePtr->retiredNextPtr;
+        stripePtr->retiredCount--;
+        le_mem_Release(releasePtr);
+    }
+
+    if (stripePtr->retiredHeadPtr == NULL)
+    {
+        stripePtr->retiredTailPtr = NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a node holds a given key.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline bool NodeHasKey
+(
+    Hashmap_t* mapPtr,
+    const Node_t* nodePtr,
+    const void* keyPtr,
+    size_t hash
+)
+{
+    return (   (nodePtr->keyPtr == keyPtr)
+            || ((nodePtr->hash == hash) && mapPtr->equalsFuncPtr(nodePtr->keyPtr, keyPtr)) );
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes the concurrent hashmap storage module.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_InitModule
+(
+    void
+)
+{
+    ReaderRecPool = le_mem_CreatePool("HashmapReaders", sizeof(ReaderRec_t));
+    LE_ASSERT(pthread_key_create(&ReaderRecKey, ReaderRecDestructor) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up the storage of a concurrent hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_Init
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    size_t capacity         ///< [in] Expected number of entries.
+)
+{
+    HashmapConcurrent_t* concPtr;
+    size_t i;
+
+    LE_ASSERT(posix_memalign((void**)&concPtr, CACHE_LINE_BYTES, sizeof(*concPtr)) == 0);
+    memset(concPtr, 0, sizeof(*concPtr));
+
+    for (i = 0; i < STRIPE_COUNT; i++)
+    {
+        LE_ASSERT(pthread_mutex_init(&concPtr->stripes[i].mutex, NULL) == 0);
+    }
+
+    // Same 0.75 load factor as the chained maps.
+    size_t bucketCount = STRIPE_COUNT;
+    while (bucketCount * 3 / 4 < capacity)
+    {
+        bucketCount <<= 1;
+    }
+    concPtr->tablePtr = AllocTable(bucketCount);
+
+    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES] = "hashMap_";
+    le_utf8_Append(poolName, mapPtr->nameStr, sizeof(poolName), NULL);
+    concPtr->nodePool = le_mem_CreatePool(poolName, sizeof(Node_t));
+    le_mem_SetConcurrent(concPtr->nodePool);
+    le_mem_ExpandPool(concPtr->nodePool, bucketCount / 2);
+
+    mapPtr->concPtr = concPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up a key in a concurrent hashmap.  Doesn't block.
+ *
+ * @return true if the key was found.
+ **/
+//--------------------------------------------------------------------------------------------------
+bool hashmapConcurrent_Find
+(
+    Hashmap_t* mapPtr,          ///< [in] The map.
+    const void* keyPtr,         ///< [in] The key.
+    size_t hash,                ///< [in] Hash of the key.
+    const void** storedKeyPtrPtr,   ///< [out] The key that was stored in the map (can be NULL).
+    const void** valuePtrPtr    ///< [out] The key's value (can be NULL).
+)
+{
+    HashmapConcurrent_t* concPtr = mapPtr->concPtr;
+    ReaderRec_t* recPtr = StartRead();
+    bool isFound = false;
+
+    Table_t* tablePtr = __atomic_load_n(&concPtr->tablePtr, __ATOMIC_ACQUIRE);
+    Node_t* nodePtr = __atomic_load_n(&tablePtr->buckets[hash & (tablePtr->bucketCount - 1)],
+                                      __ATOMIC_ACQUIRE);
+
+    while (nodePtr != NULL)
+    {
+        if (NodeHasKey(mapPtr, nodePtr, keyPtr, hash))
+        {
+            if (storedKeyPtrPtr != NULL)
+            {
+                *storedKeyPtrPtr = nodePtr->keyPtr;
+            }
+            if (valuePtrPtr != NULL)
+            {
+                *valuePtrPtr = __atomic_load_n(&nodePtr->valuePtr, __ATOMIC_ACQUIRE);
+            }
+            isFound = true;
+            break;
+        }
+
+        nodePtr = __atomic_load_n(&nodePtr->nextPtr, __ATOMIC_ACQUIRE);
+    }
+
+    EndRead(recPtr);
+
+    return isFound;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a key-value pair to a concurrent hashmap, or replaces the value if the key is already there.
+ *
+ * @return The replaced value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapConcurrent_Put
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash,            ///< [in] Hash of the key.
+    const void* valuePtr    ///< [in] The value.
+)
+{
+    HashmapConcurrent_t* concPtr = mapPtr->concPtr;
+    Stripe_t* stripePtr = StripeOf(concPtr, hash);
+
+    LE_ASSERT(pthread_mutex_lock(&stripePtr->mutex) == 0);
+
+    // The table can't be replaced while any stripe is locked.
+    Table_t* tablePtr = concPtr->tablePtr;
+    Node_t** headPtr = &tablePtr->buckets[hash & (tablePtr->bucketCount - 1)];
+    Node_t* nodePtr;
+
+    for (nodePtr = *headPtr; nodePtr != NULL; nodePtr = nodePtr->nextPtr)
+    {
+        if (NodeHasKey(mapPtr, nodePtr, keyPtr, hash))
+        {
+            void* oldValuePtr = (void*)nodePtr->valuePtr;
+
+            __atomic_store_n(&nodePtr->valuePtr, valuePtr, __ATOMIC_RELEASE);
+            LE_ASSERT(pthread_mutex_unlock(&stripePtr->mutex) == 0);
+
+            return oldValuePtr;
+        }
+    }
+
+    nodePtr = le_mem_ForceAlloc(concPtr->nodePool);
+    nodePtr->keyPtr = keyPtr;
+    nodePtr->valuePtr = valuePtr;
+    nodePtr->hash = hash;
+    nodePtr->nextPtr = *headPtr;
+
+    // Readers can see the node as soon as this is done.
+    __atomic_store_n(headPtr, nodePtr, __ATOMIC_RELEASE);
+
+    size_t count = stripePtr->count + 1;
+    __atomic_store_n(&stripePtr->count, count, __ATOMIC_RELAXED);
+
+    LE_ASSERT(pthread_mutex_unlock(&stripePtr->mutex) == 0);
+
+    // Grow once this stripe's share of the buckets is loaded past 0.75.
+    if (count * 4 > (tablePtr->bucketCount / STRIPE_COUNT) * 3)
+    {
+        Grow(concPtr, tablePtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a key from a concurrent hashmap.
+ *
+ * @return The key's value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapConcurrent_Remove
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash             ///< [in] Hash of the key.
+)
+{
+    HashmapConcurrent_t* concPtr = mapPtr->concPtr;
+    Stripe_t* stripePtr = StripeOf(concPtr, hash);
+    void* valuePtr = NULL;
+
+    LE_ASSERT(pthread_mutex_lock(&stripePtr->mutex) == 0);
+
+    Table_t* tablePtr = concPtr->tablePtr;
+    Node_t** linkPtr = &tablePtr->buckets[hash & (tablePtr->bucketCount - 1)];
+
+    while (*linkPtr != NULL)
+    {
+        Node_t* nodePtr = *linkPtr;
+
+        if (NodeHasKey(mapPtr, nodePtr, keyPtr, hash))
+        {
+            valuePtr = (void*)nodePtr->valuePtr;
+
+            // Readers that are already on this node can still follow its nextPtr.
+            __atomic_store_n(linkPtr, nodePtr->nextPtr, __ATOMIC_RELEASE);
+            __atomic_store_n(&stripePtr->count, stripePtr->count - 1, __ATOMIC_RELAXED);
+
+            RetireNode(stripePtr, nodePtr);
+            break;
+        }
+
+        linkPtr = &nodePtr->nextPtr;
+    }
+
+    LE_ASSERT(pthread_mutex_unlock(&stripePtr->mutex) == 0);
+
+    return valuePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes all keys from a concurrent hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_RemoveAll
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+)
+{
+    HashmapConcurrent_t* concPtr = mapPtr->concPtr;
+    size_t i;
+
+    LockAllStripes(concPtr);
+
+    ReplaceTable(concPtr, AllocTable(concPtr->tablePtr->bucketCount));
+
+    for (i = 0; i < STRIPE_COUNT; i++)
+    {
+        __atomic_store_n(&concPtr->stripes[i].count, 0, __ATOMIC_RELAXED);
+    }
+
+    UnlockAllStripes(concPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of keys in a concurrent hashmap.
+ *
+ * @return The number of keys.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t hashmapConcurrent_Size
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+)
+{
+    size_t size = 0;
+    size_t i;
+
+    for (i = 0; i < STRIPE_COUNT; i++)
+    {
+        size += __atomic_load_n(&mapPtr->concPtr->stripes[i].count, __ATOMIC_RELAXED);
+    }
+
+    return size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a function for each key-value pair in a concurrent hashmap, until it returns false.  Keys
+ * that are put or removed by other threads while this is going on may or may not be visited.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapConcurrent_ForEach
+(
+    Hashmap_t* mapPtr,                      ///< [in] The map.
+    le_hashmap_ForEachHandler_t forEachFn,  ///< [in] The function.
+    void* contextPtr                        ///< [in] Context pointer to pass to the function.
+)
+{
+    ReaderRec_t* recPtr = StartRead();
+    Table_t* tablePtr = __atomic_load_n(&mapPtr->concPtr->tablePtr, __ATOMIC_ACQUIRE);
+    size_t i;
+
+    for (i = 0; i < tablePtr->bucketCount; i++)
+    {
+        Node_t* nodePtr = __atomic_load_n(&tablePtr->buckets[i], __ATOMIC_ACQUIRE);
+
+        while (nodePtr != NULL)
+        {
+            if (!forEachFn(nodePtr->keyPtr,
+                           __atomic_load_n(&nodePtr->valuePtr, __ATOMIC_ACQUIRE),
+                           contextPtr))
+            {
+                EndRead(recPtr);
+                return;
+            }
+
+            nodePtr = __atomic_load_n(&nodePtr->nextPtr, __ATOMIC_ACQUIRE);
+        }
+    }
+
+    EndRead(recPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts the collisions in a concurrent hashmap (keys that share a bucket with another key).
+ *
+ * @return The number of collisions.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t hashmapConcurrent_CountCollisions
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+)
+{
+    ReaderRec_t* recPtr = StartRead();
+    Table_t* tablePtr = __atomic_load_n(&mapPtr->concPtr->tablePtr, __ATOMIC_ACQUIRE);
+    size_t collisions = 0;
+    size_t i;
+
+    for (i = 0; i < tablePtr->bucketCount; i++)
+    {
+        Node_t* nodePtr = __atomic_load_n(&tablePtr->buckets[i], __ATOMIC_ACQUIRE);
+
+        if (nodePtr != NULL)
+        {
+            for (nodePtr = __atomic_load_n(&nodePtr->nextPtr, __ATOMIC_ACQUIRE);
+                 nodePtr != NULL;
+                 nodePtr = __atomic_load_n(&nodePtr->nextPtr, __ATOMIC_ACQUIRE))
+            {
+                collisions++;
+            }
+        }
+    }
+
+    EndRead(recPtr);
+
+    return collisions;
+}
@@ -0,0 +1,697 @@
+/** @file hashmapFlat.c
+ *
+ * Flat (open addressing) storage for hash maps created using le_hashmap_CreateFlat().
+ *
+ * Keys, values and hashes are stored in one contiguous array of slots instead of in pool
+ * allocated entries on per-bucket lists.  The slots are divided into groups of FLAT_GROUP_SIZE.
+ * Each slot has a control byte, and the control bytes are kept in their own array so that a whole
+ * group's worth of them can be loaded into a vector register and compared with a key's hash in a
+ * couple of instructions (SSE2 on x86, NEON on ARM, plain C elsewhere).
+ *
+ * A control byte is either:
+ *  - CTRL_EMPTY - the slot has never held a key since the table was last rebuilt,
+ *  - CTRL_DELETED - the slot held a key that was removed, or
+ *  - 0 to 127 - the slot holds a key, and this is the low 7 bits of the key's mixed hash.
+ *
+ * A key's probe sequence starts at the group selected by the rest of its mixed hash and visits
+ * groups in triangular order (+1, +2, +3, ...), which visits every group when the number of
+ * groups is a power of 2.  A lookup can stop at the first group that has an empty slot, because
+ * a key is always put in the first empty or deleted slot of its probe sequence.
+ *
+ * The table is rebuilt, with more slots if needed, when there are no empty slots left to use
+ * within the maximum load factor.  Deleted slots are reclaimed when the table is rebuilt.  Unlike
+ * the chained maps, a flat map is rebuilt in one go; moving slots is cheap compared to following
+ * list links, and keeping two tables would double the probing work during lookups.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include "hashmap.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Control byte values for slots that don't hold a key.  Both are negative, so that full slots can
+ * be told apart by their sign bit.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define CTRL_EMPTY      ((int8_t)-128)
+#define CTRL_DELETED    ((int8_t)-2)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum load factor, as a fraction of the number of slots (7/8).
+ **/
+//--------------------------------------------------------------------------------------------------
+#define MAX_LOAD(slotCount)     ((slotCount) - (slotCount) / 8)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Trace if tracing is enabled for a given hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+#define HASHMAP_TRACE(mapRef, ...) \
+    if ((mapRef)->traceRef != NULL) \
+    { \
+        LE_TRACE((mapRef)->traceRef, ##__VA_ARGS__); \
+    }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a bit mask with bit i set for each slot i in a group whose control byte equals a value.
+ *
+ * @return The mask.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t MatchByte
+(
+    const int8_t* ctrlPtr,      ///< First control byte of the group.
+    int8_t value
+)
+{
+#if defined(__SSE2__)
+
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)ctrlPtr);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    // NEON has no movemask, so keep one distinct bit per byte and add the bytes of each half.
+    static const uint8_t bits[FLAT_GROUP_SIZE] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                                   1, 2, 4, 8, 16, 32, 64, 128 };
+
+    uint8x16_t eq = vceqq_s8(vld1q_s8(ctrlPtr), vdupq_n_s8(value));
+    uint8x16_t masked = vandq_u8(eq, vld1q_u8(bits));
+    uint8x8_t sum = vpadd_u8(vget_low_u8(masked), vget_high_u8(masked));
+    sum = vpadd_u8(sum, sum);
+    sum = vpadd_u8(sum, sum);
+
+    return (uint32_t)vget_lane_u8(sum, 0) | ((uint32_t)vget_lane_u8(sum, 1) << 8);
+
+#else
+
+    uint32_t mask = 0;
+    int i;
+
+    for (i = 0; i < FLAT_GROUP_SIZE; i++)
+    {
+        if (ctrlPtr[i] == value)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a bit mask with bit i set for each slot i in a group that is empty or deleted.
+ *
+ * @return The mask.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t MatchFree
+(
+    const int8_t* ctrlPtr       ///< First control byte of the group.
+)
+{
+#if defined(__SSE2__)
+
+    // Free slots are the ones with the sign bit set.
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrlPtr));
+
+#else
+
+    return MatchByte(ctrlPtr, CTRL_EMPTY) | MatchByte(ctrlPtr, CTRL_DELETED);
+
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the lowest set bit in a non-zero mask.
+ *
+ * @return The bit's index.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline size_t LowestBit
+(
+    uint32_t mask
+)
+{
+    return (size_t)__builtin_ctz(mask);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mixes the bits of a hash so that both the group index (high bits) and the control byte
+ * (low 7 bits) depend on all of them.  Hash functions like le_hashmap_HashUInt32() leave most of
+ * the bits unchanged, which would put consecutive keys in the same group.
+ *
+ * @return The mixed hash.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline size_t MixHash
+(
+    size_t hash
+)
+{
+#if SIZE_MAX > 0xFFFFFFFF
+    uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+#else
+    uint32_t h = hash;
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+#endif
+    return (size_t)h;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the control byte value for a full slot holding a key with a given mixed hash.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline int8_t HashCtrl
+(
+    size_t mixedHash
+)
+{
+    return (int8_t)(mixedHash & 0x7F);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the index of the first group in a key's probe sequence.
+ **/
+//--------------------------------------------------------------------------------------------------
+static inline size_t HomeGroup
+(
+    HashmapFlat_t* flatPtr,
+    size_t mixedHash
+)
+{
+    return (mixedHash >> 7) & (flatPtr->slotCount / FLAT_GROUP_SIZE - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates the control bytes and slots of a flat hashmap, all empty.  The previous arrays (if any)
+ * are not freed.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void AllocSlots
+(
+    HashmapFlat_t* flatPtr,
+    size_t slotCount            ///< A power of 2, at least FLAT_GROUP_SIZE.
+)
+{
+    // The control bytes come first.  slotCount is a multiple of 16, so the slots that follow them
+    // are suitably aligned.
+    int8_t* blockPtr = malloc(slotCount * (sizeof(int8_t) + sizeof(FlatSlot_t)));
+    LE_ASSERT(blockPtr);
+
+    memset(blockPtr, CTRL_EMPTY, slotCount);
+
+    flatPtr->ctrlPtr = blockPtr;
+    flatPtr->slotsPtr = (FlatSlot_t*)(blockPtr + slotCount);
+    flatPtr->slotCount = slotCount;
+    flatPtr->emptyCount = slotCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first free slot in a key's probe sequence.
+ *
+ * @return The slot's index.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t FindFreeSlot
+(
+    HashmapFlat_t* flatPtr,
+    size_t mixedHash
+)
+{
+    size_t groupMask = flatPtr->slotCount / FLAT_GROUP_SIZE - 1;
+    size_t group = HomeGroup(flatPtr, mixedHash);
+    size_t step = 0;
+
+    for (;;)
+    {
+        uint32_t freeMask = MatchFree(flatPtr->ctrlPtr + group * FLAT_GROUP_SIZE);
+
+        if (freeMask != 0)
+        {
+            return group * FLAT_GROUP_SIZE + LowestBit(freeMask);
+        }
+
+        step++;
+        group = (group + step) & groupMask;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rebuilds the table of a flat hashmap with a given number of slots, dropping all deleted slots.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void Rehash
+(
+    Hashmap_t* mapPtr,
+    size_t newSlotCount         ///< A power of 2, at least FLAT_GROUP_SIZE.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+    int8_t* oldCtrlPtr = flatPtr->ctrlPtr;
+    FlatSlot_t* oldSlotsPtr = flatPtr->slotsPtr;
+    size_t oldSlotCount = flatPtr->slotCount;
+
+    HASHMAP_TRACE(
+        mapPtr,
+        "Hashmap %s: Rehashing from %zu to %zu slots (%zu entries)",
+        mapPtr->nameStr,
+        oldSlotCount,
+        newSlotCount,
+        mapPtr->size
+    );
+
+    AllocSlots(flatPtr, newSlotCount);
+
+    size_t i;
+    for (i = 0; i < oldSlotCount; i++)
+    {
+        if (oldCtrlPtr[i] >= 0)
+        {
+            size_t mixedHash = MixHash(oldSlotsPtr[i].hash);
+            size_t index = FindFreeSlot(flatPtr, mixedHash);
+
+            flatPtr->ctrlPtr[index] = HashCtrl(mixedHash);
+            flatPtr->slotsPtr[index] = oldSlotsPtr[i];
+        }
+    }
+    flatPtr->emptyCount -= mapPtr->size;
+
+    free(oldCtrlPtr);
+
+    // Slot indices are meaningless after a rehash, so the iterator has to start again.
+    if (mapPtr->iteratorPtr->isPositioned)
+    {
+        mapPtr->iteratorPtr->currentIndex = -1;
+        mapPtr->iteratorPtr->isPositioned = false;
+        mapPtr->iteratorPtr->isValueValid = false;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes sure a flat hashmap has an empty slot to put a new key into, rehashing if needed.
+ *
+ * While the iterator is positioned in the map, rehashing is put off until the last empty slot
+ * (which lookups need in order to stop) would be used, so that the iteration isn't disturbed.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ReserveSlot
+(
+    Hashmap_t* mapPtr
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+    size_t reservedCount = flatPtr->slotCount - MAX_LOAD(flatPtr->slotCount);
+
+    if (mapPtr->iteratorPtr->isPositioned)
+    {
+        reservedCount = 1;
+    }
+
+    if (flatPtr->emptyCount > reservedCount)
+    {
+        return;
+    }
+
+    // If at least half of the used slots are deleted ones, rebuilding at the same size gives
+    // enough room back.  Otherwise, double the size.
+    if (mapPtr->size * 2 <= MAX_LOAD(flatPtr->slotCount))
+    {
+        Rehash(mapPtr, flatPtr->slotCount);
+    }
+    else
+    {
+        Rehash(mapPtr, flatPtr->slotCount * 2);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up the slot storage of a flat hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapFlat_Init
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    size_t capacity         ///< [in] Expected number of entries.
+)
+{
+    size_t slotCount = FLAT_GROUP_SIZE;
+
+    while (MAX_LOAD(slotCount) < capacity)
+    {
+        slotCount <<= 1;
+    }
+
+    AllocSlots(&mapPtr->flat, slotCount);
+    mapPtr->flat.minSlotCount = slotCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up a key in a flat hashmap.
+ *
+ * @return Pointer to the slot holding the key, or NULL if the key is not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+FlatSlot_t* hashmapFlat_Find
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash             ///< [in] Hash of the key.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+    size_t mixedHash = MixHash(hash);
+    int8_t ctrl = HashCtrl(mixedHash);
+    size_t groupMask = flatPtr->slotCount / FLAT_GROUP_SIZE - 1;
+    size_t group = HomeGroup(flatPtr, mixedHash);
+    size_t step = 0;
+
+    for (;;)
+    {
+        const int8_t* groupCtrlPtr = flatPtr->ctrlPtr + group * FLAT_GROUP_SIZE;
+        uint32_t matchMask = MatchByte(groupCtrlPtr, ctrl);
+
+        while (matchMask != 0)
+        {
+            FlatSlot_t* slotPtr = &flatPtr->slotsPtr[group * FLAT_GROUP_SIZE +
+                                                     LowestBit(matchMask)];
+
+            if (   (slotPtr->keyPtr == keyPtr)
+                || ((slotPtr->hash == hash) && mapPtr->equalsFuncPtr(slotPtr->keyPtr, keyPtr)) )
+            {
+                return slotPtr;
+            }
+
+            matchMask &= matchMask - 1;
+        }
+
+        // The key would have been put in this group if it had a free slot.
+        if (MatchByte(groupCtrlPtr, CTRL_EMPTY) != 0)
+        {
+            return NULL;
+        }
+
+        step++;
+        group = (group + step) & groupMask;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a key-value pair to a flat hashmap, or replaces the value if the key is already there.
+ *
+ * @return The replaced value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapFlat_Put
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash,            ///< [in] Hash of the key.
+    const void* valuePtr    ///< [in] The value.
+)
+{
+    FlatSlot_t* slotPtr = hashmapFlat_Find(mapPtr, keyPtr, hash);
+
+    if (slotPtr != NULL)
+    {
+        const void* oldValuePtr = slotPtr->valuePtr;
+        slotPtr->valuePtr = valuePtr;
+
+        HASHMAP_TRACE(
+            mapPtr,
+            "Hashmap %s: Replaced entry. Total map size now %zu",
+            mapPtr->nameStr,
+            mapPtr->size
+        );
+
+        return (void*)oldValuePtr;
+    }
+
+    ReserveSlot(mapPtr);
+
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+    size_t mixedHash = MixHash(hash);
+    size_t index = FindFreeSlot(flatPtr, mixedHash);
+
+    // Re-using a deleted slot doesn't use up any of the empty ones.
+    if (flatPtr->ctrlPtr[index] == CTRL_EMPTY)
+    {
+        flatPtr->emptyCount--;
+    }
+
+    flatPtr->ctrlPtr[index] = HashCtrl(mixedHash);
+    flatPtr->slotsPtr[index].keyPtr = keyPtr;
+    flatPtr->slotsPtr[index].valuePtr = valuePtr;
+    flatPtr->slotsPtr[index].hash = hash;
+    mapPtr->size++;
+
+    HASHMAP_TRACE(
+        mapPtr,
+        "Hashmap %s: Added entry in slot %zu. Total map size now %zu",
+        mapPtr->nameStr,
+        index,
+        mapPtr->size
+    );
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a key from a flat hashmap.
+ *
+ * @return The key's value, or NULL if the key was not in the map.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* hashmapFlat_Remove
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    const void* keyPtr,     ///< [in] The key.
+    size_t hash             ///< [in] Hash of the key.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+    FlatSlot_t* slotPtr = hashmapFlat_Find(mapPtr, keyPtr, hash);
+
+    if (slotPtr == NULL)
+    {
+        HASHMAP_TRACE(mapPtr, "Hashmap %s: Key not found", mapPtr->nameStr);
+        return NULL;
+    }
+
+    size_t index = slotPtr - flatPtr->slotsPtr;
+    void* valuePtr = (void*)slotPtr->valuePtr;
+
+    if (mapPtr->iteratorPtr->isPositioned && (mapPtr->iteratorPtr->currentIndex == (int32_t)index))
+    {
+        // The iterator stays on the slot, so the next le_hashmap_NextNode() continues from it.
+        mapPtr->iteratorPtr->isValueValid = false;
+    }
+
+    // If the slot's group still has an empty slot, lookups already stop at this group, so this
+    // slot can be made empty.  Otherwise, it must be marked deleted so that lookups for keys
+    // that were put further along their probe sequences carry on past it.
+    const int8_t* groupCtrlPtr = flatPtr->ctrlPtr + (index / FLAT_GROUP_SIZE) * FLAT_GROUP_SIZE;
+
+    if (MatchByte(groupCtrlPtr, CTRL_EMPTY) != 0)
+    {
+        flatPtr->ctrlPtr[index] = CTRL_EMPTY;
+        flatPtr->emptyCount++;
+    }
+    else
+    {
+        flatPtr->ctrlPtr[index] = CTRL_DELETED;
+    }
+    mapPtr->size--;
+
+    HASHMAP_TRACE(mapPtr, "Hashmap %s: Removing key from slot %zu", mapPtr->nameStr, index);
+
+    if (   mapPtr->isShrinkable
+        && !mapPtr->iteratorPtr->isPositioned
+        && (flatPtr->slotCount > flatPtr->minSlotCount)
+        && (mapPtr->size < flatPtr->slotCount / 8) )
+    {
+        Rehash(mapPtr, flatPtr->slotCount / 2);
+    }
+
+    return valuePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes all keys from a flat hashmap.
+ **/
+//--------------------------------------------------------------------------------------------------
+void hashmapFlat_RemoveAll
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+
+    memset(flatPtr->ctrlPtr, CTRL_EMPTY, flatPtr->slotCount);
+    flatPtr->emptyCount = flatPtr->slotCount;
+    mapPtr->size = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first full slot of a flat hashmap at or after a given slot index.
+ *
+ * @return The index of the slot, or -1 if there are no more full slots.
+ **/
+//--------------------------------------------------------------------------------------------------
+ssize_t hashmapFlat_NextFull
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    size_t index            ///< [in] Index of the first slot to check.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+
+    while (index < flatPtr->slotCount)
+    {
+        size_t groupStart = index - (index % FLAT_GROUP_SIZE);
+        uint32_t fullMask = ~MatchFree(flatPtr->ctrlPtr + groupStart) & 0xFFFF;
+
+        // Ignore the slots of the group that come before the index.
+        fullMask &= 0xFFFFu << (index - groupStart);
+
+        if (fullMask != 0)
+        {
+            return (ssize_t)(groupStart + LowestBit(fullMask));
+        }
+
+        index = groupStart + FLAT_GROUP_SIZE;
+    }
+
+    return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the last full slot of a flat hashmap at or before a given slot index.
+ *
+ * @return The index of the slot, or -1 if there are no more full slots.
+ **/
+//--------------------------------------------------------------------------------------------------
+ssize_t hashmapFlat_PrevFull
+(
+    Hashmap_t* mapPtr,      ///< [in] The map.
+    ssize_t index           ///< [in] Index of the first slot to check.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+
+    if (index >= (ssize_t)flatPtr->slotCount)
+    {
+        index = flatPtr->slotCount - 1;
+    }
+
+    for (; index >= 0; index--)
+    {
+        if (flatPtr->ctrlPtr[index] >= 0)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts the collisions in a flat hashmap.  Keys collide if their probe sequences start at the
+ * same group, so each group contributes one less than the number of keys that start there.
+ *
+ * @return The number of collisions.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t hashmapFlat_CountCollisions
+(
+    Hashmap_t* mapPtr       ///< [in] The map.
+)
+{
+    HashmapFlat_t* flatPtr = &mapPtr->flat;
+    size_t groupCount = flatPtr->slotCount / FLAT_GROUP_SIZE;
+    size_t* keyCountPtr = calloc(groupCount, sizeof(size_t));
+    LE_ASSERT(keyCountPtr);
+
+    size_t i;
+    for (i = 0; i < flatPtr->slotCount; i++)
+    {
+        if (flatPtr->ctrlPtr[i] >= 0)
+        {
+            keyCountPtr[HomeGroup(flatPtr, MixHash(flatPtr->slotsPtr[i].hash))]++;
+        }
+    }
+
+    size_t count = 0;
+    for (i = 0; i < groupCount; i++)
+    {
+        if (keyCountPtr[i] > 1)
+        {
+            count += keyCountPtr[i] - 1;
+        }
+    }
+
+    free(keyCountPtr);
+
+    return count;
+}
@@ -9,6 +9,7 @@
 
 #include "args.h"
 #include "mem.h"
+#include "arena.h"
 #include "hashmap.h"
 #include "safeRef.h"
 #include "messaging.h"
@@ -22,6 +23,9 @@
 #include "properties.h"
 #include "json.h"
 #include "pipeline.h"
+#include "coro.h"
+#include "workQueue.h"
+#include "cond.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -52,18 +56,24 @@ __attribute__((constructor)) void _legato_InitFramework
     mem_Init();
     log_Init();        // Uses memory pools.
     sig_Init();        // Uses memory pools.
+    hashmap_Init();    // Uses memory pools.
     safeRef_Init();    // Uses memory pools and hash maps.
     pathIter_Init();   // Uses memory pools and safe references.
     mutex_Init();      // Uses memory pools.
     sem_Init();        // Uses memory pools.
+    rwlock_Init();     // Uses memory pools.
+    cond_Init();       // Uses memory pools.
     thread_Init();     // Uses memory pools and safe references.
     event_Init();      // Uses thread API.
     timer_Init();      // Uses event loop.
     msg_Init();        // Uses event loop.
     kill_Init();       // Uses memory pools and timers.
     properties_Init(); // Uses memory pools and safe references.
+    arena_Init();      // Uses memory pools.
     json_Init();       // Uses memory pools.
     pipeline_Init();   // Uses memory pools and FD Monitors.
+    coro_Init();       // Uses memory pools.
+    workQueue_Init();  // Uses memory pools.
 
     // This must be called last, because it calls several subsystems to perform the
     // thread-specific initialization for the main thread.
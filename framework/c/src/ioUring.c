@@ -0,0 +1,1037 @@
+//--------------------------------------------------------------------------------------------------
+/** @file ioUring.c
+ *
+ * Implementation of the io_uring Event Loop backend.
+ *
+ * When this backend is selected (see @ref c_event_ioUring), each thread gets its own io_uring
+ * instance in place of its epoll fd.  The io_uring system calls are made directly, rather than
+ * through liburing, so that the framework doesn't pick up another library dependency.
+ *
+ * Each file descriptor being monitored has a Poll object, which is the user_data of the poll
+ * requests submitted for it, so that completions can be matched back to it.  The Poll objects are
+ * also kept in a process-wide hash map, keyed by io_uring instance and fd, so that ioUring_Ctl()
+ * can find them the same way epoll_ctl() would.
+ *
+ * epoll's level-triggered behaviour, which the FD Monitor handlers are written for, is emulated
+ * with one-shot polls.  When a poll completes, the file descriptor is reported and the Poll object
+ * is put on the instance's "arm list".  The polls on the arm list are submitted again the next
+ * time ioUring_Wait() is called, by which time the handlers have had their chance to make the
+ * file descriptor not ready anymore.  If they haven't, the poll completes again straight away.
+ * Re-arming everything at once like this means that all the file descriptors that fired during an
+ * Event Loop pass cost a single io_uring_enter() call, along with the wait for the next events.
+ *
+ * Edge-triggered registrations (EPOLLET) use multishot polls, which stay armed in the kernel and
+ * complete each time the file descriptor's state changes.  The Event Loop uses this for its
+ * eventfd.
+ *
+ * Modifying the events being waited for updates the poll in place (IORING_POLL_UPDATE_EVENTS),
+ * and removing a file descriptor cancels its poll.  The Poll object is only freed once the kernel
+ * has posted the final completion for it, so user_data values always point at live objects.
+ * Internal update and cancel requests use a user_data of zero, and their completions are ignored.
+ *
+ * Everything to do with an io_uring instance is only ever done by the thread that owns it, so
+ * none of it needs locking (apart from the hash map, which is shared by all the threads).
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "ioUring.h"
+#include "fileDescriptor.h"
+
+#include <endian.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#endif
+
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(IORING_POLL_UPDATE_EVENTS)
+
+// ==============================================
+//  PRIVATE DATA
+// ==============================================
+
+/// Number of submission queue entries in each io_uring instance.  The completion queue is twice
+/// as big.  Neither is a hard limit:  the submission queue is submitted when it fills up, and
+/// the kernel holds on to completions that don't fit in the completion queue.
+#define RING_ENTRIES 64
+
+/// The default number of Poll objects in the Poll Pool.
+#define DEFAULT_POLL_POOL_SIZE 10
+
+/// epoll flags that have no poll(2) equivalent.
+#define EPOLL_ONLY_FLAGS (EPOLLET | EPOLLONESHOT | EPOLLWAKEUP | EPOLLEXCLUSIVE)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An io_uring instance.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct ioUring_Ring
+{
+    int                     fd;             ///< The io_uring file descriptor.
+    void*                   sqRingPtr;      ///< Submission queue ring mapping.
+    size_t                  sqRingSize;     ///< Size of the submission queue ring mapping.
+    void*                   cqRingPtr;      ///< Completion queue ring mapping (may be sqRingPtr).
+    size_t                  cqRingSize;     ///< Size of the completion queue ring mapping.
+    struct io_uring_sqe*    sqesPtr;        ///< Submission queue entries.
+    size_t                  sqesSize;       ///< Size of the submission queue entry mapping.
+    uint32_t*               sqHeadPtr;      ///< Submission queue head (written by the kernel).
+    uint32_t*               sqTailPtr;      ///< Submission queue tail (written by us).
+    uint32_t*               sqArrayPtr;     ///< Submission queue index array.
+    uint32_t                sqMask;         ///< Submission queue ring mask.
+    uint32_t                sqEntries;      ///< Number of submission queue entries.
+    uint32_t                sqTail;         ///< Local copy of the tail, including unsubmitted SQEs.
+    uint32_t*               cqHeadPtr;      ///< Completion queue head (written by us).
+    uint32_t*               cqTailPtr;      ///< Completion queue tail (written by the kernel).
+    struct io_uring_cqe*    cqesPtr;        ///< Completion queue entries.
+    uint32_t                cqMask;         ///< Completion queue ring mask.
+    le_dls_List_t           armList;        ///< Polls to be submitted at the next wait.
+    le_dls_List_t           pollList;       ///< All the instance's Poll objects.
+}
+Ring_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key of the Poll Map.  A file descriptor can be monitored by more than one thread.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    Ring_t*     ringPtr;    ///< io_uring instance monitoring the file descriptor.
+    int         fd;         ///< The file descriptor.
+}
+PollKey_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A file descriptor being monitored by an io_uring instance.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    PollKey_t       key;            ///< Key in the Poll Map.
+    le_dls_Link_t   link;           ///< Link in the instance's arm list.
+    le_dls_Link_t   ringLink;       ///< Link in the instance's list of all its Poll objects.
+    uint32_t        events;         ///< poll(2) events being waited for.
+    void*           dataPtr;        ///< Reported in the data member of the epoll_event.
+    bool            isMultishot;    ///< true if the poll stays armed after completing (EPOLLET).
+    bool            isArmed;        ///< true if a poll request has been submitted and not ended.
+    bool            isOnArmList;    ///< true if on the instance's arm list.
+    bool            isDeleted;      ///< true if removed, and waiting for the kernel to let go.
+}
+Poll_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which io_uring instances are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RingPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Poll objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t PollPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map of Poll objects, keyed by PollKey_t.  Shared by all threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t PollMap;
+
+
+// ==============================================
+//  PRIVATE FUNCTIONS
+// ==============================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function for the Poll Map.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashPollKey
+(
+    const void* keyPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const PollKey_t* pollKeyPtr = keyPtr;
+
+    return le_hashmap_HashVoidPointer(pollKeyPtr->ringPtr) ^ (size_t)pollKeyPtr->fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for the Poll Map.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsPollKey
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const PollKey_t* firstPtr = firstKeyPtr;
+    const PollKey_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->ringPtr == secondPtr->ringPtr) && (firstPtr->fd == secondPtr->fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts poll(2) events to the form the kernel expects in the poll32_events of an SQE.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ToPoll32Events
+(
+    uint32_t events
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if __BYTE_ORDER == __BIG_ENDIAN
+    return (events << 16) | (events >> 16);
+#else
+    return events;
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets up an io_uring instance and maps its rings into memory.
+ *
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static int SetUpRing
+(
+    Ring_t* ringPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    memset(ringPtr, 0, sizeof(*ringPtr));
+
+    ringPtr->fd = syscall(__NR_io_uring_setup, RING_ENTRIES, &params);
+    if (ringPtr->fd < 0)
+    {
+        return -1;
+    }
+
+    ringPtr->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    ringPtr->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ringPtr->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    // Newer kernels map both rings with the one mmap().
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ringPtr->cqRingSize > ringPtr->sqRingSize)
+        {
+            ringPtr->sqRingSize = ringPtr->cqRingSize;
+        }
+        ringPtr->cqRingSize = ringPtr->sqRingSize;
+    }
+
+    ringPtr->sqRingPtr = mmap(NULL, ringPtr->sqRingSize, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, ringPtr->fd, IORING_OFF_SQ_RING);
+    if (ringPtr->sqRingPtr == MAP_FAILED)
+    {
+        goto closeFd;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ringPtr->cqRingPtr = ringPtr->sqRingPtr;
+    }
+    else
+    {
+        ringPtr->cqRingPtr = mmap(NULL, ringPtr->cqRingSize, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ringPtr->fd, IORING_OFF_CQ_RING);
+        if (ringPtr->cqRingPtr == MAP_FAILED)
+        {
+            goto unmapSqRing;
+        }
+    }
+
+    ringPtr->sqesPtr = mmap(NULL, ringPtr->sqesSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ringPtr->fd, IORING_OFF_SQES);
+    if (ringPtr->sqesPtr == MAP_FAILED)
+    {
+        goto unmapCqRing;
+    }
+
+    uint8_t* sqPtr = ringPtr->sqRingPtr;
+    ringPtr->sqHeadPtr = (uint32_t*)(sqPtr + params.sq_off.head);
+    ringPtr->sqTailPtr = (uint32_t*)(sqPtr + params.sq_off.tail);
+    ringPtr->sqArrayPtr = (uint32_t*)(sqPtr + params.sq_off.array);
+    ringPtr->sqMask = *(uint32_t*)(sqPtr + params.sq_off.ring_mask);
+    ringPtr->sqEntries = *(uint32_t*)(sqPtr + params.sq_off.ring_entries);
+    ringPtr->sqTail = *ringPtr->sqTailPtr;
+
+    uint8_t* cqPtr = ringPtr->cqRingPtr;
+    ringPtr->cqHeadPtr = (uint32_t*)(cqPtr + params.cq_off.head);
+    ringPtr->cqTailPtr = (uint32_t*)(cqPtr + params.cq_off.tail);
+    ringPtr->cqesPtr = (struct io_uring_cqe*)(cqPtr + params.cq_off.cqes);
+    ringPtr->cqMask = *(uint32_t*)(cqPtr + params.cq_off.ring_mask);
+
+    ringPtr->armList = LE_DLS_LIST_INIT;
+    ringPtr->pollList = LE_DLS_LIST_INIT;
+
+    return 0;
+
+unmapCqRing:
+    if (ringPtr->cqRingPtr != ringPtr->sqRingPtr)
+    {
+        munmap(ringPtr->cqRingPtr, ringPtr->cqRingSize);
+    }
+unmapSqRing:
+    munmap(ringPtr->sqRingPtr, ringPtr->sqRingSize);
+closeFd:
+    {
+        int savedErrno = errno;
+        fd_Close(ringPtr->fd);
+        errno = savedErrno;
+    }
+    return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmaps an io_uring instance's rings and closes it.  The kernel cancels anything still in
+ * progress.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TearDownRing
+(
+    Ring_t* ringPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    munmap(ringPtr->sqesPtr, ringPtr->sqesSize);
+    if (ringPtr->cqRingPtr != ringPtr->sqRingPtr)
+    {
+        munmap(ringPtr->cqRingPtr, ringPtr->cqRingSize);
+    }
+    munmap(ringPtr->sqRingPtr, ringPtr->sqRingSize);
+    fd_Close(ringPtr->fd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submits everything on the submission queue and, optionally, waits for a completion.
+ *
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Enter
+(
+    Ring_t* ringPtr,
+    bool wait               ///< [in] true to wait for at least one completion.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Publish the new SQEs to the kernel.
+    __atomic_store_n(ringPtr->sqTailPtr, ringPtr->sqTail, __ATOMIC_RELEASE);
+
+    uint32_t toSubmit = ringPtr->sqTail - __atomic_load_n(ringPtr->sqHeadPtr, __ATOMIC_ACQUIRE);
+
+    if ((toSubmit == 0) && !wait)
+    {
+        return 0;
+    }
+
+    // SQEs that fail are completed with an error, rather than failing the system call, and any
+    // that the kernel doesn't get to are left on the submission queue for next time.
+    int result = syscall(__NR_io_uring_enter,
+                         ringPtr->fd,
+                         toSubmit,
+                         wait ? 1 : 0,
+                         wait ? IORING_ENTER_GETEVENTS : 0,
+                         NULL,
+                         0);
+
+    return (result < 0 ? -1 : 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a free submission queue entry, submitting what's already there if the queue is full.
+ *
+ * @return Pointer to the zeroed entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct io_uring_sqe* GetSqe
+(
+    Ring_t* ringPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (ringPtr->sqTail - __atomic_load_n(ringPtr->sqHeadPtr, __ATOMIC_ACQUIRE)
+           >= ringPtr->sqEntries)
+    {
+        if ((Enter(ringPtr, false) != 0) && (errno != EINTR) && (errno != EAGAIN) &&
+            (errno != EBUSY))
+        {
+            LE_FATAL("io_uring_enter() failed. errno = %d (%m).", errno);
+        }
+    }
+
+    uint32_t index = ringPtr->sqTail & ringPtr->sqMask;
+    struct io_uring_sqe* sqePtr = &ringPtr->sqesPtr[index];
+
+    memset(sqePtr, 0, sizeof(*sqePtr));
+    ringPtr->sqArrayPtr[index] = index;
+    ringPtr->sqTail++;
+
+    return sqePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues a poll request for a Poll object.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmPoll
+(
+    Poll_t* pollPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct io_uring_sqe* sqePtr = GetSqe(pollPtr->key.ringPtr);
+
+    sqePtr->opcode = IORING_OP_POLL_ADD;
+    sqePtr->fd = pollPtr->key.fd;
+    sqePtr->poll32_events = ToPoll32Events(pollPtr->events);
+    sqePtr->len = (pollPtr->isMultishot ? IORING_POLL_ADD_MULTI : 0);
+    sqePtr->user_data = (uintptr_t)pollPtr;
+
+    pollPtr->isArmed = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues a request to update the events of a Poll object's armed poll request, or to cancel it
+ * if the Poll object has been deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdatePoll
+(
+    Poll_t* pollPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct io_uring_sqe* sqePtr = GetSqe(pollPtr->key.ringPtr);
+
+    sqePtr->opcode = IORING_OP_POLL_REMOVE;
+    sqePtr->fd = -1;
+    sqePtr->addr = (uintptr_t)pollPtr;
+    if (!pollPtr->isDeleted)
+    {
+        sqePtr->len = IORING_POLL_UPDATE_EVENTS;
+        sqePtr->poll32_events = ToPoll32Events(pollPtr->events);
+    }
+    sqePtr->user_data = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Frees a deleted Poll object, once the kernel has finished with it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleasePoll
+(
+    Poll_t* pollPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Remove(&pollPtr->key.ringPtr->pollList, &pollPtr->ringLink);
+    le_mem_Release(pollPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Puts a Poll object on its instance's arm list, if it isn't already there.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueArm
+(
+    Poll_t* pollPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!pollPtr->isOnArmList)
+    {
+        le_dls_Queue(&pollPtr->key.ringPtr->armList, &pollPtr->link);
+        pollPtr->isOnArmList = true;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues poll requests for all the Poll objects on an instance's arm list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmAll
+(
+    Ring_t* ringPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&ringPtr->armList)) != NULL)
+    {
+        Poll_t* pollPtr = CONTAINER_OF(linkPtr, Poll_t, link);
+
+        pollPtr->isOnArmList = false;
+        ArmPoll(pollPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Collects completions from an instance's completion queue, and turns them into epoll events.
+ *
+ * @return The number of events put in the list.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Harvest
+(
+    Ring_t* ringPtr,
+    struct epoll_event* eventListPtr,
+    int maxEvents
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t head = *ringPtr->cqHeadPtr;
+    uint32_t tail = __atomic_load_n(ringPtr->cqTailPtr, __ATOMIC_ACQUIRE);
+    int count = 0;
+
+    while ((head != tail) && (count < maxEvents))
+    {
+        struct io_uring_cqe* cqePtr = &ringPtr->cqesPtr[head & ringPtr->cqMask];
+        Poll_t* pollPtr = (Poll_t*)(uintptr_t)cqePtr->user_data;
+        int res = cqePtr->res;
+        uint32_t flags = cqePtr->flags;
+
+        head++;
+
+        // Internal update and cancel requests.  They fail harmlessly if the poll had already
+        // completed.
+        if (pollPtr == NULL)
+        {
+            if ((res < 0) && (res != -ENOENT) && (res != -EALREADY))
+            {
+                LE_WARN("io_uring poll update failed. errno = %d (%s).", -res, strerror(-res));
+            }
+            continue;
+        }
+
+        if (!(flags & IORING_CQE_F_MORE))
+        {
+            pollPtr->isArmed = false;
+        }
+
+        if (pollPtr->isDeleted)
+        {
+            if (!pollPtr->isArmed)
+            {
+                ReleasePoll(pollPtr);
+            }
+            continue;
+        }
+
+        if (res > 0)
+        {
+            eventListPtr[count].events = (uint32_t)res;
+            eventListPtr[count].data.ptr = pollPtr->dataPtr;
+            count++;
+        }
+        else if ((res < 0) && (res != -ECANCELED))
+        {
+            // Most likely the fd was closed without being removed first.  Trying again would
+            // just fail again, so the fd is left alone until it is modified.
+            LE_CRIT("io_uring poll failed for fd %d. errno = %d (%s).",
+                    pollPtr->key.fd,
+                    -res,
+                    strerror(-res));
+            continue;
+        }
+
+        // The poll is submitted again at the next wait, when the handlers have run.
+        if (!pollPtr->isArmed)
+        {
+            QueueArm(pollPtr);
+        }
+    }
+
+    __atomic_store_n(ringPtr->cqHeadPtr, head, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that the kernel supports multishot polls and in-place poll updates (Linux 5.13 and
+ * later), by trying one on a temporary io_uring instance.
+ *
+ * @return true if supported.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsMultishotPollSupported
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Ring_t ring;
+    bool isSupported = false;
+
+    if (SetUpRing(&ring) != 0)
+    {
+        LE_DEBUG("io_uring_setup() failed. errno = %d (%m).", errno);
+        return false;
+    }
+
+    // Poll an eventfd that is already readable.  Older kernels don't know the update flag, and
+    // complete the poll with -EINVAL.
+    int efd = eventfd(1, EFD_NONBLOCK);
+    if (efd >= 0)
+    {
+        struct io_uring_sqe* sqePtr = GetSqe(&ring);
+
+        sqePtr->opcode = IORING_OP_POLL_ADD;
+        sqePtr->fd = efd;
+        sqePtr->poll32_events = ToPoll32Events(POLLIN);
+        sqePtr->len = IORING_POLL_ADD_MULTI;
+        sqePtr->user_data = 1;
+
+        if (Enter(&ring, true) == 0)
+        {
+            uint32_t head = *ring.cqHeadPtr;
+
+            if (head != __atomic_load_n(ring.cqTailPtr, __ATOMIC_ACQUIRE))
+            {
+                struct io_uring_cqe* cqePtr = &ring.cqesPtr[head & ring.cqMask];
+
+                isSupported = (cqePtr->res > 0) && (cqePtr->flags & IORING_CQE_F_MORE);
+            }
+        }
+
+        fd_Close(efd);
+    }
+
+    TearDownRing(&ring);
+
+    return isSupported;
+}
+
+
+// ==============================================
+//  INTER-MODULE FUNCTIONS
+// ==============================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the io_uring module.
+ *
+ * This function must be called exactly once at process start-up, before any other io_uring
+ * functions are called.
+ *
+ * @return
+ *  - true if io_uring can be used as the Event Loop backend.
+ *  - false if the kernel (or the framework build) doesn't support everything that is needed.
+ */
+//--------------------------------------------------------------------------------------------------
+bool ioUring_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!IsMultishotPollSupported())
+    {
+        return false;
+    }
+
+    RingPool = le_mem_CreatePool("IoUring", sizeof(Ring_t));
+    le_mem_SetConcurrent(RingPool);     // Threads allocate them for themselves.
+
+    PollPool = le_mem_CreatePool("IoUringPoll", sizeof(Poll_t));
+    le_mem_SetConcurrent(PollPool);
+    le_mem_ExpandPool(PollPool, DEFAULT_POLL_POOL_SIZE);
+
+    PollMap = le_hashmap_CreateConcurrent("IoUringPolls",
+                                          DEFAULT_POLL_POOL_SIZE,
+                                          HashPollKey,
+                                          EqualsPollKey);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an io_uring instance for the calling thread.  It must only ever be used by that thread.
+ *
+ * @return Reference to the new instance, or NULL if it couldn't be created (in which case the
+ *         caller should fall back to using epoll).
+ */
+//--------------------------------------------------------------------------------------------------
+ioUring_Ref_t ioUring_Create
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Ring_t* ringPtr = le_mem_ForceAlloc(RingPool);
+
+    if (SetUpRing(ringPtr) != 0)
+    {
+        LE_WARN("io_uring_setup() failed. errno = %d (%m).  Falling back to epoll.", errno);
+        le_mem_Release(ringPtr);
+        return NULL;
+    }
+
+    return ringPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an io_uring instance, cancelling everything it is waiting for.
+ */
+//--------------------------------------------------------------------------------------------------
+void ioUring_Delete
+(
+    ioUring_Ref_t ringRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr;
+
+    // Closing the io_uring fd cancels all the polls, so all the Poll objects can be freed.
+    TearDownRing(ringRef);
+
+    while ((linkPtr = le_dls_Pop(&ringRef->pollList)) != NULL)
+    {
+        Poll_t* pollPtr = CONTAINER_OF(linkPtr, Poll_t, ringLink);
+
+        if (!pollPtr->isDeleted)
+        {
+            le_hashmap_Remove(PollMap, &pollPtr->key);
+        }
+        le_mem_Release(pollPtr);
+    }
+
+    le_mem_Release(ringRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get an io_uring instance's file descriptor.  This appears readable to poll() and select() when
+ * there are completions waiting to be collected by ioUring_Wait(), as long as everything has been
+ * submitted using ioUring_Submit().
+ *
+ * @return The file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+int ioUring_GetFd
+(
+    ioUring_Ref_t ringRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ringRef->fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit everything that ioUring_Wait() would submit, without waiting.  This is needed before
+ * waiting for the io_uring instance's file descriptor to become readable.
+ */
+//--------------------------------------------------------------------------------------------------
+void ioUring_Submit
+(
+    ioUring_Ref_t ringRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ArmAll(ringRef);
+
+    if ((Enter(ringRef, false) != 0) && (errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY))
+    {
+        LE_FATAL("io_uring_enter() failed. errno = %d (%m).", errno);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add, modify or remove a file descriptor in the set monitored by an io_uring instance.
+ *
+ * Works like epoll_ctl(2), with the same operation codes and errors (which the FD Monitor module
+ * relies on).  Events are level-triggered, unless EPOLLET is given, in which case the file
+ * descriptor is reported each time it changes state.  EPOLLONESHOT and EPOLLEXCLUSIVE are not
+ * supported.
+ *
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int ioUring_Ctl
+(
+    ioUring_Ref_t ringRef,
+    int op,                     ///< [in] EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL.
+    int fd,                     ///< [in] File descriptor.
+    struct epoll_event* evPtr   ///< [in] Events and data pointer (ignored for EPOLL_CTL_DEL).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    PollKey_t key = { .ringPtr = ringRef, .fd = fd };
+    Poll_t* pollPtr = le_hashmap_Get(PollMap, &key);
+
+    switch (op)
+    {
+        case EPOLL_CTL_ADD:
+        {
+            struct stat fileInfo;
+
+            if (pollPtr != NULL)
+            {
+                errno = EEXIST;
+                return -1;
+            }
+
+            // epoll refuses regular files and directories, and the FD Monitor relies on that to
+            // find out that they are always ready.
+            if (fstat(fd, &fileInfo) != 0)
+            {
+                return -1;
+            }
+            if (S_ISREG(fileInfo.st_mode) || S_ISDIR(fileInfo.st_mode))
+            {
+                errno = EPERM;
+                return -1;
+            }
+
+            pollPtr = le_mem_ForceAlloc(PollPool);
+            memset(pollPtr, 0, sizeof(*pollPtr));
+            pollPtr->key = key;
+            pollPtr->link = LE_DLS_LINK_INIT;
+            pollPtr->ringLink = LE_DLS_LINK_INIT;
+            pollPtr->events = evPtr->events & ~EPOLL_ONLY_FLAGS;
+            pollPtr->dataPtr = evPtr->data.ptr;
+            pollPtr->isMultishot = ((evPtr->events & EPOLLET) != 0);
+
+            le_hashmap_Put(PollMap, &pollPtr->key, pollPtr);
+            le_dls_Queue(&ringRef->pollList, &pollPtr->ringLink);
+            QueueArm(pollPtr);
+
+            return 0;
+        }
+
+        case EPOLL_CTL_MOD:
+
+            if (pollPtr == NULL)
+            {
+                errno = ENOENT;
+                return -1;
+            }
+            if (pollPtr->isMultishot != ((evPtr->events & EPOLLET) != 0))
+            {
+                errno = EINVAL;
+                return -1;
+            }
+
+            pollPtr->events = evPtr->events & ~EPOLL_ONLY_FLAGS;
+            pollPtr->dataPtr = evPtr->data.ptr;
+
+            // If the poll has completed but hasn't been reported yet, the update will fail, and
+            // the new events will be used when it is re-armed.
+            if (pollPtr->isArmed)
+            {
+                UpdatePoll(pollPtr);
+            }
+            else
+            {
+                QueueArm(pollPtr);
+            }
+
+            return 0;
+
+        case EPOLL_CTL_DEL:
+
+            if (pollPtr == NULL)
+            {
+                errno = ENOENT;
+                return -1;
+            }
+
+            le_hashmap_Remove(PollMap, &pollPtr->key);
+            pollPtr->isDeleted = true;
+
+            if (pollPtr->isOnArmList)
+            {
+                le_dls_Remove(&ringRef->armList, &pollPtr->link);
+                pollPtr->isOnArmList = false;
+            }
+
+            // If a poll request is still in the kernel, cancel it and free the Poll object when
+            // its final completion arrives.
+            if (pollPtr->isArmed)
+            {
+                UpdatePoll(pollPtr);
+            }
+            else
+            {
+                ReleasePoll(pollPtr);
+            }
+
+            return 0;
+    }
+
+    errno = EINVAL;
+    return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for events on the file descriptors monitored by an io_uring instance.
+ *
+ * Works like epoll_wait(2), except that the only timeouts supported are 0 and -1.
+ *
+ * @return The number of events put in the list, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int ioUring_Wait
+(
+    ioUring_Ref_t ringRef,
+    struct epoll_event* eventListPtr,   ///< [out] Events that occurred.
+    int maxEvents,                      ///< [in] Number of entries in the event list.
+    int timeout                         ///< [in] 0 to return immediately, -1 to wait forever.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT((timeout == 0) || (timeout == -1));
+
+    // Everything that was reported last time has been handled by now, so its polls can be
+    // submitted again, along with the wait.
+    ArmAll(ringRef);
+
+    int count = Harvest(ringRef, eventListPtr, maxEvents);
+
+    // Completions of internal requests don't count, so go back to waiting if that's all there was.
+    while (count == 0)
+    {
+        // EAGAIN and EBUSY mean that the kernel is short of room for completions, so make
+        // some by collecting them.
+        if ((Enter(ringRef, (timeout != 0)) != 0) && (errno != EAGAIN) && (errno != EBUSY))
+        {
+            return -1;
+        }
+
+        count = Harvest(ringRef, eventListPtr, maxEvents);
+
+        if (timeout == 0)
+        {
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+#else // io_uring not supported by the kernel headers.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the io_uring module.
+ *
+ * @return false, as the kernel headers the framework was built with don't support everything
+ *         that is needed.
+ */
+//--------------------------------------------------------------------------------------------------
+bool ioUring_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return false;
+}
+
+
+ioUring_Ref_t ioUring_Create(void)
+{
+    return NULL;
+}
+
+
+void ioUring_Delete(ioUring_Ref_t ringRef)
+{
+    LE_FATAL("io_uring not supported.");
+}
+
+
+int ioUring_GetFd(ioUring_Ref_t ringRef)
+{
+    LE_FATAL("io_uring not supported.");
+}
+
+
+void ioUring_Submit(ioUring_Ref_t ringRef)
+{
+    LE_FATAL("io_uring not supported.");
+}
+
+
+int ioUring_Ctl(ioUring_Ref_t ringRef, int op, int fd, struct epoll_event* evPtr)
+{
+    LE_FATAL("io_uring not supported.");
+}
+
+
+int ioUring_Wait(ioUring_Ref_t ringRef, struct epoll_event* eventListPtr, int maxEvents,
+                 int timeout)
+{
+    LE_FATAL("io_uring not supported.");
+}
+
+
+#endif
@@ -0,0 +1,139 @@
+//--------------------------------------------------------------------------------------------------
+/** @file ioUring.h
+ *
+ * Inter-module interface definitions exported by the io_uring module to other modules within the
+ * framework.
+ *
+ * The io_uring module is an optional backend for the @ref c_eventLoop implementation.  It stands
+ * in for a thread's epoll fd, using the Linux io_uring(7) interface to wait for file descriptor
+ * events, and mimics the parts of epoll_ctl() and epoll_wait() that the Event Loop and the FD
+ * Monitor module use.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_IO_URING_H_INCLUDE_GUARD
+#define LEGATO_IO_URING_H_INCLUDE_GUARD
+
+#include <sys/epoll.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a thread's io_uring instance.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct ioUring_Ring* ioUring_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the io_uring module.
+ *
+ * This function must be called exactly once at process start-up, before any other io_uring
+ * functions are called.
+ *
+ * @return
+ *  - true if io_uring can be used as the Event Loop backend.
+ *  - false if the kernel (or the framework build) doesn't support everything that is needed.
+ */
+//--------------------------------------------------------------------------------------------------
+bool ioUring_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an io_uring instance for the calling thread.  It must only ever be used by that thread.
+ *
+ * @return Reference to the new instance, or NULL if it couldn't be created (in which case the
+ *         caller should fall back to using epoll).
+ */
+//--------------------------------------------------------------------------------------------------
+ioUring_Ref_t ioUring_Create
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an io_uring instance, cancelling everything it is waiting for.
+ */
+//--------------------------------------------------------------------------------------------------
+void ioUring_Delete
+(
+    ioUring_Ref_t ringRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get an io_uring instance's file descriptor.  This appears readable to poll() and select() when
+ * there are completions waiting to be collected by ioUring_Wait(), as long as everything has been
+ * submitted using ioUring_Submit().
+ *
+ * @return The file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+int ioUring_GetFd
+(
+    ioUring_Ref_t ringRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submit everything that ioUring_Wait() would submit, without waiting.  This is needed before
+ * waiting for the io_uring instance's file descriptor to become readable.
+ */
+//--------------------------------------------------------------------------------------------------
+void ioUring_Submit
+(
+    ioUring_Ref_t ringRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add, modify or remove a file descriptor in the set monitored by an io_uring instance.
+ *
+ * Works like epoll_ctl(2), with the same operation codes and errors (which the FD Monitor module
+ * relies on).  Events are level-triggered, unless EPOLLET is given, in which case the file
+ * descriptor is reported each time it changes state.  EPOLLONESHOT and EPOLLEXCLUSIVE are not
+ * supported.
+ *
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int ioUring_Ctl
+(
+    ioUring_Ref_t ringRef,
+    int op,                     ///< [in] EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL.
+    int fd,                     ///< [in] File descriptor.
+    struct epoll_event* evPtr   ///< [in] Events and data pointer (ignored for EPOLL_CTL_DEL).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for events on the file descriptors monitored by an io_uring instance.
+ *
+ * Works like epoll_wait(2), except that the only timeouts supported are 0 and -1.
+ *
+ * @return The number of events put in the list, or -1 with errno set on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int ioUring_Wait
+(
+    ioUring_Ref_t ringRef,
+    struct epoll_event* eventListPtr,   ///< [out] Events that occurred.
+    int maxEvents,                      ///< [in] Number of entries in the event list.
+    int timeout                         ///< [in] 0 to return immediately, -1 to wait forever.
+);
+
+
+#endif // LEGATO_IO_URING_H_INCLUDE_GUARD
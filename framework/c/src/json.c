@@ -65,6 +65,7 @@ typedef struct le_json_ParsingSession
     le_thread_DestructorRef_t threadDestructor; ///< Ref to thread death destructor for this parser.
 
     le_sls_List_t contextStack;     ///< Stack of Context records.
+    le_arena_Ref_t contextArena;    ///< Arena that Context records are allocated from.
 }
 Parser_t;
 
@@ -74,7 +75,9 @@ Parser_t;
  * Context record.  Keeps track of the event handler function and opaque pointer that belongs
  * to a given parsing context.
  *
- * These are allocated from the Context Pool and are kept on a Parser instance's Context Stack.
+ * These are allocated from the Parser's Context Arena and are kept on its Context Stack.  Since
+ * contexts are strictly nested, popping a context just rewinds the arena to where it was before
+ * the context was pushed.
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct
@@ -84,6 +87,8 @@ typedef struct
     le_json_ContextType_t type;     ///< Type of JSON syntax structure being parsed.
 
     le_json_EventHandler_t  eventHandler;   ///< Called when parsing events happen in this context.
+
+    le_arena_Mark_t mark;   ///< Position of the Context Arena before this record was allocated.
 }
 Context_t;
 
@@ -91,9 +96,6 @@ Context_t;
 // Memory pool reference for the pool that parser instance records are allocated from.
 static le_mem_PoolRef_t ParserPool;
 
-// Memory pool reference for the pool that context records are allocated from.
-static le_mem_PoolRef_t ContextPool;
-
 
 /// Thread-local data key for use by the event and error handler functions.
 /// When inside a handler, this thread-local data value will be a pointer to a Parser object.
@@ -152,12 +154,9 @@ static void ParserDestructor
 
     StopParsing(parserPtr);
 
-    le_sls_Link_t* linkPtr;
-
-    while ((linkPtr = le_sls_Pop(&parserPtr->contextStack)) != NULL)
-    {
-        le_mem_Release(CONTAINER_OF(linkPtr, Context_t, link));
-    }
+    // Deleting the arena releases all the contexts.
+    parserPtr->contextStack = LE_SLS_LIST_INIT;
+    le_arena_Delete(parserPtr->contextArena);
 
     le_thread_RemoveDestructor(parserPtr->threadDestructor);
 }
@@ -179,7 +178,6 @@ void json_Init
     // Create the memory pools.
     ParserPool = le_mem_CreatePool("JSON Parser", sizeof(Parser_t));
     le_mem_SetDestructor(ParserPool, ParserDestructor);
-    ContextPool = le_mem_CreatePool("JSON Context", sizeof(Context_t));
 
     // Initialize the thread-local data key.
     pthread_key_create(&HandlerKey, NULL);
@@ -352,8 +350,10 @@ static void PushContext
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Context_t* contextPtr = le_mem_ForceAlloc(ContextPool);
+    le_arena_Mark_t mark = le_arena_GetMark(parserPtr->contextArena);
+    Context_t* contextPtr = le_arena_Alloc(parserPtr->contextArena, sizeof(Context_t));
 
+    contextPtr->mark = mark;
     contextPtr->link = LE_SLS_LINK_INIT;
     contextPtr->type = type;
     contextPtr->eventHandler = eventHandler;
@@ -382,7 +382,7 @@ static void PopContext
     {
         // Pop the top one and release it.
         le_sls_Link_t* linkPtr = le_sls_Pop(&parserPtr->contextStack);
-        le_mem_Release(CONTAINER_OF(linkPtr, Context_t, link));
+        le_arena_Rewind(parserPtr->contextArena, CONTAINER_OF(linkPtr, Context_t, link)->mark);
 
         // Check the new context
         le_json_ContextType_t context = GetContext(parserPtr)->type;
@@ -1008,6 +1008,7 @@ le_json_ParsingSessionRef_t le_json_Parse
     parserPtr->threadDestructor = le_thread_AddDestructor(ThreadDeathHandler, parserPtr);
 
     parserPtr->contextStack = LE_SLS_LIST_INIT;
+    parserPtr->contextArena = le_arena_Create("JSON Context");
 
     // Create the top-level context and push it onto the context stack.
     PushContext(parserPtr, LE_JSON_CONTEXT_DOC, eventHandler);
@@ -119,6 +119,24 @@
 #define LIMIT_MAX_SEMAPHORE_NAME_BYTES          (LIMIT_MAX_SEMAPHORE_NAME_LEN + 1)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum string length and byte storage size of reader-writer lock names.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LIMIT_MAX_RWLOCK_NAME_LEN               31
+#define LIMIT_MAX_RWLOCK_NAME_BYTES             (LIMIT_MAX_RWLOCK_NAME_LEN + 1)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum string length and byte storage size of condition variable names.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LIMIT_MAX_COND_NAME_LEN                 31
+#define LIMIT_MAX_COND_NAME_BYTES               (LIMIT_MAX_COND_NAME_LEN + 1)
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum string length and byte storage size of timer names.
@@ -128,6 +146,15 @@
 #define LIMIT_MAX_TIMER_NAME_BYTES              (LIMIT_MAX_TIMER_NAME_LEN + 1)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum string length and byte storage size of coroutine names.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LIMIT_MAX_COROUTINE_NAME_LEN            31
+#define LIMIT_MAX_COROUTINE_NAME_BYTES          (LIMIT_MAX_COROUTINE_NAME_LEN + 1)
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum string length and byte storage size of memory pool names (excluding the component
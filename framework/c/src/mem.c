@@ -7,13 +7,67 @@
  * object, the number of blocks and objects in a memory pool are always the same.
  *
  * Memory for the memory blocks (including the user object) is allocated from system
- * memory when a memory pool is expanded.  Memory blocks are never released back to system memory.
- * Instead, when they are "free", they are kept on their pool's "free list".  The free list is
+ * memory when a memory pool is expanded, in chunks called "slabs".  Normally, memory blocks are
+ * never released back to system memory.  Instead, when they are "free", they are kept on their
+ * pool's "free list".  The free list is
  * O(1) for both insertion and removal.  It is treated as a stack, in that blocks are popped from
  * the head of the free list when they are allocated and pushed back onto the head of the free
  * list when they are deallocated.  The hope is that this will speed things up by utilizing the
  * cache better when there are a lot of allocations interleaved with releases.
  *
+ * TRIMMING
+ * ========
+ *
+ * A pool can be made "trimmable" using le_mem_SetTrimWatermarks().  The slabs of a trimmable pool
+ * are mapped directly from the system, a whole number of pages at a time, and start with a header
+ * that links them into the pool's list of slabs, so that slabs that contain nothing but free blocks
+ * can be found and released back to system memory.  Other pools' slabs have no header and are
+ * never released.  Finding the fully free slabs requires a walk of the free list, which looks up
+ * each block's slab by binary search in an address-sorted array of the slabs, so it is only ever
+ * done when trimming, never when allocating or releasing.
+ *
+ * Forced expansions of a trimmable pool grow it geometrically (by half its current size, up to a
+ * limit) so that the number of slabs stays small.  Whenever the number of free blocks in a
+ * trimmable pool grows above its high watermark, fully free slabs are unmapped until no more than
+ * the low watermark number of free blocks are left (or no fully free slabs are left).  This check
+ * is made when a thread's cache overflows, so it doesn't add anything to the fast paths.
+ *
+ * PER-THREAD CACHES
+ * =================
+ *
+ * To keep the module's mutex off the allocation and release paths, every thread keeps a small
+ * cache (a "magazine") of free blocks in front of each pool's free list.  Blocks are allocated
+ * from and released into the calling thread's cache without taking the mutex.  Only when the cache
+ * runs empty (or fills up) is the mutex taken, and then a whole batch of blocks is moved between
+ * the cache and the pool's free list at once.
+ *
+ * Each cache is protected by a "busy" flag that is only ever contended when another thread needs
+ * to reach into it while holding the mutex.  That happens when a pool's free list is empty but
+ * some other thread's cache still holds free blocks of that pool (the blocks are stolen, so
+ * le_mem_TryAlloc() only fails when there really are no free blocks left anywhere), when a
+ * sub-pool is expanded or deleted, and when a thread dies (its caches are flushed back into the
+ * pools' free lists).  To avoid deadlocks, the mutex is always locked before any busy flag is set.
+ *
+ * The pool statistics are maintained using atomic operations, so they stay exact no matter which
+ * cache a block is allocated from or released into.  Blocks sitting in a cache count as free.
+ *
+ * LOCK-FREE POOLS
+ * ===============
+ *
+ * A pool made "concurrent" using le_mem_SetConcurrent() doesn't use the per-thread caches or its
+ * free list.  Its free blocks are kept on a Treiber stack instead: a lock-free stack whose top is
+ * updated by compare-and-swap.  To defeat the ABA problem, the top-of-stack pointer is tagged with
+ * a counter that is incremented by every successful push or pop, and the pointer and tag are
+ * swapped together by a double-width compare-and-swap (see mem_TaggedPtr_t).  The tag is as wide
+ * as a pointer, so it doesn't wrap around until 2^32 (32-bit) or 2^64 (64-bit) pushes and pops
+ * have been done.  On 64-bit platforms the compare-and-swap comes from libatomic, which uses the
+ * CPU's 16-byte compare-and-swap instruction where there is one.
+ *
+ * A popping thread may read the link of a block that another thread has just allocated (the
+ * compare-and-swap then fails and the pop is retried), so a concurrent pool's slabs must never
+ * be released back to the system.  That's why concurrent pools can't be trimmed.  They also can't
+ * have sub-pools, because moving blocks between pools is done through the free lists.
+ *
  * Sub-pools behave exactly like memory pools except in the way that they are created, expanded and
  * deleted.
  *
@@ -45,6 +99,7 @@
 #include "legato.h"
 #include "mem.h"
 #include "limit.h"
+#include <sys/mman.h>
 
 #define USE_GUARD_BAND
 #define FILL_DELETED_AND_CHECK_ALLOCATED
@@ -62,6 +117,21 @@
 /// @todo Make this configurable.
 #define DEFAULT_SUB_POOLS_POOL_SIZE     8
 
+/// The maximum number of free blocks that a thread can hold in its cache for a single pool.
+#define CACHE_SIZE                      16
+
+/// The number of blocks moved between a thread's cache and its pool's free list at once.
+#define CACHE_BATCH_SIZE                (CACHE_SIZE / 2)
+
+/// The maximum number of bytes that a trimmable pool grows by when le_mem_ForceAlloc() expands it.
+#define MAX_GROWTH_BYTES                (64 * 1024)
+
+/// Position of the tag in a concurrent pool's tagged top-of-stack pointer (see LOCK-FREE POOLS).
+#define STACK_TAG_SHIFT                 (sizeof(uintptr_t) * 8)
+
+/// Mask of the pointer part of a concurrent pool's tagged top-of-stack pointer.
+#define STACK_PTR_MASK                  ((mem_TaggedPtr_t)UINTPTR_MAX)
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -109,6 +179,91 @@ typedef struct
 MemBlock_t;
 
 
+#ifndef LE_MEM_VALGRIND
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of each slab of memory mapped for a trimmable pool's blocks.  The blocks
+ * follow immediately after the header.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;                 ///< Link in the pool's list of slabs.
+    size_t size;                        ///< Size of the slab in bytes, including this header.
+    size_t numBlocks;                   ///< Number of blocks in the slab.
+    size_t numFree;                     ///< Number of free blocks (only valid while trimming).
+}
+Slab_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The system's memory page size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t PageSize;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A thread's cache of free blocks for a single pool.
+ *
+ * Only the owning thread adds blocks to or removes blocks from its cache, unless the busy flag
+ * is held by another thread (which must also be holding the mutex).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;                 ///< Link in the pool's list of caches.
+    MemPool_t* poolPtr;                 ///< The pool the cached blocks belong to.  NULL if the pool
+                                        ///  was deleted while this cache still existed.
+    bool isBusy;                        ///< true while someone is accessing the cached blocks.
+    size_t numBlocks;                   ///< Number of free blocks currently in the cache.
+    MemBlock_t* blocks[CACHE_SIZE];     ///< The cached free blocks (used as a stack).
+}
+MemCache_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Table of a thread's caches, indexed by pool cache index.  Stored in thread-local storage.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t numCaches;                   ///< Number of entries in the cache pointer array.
+    MemCache_t** caches;                ///< Array of pointers to caches (NULL = no cache yet).
+}
+ThreadCaches_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread-local data key used to find the calling thread's cache table.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t ThreadCachesKey;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The next pool cache index that has never been assigned to a pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t NextCacheIndex = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cache indices released by deleted sub-pools, available for reuse.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t* FreeCacheIndices = NULL;
+static size_t NumFreeCacheIndices = 0;
+static size_t FreeCacheIndicesSize = 0;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Local list of all memory pools created with le_mem_CreatePool and le_mem_CreateSubPool
@@ -282,188 +437,1066 @@ static inline void Unlock
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initializes a memory pool.
- *
- * @warning Called without the mutex locked.
+ * Atomically adds to a pool's count of blocks in use and updates its high-water mark.
  */
 //--------------------------------------------------------------------------------------------------
-static void InitPool
+static inline void AddBlocksInUse
 (
-    le_mem_PoolRef_t    pool,       ///< [IN] The pool to initialize.
-    const char*      componentName, ///< [IN] Name of the component.
-    const char*         name,       ///< [IN] Name of the pool inside the component.
-    size_t              objSize     ///< [IN] The size of the individual objects to be allocated
-                                    ///       from this pool in bytes.
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool.
+    size_t              numBlocks   ///< [IN] The number of blocks that were taken into use.
 )
 {
-    // Construct the component-scoped pool name.
-    size_t nameSize = snprintf(pool->name, sizeof(pool->name), "%s.%s", componentName, name);
-    if (nameSize >= sizeof(pool->name))
-    {
-        LE_DEBUG("Memory pool name '%s.%s' is truncated to '%s'", componentName, name, pool->name);
-    }
-
-    // Compute the total block size.
-    size_t blockSize = sizeof(MemBlock_t) + objSize;
-
-    #ifdef USE_GUARD_BAND
-    {
-        // Add guard bands around the user data in every block.
-        blockSize += (GUARD_BAND_SIZE * 2);
-    }
-    #endif
-
-    // Round up the block size to the nearest multiple of the processor word size.
-    size_t remainder = blockSize % sizeof(void*);
-    if (remainder != 0)
+    size_t numInUse = __atomic_add_fetch(&(pool->numBlocksInUse), numBlocks, __ATOMIC_RELAXED);
+    size_t maxUsed = __atomic_load_n(&(pool->maxNumBlocksUsed), __ATOMIC_RELAXED);
+
+    while (   (numInUse > maxUsed)
+           && !__atomic_compare_exchange_n(&(pool->maxNumBlocksUsed),
+                                           &maxUsed,
+                                           numInUse,
+                                           true,
+                                           __ATOMIC_RELAXED,
+                                           __ATOMIC_RELAXED) )
     {
-        blockSize += (sizeof(void*) - remainder);
+        // maxUsed has been refreshed by the failed compare-exchange; try again.
     }
-
-    pool->poolLink = LE_DLS_LINK_INIT;
-
-    #ifndef LE_MEM_VALGRIND
-        pool->freeList = LE_SLS_LIST_INIT;
-    #endif
-
-    pool->userDataSize = objSize;
-    pool->blockSize = blockSize;
-    pool->destructor = NULL;
-    pool->superPoolPtr = NULL;
-    pool->numAllocations = 0;
-    pool->numOverflows = 0;
-    pool->totalBlocks = 0;
-    pool->numBlocksInUse = 0;
-    pool->maxNumBlocksUsed = 0;
-    pool->numBlocksToForce = DEFAULT_NUM_BLOCKS_TO_FORCE;
-
-    #ifdef LE_MEM_TRACE
-        pool->memTrace = NULL;
-
-        if (LE_LOG_SESSION != NULL)
-        {
-            pool->memTrace = le_log_GetTraceRef(pool->name);
-            LE_DEBUG("Tracing enabled for pool '%s'.", pool->name);
-        }
-    #endif
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Moves the specified number of blocks from the source pool to the destination pool.
- *
- * @note
- *      Does not update the total number of blocks for either pool.
- *
- * @note
- *      Assumes that the mutex is locked.
+ * Atomically subtracts from a pool's count of blocks in use.
  */
 //--------------------------------------------------------------------------------------------------
-static void MoveBlocks
+static inline void RemoveBlocksInUse
 (
-    le_mem_PoolRef_t    destPool,   ///< [IN] The pool to move the blocks to.
-    le_mem_PoolRef_t    srcPool,    ///< [IN] The pool to get the blocks from.
-    size_t              numBlocks   ///< [IN] The maximum number of blocks to move.
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool.
+    size_t              numBlocks   ///< [IN] The number of blocks that were put out of use.
 )
 {
-    #ifndef LE_MEM_VALGRIND
-        // Get the first block to move.
-        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(srcPool->freeList));
+    __atomic_sub_fetch(&(pool->numBlocksInUse), numBlocks, __ATOMIC_RELAXED);
+}
 
-        size_t i = 0;
-        while (i < numBlocks)
+
+#ifndef LE_MEM_VALGRIND
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Sets a cache's busy flag, waiting for whoever else holds it to finish first.
+     *
+     * The flag is only ever held for a handful of instructions, so contention is resolved by
+     * briefly sleeping, which also lets a preempted lower-priority holder run.
+     */
+    //----------------------------------------------------------------------------------------------
+    static inline void LockCache
+    (
+        MemCache_t* cachePtr        ///< [IN] The cache.
+    )
+    {
+        while (__atomic_exchange_n(&(cachePtr->isBusy), true, __ATOMIC_ACQUIRE))
         {
-            if (blockLinkPtr == NULL)
-            {
-                LE_FATAL("Asked to move %zu blocks from pool '%s' to pool '%s', "
-                         "but only %zu were available.",
-                         numBlocks,
-                         srcPool->name,
-                         destPool->name,
-                         i);
-            }
+            static const struct timespec backoff = { 0, 1000 };
+            nanosleep(&backoff, NULL);
+        }
+    }
 
-            // Add the block to the destination pool.
-            le_sls_Stack(&(destPool->freeList), blockLinkPtr);
 
-            // Update the blocks parent pool.
-            MemBlock_t* blockPtr = CONTAINER_OF(blockLinkPtr, MemBlock_t, link);
-            blockPtr->poolPtr = destPool;
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Clears a cache's busy flag.
+     */
+    //----------------------------------------------------------------------------------------------
+    static inline void UnlockCache
+    (
+        MemCache_t* cachePtr        ///< [IN] The cache.
+    )
+    {
+        __atomic_store_n(&(cachePtr->isBusy), false, __ATOMIC_RELEASE);
+    }
 
-            // Get the next block.
-            blockLinkPtr = le_sls_Pop(&(srcPool->freeList));
 
-            i++;
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Gets a cache index for a new pool, reusing one released by a deleted sub-pool if possible.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static size_t GetCacheIndex
+    (
+        void
+    )
+    {
+        if (NumFreeCacheIndices > 0)
+        {
+            NumFreeCacheIndices--;
+            return FreeCacheIndices[NumFreeCacheIndices];
         }
-    #endif
-}
 
+        return NextCacheIndex++;
+    }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Initialize a new pool block.
- */
-//--------------------------------------------------------------------------------------------------
-static void InitBlock
-(
-    le_mem_PoolRef_t pool,       ///< [IN] The pool the new block belongs to.
-    MemBlock_t* newBlockPtr      ///< [IN] The block being initialized.
-)
-{
-    // Initialize the block.
-    #ifndef LE_MEM_VALGRIND
-        // Add the block to the pool's free list.
-        newBlockPtr->link = LE_SLS_LINK_INIT;
-        le_sls_Stack(&(pool->freeList), &(newBlockPtr->link));
-    #endif
 
-    newBlockPtr->refCount = 0;
-    newBlockPtr->poolPtr = pool;
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Releases a deleted sub-pool's cache index for reuse by a future pool.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void ReleaseCacheIndex
+    (
+        size_t cacheIndex           ///< [IN] The cache index no longer used by any pool.
+    )
+    {
+        if (NumFreeCacheIndices == FreeCacheIndicesSize)
+        {
+            FreeCacheIndicesSize = (FreeCacheIndicesSize == 0 ? DEFAULT_SUB_POOLS_POOL_SIZE
+                                                              : FreeCacheIndicesSize * 2);
+            FreeCacheIndices = realloc(FreeCacheIndices,
+                                       FreeCacheIndicesSize * sizeof(*FreeCacheIndices));
+            LE_ASSERT(FreeCacheIndices);
+        }
 
-    #ifdef USE_GUARD_BAND
-        InitGuardBands(newBlockPtr);
-    #endif
-}
+        FreeCacheIndices[NumFreeCacheIndices] = cacheIndex;
+        NumFreeCacheIndices++;
+    }
 
 
-#ifndef LE_MEM_VALGRIND
     //----------------------------------------------------------------------------------------------
     /**
-     * Creates blocks and adds them to the pool.
+     * Creates the calling thread's cache for a given pool.
      *
-     * @note
-     *      Updates the pools total number of blocks.
+     * @return Pointer to the new cache.
      *
      * @note
-     *      Assumes that the mutex is locked.
+     *      Must be called without the mutex locked.
      */
     //----------------------------------------------------------------------------------------------
-    static void AddBlocks
+    static MemCache_t* CreateThreadCache
     (
-        le_mem_PoolRef_t    pool,       ///< [IN] The pool to be expanded.
-        size_t              numBlocks   ///< [IN] The number of blocks to add to the pool.
+        le_mem_PoolRef_t    pool,   ///< [IN] The pool to create a cache for.
+        ThreadCaches_t*     tcPtr   ///< [IN] The thread's cache table, or NULL if none yet.
     )
     {
-        size_t i;
-        size_t blockSize = pool->blockSize;
-        size_t mallocSize = numBlocks * blockSize;
+        if (tcPtr == NULL)
+        {
+            tcPtr = calloc(1, sizeof(ThreadCaches_t));
+            LE_ASSERT(tcPtr);
+            LE_ASSERT(pthread_setspecific(ThreadCachesKey, tcPtr) == 0);
+        }
 
-        // Allocate the chunk.
-        MemBlock_t* newBlockPtr = malloc(mallocSize);
+        if (pool->cacheIndex >= tcPtr->numCaches)
+        {
+            size_t numCaches = tcPtr->numCaches * 2;
 
-        LE_ASSERT(newBlockPtr);
+            if (numCaches <= pool->cacheIndex)
+            {
+                numCaches = pool->cacheIndex + 1;
+            }
 
-        for (i = 0; i < numBlocks; i++)
-        {
-            InitBlock(pool, newBlockPtr);
-            newBlockPtr = (MemBlock_t*)(((uint8_t*)newBlockPtr) + blockSize);
+            tcPtr->caches = realloc(tcPtr->caches, numCaches * sizeof(MemCache_t*));
+            LE_ASSERT(tcPtr->caches);
+
+            memset(tcPtr->caches + tcPtr->numCaches,
+                   0,
+                   (numCaches - tcPtr->numCaches) * sizeof(MemCache_t*));
+            tcPtr->numCaches = numCaches;
         }
 
-        // Update the pool.
-        pool->totalBlocks += numBlocks;
-    }
-#endif
+        MemCache_t* cachePtr = malloc(sizeof(MemCache_t));
+        LE_ASSERT(cachePtr);
+
+        cachePtr->link = LE_DLS_LINK_INIT;
+        cachePtr->poolPtr = pool;
+        cachePtr->isBusy = false;
+        cachePtr->numBlocks = 0;
+
+        Lock();
+        le_dls_Queue(&(pool->cacheList), &(cachePtr->link));
+        Unlock();
+
+        tcPtr->caches[pool->cacheIndex] = cachePtr;
+
+        return cachePtr;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Gets the calling thread's cache for a given pool, creating it if necessary, and sets its
+     * busy flag.
+     *
+     * @return Pointer to the cache.
+     *
+     * @note
+     *      Must be called without the mutex locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static MemCache_t* LockThreadCache
+    (
+        le_mem_PoolRef_t    pool    ///< [IN] The pool.
+    )
+    {
+        ThreadCaches_t* tcPtr = pthread_getspecific(ThreadCachesKey);
+        MemCache_t* cachePtr = NULL;
+
+        if ((tcPtr != NULL) && (pool->cacheIndex < tcPtr->numCaches))
+        {
+            cachePtr = tcPtr->caches[pool->cacheIndex];
+        }
+
+        if (cachePtr != NULL)
+        {
+            LockCache(cachePtr);
+
+            if (cachePtr->poolPtr == pool)
+            {
+                return cachePtr;
+            }
+
+            // The cache belonged to a deleted sub-pool whose cache index has since been reused.
+            // It has already been detached from that sub-pool, so nobody else can reach it.
+            UnlockCache(cachePtr);
+            free(cachePtr);
+            tcPtr->caches[pool->cacheIndex] = NULL;
+        }
+
+        cachePtr = CreateThreadCache(pool, tcPtr);
+        LockCache(cachePtr);
+
+        return cachePtr;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Moves free blocks from other threads' caches into a given cache, up to a batch worth.
+     *
+     * @note
+     *      Assumes that the mutex is locked and the given cache's busy flag is set.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void StealBlocks
+    (
+        MemCache_t* cachePtr        ///< [IN] The cache to move the stolen blocks into.
+    )
+    {
+        le_dls_List_t* cacheListPtr = &(cachePtr->poolPtr->cacheList);
+        le_dls_Link_t* linkPtr = le_dls_Peek(cacheListPtr);
+
+        while ((linkPtr != NULL) && (cachePtr->numBlocks < CACHE_BATCH_SIZE))
+        {
+            MemCache_t* otherCachePtr = CONTAINER_OF(linkPtr, MemCache_t, link);
+
+            if (otherCachePtr != cachePtr)
+            {
+                LockCache(otherCachePtr);
+
+                while ((otherCachePtr->numBlocks > 0) && (cachePtr->numBlocks < CACHE_BATCH_SIZE))
+                {
+                    otherCachePtr->numBlocks--;
+                    cachePtr->blocks[cachePtr->numBlocks] =
+                                                    otherCachePtr->blocks[otherCachePtr->numBlocks];
+                    cachePtr->numBlocks++;
+                }
+
+                UnlockCache(otherCachePtr);
+            }
+
+            linkPtr = le_dls_PeekNext(cacheListPtr, linkPtr);
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Refills an empty cache with a batch of blocks from its pool's free list.  If the free list
+     * is empty, tries to get blocks out of other threads' caches instead.
+     *
+     * @note
+     *      Assumes that the mutex is locked and the cache's busy flag is set.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void FillCache
+    (
+        MemCache_t* cachePtr        ///< [IN] The cache to be filled.
+    )
+    {
+        le_sls_List_t* freeListPtr = &(cachePtr->poolPtr->freeList);
+
+        while (cachePtr->numBlocks < CACHE_BATCH_SIZE)
+        {
+            le_sls_Link_t* blockLinkPtr = le_sls_Pop(freeListPtr);
+
+            if (blockLinkPtr == NULL)
+            {
+                break;
+            }
+
+            cachePtr->blocks[cachePtr->numBlocks] = CONTAINER_OF(blockLinkPtr, MemBlock_t, link);
+            cachePtr->numBlocks++;
+        }
+
+        if (cachePtr->numBlocks == 0)
+        {
+            StealBlocks(cachePtr);
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Moves blocks from a cache back onto its pool's free list until the cache holds no more than
+     * a given number of blocks.
+     *
+     * @note
+     *      Assumes that the mutex is locked and the cache's busy flag is set.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void FlushCache
+    (
+        MemCache_t* cachePtr,       ///< [IN] The cache to be flushed.
+        size_t      numToKeep       ///< [IN] The number of blocks to leave in the cache.
+    )
+    {
+        le_sls_List_t* freeListPtr = &(cachePtr->poolPtr->freeList);
+
+        while (cachePtr->numBlocks > numToKeep)
+        {
+            cachePtr->numBlocks--;
+            le_sls_Stack(freeListPtr, &(cachePtr->blocks[cachePtr->numBlocks]->link));
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Moves all blocks in all threads' caches for a given pool back onto the pool's free list.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void ReclaimCaches
+    (
+        le_mem_PoolRef_t    pool    ///< [IN] The pool.
+    )
+    {
+        le_dls_Link_t* linkPtr = le_dls_Peek(&(pool->cacheList));
+
+        while (linkPtr != NULL)
+        {
+            MemCache_t* cachePtr = CONTAINER_OF(linkPtr, MemCache_t, link);
+
+            LockCache(cachePtr);
+            FlushCache(cachePtr, 0);
+            UnlockCache(cachePtr);
+
+            linkPtr = le_dls_PeekNext(&(pool->cacheList), linkPtr);
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Empties all threads' caches for a pool that is being deleted and detaches them from the
+     * pool.  Each detached cache is freed later by its owning thread.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void DetachCaches
+    (
+        le_mem_PoolRef_t    pool    ///< [IN] The pool.
+    )
+    {
+        le_dls_Link_t* linkPtr;
+
+        while ((linkPtr = le_dls_Pop(&(pool->cacheList))) != NULL)
+        {
+            MemCache_t* cachePtr = CONTAINER_OF(linkPtr, MemCache_t, link);
+
+            LockCache(cachePtr);
+            FlushCache(cachePtr, 0);
+            cachePtr->poolPtr = NULL;
+            UnlockCache(cachePtr);
+        }
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Thread-local data destructor that flushes a dying thread's caches back into their pools and
+     * frees them.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void DestructThreadCaches
+    (
+        void* tcVoidPtr             ///< [IN] Pointer to the thread's cache table.
+    )
+    {
+        ThreadCaches_t* tcPtr = tcVoidPtr;
+        size_t i;
+
+        Lock();
+
+        for (i = 0; i < tcPtr->numCaches; i++)
+        {
+            MemCache_t* cachePtr = tcPtr->caches[i];
+
+            if (cachePtr != NULL)
+            {
+                LockCache(cachePtr);
+
+                if (cachePtr->poolPtr != NULL)
+                {
+                    FlushCache(cachePtr, 0);
+                    le_dls_Remove(&(cachePtr->poolPtr->cacheList), &(cachePtr->link));
+                }
+
+                UnlockCache(cachePtr);
+                free(cachePtr);
+            }
+        }
+
+        Unlock();
+
+        free(tcPtr->caches);
+        free(tcPtr);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Gets the block pointer out of a concurrent pool's tagged top-of-stack pointer.
+     */
+    //----------------------------------------------------------------------------------------------
+    static inline MemBlock_t* StackTop
+    (
+        mem_TaggedPtr_t taggedPtr   ///< [IN] The tagged pointer.
+    )
+    {
+        return (MemBlock_t*)(uintptr_t)(taggedPtr & STACK_PTR_MASK);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Makes a new tagged top-of-stack pointer to replace a given one.
+     */
+    //----------------------------------------------------------------------------------------------
+    static inline mem_TaggedPtr_t NewStackTop
+    (
+        MemBlock_t*     blockPtr,       ///< [IN] The new top block (NULL if the stack is now
+                                        ///<      empty).
+        mem_TaggedPtr_t oldTaggedPtr    ///< [IN] The tagged pointer being replaced.
+    )
+    {
+        return ((mem_TaggedPtr_t)(uintptr_t)blockPtr)
+               | ((oldTaggedPtr & ~STACK_PTR_MASK) + (((mem_TaggedPtr_t)1) << STACK_TAG_SHIFT));
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Pushes a chain of blocks onto a concurrent pool's free block stack.  The blocks must already
+     * be linked together from first to last.
+     *
+     * @note
+     *      Lock-free.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void PushBlocks
+    (
+        le_mem_PoolRef_t    pool,       ///< [IN] The pool.
+        MemBlock_t*         firstPtr,   ///< [IN] The block to go on top.
+        MemBlock_t*         lastPtr     ///< [IN] The block at the end of the chain.
+    )
+    {
+        mem_TaggedPtr_t oldTop = __atomic_load_n(&(pool->freeStack), __ATOMIC_RELAXED);
+
+        do
+        {
+            MemBlock_t* topPtr = StackTop(oldTop);
+
+            // PopBlock() can still be reading this link from a thread that saw it on top of the
+            // stack before it was popped, so it has to be stored atomically.
+            __atomic_store_n(&(lastPtr->link.nextPtr),
+                             (topPtr == NULL ? NULL : &(topPtr->link)),
+                             __ATOMIC_RELAXED);
+        }
+        while (!__atomic_compare_exchange_n(&(pool->freeStack),
+                                            &oldTop,
+                                            NewStackTop(firstPtr, oldTop),
+                                            true,
+                                            __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED));
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Pops a block off a concurrent pool's free block stack.
+     *
+     * @return Pointer to the block, or NULL if the stack is empty.
+     *
+     * @note
+     *      Lock-free.
+     */
+    //----------------------------------------------------------------------------------------------
+    static MemBlock_t* PopBlock
+    (
+        le_mem_PoolRef_t    pool        ///< [IN] The pool.
+    )
+    {
+        mem_TaggedPtr_t oldTop = __atomic_load_n(&(pool->freeStack), __ATOMIC_ACQUIRE);
+        MemBlock_t* topPtr;
+
+        do
+        {
+            topPtr = StackTop(oldTop);
+
+            if (topPtr == NULL)
+            {
+                return NULL;
+            }
+
+            // The top block may be popped and reused by another thread before this read happens,
+            // in which case the tag will have changed and the compare-and-swap will fail.
+            le_sls_Link_t* nextLinkPtr = __atomic_load_n(&(topPtr->link.nextPtr), __ATOMIC_RELAXED);
+            MemBlock_t* nextPtr =
+                (nextLinkPtr == NULL ? NULL : CONTAINER_OF(nextLinkPtr, MemBlock_t, link));
+
+            if (__atomic_compare_exchange_n(&(pool->freeStack),
+                                            &oldTop,
+                                            NewStackTop(nextPtr, oldTop),
+                                            true,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_ACQUIRE))
+            {
+                return topPtr;
+            }
+        }
+        while (true);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Moves all the blocks on a concurrent pool's free list onto its free block stack.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void StackFreeList
+    (
+        le_mem_PoolRef_t    pool        ///< [IN] The pool.
+    )
+    {
+        le_sls_Link_t* firstLinkPtr = le_sls_Peek(&(pool->freeList));
+        le_sls_Link_t* lastLinkPtr = firstLinkPtr;
+        le_sls_Link_t* linkPtr;
+
+        if (firstLinkPtr == NULL)
+        {
+            return;
+        }
+
+        while ((linkPtr = le_sls_PeekNext(&(pool->freeList), lastLinkPtr)) != NULL)
+        {
+            lastLinkPtr = linkPtr;
+        }
+
+        pool->freeList = LE_SLS_LIST_INIT;
+
+        // The links of the blocks already chain them together in order.
+        PushBlocks(pool,
+                   CONTAINER_OF(firstLinkPtr, MemBlock_t, link),
+                   CONTAINER_OF(lastLinkPtr, MemBlock_t, link));
+    }
+
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes a memory pool.
+ *
+ * @warning Called without the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitPool
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool to initialize.
+    const char*      componentName, ///< [IN] Name of the component.
+    const char*         name,       ///< [IN] Name of the pool inside the component.
+    size_t              objSize     ///< [IN] The size of the individual objects to be allocated
+                                    ///       from this pool in bytes.
+)
+{
+    // Construct the component-scoped pool name.
+    size_t nameSize = snprintf(pool->name, sizeof(pool->name), "%s.%s", componentName, name);
+    if (nameSize >= sizeof(pool->name))
+    {
+        LE_DEBUG("Memory pool name '%s.%s' is truncated to '%s'", componentName, name, pool->name);
+    }
+
+    // Compute the total block size.
+    size_t blockSize = sizeof(MemBlock_t) + objSize;
+
+    #ifdef USE_GUARD_BAND
+    {
+        // Add guard bands around the user data in every block.
+        blockSize += (GUARD_BAND_SIZE * 2);
+    }
+    #endif
+
+    // Round up the block size to the nearest multiple of the processor word size.
+    size_t remainder = blockSize % sizeof(void*);
+    if (remainder != 0)
+    {
+        blockSize += (sizeof(void*) - remainder);
+    }
+
+    pool->poolLink = LE_DLS_LINK_INIT;
+
+    #ifndef LE_MEM_VALGRIND
+        pool->freeList = LE_SLS_LIST_INIT;
+        pool->cacheList = LE_DLS_LIST_INIT;
+        pool->slabList = LE_SLS_LIST_INIT;
+        pool->freeStack = 0;
+    #endif
+
+    pool->userDataSize = objSize;
+    pool->blockSize = blockSize;
+    pool->destructor = NULL;
+    pool->superPoolPtr = NULL;
+    pool->numAllocations = 0;
+    pool->numOverflows = 0;
+    pool->totalBlocks = 0;
+    pool->numBlocksInUse = 0;
+    pool->maxNumBlocksUsed = 0;
+    pool->numBlocksToForce = DEFAULT_NUM_BLOCKS_TO_FORCE;
+    pool->isTrimmable = false;
+    pool->lowWatermark = 0;
+    pool->highWatermark = 0;
+    pool->trimThreshold = 0;
+    pool->numTrimmedBlocks = 0;
+    pool->isConcurrent = false;
+
+    #ifdef LE_MEM_TRACE
+        pool->memTrace = NULL;
+
+        if (LE_LOG_SESSION != NULL)
+        {
+            pool->memTrace = le_log_GetTraceRef(pool->name);
+            LE_DEBUG("Tracing enabled for pool '%s'.", pool->name);
+        }
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the specified number of blocks from the source pool to the destination pool.
+ *
+ * @note
+ *      Does not update the total number of blocks for either pool.
+ *
+ * @note
+ *      Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MoveBlocks
+(
+    le_mem_PoolRef_t    destPool,   ///< [IN] The pool to move the blocks to.
+    le_mem_PoolRef_t    srcPool,    ///< [IN] The pool to get the blocks from.
+    size_t              numBlocks   ///< [IN] The maximum number of blocks to move.
+)
+{
+    #ifndef LE_MEM_VALGRIND
+        // Get the first block to move.
+        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(srcPool->freeList));
+
+        size_t i = 0;
+        while (i < numBlocks)
+        {
+            if (blockLinkPtr == NULL)
+            {
+                LE_FATAL("Asked to move %zu blocks from pool '%s' to pool '%s', "
+                         "but only %zu were available.",
+                         numBlocks,
+                         srcPool->name,
+                         destPool->name,
+                         i);
+            }
+
+            // Add the block to the destination pool.
+            le_sls_Stack(&(destPool->freeList), blockLinkPtr);
+
+            // Update the blocks parent pool.
+            MemBlock_t* blockPtr = CONTAINER_OF(blockLinkPtr, MemBlock_t, link);
+            blockPtr->poolPtr = destPool;
+
+            // Get the next block.
+            blockLinkPtr = le_sls_Pop(&(srcPool->freeList));
+
+            i++;
+        }
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a new pool block.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitBlock
+(
+    le_mem_PoolRef_t pool,       ///< [IN] The pool the new block belongs to.
+    MemBlock_t* newBlockPtr      ///< [IN] The block being initialized.
+)
+{
+    // Initialize the block.
+    #ifndef LE_MEM_VALGRIND
+        // Add the block to the pool's free list.
+        newBlockPtr->link = LE_SLS_LINK_INIT;
+        le_sls_Stack(&(pool->freeList), &(newBlockPtr->link));
+    #endif
+
+    newBlockPtr->refCount = 0;
+    newBlockPtr->poolPtr = pool;
+
+    #ifdef USE_GUARD_BAND
+        InitGuardBands(newBlockPtr);
+    #endif
+}
+
+
+#ifndef LE_MEM_VALGRIND
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Creates a slab of blocks and adds them to the pool.
+     *
+     * The slabs of trimmable pools have a header and are rounded up to a whole number of pages, so
+     * more blocks than requested may be added to them.
+     *
+     * @note
+     *      Updates the pools total number of blocks.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void AddBlocks
+    (
+        le_mem_PoolRef_t    pool,       ///< [IN] The pool to be expanded.
+        size_t              numBlocks   ///< [IN] The number of blocks to add to the pool.
+    )
+    {
+        size_t i;
+        size_t blockSize = pool->blockSize;
+        MemBlock_t* newBlockPtr;
+
+        if (numBlocks == 0)
+        {
+            return;
+        }
+
+        // Allocate the slab.
+        if (pool->isTrimmable)
+        {
+            // Round up to a whole number of pages and fill the rest of the last page with blocks.
+            size_t slabSize = sizeof(Slab_t) + (numBlocks * blockSize);
+            slabSize = ((slabSize + PageSize - 1) / PageSize) * PageSize;
+            numBlocks = (slabSize - sizeof(Slab_t)) / blockSize;
+
+            Slab_t* slabPtr = mmap(NULL,
+                                   slabSize,
+                                   PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS,
+                                   -1,
+                                   0);
+
+            LE_FATAL_IF(slabPtr == MAP_FAILED,
+                        "Failed to map %zu bytes for pool '%s' (%m).",
+                        slabSize,
+                        pool->name);
+
+            slabPtr->link = LE_SLS_LINK_INIT;
+            slabPtr->size = slabSize;
+            slabPtr->numBlocks = numBlocks;
+            slabPtr->numFree = 0;
+
+            le_sls_Stack(&(pool->slabList), &(slabPtr->link));
+
+            newBlockPtr = (MemBlock_t*)(slabPtr + 1);
+        }
+        else
+        {
+            newBlockPtr = malloc(numBlocks * blockSize);
+
+            LE_ASSERT(newBlockPtr);
+        }
+
+        for (i = 0; i < numBlocks; i++)
+        {
+            InitBlock(pool, newBlockPtr);
+            newBlockPtr = (MemBlock_t*)(((uint8_t*)newBlockPtr) + blockSize);
+        }
+
+        // Update the pool.
+        pool->totalBlocks += numBlocks;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Compares the addresses of two slabs, for qsort().
+     */
+    //----------------------------------------------------------------------------------------------
+    static int CompareSlabs
+    (
+        const void* aPtr,               ///< [IN] Pointer to a slab pointer.
+        const void* bPtr                ///< [IN] Pointer to another slab pointer.
+    )
+    {
+        uintptr_t a = (uintptr_t)*(Slab_t* const*)aPtr;
+        uintptr_t b = (uintptr_t)*(Slab_t* const*)bPtr;
+
+        return (a > b) - (a < b);
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Finds the slab that a given block lives in.
+     *
+     * @return Pointer to the slab, or NULL if the block isn't in any of the slabs (it was added
+     *         before the pool was made trimmable).
+     */
+    //----------------------------------------------------------------------------------------------
+    static Slab_t* FindSlab
+    (
+        Slab_t**            slabs,      ///< [IN] The pool's slabs, sorted by address.
+        size_t              numSlabs,   ///< [IN] The number of slabs.
+        MemBlock_t*         blockPtr    ///< [IN] The block.
+    )
+    {
+        // Find the first slab that starts above the block.  The block can only be in the slab
+        // before that one.
+        size_t low = 0;
+        size_t high = numSlabs;
+
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+
+            if ((uint8_t*)slabs[mid] < (uint8_t*)blockPtr)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        if (low == 0)
+        {
+            return NULL;
+        }
+
+        Slab_t* slabPtr = slabs[low - 1];
+
+        if ((uint8_t*)blockPtr < (uint8_t*)slabPtr + slabPtr->size)
+        {
+            return slabPtr;
+        }
+
+        return NULL;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Releases slabs that contain only free blocks back to system memory, as long as at least a
+     * given number of free blocks remains in the pool.
+     *
+     * @return The number of blocks released.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static size_t TrimPool
+    (
+        le_mem_PoolRef_t    pool,       ///< [IN] The pool to trim (not a sub-pool).
+        size_t              numToKeep   ///< [IN] The number of free blocks to keep.
+    )
+    {
+        le_sls_Link_t* linkPtr;
+        size_t numFree = 0;
+        size_t numReleased = 0;
+        size_t numSlabs = le_sls_NumLinks(&(pool->slabList));
+
+        if (numSlabs == 0)
+        {
+            return 0;
+        }
+
+        // Get all the free blocks back from the threads' caches.
+        ReclaimCaches(pool);
+
+        // Sort the slabs by address, so that the slab a block is in can be found quickly.
+        Slab_t** slabs = malloc(numSlabs * sizeof(Slab_t*));
+        LE_ASSERT(slabs);
+
+        size_t i = 0;
+        linkPtr = le_sls_Peek(&(pool->slabList));
+        while (linkPtr != NULL)
+        {
+            slabs[i] = CONTAINER_OF(linkPtr, Slab_t, link);
+            slabs[i]->numFree = 0;
+            i++;
+            linkPtr = le_sls_PeekNext(&(pool->slabList), linkPtr);
+        }
+
+        qsort(slabs, numSlabs, sizeof(Slab_t*), CompareSlabs);
+
+        // Count the free blocks in each slab.
+        linkPtr = le_sls_Peek(&(pool->freeList));
+        while (linkPtr != NULL)
+        {
+            Slab_t* slabPtr = FindSlab(slabs, numSlabs, CONTAINER_OF(linkPtr, MemBlock_t, link));
+
+            if (slabPtr != NULL)
+            {
+                slabPtr->numFree++;
+            }
+
+            numFree++;
+            linkPtr = le_sls_PeekNext(&(pool->freeList), linkPtr);
+        }
+
+        // Pick the fully free slabs to be released.  Their free counts are set to zero to mark
+        // them.
+        linkPtr = le_sls_Peek(&(pool->slabList));
+        while (linkPtr != NULL)
+        {
+            Slab_t* slabPtr = CONTAINER_OF(linkPtr, Slab_t, link);
+
+            if (   (slabPtr->numFree == slabPtr->numBlocks)
+                && (numFree - numReleased >= numToKeep + slabPtr->numBlocks) )
+            {
+                numReleased += slabPtr->numBlocks;
+                slabPtr->numFree = 0;
+            }
+            else
+            {
+                // Make sure a slab with no blocks in it is never mistaken for a released one.
+                slabPtr->numFree = SIZE_MAX;
+            }
+
+            linkPtr = le_sls_PeekNext(&(pool->slabList), linkPtr);
+        }
+
+        if (numReleased == 0)
+        {
+            free(slabs);
+            return 0;
+        }
+
+        // Take the released slabs' blocks off the free list.
+        le_sls_List_t keptBlocks = LE_SLS_LIST_INIT;
+
+        while ((linkPtr = le_sls_Pop(&(pool->freeList))) != NULL)
+        {
+            Slab_t* slabPtr = FindSlab(slabs, numSlabs, CONTAINER_OF(linkPtr, MemBlock_t, link));
+
+            if ((slabPtr == NULL) || (slabPtr->numFree != 0))
+            {
+                le_sls_Stack(&keptBlocks, linkPtr);
+            }
+        }
+
+        pool->freeList = keptBlocks;
+
+        free(slabs);
+
+        // Release the slabs.
+        le_sls_List_t keptSlabs = LE_SLS_LIST_INIT;
+
+        while ((linkPtr = le_sls_Pop(&(pool->slabList))) != NULL)
+        {
+            Slab_t* slabPtr = CONTAINER_OF(linkPtr, Slab_t, link);
+
+            if (slabPtr->numFree != 0)
+            {
+                le_sls_Queue(&keptSlabs, linkPtr);
+            }
+            else
+            {
+                LE_ASSERT(munmap(slabPtr, slabPtr->size) == 0);
+            }
+        }
+
+        pool->slabList = keptSlabs;
+
+        pool->totalBlocks -= numReleased;
+        pool->numTrimmedBlocks += numReleased;
+
+        LE_DEBUG("Memory pool '%s' trimmed by %zu blocks to %zu blocks.",
+                 pool->name,
+                 numReleased,
+                 pool->totalBlocks);
+
+        return numReleased;
+    }
+
+
+    //----------------------------------------------------------------------------------------------
+    /**
+     * Trims a trimmable pool if it has more free blocks than its high watermark.
+     *
+     * @note
+     *      Assumes that the mutex is locked.
+     */
+    //----------------------------------------------------------------------------------------------
+    static void CheckTrim
+    (
+        le_mem_PoolRef_t    pool        ///< [IN] The pool.
+    )
+    {
+        if (pool->isTrimmable)
+        {
+            size_t numFree = pool->totalBlocks
+                             - __atomic_load_n(&(pool->numBlocksInUse), __ATOMIC_RELAXED);
+
+            if (numFree > pool->trimThreshold)
+            {
+                TrimPool(pool, pool->lowWatermark);
+
+                // If too few slabs were fully free to get below the high watermark, don't try again
+                // until enough blocks have been freed to make it worthwhile.
+                numFree = pool->totalBlocks
+                          - __atomic_load_n(&(pool->numBlocksInUse), __ATOMIC_RELAXED);
+
+                pool->trimThreshold = pool->highWatermark;
+
+                if (numFree + pool->highWatermark - pool->lowWatermark > pool->trimThreshold)
+                {
+                    pool->trimThreshold = numFree + pool->highWatermark - pool->lowWatermark;
+                }
+            }
+        }
+    }
+#endif
 
 
 //--------------------------------------------------------------------------------------------------
@@ -513,6 +1546,14 @@ void mem_Init
     // NOTE: No need to lock the mutex because this function should be called when there is still
     //       only one thread running.
 
+    #ifndef LE_MEM_VALGRIND
+        PageSize = sysconf(_SC_PAGESIZE);
+
+        // Create the thread-local data key used to find each thread's block caches.  The
+        // destructor flushes a thread's caches back into their pools when the thread dies.
+        LE_ASSERT(pthread_key_create(&ThreadCachesKey, DestructThreadCaches) == 0);
+    #endif
+
     // Create a memory for all sub-pools.
     SubPoolsPool = le_mem_CreatePool("SubPools", sizeof(MemPool_t));
     le_mem_ExpandPool(SubPoolsPool, DEFAULT_SUB_POOLS_POOL_SIZE);
@@ -643,6 +1684,10 @@ le_mem_PoolRef_t _le_mem_CreatePool
     // Generate an error if there are multiple pools with the same name.
     VerifyUniquenessOfName(newPool);
 
+    #ifndef LE_MEM_VALGRIND
+        newPool->cacheIndex = GetCacheIndex();
+    #endif
+
     // Add the new pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(newPool->poolLink));
@@ -670,46 +1715,303 @@ le_mem_PoolRef_t le_mem_ExpandPool
 )
 {
     #ifndef LE_MEM_VALGRIND
-        LE_ASSERT(pool);
+        LE_ASSERT(pool);
+
+        Lock();
+
+        if (pool->superPoolPtr)
+        {
+            // This is a sub-pool so the memory blocks to create must come from the super-pool.
+            // Get the super-pool's cached free blocks back onto its free list first, then check
+            // that there are enough blocks in the superpool.
+            ReclaimCaches(pool->superPoolPtr);
+
+            ssize_t numBlocksToAdd = numObjects - le_sls_NumLinks(&(pool->superPoolPtr->freeList));
+
+            if (numBlocksToAdd > 0)
+            {
+                // Expand the super-pool.
+                AddBlocks(pool->superPoolPtr, numBlocksToAdd);
+            }
+
+            // Move the blocks from the superpool to our pool.
+            MoveBlocks(pool, pool->superPoolPtr, numObjects);
+
+            // Update the sub-pool total block count.
+            pool->totalBlocks = pool->totalBlocks + numObjects;
+
+            // Update the super-pool's block use counts.
+            AddBlocksInUse(pool->superPoolPtr, numObjects);
+        }
+        else
+        {
+            // This is not a sub-pool.
+            AddBlocks(pool, numObjects);
+
+            if (pool->isConcurrent)
+            {
+                StackFreeList(pool);
+            }
+        }
+
+        Unlock();
+    #endif
+
+    return pool;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes up to a given number of free blocks out of a pool.  The blocks come from the calling
+ * thread's cache if possible, then from the pool's free list, then from other threads' caches.
+ * Blocks of concurrent pools come from the pool's free block stack.
+ *
+ * @return
+ *      The number of blocks taken.  Less than requested only if the pool ran out of free blocks.
+ *
+ * @note
+ *      Doesn't update the pool's statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t TakeBlocks
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool.
+    size_t              numBlocks,  ///< [IN] The number of blocks wanted.
+    MemBlock_t*         blocks[]    ///< [OUT] Array that receives pointers to the blocks.
+)
+{
+    size_t numTaken = 0;
+
+    #ifndef LE_MEM_VALGRIND
+        if (pool->isConcurrent)
+        {
+            while (numTaken < numBlocks)
+            {
+                MemBlock_t* blockPtr = PopBlock(pool);
+
+                if (blockPtr == NULL)
+                {
+                    break;
+                }
+
+                blocks[numTaken++] = blockPtr;
+            }
+
+            return numTaken;
+        }
+
+        MemCache_t* cachePtr = LockThreadCache(pool);
+
+        while ((numTaken < numBlocks) && (cachePtr->numBlocks > 0))
+        {
+            cachePtr->numBlocks--;
+            blocks[numTaken++] = cachePtr->blocks[cachePtr->numBlocks];
+        }
+
+        if (numTaken < numBlocks)
+        {
+            // The cache is empty, so go to the pool.  The busy flag must not be held while waiting
+            // for the mutex.
+            UnlockCache(cachePtr);
+            Lock();
+            LockCache(cachePtr);
+
+            do
+            {
+                // Refill the cache from the free list (or other threads' caches) and take what
+                // we need from it.
+                FillCache(cachePtr);
+
+                if (cachePtr->numBlocks == 0)
+                {
+                    break;
+                }
+
+                while ((numTaken < numBlocks) && (cachePtr->numBlocks > 0))
+                {
+                    cachePtr->numBlocks--;
+                    blocks[numTaken++] = cachePtr->blocks[cachePtr->numBlocks];
+                }
+            }
+            while (numTaken < numBlocks);
+
+            Unlock();
+        }
+
+        UnlockCache(cachePtr);
+    #else
+        while (numTaken < numBlocks)
+        {
+            MemBlock_t* blockPtr = malloc(pool->blockSize);
+
+            if (blockPtr == NULL)
+            {
+                break;
+            }
+
+            InitBlock(pool, blockPtr);
+            blocks[numTaken++] = blockPtr;
+        }
+    #endif
+
+    return numTaken;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives free blocks back to their pool.  The blocks go into the calling thread's cache, overflowing
+ * onto the pool's free list, or onto the free block stack of a concurrent pool.
+ *
+ * @note
+ *      Doesn't update the pool's statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReturnBlocks
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool the blocks belong to.
+    MemBlock_t*         blocks[],   ///< [IN] The blocks.
+    size_t              numBlocks   ///< [IN] The number of blocks (no more than CACHE_SIZE).
+)
+{
+    size_t i;
+
+    #ifndef LE_MEM_VALGRIND
+        LE_ASSERT(numBlocks <= CACHE_SIZE);
+
+        if (pool->isConcurrent)
+        {
+            // Chain the blocks together and push them all at once.
+            for (i = 0; i + 1 < numBlocks; i++)
+            {
+                __atomic_store_n(&(blocks[i]->link.nextPtr), &(blocks[i + 1]->link),
+                                 __ATOMIC_RELAXED);
+            }
+
+            PushBlocks(pool, blocks[0], blocks[numBlocks - 1]);
+
+            return;
+        }
+
+        MemCache_t* cachePtr = LockThreadCache(pool);
+
+        if (cachePtr->numBlocks + numBlocks > CACHE_SIZE)
+        {
+            // There isn't enough room in the cache, so move blocks back to the pool.  The busy
+            // flag must not be held while waiting for the mutex.
+            size_t numToKeep = CACHE_SIZE - CACHE_BATCH_SIZE;
+
+            if (numToKeep > CACHE_SIZE - numBlocks)
+            {
+                numToKeep = CACHE_SIZE - numBlocks;
+            }
+
+            UnlockCache(cachePtr);
+            Lock();
+            LockCache(cachePtr);
+            FlushCache(cachePtr, numToKeep);
+            UnlockCache(cachePtr);
+
+            // Now that the pool has more free blocks, see if any memory can be given back.
+            CheckTrim(pool);
+
+            Unlock();
+            LockCache(cachePtr);
+        }
+
+        for (i = 0; i < numBlocks; i++)
+        {
+            cachePtr->blocks[cachePtr->numBlocks] = blocks[i];
+            cachePtr->numBlocks++;
+        }
+
+        UnlockCache(cachePtr);
+    #else
+        for (i = 0; i < numBlocks; i++)
+        {
+            free(blocks[i]);
+        }
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a block that has just been taken out of its pool ready for use.
+ *
+ * @return
+ *      A pointer to the user object in the block.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void* PrepareBlock
+(
+    MemBlock_t* blockPtr            ///< [IN] The block.
+)
+{
+    blockPtr->refCount = 1;
+
+    // Return the user object in the block.
+    #ifdef USE_GUARD_BAND
+        CheckGuardBands(blockPtr);
+        return blockPtr->data + GUARD_BAND_SIZE;
+    #else
+        return blockPtr->data;
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expands a pool that has run out of free blocks in le_mem_ForceAlloc() or le_mem_AllocBatch().
+ */
+//--------------------------------------------------------------------------------------------------
+static void ForceExpand
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] The pool.
+    size_t              numNeeded   ///< [IN] The minimum number of blocks to add.
+)
+{
+    #ifndef LE_MEM_VALGRIND
+        size_t numBlocksToAdd = pool->numBlocksToForce;
 
-        Lock();
+        if (numBlocksToAdd < numNeeded)
+        {
+            numBlocksToAdd = numNeeded;
+        }
 
-        if (pool->superPoolPtr)
+        // Trimmable pools grow geometrically, so that they are made of a small number of
+        // slabs, which can be given back to the system when they are no longer needed.
+        if (pool->isTrimmable)
         {
-            // This is a sub-pool so the memory blocks to create must come from the super-pool.
-            // Check that there are enough blocks in the superpool.
-            ssize_t numBlocksToAdd = numObjects - le_sls_NumLinks(&(pool->superPoolPtr->freeList));
+            size_t maxGrowth = MAX_GROWTH_BYTES / pool->blockSize;
+            size_t growth = pool->totalBlocks / 2;
 
-            if (numBlocksToAdd > 0)
+            if (growth > maxGrowth)
             {
-                // Expand the super-pool.
-                AddBlocks(pool->superPoolPtr, numBlocksToAdd);
+                growth = maxGrowth;
             }
-
-            // Move the blocks from the superpool to our pool.
-            MoveBlocks(pool, pool->superPoolPtr, numObjects);
-
-            // Update the sub-pool total block count.
-            pool->totalBlocks = pool->totalBlocks + numObjects;
-
-            // Update the super-pool's block use counts.
-            pool->superPoolPtr->numBlocksInUse += numObjects;
-
-            if (pool->superPoolPtr->numBlocksInUse > pool->superPoolPtr->maxNumBlocksUsed)
+            if (growth > numBlocksToAdd)
             {
-                pool->superPoolPtr->maxNumBlocksUsed = pool->superPoolPtr->numBlocksInUse;
+                numBlocksToAdd = growth;
             }
         }
-        else
-        {
-            // This is not a sub-pool.
-            AddBlocks(pool, numObjects);
-        }
+
+        // Expand the pool.
+        le_mem_ExpandPool(pool, numBlocksToAdd);
+
+        Lock();
+        pool->numOverflows++;
+
+        // log a warning.
+        LE_DEBUG("Memory pool '%s' overflowed. Expanded to %zu blocks.",
+                pool->name,
+                pool->totalBlocks);
 
         Unlock();
+    #else
+        LE_FATAL("Out of memory allocating from pool '%s'.", pool->name);
     #endif
-
-    return pool;
 }
 
 
@@ -729,54 +2031,18 @@ void* le_mem_TryAlloc
 {
     LE_ASSERT(pool != NULL);
 
-    MemBlock_t* blockPtr = NULL;
-    void* userPtr = NULL;
-
-    Lock();
-
-    #ifndef LE_MEM_VALGRIND
-        // Pop a link off the pool.
-        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(pool->freeList));
-
-        if (blockLinkPtr != NULL)
-        {
-            // Get the block from the block link.
-            blockPtr = CONTAINER_OF(blockLinkPtr, MemBlock_t, link);
-        }
-    #else
-        blockPtr = malloc(pool->blockSize);
-
-        if (blockPtr != NULL)
-        {
-            InitBlock(pool, blockPtr);
-        }
-    #endif
+    MemBlock_t* blockPtr;
 
-    if (blockPtr != NULL)
+    if (TakeBlocks(pool, 1, &blockPtr) == 0)
     {
-        // Update the pool and the block.
-        pool->numAllocations++;
-        pool->numBlocksInUse++;
-
-        if (pool->numBlocksInUse > pool->maxNumBlocksUsed)
-        {
-            pool->maxNumBlocksUsed = pool->numBlocksInUse;
-        }
-
-        blockPtr->refCount = 1;
-
-        // Return the user object in the block.
-        #ifdef USE_GUARD_BAND
-            CheckGuardBands(blockPtr);
-            userPtr = blockPtr->data + GUARD_BAND_SIZE;
-        #else
-            userPtr = blockPtr->data;
-        #endif
+        return NULL;
     }
 
-    Unlock();
+    // Update the pool and the block.
+    __atomic_add_fetch(&(pool->numAllocations), 1, __ATOMIC_RELAXED);
+    AddBlocksInUse(pool, 1);
 
-    return userPtr;
+    return PrepareBlock(blockPtr);
 }
 
 
@@ -826,27 +2092,66 @@ void* le_mem_ForceAlloc
 
     void* objPtr;
 
-    #ifndef LE_MEM_VALGRIND
-        while ((objPtr = le_mem_TryAlloc(pool)) == NULL)
-        {
-            // Expand the pool.
-            le_mem_ExpandPool(pool, pool->numBlocksToForce);
+    while ((objPtr = le_mem_TryAlloc(pool)) == NULL)
+    {
+        ForceExpand(pool, 1);
+    }
 
-            Lock();
-            pool->numOverflows++;
+    return objPtr;
+}
 
-            // log a warning.
-            LE_DEBUG("Memory pool '%s' overflowed. Expanded to %zu blocks.",
-                    pool->name,
-                    pool->totalBlocks);
 
-            Unlock();
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a number of objects from a pool, expanding the pool if it doesn't have enough free
+ * objects (like le_mem_ForceAlloc() does).
+ *
+ * @return  Nothing.
+ *
+ * @note    On failure, the process exits, so you don't have to worry about checking the returned
+ *          pointers for validity.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_AllocBatch
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool from which the objects are to be allocated.
+    size_t              numObjects, ///< [IN] Number of objects to allocate.
+    void*               objPtrs[]   ///< [OUT] Array that receives pointers to the objects.
+)
+{
+    LE_ASSERT(pool != NULL);
+
+    size_t numAllocated = 0;
+
+    // Work through the batch a cache-full at a time.
+    while (numAllocated < numObjects)
+    {
+        MemBlock_t* blocks[CACHE_SIZE];
+        size_t numWanted = numObjects - numAllocated;
+        size_t i;
+
+        if (numWanted > CACHE_SIZE)
+        {
+            numWanted = CACHE_SIZE;
         }
-    #else
-        objPtr = le_mem_AssertAlloc(pool);
-    #endif
 
-    return objPtr;
+        size_t numTaken = TakeBlocks(pool, numWanted, blocks);
+
+        if (numTaken < numWanted)
+        {
+            // Expand the pool enough for the rest of the batch in one go.
+            ForceExpand(pool, numObjects - numAllocated - numTaken);
+        }
+
+        // Update the pool and the blocks.
+        __atomic_add_fetch(&(pool->numAllocations), numTaken, __ATOMIC_RELAXED);
+        AddBlocksInUse(pool, numTaken);
+
+        for (i = 0; i < numTaken; i++)
+        {
+            objPtrs[numAllocated++] = PrepareBlock(blocks[i]);
+        }
+    }
 }
 
 
@@ -878,22 +2183,139 @@ void le_mem_SetNumObjsToForce
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Releases an object.  If the object's reference count has reached zero, it will be destructed
- * and its memory will be put back into the pool for later reuse.
+ * Makes a pool trimmable, so that memory is given back to the system automatically when the pool
+ * has too many free objects.
+ *
+ * See @ref mem_trimming for more information.
  *
  * @return
  *      Nothing.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_SetTrimWatermarks
+(
+    le_mem_PoolRef_t    pool,           ///< [IN] The pool (not a sub-pool).
+    size_t              lowWatermark,   ///< [IN] Number of free objects to keep when trimming.
+    size_t              highWatermark   ///< [IN] Number of free objects above which to trim.
+)
+{
+    LE_ASSERT(pool != NULL);
+
+    LE_FATAL_IF(pool->superPoolPtr != NULL, "Sub-pool '%s' can't be made trimmable.", pool->name);
+    LE_FATAL_IF(lowWatermark > highWatermark,
+                "Low watermark (%zu) of pool '%s' is above its high watermark (%zu).",
+                lowWatermark,
+                pool->name,
+                highWatermark);
+
+    Lock();
+
+    LE_FATAL_IF(pool->isConcurrent, "Concurrent pool '%s' can't be made trimmable.", pool->name);
+
+    pool->isTrimmable = true;
+    pool->lowWatermark = lowWatermark;
+    pool->highWatermark = highWatermark;
+    pool->trimThreshold = highWatermark;
+
+    Unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases all of a trimmable pool's memory that doesn't hold any allocated objects back to the
+ * system.
  *
- * @warning
- *      - <b>Do not EVER access an object after releasing it.</b>  It might not exist anymore.
- *      - If the object has a destructor that accesses a data structure that is shared by multiple
- *        threads, make sure you hold the mutex (or take other measures to prevent races) before
- *        releasing the object.
+ * See @ref mem_trimming for more information.
+ *
+ * @return
+ *      The number of free objects that were removed from the pool.
  */
 //--------------------------------------------------------------------------------------------------
-void le_mem_Release
+size_t le_mem_Trim
 (
-    void*   objPtr  ///< [IN] Pointer to the object to be released.
+    le_mem_PoolRef_t    pool        ///< [IN] The pool to be trimmed.
+)
+{
+    LE_ASSERT(pool != NULL);
+
+    size_t numReleased = 0;
+
+    #ifndef LE_MEM_VALGRIND
+        // Only trimmable pools have slabs that can be released.  Sub-pools can't be trimmable.
+        if (pool->isTrimmable)
+        {
+            Lock();
+            numReleased = TrimPool(pool, 0);
+            Unlock();
+        }
+    #endif
+
+    return numReleased;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes allocating objects from and releasing objects to a pool lock-free.  Must be called before
+ * the pool is used by more than one thread.
+ *
+ * See @ref mem_concurrent for more information.
+ *
+ * @return
+ *      Nothing.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_SetConcurrent
+(
+    le_mem_PoolRef_t    pool            ///< [IN] The pool.
+)
+{
+    LE_ASSERT(pool != NULL);
+
+    LE_FATAL_IF(pool->superPoolPtr != NULL, "Sub-pool '%s' can't be made concurrent.", pool->name);
+
+    Lock();
+
+    LE_FATAL_IF(pool->isTrimmable, "Trimmable pool '%s' can't be made concurrent.", pool->name);
+
+    le_dls_Link_t* poolLinkPtr = le_dls_Peek(&PoolList);
+
+    while (poolLinkPtr != NULL)
+    {
+        LE_FATAL_IF(CONTAINER_OF(poolLinkPtr, MemPool_t, poolLink)->superPoolPtr == pool,
+                    "Pool '%s' has sub-pools and can't be made concurrent.",
+                    pool->name);
+
+        poolLinkPtr = le_dls_PeekNext(&PoolList, poolLinkPtr);
+    }
+
+    if (!pool->isConcurrent)
+    {
+        #ifndef LE_MEM_VALGRIND
+            // Move all of the pool's free blocks onto its free block stack.
+            ReclaimCaches(pool);
+            StackFreeList(pool);
+        #endif
+
+        pool->isConcurrent = true;
+    }
+
+    Unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the block that a user object lives in.
+ *
+ * @return
+ *      A pointer to the block.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline MemBlock_t* GetBlock
+(
+    void*   objPtr                  ///< [IN] Pointer to the user object.
 )
 {
     MemBlock_t* blockPtr;
@@ -911,59 +2333,132 @@ void le_mem_Release
         CheckGuardBands(blockPtr);
     #endif
 
-    Lock();
+    return blockPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drops a reference to an object.  If that was the last reference, the object is destructed.
+ *
+ * @return
+ *      true if the object's block is now free and must be given back to its pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DropRef
+(
+    MemBlock_t* blockPtr,           ///< [IN] The object's block.
+    void*       objPtr              ///< [IN] Pointer to the object.
+)
+{
+    size_t refCount = __atomic_fetch_sub(&(blockPtr->refCount), 1, __ATOMIC_ACQ_REL);
 
-    switch (blockPtr->refCount)
+    if (refCount == 1)
     {
-        case 1:
+        // The reference count has reached zero.  Call the destructor, if there is one.
+        // Note that the block can't be given back to the pool before calling the destructor
+        // because the destructor still needs to access it, but after it goes back in the pool,
+        // it could get reallocated by another thread (or even the destructor itself) and have
+        // its contents clobbered.
+        le_mem_Destructor_t destructor = blockPtr->poolPtr->destructor;
+        if (destructor)
         {
-            MemPool_t* poolPtr = blockPtr->poolPtr;
+            destructor(objPtr);
+        }
+
+        return true;
+    }
+    else if (refCount == 0)
+    {
+        LE_EMERG("Releasing free block.");
+        LE_FATAL("Free block released from pool %p (%s).",
+                 blockPtr->poolPtr,
+                 blockPtr->poolPtr->name);
+    }
 
-            // The reference count has reached zero.
-            blockPtr->refCount = 0;
+    return false;
+}
 
-            // Call the destructor, if there is one.
-            if (poolPtr->destructor)
-            {
-                // Make sure that the destructor is not called with the mutex locked, because
-                // it is not a recursive mutex and therefore will deadlock if locked again by
-                // the same thread.  Also, fetch the destructor function address before unlocking
-                // the mutex so that we don't touch the pool object while the mutex is unlocked.
-                le_mem_Destructor_t destructor = poolPtr->destructor;
-                Unlock();
-                destructor(objPtr);
-
-                // Re-lock the mutex now so that it is safe to access the pool object again.
-                Lock();
-            }
 
-            #ifndef LE_MEM_VALGRIND
-                // Release the memory back into the pool.
-                // Note that we don't do this before calling the destructor because the destructor
-                // still needs to access it, but after it goes back on the free list, it could get
-                // reallocated by another thread (or even the destructor itself) and have its
-                // contents clobbered.
-                le_sls_Stack(&(poolPtr->freeList), &(blockPtr->link));
-            #else
-                free(blockPtr);
-            #endif
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases an object.  If the object's reference count has reached zero, it will be destructed
+ * and its memory will be put back into the pool for later reuse.
+ *
+ * @return
+ *      Nothing.
+ *
+ * @warning
+ *      - <b>Do not EVER access an object after releasing it.</b>  It might not exist anymore.
+ *      - If the object has a destructor that accesses a data structure that is shared by multiple
+ *        threads, make sure you hold the mutex (or take other measures to prevent races) before
+ *        releasing the object.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_Release
+(
+    void*   objPtr  ///< [IN] Pointer to the object to be released.
+)
+{
+    MemBlock_t* blockPtr = GetBlock(objPtr);
+
+    if (DropRef(blockPtr, objPtr))
+    {
+        MemPool_t* poolPtr = blockPtr->poolPtr;
+
+        // Count the block out of use before it can be handed to another thread, so that thread's
+        // allocation can't push the pool's high-water mark up.
+        RemoveBlocksInUse(poolPtr, 1);
+        ReturnBlocks(poolPtr, &blockPtr, 1);
+    }
+}
 
-            poolPtr->numBlocksInUse--;
 
-            break;
-        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a number of objects, as if le_mem_Release() was called on each of them in order.
+ *
+ * @return
+ *      Nothing.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mem_ReleaseBatch
+(
+    void*   objPtrs[],  ///< [IN] Array of pointers to the objects to be released.
+    size_t  numObjects  ///< [IN] Number of objects in the array.
+)
+{
+    MemBlock_t* freeBlocks[CACHE_SIZE];
+    size_t numFree = 0;
+    MemPool_t* poolPtr = NULL;
+    size_t i;
+
+    // Collect the freed blocks and give them back to their pools in runs of blocks from the
+    // same pool.
+    for (i = 0; i < numObjects; i++)
+    {
+        MemBlock_t* blockPtr = GetBlock(objPtrs[i]);
 
-        case 0:
-            LE_EMERG("Releasing free block.");
-            LE_FATAL("Free block released from pool %p (%s).",
-                     blockPtr->poolPtr,
-                     blockPtr->poolPtr->name);
+        if (DropRef(blockPtr, objPtrs[i]))
+        {
+            if (   (numFree > 0)
+                && ((blockPtr->poolPtr != poolPtr) || (numFree == CACHE_SIZE)) )
+            {
+                RemoveBlocksInUse(poolPtr, numFree);
+                ReturnBlocks(poolPtr, freeBlocks, numFree);
+                numFree = 0;
+            }
 
-        default:
-            blockPtr->refCount--;
+            poolPtr = blockPtr->poolPtr;
+            freeBlocks[numFree++] = blockPtr;
+        }
     }
 
-    Unlock();
+    if (numFree > 0)
+    {
+        RemoveBlocksInUse(poolPtr, numFree);
+        ReturnBlocks(poolPtr, freeBlocks, numFree);
+    }
 }
 
 
@@ -991,13 +2486,7 @@ void le_mem_AddRef
         CheckGuardBands(memBlockPtr);
     #endif
 
-    Lock();
-
-    LE_ASSERT(memBlockPtr->refCount != 0);
-
-    memBlockPtr->refCount++;
-
-    Unlock();
+    LE_ASSERT(__atomic_fetch_add(&(memBlockPtr->refCount), 1, __ATOMIC_RELAXED) != 0);
 }
 
 
@@ -1043,11 +2532,13 @@ void le_mem_GetStats
 
     Lock();
 
-    statsPtr->numAllocs = pool->numAllocations;
+    size_t numBlocksInUse = __atomic_load_n(&(pool->numBlocksInUse), __ATOMIC_RELAXED);
+
+    statsPtr->numAllocs = __atomic_load_n(&(pool->numAllocations), __ATOMIC_RELAXED);
     statsPtr->numOverflows = pool->numOverflows;
-    statsPtr->numFree = pool->totalBlocks - pool->numBlocksInUse;
-    statsPtr->numBlocksInUse = pool->numBlocksInUse;
-    statsPtr->maxNumBlocksUsed = pool->maxNumBlocksUsed;
+    statsPtr->numFree = pool->totalBlocks - numBlocksInUse;
+    statsPtr->numBlocksInUse = numBlocksInUse;
+    statsPtr->maxNumBlocksUsed = __atomic_load_n(&(pool->maxNumBlocksUsed), __ATOMIC_RELAXED);
 
     Unlock();
 }
@@ -1069,7 +2560,7 @@ void le_mem_ResetStats
     LE_ASSERT(pool != NULL);
 
     Lock();
-    pool->numAllocations = 0;
+    __atomic_store_n(&(pool->numAllocations), 0, __ATOMIC_RELAXED);
     pool->numOverflows = 0;
     Unlock();
 }
@@ -1281,6 +2772,10 @@ le_mem_PoolRef_t _le_mem_CreateSubPool
     // Make sure the parent pool is not itself a sub-pool.
     LE_ASSERT(superPool->superPoolPtr == NULL);
 
+    LE_FATAL_IF(superPool->isConcurrent,
+                "Concurrent pool '%s' can't have sub-pools.",
+                superPool->name);
+
     // Get a sub-pool from the pool of sub-pools.
     le_mem_PoolRef_t subPool = le_mem_ForceAlloc(SubPoolsPool);
 
@@ -1293,6 +2788,10 @@ le_mem_PoolRef_t _le_mem_CreateSubPool
     // Log an error if the pool name is not unique.
     VerifyUniquenessOfName(subPool);
 
+    #ifndef LE_MEM_VALGRIND
+        subPool->cacheIndex = GetCacheIndex();
+    #endif
+
     // Add the sub-pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(subPool->poolLink));
@@ -1340,11 +2839,18 @@ void le_mem_DeleteSubPool
 
     size_t numBlocks = subPool->totalBlocks;
 
+    #ifndef LE_MEM_VALGRIND
+        // Get all the sub-pool's blocks out of the threads' caches, and make sure none of those
+        // caches is ever used again, so that the sub-pool's cache index can be reused.
+        DetachCaches(subPool);
+        ReleaseCacheIndex(subPool->cacheIndex);
+    #endif
+
     // Move the blocks from the subPool back to the superpool.
     MoveBlocks(superPool, subPool, numBlocks);
 
     // Update the superPool's block use count.
-    superPool->numBlocksInUse -= numBlocks;
+    RemoveBlocksInUse(superPool, numBlocks);
 
     // Remove the sub-pool from the list of sub-pools.
     PoolListChangeCount++;
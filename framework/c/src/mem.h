@@ -15,6 +15,20 @@
 #include "limit.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tagged pointer to the top block of a concurrent pool's free block stack.  The pointer is in the
+ * lower half and the tag in the upper half, and both are swapped together by a double-width
+ * compare-and-swap.
+ */
+//--------------------------------------------------------------------------------------------------
+#if UINTPTR_MAX == UINT32_MAX
+    typedef uint64_t mem_TaggedPtr_t;
+#else
+    typedef unsigned __int128 mem_TaggedPtr_t;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Definition of a memory pool.
@@ -27,10 +41,22 @@ typedef struct le_mem_Pool
                                         ///  if we are not a sub-pool.
     #ifndef LE_MEM_VALGRIND
         le_sls_List_t freeList;         ///< List of free memory blocks.
+        le_dls_List_t cacheList;        ///< List of per-thread block caches for this pool.
+        size_t cacheIndex;              ///< Index of this pool's cache in each thread's cache
+                                        ///< table.
+        le_sls_List_t slabList;         ///< List of slabs of memory that the blocks live in.
+        mem_TaggedPtr_t freeStack __attribute__((aligned(sizeof(mem_TaggedPtr_t))));
+                                        ///< Lock-free stack of free blocks, used instead of the
+                                        ///  free list and caches by concurrent pools.
+                                        ///  (Tagged pointer to the top block.)
     #endif
+    bool isConcurrent;                  ///< true = allocation and release are lock-free.
 
     size_t userDataSize;                ///< Size of the object requested by the client in bytes.
     size_t blockSize;                   ///< Number of bytes in a block, including all overhead.
+
+    // NOTE: The block usage statistics below are updated using atomic operations, because blocks
+    //       are allocated from and released to the per-thread caches without holding the mutex.
     uint64_t numAllocations;            ///< Total number of times an object has been allocated
                                         ///  from this pool.
     size_t numOverflows;                ///< Number of times le_mem_ForceAlloc() had to expand pool.
@@ -40,6 +66,12 @@ typedef struct le_mem_Pool
     size_t maxNumBlocksUsed;            ///< Maximum number of allocated blocks at any one time.
     size_t numBlocksToForce;            ///< Number of blocks that is added when Force Alloc
                                         ///  expands the pool.
+    bool isTrimmable;                   ///< true = slabs are page-aligned and fully free slabs
+                                        ///  are released back to the system automatically.
+    size_t lowWatermark;                ///< Number of free blocks to leave when trimming.
+    size_t highWatermark;               ///< Number of free blocks above which trimming is done.
+    size_t trimThreshold;               ///< Number of free blocks at which to try trimming next.
+    size_t numTrimmedBlocks;            ///< Total number of blocks released to the system.
     #ifdef LE_MEM_TRACE
         le_log_TraceRef_t memTrace;     ///< If tracing is enabled, keeps track of a trace object
                                         ///  for this pool.
@@ -150,7 +150,7 @@ static size_t ComputeInterfaceIdHash
     //       same process, so a collision here and there isn't a big deal.  So, we just use
     //       the interface instance name to compute the hash of the key to save some cycles.
 
-    return le_hashmap_HashString(idPtr->name);
+    return le_hashmap_HashStringFast(idPtr->name);
 }
 
 
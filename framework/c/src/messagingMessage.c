@@ -15,6 +15,69 @@
 #include "fileDescriptor.h"
 #include "unixSocket.h"
 
+// =======================================
+//  PRIVATE DATA
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload size (in bytes) of the smallest message size class.  Each of a protocol's size classes
+ * is SIZE_CLASS_SCALE times bigger than the one before it, up to the size of the largest message
+ * in the protocol.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMALLEST_SIZE_CLASS 64
+#define SIZE_CLASS_SCALE 4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload size (in bytes) of the largest size class that a protocol has its own pool for.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LARGEST_SIZE_CLASS (SMALLEST_SIZE_CLASS * SIZE_CLASS_SCALE * SIZE_CLASS_SCALE)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of overflow size classes.  Each overflow class is twice as big as the one before it,
+ * starting at twice the size of LARGEST_SIZE_CLASS.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_OVERFLOW_CLASSES 8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages to pre-allocate in the smallest size class of each protocol.
+ *
+ * @todo Make this configurable.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_PREALLOCATED_MSGS 10
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Overflow pools, shared by all protocols, for messages that don't fit into any of their protocol's
+ * size classes.  These are created when they are first needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t OverflowPoolRefs[NUM_OVERFLOW_CLASSES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex used to protect the overflow pool list from multi-threaded race conditions.
+ *
+ * @note This is a pthreads FAST mutex, chosen to minimize overhead.  It is non-recursive.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+#define UNLOCK  LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+
+
 // =======================================
 //  PRIVATE FUNCTIONS
 // =======================================
@@ -67,6 +130,89 @@ static void MessageDestructor
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a pool of Message objects.
+ *
+ * @return  A reference to the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CreateMessagePool
+(
+    const char* prefix,     ///< [in] Start of the pool name.
+    const char* name,       ///< [in] Rest of the pool name.
+    size_t payloadSize      ///< [in] Size of the message payload, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
+    size_t bytesCopied;
+    le_result_t result;
+
+    le_utf8_Copy(poolName, prefix, sizeof(poolName), &bytesCopied);
+    result = le_utf8_Copy(poolName + bytesCopied, name, sizeof(poolName) - bytesCopied, NULL);
+    if (result != LE_OK)
+    {
+        LE_DEBUG("Pool name truncated to '%s' for '%s'.", poolName, name);
+    }
+
+    le_mem_PoolRef_t poolRef = le_mem_CreatePool(poolName, sizeof(Message_t) + payloadSize);
+
+    le_mem_SetDestructor(poolRef, MessageDestructor);
+
+    // Messages are passed between client threads and the threads that service their sessions.
+    le_mem_SetConcurrent(poolRef);
+
+    return poolRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the shared overflow pool that holds messages of a given size, creating it if necessary.
+ *
+ * @return  A reference to the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t GetOverflowPool
+(
+    size_t payloadSize,     ///< [in] Size of the message payload, in bytes.
+    size_t* classSizePtr    ///< [out] Payload size of the pool's messages, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t classSize = LARGEST_SIZE_CLASS * 2;
+    size_t i = 0;
+
+    while (classSize < payloadSize)
+    {
+        classSize *= 2;
+        i++;
+    }
+
+    LE_FATAL_IF(i >= NUM_OVERFLOW_CLASSES, "Message payload too big (%zu bytes).", payloadSize);
+
+    LOCK
+
+    if (OverflowPoolRefs[i] == NULL)
+    {
+        char name[LIMIT_MAX_MEM_POOL_NAME_BYTES];
+
+        LE_ASSERT(snprintf(name, sizeof(name), "%zu", classSize) < (int)sizeof(name));
+
+        OverflowPoolRefs[i] = CreateMessagePool("msgs-overflow-", name, classSize);
+    }
+
+    le_mem_PoolRef_t poolRef = OverflowPoolRefs[i];
+
+    UNLOCK
+
+    *classSizePtr = classSize;
+
+    return poolRef;
+}
+
+
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
 // =======================================
@@ -89,36 +235,93 @@ void msgMessage_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a Message Pool.
- *
- * @return  A reference to the pool.
+ * Create the set of Message Pools for a protocol.
  */
 //--------------------------------------------------------------------------------------------------
-le_mem_PoolRef_t msgMessage_CreatePool
+void msgMessage_CreatePools
 (
-    const char* name,       ///< [in] Name of the pool.
-    size_t largestMsgSize   ///< [in] Size of the largest message payload, in bytes.
+    const char* name,               ///< [in] Name of the protocol.
+    size_t largestMsgSize,          ///< [in] Size of the largest message payload, in bytes.
+    msgMessage_Pools_t* poolsPtr    ///< [out] Set of pools to initialize.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    char poolName[LIMIT_MAX_MEM_POOL_NAME_BYTES];
-    size_t bytesCopied;
-    le_result_t result;
+    static const char* prefixes[MSG_NUM_SIZE_CLASSES] = { "msgsS-", "msgsM-", "msgsL-" };
 
-    le_utf8_Copy(poolName, "msgs-", sizeof(poolName), &bytesCopied);
-    result = le_utf8_Copy(poolName + bytesCopied, name, sizeof(poolName) - bytesCopied, NULL);
-    if (result != LE_OK)
+    size_t classSize = SMALLEST_SIZE_CLASS;
+    size_t i;
+
+    poolsPtr->largestMsgSize = largestMsgSize;
+
+    // Each size class is SIZE_CLASS_SCALE times bigger than the last, except that no class is
+    // bigger than the largest message in the protocol.  Once the largest message fits, there's
+    // no need for any more classes.
+    for (i = 0; i < MSG_NUM_SIZE_CLASSES; i++)
     {
-        LE_DEBUG("Pool name truncated to '%s' for protocol '%s'.", poolName, name);
+        if ((i > 0) && (poolsPtr->classSize[i - 1] >= largestMsgSize))
+        {
+            poolsPtr->classSize[i] = 0;
+            poolsPtr->classPoolRef[i] = NULL;
+            continue;
+        }
+
+        if (classSize > largestMsgSize)
+        {
+            classSize = largestMsgSize;
+        }
+
+        poolsPtr->classSize[i] = classSize;
+        poolsPtr->classPoolRef[i] = CreateMessagePool(prefixes[i], name, classSize);
+
+        classSize *= SIZE_CLASS_SCALE;
     }
 
-    le_mem_PoolRef_t poolRef = le_mem_CreatePool(poolName, sizeof(Message_t) + largestMsgSize);
+    // Most messages are small, so only the smallest size class is pre-allocated.
+    le_mem_ExpandPool(poolsPtr->classPoolRef[0], NUM_PREALLOCATED_MSGS);
+}
+
 
-    le_mem_SetDestructor(poolRef, MessageDestructor);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a Message object from the smallest size class that has room for a given payload size.
+ *
+ * @return A pointer to the Message object.  Only the payloadSize member is initialized.
+ */
+//--------------------------------------------------------------------------------------------------
+Message_t* msgMessage_Alloc
+(
+    const msgMessage_Pools_t* poolsPtr, ///< [in] Set of pools to allocate from.
+    size_t payloadSize                  ///< [in] Minimum payload size, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Message_t* msgPtr;
+    size_t i;
 
-    le_mem_ExpandPool(poolRef, 10); /// @todo Make this configurable.
+    for (i = 0; (i < MSG_NUM_SIZE_CLASSES) && (poolsPtr->classPoolRef[i] != NULL); i++)
+    {
+        if (poolsPtr->classSize[i] >= payloadSize)
+        {
+            msgPtr = le_mem_ForceAlloc(poolsPtr->classPoolRef[i]);
+            msgPtr->payloadSize = poolsPtr->classSize[i];
 
-    return poolRef;
+            return msgPtr;
+        }
+    }
+
+    // Too big for any of the protocol's own size classes, so use an overflow pool.
+    size_t classSize;
+    msgPtr = le_mem_ForceAlloc(GetOverflowPool(payloadSize, &classSize));
+
+    // The peer's messages for this protocol can't be bigger than the protocol's largest message,
+    // so never send more than that, even if the overflow class is bigger.
+    if (classSize > poolsPtr->largestMsgSize)
+    {
+        classSize = poolsPtr->largestMsgSize;
+    }
+    msgPtr->payloadSize = classSize;
+
+    return msgPtr;
 }
 
 
@@ -170,7 +373,8 @@ le_result_t msgMessage_Send
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Receive a single message from a connected socket.
+ * Receive a single message from a connected socket into a new Message object that is just big
+ * enough to hold it.
  *
  * @return
  * - LE_OK if successful.
@@ -182,24 +386,56 @@ le_result_t msgMessage_Send
 le_result_t msgMessage_Receive
 (
     int                 socketFd,   ///< [IN] The socket's file descriptor.
-    le_msg_MessageRef_t msgRef      ///< [IN] Message object to store the received message in.
+    le_msg_SessionRef_t sessionRef, ///< [IN] Session that the message is being received for.
+    le_msg_MessageRef_t* msgRefPtr  ///< [OUT] Ptr to where the new Message object will be put.
 )
 //--------------------------------------------------------------------------------------------------
 {
+    // Find out how big the next message is before creating the Message object to receive it into.
+    size_t byteCount;
+    le_result_t result = unixSocket_PeekMsgSize(socketFd, &byteCount);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    // The sender sends its whole payload buffer, and a server will respond using the same buffer,
+    // so the new message's payload buffer must be at least as big as the sender's.  But it is
+    // never bigger than the largest message in the protocol.
+    size_t payloadSize = 0;
+    if (byteCount > sizeof(((Message_t*)0)->txnId))
+    {
+        payloadSize = byteCount - sizeof(((Message_t*)0)->txnId);
+    }
+    size_t maxPayloadSize = le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(sessionRef));
+    if (payloadSize > maxPayloadSize)
+    {
+        payloadSize = maxPayloadSize;
+    }
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsgWithSize(sessionRef, payloadSize);
+
     // Receive the first bytes into our transaction ID and the rest (if any)
     // into our Message object's payload section.
-    size_t byteCount = sizeof(msgRef->txnId) + le_msg_GetMaxPayloadSize(msgRef);
-    le_result_t result = unixSocket_ReceiveMsg( socketFd,
-                                                &msgRef->txnId,
-                                                &byteCount,
-                                                &msgRef->fd,
-                                                NULL    );  // Don't receive credentials.
+    byteCount = sizeof(msgRef->txnId) + le_msg_GetMaxPayloadSize(msgRef);
+    result = unixSocket_ReceiveMsg( socketFd,
+                                    &msgRef->txnId,
+                                    &byteCount,
+                                    &msgRef->fd,
+                                    NULL    );  // Don't receive credentials.
     if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
     {
         msgRef->clientServer.server.responseFd = -1;
     }
 
-    return result;
+    if (result != LE_OK)
+    {
+        le_msg_ReleaseMsg(msgRef);
+        return result;
+    }
+
+    *msgRefPtr = msgRef;
+
+    return LE_OK;
 }
 
 
@@ -222,6 +458,22 @@ void msgMessage_CallCompletionCallback
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a batch of messages at once.  This takes the message pool locks once for the whole batch
+ * instead of once per message, as le_msg_ReleaseMsg() would.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_ReleaseBatch
+(
+    le_msg_MessageRef_t msgRefList[],   ///< [in] List of messages to release.
+    size_t numMsgs                      ///< [in] Number of messages in the list.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_mem_ReleaseBatch((void**)msgRefList, numMsgs);
+}
+
 
 // =======================================
 //  PUBLIC API FUNCTIONS
@@ -244,11 +496,37 @@ le_msg_MessageRef_t le_msg_CreateMsg
     le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
 )
 //--------------------------------------------------------------------------------------------------
+{
+    return le_msg_CreateMsgWithSize(sessionRef,
+                                    le_msg_GetProtocolMaxMsgSize(
+                                                        le_msg_GetSessionProtocol(sessionRef)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message to be sent over a given session, with a payload buffer that is at least a
+ * given size.  This can be much smaller than the largest message in the session's protocol.
+ *
+ * @return  The message reference.
+ *
+ * @note
+ * - This function never returns on failure, so no need to check the return code.
+ * - If a response is expected, the payload buffer must also be large enough to hold the response.
+ * - It is a fatal error to ask for more than the protocol's maximum message size.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t le_msg_CreateMsgWithSize
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Reference to the session.
+    size_t payloadSize              ///< [in] Minimum size of the payload buffer, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
 {
     // Get a reference to the Session's Protocol and ask the Protocol to allocate a Message
-    // object from its Message Pool.
+    // object from one of its Message Pools.
     le_msg_ProtocolRef_t protocolRef = le_msg_GetSessionProtocol(sessionRef);
-    Message_t* msgPtr = msgProto_AllocMessage(protocolRef);
+    Message_t* msgPtr = msgProto_AllocMessage(protocolRef, payloadSize);
 
     // Initialize the Message object's data members.
     msgPtr->link = LE_DLS_LINK_INIT;
@@ -273,7 +551,7 @@ le_msg_MessageRef_t le_msg_CreateMsg
 
     msgPtr->fd = -1;
     msgPtr->txnId = 0;
-    memset(msgPtr->payload, 0, le_msg_GetProtocolMaxMsgSize(protocolRef));
+    memset(msgPtr->payload, 0, msgPtr->payloadSize);
 
     return msgPtr;
 }
@@ -368,7 +646,7 @@ size_t le_msg_GetMaxPayloadSize
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return le_msg_GetProtocolMaxMsgSize(le_msg_GetSessionProtocol(msgRef->sessionRef));
+    return msgRef->payloadSize;
 }
 
 
@@ -501,6 +779,41 @@ void le_msg_RequestResponse
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Where a coroutine waits for the response to its request in le_msg_RequestSyncResponse().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_coro_Ref_t       coroRef;        ///< The waiting coroutine.
+    bool                isDone;         ///< true once the transaction is over.
+    le_msg_MessageRef_t responseMsgRef; ///< The response, or NULL if there wasn't one.
+}
+CoroResponse_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion callback for a request sent by a coroutine in le_msg_RequestSyncResponse().
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoroResponseHandler
+(
+    le_msg_MessageRef_t responseMsgRef, ///< [in] The response, or NULL if there wasn't one.
+    void*               contextPtr      ///< [in] The CoroResponse_t on the coroutine's stack.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    CoroResponse_t* waitPtr = contextPtr;
+
+    waitPtr->responseMsgRef = responseMsgRef;
+    waitPtr->isDone = true;
+
+    le_coro_Resume(waitPtr->coroRef);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Requests a response from a server by sending it a request.  Blocks until the response arrives
@@ -527,6 +840,9 @@ void le_msg_RequestResponse
  *        - If this function is used when the client and server are in the same thread, then the
  *          message will be discarded and NULL will be returned.  This is a deadlock prevention
  *          measure.
+ *
+ * @note  When called from inside a coroutine, only the coroutine waits for the response.  The
+ *        thread's Event Loop carries on handling other events in the meantime (see @ref coro_ipc).
  */
 //--------------------------------------------------------------------------------------------------
 le_msg_MessageRef_t le_msg_RequestSyncResponse
@@ -535,6 +851,23 @@ le_msg_MessageRef_t le_msg_RequestSyncResponse
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_coro_Ref_t coroRef = le_coro_GetCurrent();
+
+    if (coroRef != NULL)
+    {
+        // Do an asynchronous transaction instead, and suspend the coroutine until it's over.
+        CoroResponse_t wait = { .coroRef = coroRef, .isDone = false, .responseMsgRef = NULL };
+
+        le_msg_RequestResponse(msgRef, CoroResponseHandler, &wait);
+
+        while (!wait.isDone)
+        {
+            le_coro_Suspend();
+        }
+
+        return wait.responseMsgRef;
+    }
+
     // Tell the Session to do a synchronous request-response transaction.
     return msgSession_DoSyncRequestResponse(msgRef->sessionRef, msgRef);
 }
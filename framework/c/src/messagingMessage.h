@@ -40,6 +40,7 @@ typedef struct le_msg_Message
     }
     clientServer;
 
+    size_t                      payloadSize;///< Size of the payload buffer (bytes).
     int                         fd;         ///< File descriptor to send or received (-1 = no fd)
     void*                       txnId;      ///< Safe reference value used as a transaction ID.
     void*                       payload[0]; ///< Variable-length payload buffer appears at the end.
@@ -47,6 +48,32 @@ typedef struct le_msg_Message
 Message_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of message size classes that each protocol has its own Message Pool for.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_NUM_SIZE_CLASSES 3
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A protocol's set of Message Pools, one per size class.
+ *
+ * Messages that are too big for the protocol's largest size class come from the overflow pools,
+ * which are shared by all protocols.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t              largestMsgSize;                         ///< Largest payload in protocol.
+    size_t              classSize[MSG_NUM_SIZE_CLASSES];        ///< Payload size of each class.
+    le_mem_PoolRef_t    classPoolRef[MSG_NUM_SIZE_CLASSES];     ///< Pool for each class.
+                                                                ///  NULL if the class isn't used.
+}
+msgMessage_Pools_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initializes this module.  This must be called only once at start-up, before any other functions
@@ -61,15 +88,28 @@ void msgMessage_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a Message Pool.
+ * Create the set of Message Pools for a protocol.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_CreatePools
+(
+    const char* name,               ///< [in] Name of the protocol.
+    size_t largestMsgSize,          ///< [in] Size of the largest message payload, in bytes.
+    msgMessage_Pools_t* poolsPtr    ///< [out] Set of pools to initialize.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a Message object from the smallest size class that has room for a given payload size.
  *
- * @return  A reference to the pool.
+ * @return A pointer to the Message object.  Only the payloadSize member is initialized.
  */
 //--------------------------------------------------------------------------------------------------
-le_mem_PoolRef_t msgMessage_CreatePool
+Message_t* msgMessage_Alloc
 (
-    const char* name,       ///< [in] Name of the pool.
-    size_t largestMsgSize   ///< [in] Size of the largest message payload, in bytes.
+    const msgMessage_Pools_t* poolsPtr, ///< [in] Set of pools to allocate from.
+    size_t payloadSize                  ///< [in] Minimum payload size, in bytes.
 );
 
 
@@ -92,7 +132,8 @@ le_result_t msgMessage_Send
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Receive a single message from a connected socket.
+ * Receive a single message from a connected socket into a new Message object that is just big
+ * enough to hold it.
  *
  * @return
  * - LE_OK if successful.
@@ -104,7 +145,8 @@ le_result_t msgMessage_Send
 le_result_t msgMessage_Receive
 (
     int                 socketFd,   ///< [IN] The socket's file descriptor.
-    le_msg_MessageRef_t msgRef      ///< [IN] Message object to store the received message in.
+    le_msg_SessionRef_t sessionRef, ///< [IN] Session that the message is being received for.
+    le_msg_MessageRef_t* msgRefPtr  ///< [OUT] Ptr to where the new Message object will be put.
 );
 
 
@@ -187,4 +229,16 @@ void msgMessage_CallCompletionCallback
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a batch of messages at once.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_ReleaseBatch
+(
+    le_msg_MessageRef_t msgRefList[],   ///< [in] List of messages to release.
+    size_t numMsgs                      ///< [in] Number of messages in the list.
+);
+
+
 #endif // LEGATO_MESSAGING_MESSAGE_H_INCLUDE_GUARD
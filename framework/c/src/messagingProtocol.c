@@ -115,7 +115,7 @@ static msgProtocol_Protocol_t* CreateProtocol
         LE_CRIT("Protocol identifier truncated from '%s' to '%s'.", protocolId, protocolPtr->id);
     }
 
-    protocolPtr->messagePoolRef = msgMessage_CreatePool(protocolId, largestMsgSize);
+    msgMessage_CreatePools(protocolId, largestMsgSize, &protocolPtr->messagePools);
 
     LOCK
 
@@ -150,19 +150,26 @@ void msgProto_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Allocate a Message object from a given Protocol's Message Pool.
+ * Allocate a Message object from one of a given Protocol's Message Pools.
  *
- * @return A pointer to the (uninitialized) Message object memory.
+ * @return A pointer to the Message object memory.  Only the payloadSize member is initialized.
  */
 //--------------------------------------------------------------------------------------------------
 le_msg_MessageRef_t msgProto_AllocMessage
 (
-    le_msg_ProtocolRef_t protocolRef
+    le_msg_ProtocolRef_t protocolRef,
+    size_t payloadSize                  ///< [in] Minimum payload size, in bytes.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Allocate a Message object from this Protocol's Message Pool.
-    return le_mem_ForceAlloc(protocolRef->messagePoolRef);
+    LE_FATAL_IF(payloadSize > protocolRef->maxPayloadSize,
+                "Message payload size %zu is bigger than protocol '%s' maximum (%zu).",
+                payloadSize,
+                protocolRef->id,
+                protocolRef->maxPayloadSize);
+
+    // Allocate a Message object from the smallest of this Protocol's size classes that fits.
+    return msgMessage_Alloc(&protocolRef->messagePools, payloadSize);
 }
 
 
@@ -9,6 +9,7 @@
 #define MESSAGING_PROTOCOL_H_INCLUDE_GUARD
 
 #include "limit.h"
+#include "messagingMessage.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -20,7 +21,7 @@ typedef struct le_msg_Protocol
     le_sls_Link_t link;                     ///< Used to link this into the Protocol List.
     char id[LIMIT_MAX_PROTOCOL_ID_BYTES];   ///< Unique identifier for the protocol.
     size_t maxPayloadSize;                  ///< Max payload size (in bytes) in this protocol.
-    le_mem_PoolRef_t messagePoolRef;        ///< Pool of Message objects.
+    msgMessage_Pools_t messagePools;        ///< Pools of Message objects (one per size class).
 }
 msgProtocol_Protocol_t;
 
@@ -39,14 +40,15 @@ void msgProto_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Allocate a Message object from a given Protocol's Message Pool.
+ * Allocate a Message object from one of a given Protocol's Message Pools.
  *
- * @return A pointer to the (uninitialized) Message object memory.
+ * @return A pointer to the Message object memory.  Only the payloadSize member is initialized.
  */
 //--------------------------------------------------------------------------------------------------
 le_msg_MessageRef_t msgProto_AllocMessage
 (
-    le_msg_ProtocolRef_t protocolRef
+    le_msg_ProtocolRef_t protocolRef,
+    size_t payloadSize                  ///< [in] Minimum payload size, in bytes.
 );
 
 
@@ -30,6 +30,12 @@
 #define MAX_EXPECTED_TXNS 32
 
 
+//--------------------------------------------------------------------------------------------------
+/// The maximum number of messages that are released together when purging a Transmit Queue.
+//--------------------------------------------------------------------------------------------------
+#define PURGE_BATCH_SIZE 16
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mutex used to protect data structures in this module from multi-threaded race conditions.
@@ -368,6 +374,8 @@ static void PurgeTransmitQueue
 //--------------------------------------------------------------------------------------------------
 {
     le_msg_MessageRef_t msgRef;
+    le_msg_MessageRef_t releaseList[PURGE_BATCH_SIZE];
+    size_t releaseCount = 0;
 
     while (NULL != (msgRef = PopTransmitQueue(sessionPtr)))
     {
@@ -388,8 +396,16 @@ static void PurgeTransmitQueue
         // NOTE: Messages never have completion call-backs on the server side, and transaction IDs
         //       are only created and deleted on the client-side.
 
-        le_msg_ReleaseMsg(msgRef);
+        // Messages are released in batches, to save locking the message pools for each one.
+        releaseList[releaseCount++] = msgRef;
+        if (releaseCount == PURGE_BATCH_SIZE)
+        {
+            msgMessage_ReleaseBatch(releaseList, releaseCount);
+            releaseCount = 0;
+        }
     }
+
+    msgMessage_ReleaseBatch(releaseList, releaseCount);
 }
 
 
@@ -913,11 +929,10 @@ static void ReceiveMessages
 {
     for (;;)
     {
-        // Create a Message object.
-        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionPtr);
+        le_msg_MessageRef_t msgRef;
 
-        // Receive from the socket into the Message object.
-        le_result_t result = msgMessage_Receive(sessionPtr->socketFd, msgRef);
+        // Receive from the socket into a new Message object.
+        le_result_t result = msgMessage_Receive(sessionPtr->socketFd, sessionPtr, &msgRef);
 
         if (result == LE_OK)
         {
@@ -927,7 +942,6 @@ static void ReceiveMessages
         else
         {
             // Nothing left to receive from the socket.  We are done.
-            le_msg_ReleaseMsg(msgRef);
             break;
         }
     }
@@ -1679,15 +1693,12 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // function call.
     for (;;)
     {
-        rxMsgRef = le_msg_CreateMsg(sessionRef);
-
-        le_result_t result = msgMessage_Receive(sessionRef->socketFd, rxMsgRef);
+        le_result_t result = msgMessage_Receive(sessionRef->socketFd, sessionRef, &rxMsgRef);
 
         if (result != LE_OK)
         {
             // The socket experienced an error or the connection was closed.
             // No message was received.
-            le_msg_ReleaseMsg(rxMsgRef);
             rxMsgRef = NULL;
             break;
         }
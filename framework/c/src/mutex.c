@@ -28,6 +28,14 @@
  *  -# What type of mutex is a given mutex? (recursive?)
  *    - Stored in each Mutex object as a boolean flag.
  *
+ * None of this should make locking a mutex much more expensive than locking a plain pthreads
+ * mutex, though.  So le_mutex_Lock() first tries to get the lock without waiting
+ * (pthread_mutex_trylock(), a single atomic operation when the mutex is free).  Only if that fails
+ * does it put the thread on the mutex's waiting list, which means locking the Waiting List Mutex,
+ * before blocking in pthread_mutex_lock().  Threads that are blocked don't care about a couple of
+ * extra lock operations.  The thread's list of locked mutexes and its waitingOnMutex pointer are
+ * only ever written by the thread itself, so updating them needs no locking at all.
+ *
  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
  */
 
@@ -448,15 +456,22 @@ void le_mutex_Lock
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int result;
-
     mutex_ThreadRec_t* perThreadRecPtr = thread_GetMutexRecPtr();
 
-    AddToWaitingList(mutexRef, perThreadRecPtr);
+    // Fast path: if nobody holds the lock (or this thread holds a recursive one), this gets it
+    // without the waiting list ever being touched.
+    int result = pthread_mutex_trylock(&mutexRef->mutex);
 
-    result = pthread_mutex_lock(&mutexRef->mutex);
+    // Slow path: the lock is held by someone (possibly this thread, if it isn't recursive), so
+    // this thread will have to wait.  Let the diagnostic tools know what it is waiting for.
+    if (result == EBUSY)
+    {
+        AddToWaitingList(mutexRef, perThreadRecPtr);
+
+        result = pthread_mutex_lock(&mutexRef->mutex);
 
-    RemoveFromWaitingList(mutexRef, perThreadRecPtr);
+        RemoveFromWaitingList(mutexRef, perThreadRecPtr);
+    }
 
     if (result == 0)
     {
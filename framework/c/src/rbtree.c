@@ -0,0 +1,664 @@
+ /** @file rbtree.c
+  *
+  * Legato @ref c_rbtree implementation.
+  *
+  * This is a standard red/black tree (see Cormen, Leiserson, Rivest and Stein, "Introduction to
+  * Algorithms", chapter 13), using NULL leaves so that nodes and trees can be initialized without
+  * knowing about each other.  The node with the smallest key is cached in the tree, because the
+  * most common use of an ordered container in the framework is to find the earliest item.
+  *
+  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+  */
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if a node is black.  NULL leaves are black.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsBlack
+(
+    const le_rbtree_Node_t* nodePtr     ///< [IN] Node, or NULL.
+)
+{
+    return (nodePtr == NULL) || (nodePtr->color == LE_RBTREE_BLACK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node with the smallest key in a sub-tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_rbtree_Node_t* Minimum
+(
+    le_rbtree_Node_t* nodePtr           ///< [IN] Root of the sub-tree.
+)
+{
+    while (nodePtr->leftPtr != NULL)
+    {
+        nodePtr = nodePtr->leftPtr;
+    }
+
+    return nodePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node with the largest key in a sub-tree.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline le_rbtree_Node_t* Maximum
+(
+    le_rbtree_Node_t* nodePtr           ///< [IN] Root of the sub-tree.
+)
+{
+    while (nodePtr->rightPtr != NULL)
+    {
+        nodePtr = nodePtr->rightPtr;
+    }
+
+    return nodePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replaces the sub-tree rooted at one node with the sub-tree rooted at another node, as far as the
+ * first node's parent is concerned.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Transplant
+(
+    le_rbtree_Tree_t* treePtr,          ///< [IN] The tree.
+    le_rbtree_Node_t* oldNodePtr,       ///< [IN] Node being replaced.
+    le_rbtree_Node_t* newNodePtr        ///< [IN] Replacement node, or NULL.
+)
+{
+    le_rbtree_Node_t* parentPtr = oldNodePtr->parentPtr;
+
+    if (parentPtr == NULL)
+    {
+        treePtr->rootPtr = newNodePtr;
+    }
+    else if (oldNodePtr == parentPtr->leftPtr)
+    {
+        parentPtr->leftPtr = newNodePtr;
+    }
+    else
+    {
+        parentPtr->rightPtr = newNodePtr;
+    }
+
+    if (newNodePtr != NULL)
+    {
+        newNodePtr->parentPtr = parentPtr;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rotates a node's right child up into its place.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RotateLeft
+(
+    le_rbtree_Tree_t* treePtr,          ///< [IN] The tree.
+    le_rbtree_Node_t* nodePtr           ///< [IN] The node.  Must have a right child.
+)
+{
+    le_rbtree_Node_t* childPtr = nodePtr->rightPtr;
+
+    nodePtr->rightPtr = childPtr->leftPtr;
+    if (childPtr->leftPtr != NULL)
+    {
+        childPtr->leftPtr->parentPtr = nodePtr;
+    }
+
+    Transplant(treePtr, nodePtr, childPtr);
+
+    childPtr->leftPtr = nodePtr;
+    nodePtr->parentPtr = childPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rotates a node's left child up into its place.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RotateRight
+(
+    le_rbtree_Tree_t* treePtr,          ///< [IN] The tree.
+    le_rbtree_Node_t* nodePtr           ///< [IN] The node.  Must have a left child.
+)
+{
+    le_rbtree_Node_t* childPtr = nodePtr->leftPtr;
+
+    nodePtr->leftPtr = childPtr->rightPtr;
+    if (childPtr->rightPtr != NULL)
+    {
+        childPtr->rightPtr->parentPtr = nodePtr;
+    }
+
+    Transplant(treePtr, nodePtr, childPtr);
+
+    childPtr->rightPtr = nodePtr;
+    nodePtr->parentPtr = childPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores the red/black properties after a red node has been inserted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InsertFixup
+(
+    le_rbtree_Tree_t* treePtr,          ///< [IN] The tree.
+    le_rbtree_Node_t* nodePtr           ///< [IN] The inserted node.
+)
+{
+    le_rbtree_Node_t* parentPtr;
+
+    while (((parentPtr = nodePtr->parentPtr) != NULL) && (parentPtr->color == LE_RBTREE_RED))
+    {
+        // A red node is never the root, so the grandparent exists.
+        le_rbtree_Node_t* grandparentPtr = parentPtr->parentPtr;
+
+        if (parentPtr == grandparentPtr->leftPtr)
+        {
+            le_rbtree_Node_t* unclePtr = grandparentPtr->rightPtr;
+
+            if (!IsBlack(unclePtr))
+            {
+                parentPtr->color = LE_RBTREE_BLACK;
+                unclePtr->color = LE_RBTREE_BLACK;
+                grandparentPtr->color = LE_RBTREE_RED;
+                nodePtr = grandparentPtr;
+            }
+            else
+            {
+                if (nodePtr == parentPtr->rightPtr)
+                {
+                    RotateLeft(treePtr, parentPtr);
+                    nodePtr = parentPtr;
+                    parentPtr = nodePtr->parentPtr;
+                }
+                parentPtr->color = LE_RBTREE_BLACK;
+                grandparentPtr->color = LE_RBTREE_RED;
+                RotateRight(treePtr, grandparentPtr);
+            }
+        }
+        else
+        {
+            le_rbtree_Node_t* unclePtr = grandparentPtr->leftPtr;
+
+            if (!IsBlack(unclePtr))
+            {
+                parentPtr->color = LE_RBTREE_BLACK;
+                unclePtr->color = LE_RBTREE_BLACK;
+                grandparentPtr->color = LE_RBTREE_RED;
+                nodePtr = grandparentPtr;
+            }
+            else
+            {
+                if (nodePtr == parentPtr->leftPtr)
+                {
+                    RotateRight(treePtr, parentPtr);
+                    nodePtr = parentPtr;
+                    parentPtr = nodePtr->parentPtr;
+                }
+                parentPtr->color = LE_RBTREE_BLACK;
+                grandparentPtr->color = LE_RBTREE_RED;
+                RotateLeft(treePtr, grandparentPtr);
+            }
+        }
+    }
+
+    treePtr->rootPtr->color = LE_RBTREE_BLACK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restores the red/black properties after a black node has been removed.  The sub-tree rooted at
+ * nodePtr is one black node short.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFixup
+(
+    le_rbtree_Tree_t* treePtr,          ///< [IN] The tree.
+    le_rbtree_Node_t* nodePtr,          ///< [IN] Node that took the removed node's place, or NULL.
+    le_rbtree_Node_t* parentPtr         ///< [IN] Parent of nodePtr.
+)
+{
+    while ((nodePtr != treePtr->rootPtr) && IsBlack(nodePtr))
+    {
+        // The sibling can't be a NULL leaf, because its side of the tree has more black nodes.
+        if (nodePtr == parentPtr->leftPtr)
+        {
+            le_rbtree_Node_t* siblingPtr = parentPtr->rightPtr;
+
+            if (!IsBlack(siblingPtr))
+            {
+                siblingPtr->color = LE_RBTREE_BLACK;
+                parentPtr->color = LE_RBTREE_RED;
+                RotateLeft(treePtr, parentPtr);
+                siblingPtr = parentPtr->rightPtr;
+            }
+
+            if (IsBlack(siblingPtr->leftPtr) && IsBlack(siblingPtr->rightPtr))
+            {
+                siblingPtr->color = LE_RBTREE_RED;
+                nodePtr = parentPtr;
+                parentPtr = nodePtr->parentPtr;
+            }
+            else
+            {
+                if (IsBlack(siblingPtr->rightPtr))
+                {
+                    siblingPtr->leftPtr->color = LE_RBTREE_BLACK;
+                    siblingPtr->color = LE_RBTREE_RED;
+                    RotateRight(treePtr, siblingPtr);
+                    siblingPtr = parentPtr->rightPtr;
+                }
+                siblingPtr->color = parentPtr->color;
+                parentPtr->color = LE_RBTREE_BLACK;
+                siblingPtr->rightPtr->color = LE_RBTREE_BLACK;
+                RotateLeft(treePtr, parentPtr);
+                nodePtr = treePtr->rootPtr;
+            }
+        }
+        else
+        {
+            le_rbtree_Node_t* siblingPtr = parentPtr->leftPtr;
+
+            if (!IsBlack(siblingPtr))
+            {
+                siblingPtr->color = LE_RBTREE_BLACK;
+                parentPtr->color = LE_RBTREE_RED;
+                RotateRight(treePtr, parentPtr);
+                siblingPtr = parentPtr->leftPtr;
+            }
+
+            if (IsBlack(siblingPtr->leftPtr) && IsBlack(siblingPtr->rightPtr))
+            {
+                siblingPtr->color = LE_RBTREE_RED;
+                nodePtr = parentPtr;
+                parentPtr = nodePtr->parentPtr;
+            }
+            else
+            {
+                if (IsBlack(siblingPtr->leftPtr))
+                {
+                    siblingPtr->rightPtr->color = LE_RBTREE_BLACK;
+                    siblingPtr->color = LE_RBTREE_RED;
+                    RotateLeft(treePtr, siblingPtr);
+                    siblingPtr = parentPtr->leftPtr;
+                }
+                siblingPtr->color = parentPtr->color;
+                parentPtr->color = LE_RBTREE_BLACK;
+                siblingPtr->leftPtr->color = LE_RBTREE_BLACK;
+                RotateRight(treePtr, parentPtr);
+                nodePtr = treePtr->rootPtr;
+            }
+        }
+    }
+
+    if (nodePtr != NULL)
+    {
+        nodePtr->color = LE_RBTREE_BLACK;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes a tree.  The tree is empty afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_InitTree
+(
+    le_rbtree_Tree_t* treePtr,                  ///< [IN] Tree to initialize.
+    le_rbtree_CompareFunc_t compareFuncPtr      ///< [IN] Key comparison function.
+)
+{
+    treePtr->rootPtr = NULL;
+    treePtr->firstPtr = NULL;
+    treePtr->numNodes = 0;
+    treePtr->compareFuncPtr = compareFuncPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes a node.  This must be done before the node is inserted in a tree, and the key must
+ * not change while the node is in a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_InitNode
+(
+    le_rbtree_Node_t* nodePtr,                  ///< [IN] Node to initialize.
+    const void* keyPtr                          ///< [IN] Pointer to the node's key.
+)
+{
+    nodePtr->keyPtr = keyPtr;
+    nodePtr->parentPtr = NULL;
+    nodePtr->leftPtr = NULL;
+    nodePtr->rightPtr = NULL;
+    nodePtr->color = LE_RBTREE_NOT_IN_TREE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Inserts a node in the tree.  If the tree already has nodes with an equal key, the new node is
+ * put after them.  The node must not already be in a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_Insert
+(
+    le_rbtree_Tree_t* treePtr,                  ///< [IN] Tree to insert into.
+    le_rbtree_Node_t* nodePtr                   ///< [IN] Node to insert.
+)
+{
+    LE_ASSERT(nodePtr->color == LE_RBTREE_NOT_IN_TREE);
+
+    le_rbtree_Node_t* parentPtr = NULL;
+    le_rbtree_Node_t** linkPtrPtr = &treePtr->rootPtr;
+    bool isFirst = true;
+
+    while (*linkPtrPtr != NULL)
+    {
+        parentPtr = *linkPtrPtr;
+
+        if (treePtr->compareFuncPtr(nodePtr->keyPtr, parentPtr->keyPtr) < 0)
+        {
+            linkPtrPtr = &parentPtr->leftPtr;
+        }
+        else
+        {
+            linkPtrPtr = &parentPtr->rightPtr;
+            isFirst = false;
+        }
+    }
+
+    nodePtr->parentPtr = parentPtr;
+    nodePtr->leftPtr = NULL;
+    nodePtr->rightPtr = NULL;
+    nodePtr->color = LE_RBTREE_RED;
+    *linkPtrPtr = nodePtr;
+
+    if (isFirst)
+    {
+        treePtr->firstPtr = nodePtr;
+    }
+    treePtr->numNodes++;
+
+    InsertFixup(treePtr, nodePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a node from the tree.  Ensure the node is in the tree otherwise the behaviour of this
+ * function is undefined.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rbtree_Remove
+(
+    le_rbtree_Tree_t* treePtr,                  ///< [IN] Tree to remove from.
+    le_rbtree_Node_t* nodePtr                   ///< [IN] Node to remove.
+)
+{
+    LE_ASSERT(nodePtr->color != LE_RBTREE_NOT_IN_TREE);
+
+    if (treePtr->firstPtr == nodePtr)
+    {
+        treePtr->firstPtr = le_rbtree_GetNext(treePtr, nodePtr);
+    }
+
+    le_rbtree_Color_t removedColor = nodePtr->color;
+    le_rbtree_Node_t* childPtr;
+    le_rbtree_Node_t* childParentPtr;
+
+    if (nodePtr->leftPtr == NULL)
+    {
+        childPtr = nodePtr->rightPtr;
+        childParentPtr = nodePtr->parentPtr;
+        Transplant(treePtr, nodePtr, childPtr);
+    }
+    else if (nodePtr->rightPtr == NULL)
+    {
+        childPtr = nodePtr->leftPtr;
+        childParentPtr = nodePtr->parentPtr;
+        Transplant(treePtr, nodePtr, childPtr);
+    }
+    else
+    {
+        // Move the node's successor into its place.  The successor has no left child.
+        le_rbtree_Node_t* successorPtr = Minimum(nodePtr->rightPtr);
+
+        removedColor = successorPtr->color;
+        childPtr = successorPtr->rightPtr;
+
+        if (successorPtr->parentPtr == nodePtr)
+        {
+            childParentPtr = successorPtr;
+        }
+        else
+        {
+            childParentPtr = successorPtr->parentPtr;
+            Transplant(treePtr, successorPtr, childPtr);
+            successorPtr->rightPtr = nodePtr->rightPtr;
+            successorPtr->rightPtr->parentPtr = successorPtr;
+        }
+
+        Transplant(treePtr, nodePtr, successorPtr);
+        successorPtr->leftPtr = nodePtr->leftPtr;
+        successorPtr->leftPtr->parentPtr = successorPtr;
+        successorPtr->color = nodePtr->color;
+    }
+
+    if (removedColor == LE_RBTREE_BLACK)
+    {
+        RemoveFixup(treePtr, childPtr, childParentPtr);
+    }
+
+    treePtr->numNodes--;
+
+    nodePtr->parentPtr = NULL;
+    nodePtr->leftPtr = NULL;
+    nodePtr->rightPtr = NULL;
+    nodePtr->color = LE_RBTREE_NOT_IN_TREE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first node with a key equal to a given key.
+ *
+ * @return
+ *      The node, or NULL if there is no node with an equal key.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_Find
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree to search.
+    const void* keyPtr                          ///< [IN] Key to search for.
+)
+{
+    le_rbtree_Node_t* nodePtr = le_rbtree_LowerBound(treePtr, keyPtr);
+
+    if ((nodePtr != NULL) && (treePtr->compareFuncPtr(nodePtr->keyPtr, keyPtr) == 0))
+    {
+        return nodePtr;
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first node with a key greater than or equal to a given key.
+ *
+ * @return
+ *      The node, or NULL if all keys in the tree are less than the given key.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_LowerBound
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree to search.
+    const void* keyPtr                          ///< [IN] Key to search for.
+)
+{
+    le_rbtree_Node_t* nodePtr = treePtr->rootPtr;
+    le_rbtree_Node_t* resultPtr = NULL;
+
+    while (nodePtr != NULL)
+    {
+        if (treePtr->compareFuncPtr(nodePtr->keyPtr, keyPtr) < 0)
+        {
+            nodePtr = nodePtr->rightPtr;
+        }
+        else
+        {
+            resultPtr = nodePtr;
+            nodePtr = nodePtr->leftPtr;
+        }
+    }
+
+    return resultPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the first node with a key greater than a given key.
+ *
+ * @return
+ *      The node, or NULL if no key in the tree is greater than the given key.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_UpperBound
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree to search.
+    const void* keyPtr                          ///< [IN] Key to search for.
+)
+{
+    le_rbtree_Node_t* nodePtr = treePtr->rootPtr;
+    le_rbtree_Node_t* resultPtr = NULL;
+
+    while (nodePtr != NULL)
+    {
+        if (treePtr->compareFuncPtr(nodePtr->keyPtr, keyPtr) <= 0)
+        {
+            nodePtr = nodePtr->rightPtr;
+        }
+        else
+        {
+            resultPtr = nodePtr;
+            nodePtr = nodePtr->leftPtr;
+        }
+    }
+
+    return resultPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node with the largest key (the last of them, if there are several).
+ *
+ * @return
+ *      The node, or NULL if the tree is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_GetLast
+(
+    const le_rbtree_Tree_t* treePtr             ///< [IN] The tree.
+)
+{
+    if (treePtr->rootPtr == NULL)
+    {
+        return NULL;
+    }
+
+    return Maximum(treePtr->rootPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node after a given node.  Ensure the node is in the tree otherwise the behaviour of
+ * this function is undefined.
+ *
+ * @return
+ *      The next node, or NULL if the given node is the last one.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_GetNext
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree containing the node.
+    const le_rbtree_Node_t* nodePtr             ///< [IN] The node.
+)
+{
+    (void)treePtr;  // Cast to void to avoid compiler warning.  Remove if treePtr is used.
+
+    if (nodePtr->rightPtr != NULL)
+    {
+        return Minimum(nodePtr->rightPtr);
+    }
+
+    // Go up until we come up from a left child.
+    le_rbtree_Node_t* parentPtr = nodePtr->parentPtr;
+
+    while ((parentPtr != NULL) && (nodePtr == parentPtr->rightPtr))
+    {
+        nodePtr = parentPtr;
+        parentPtr = parentPtr->parentPtr;
+    }
+
+    return parentPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the node before a given node.  Ensure the node is in the tree otherwise the behaviour of
+ * this function is undefined.
+ *
+ * @return
+ *      The previous node, or NULL if the given node is the first one.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rbtree_Node_t* le_rbtree_GetPrev
+(
+    const le_rbtree_Tree_t* treePtr,            ///< [IN] Tree containing the node.
+    const le_rbtree_Node_t* nodePtr             ///< [IN] The node.
+)
+{
+    (void)treePtr;  // Cast to void to avoid compiler warning.  Remove if treePtr is used.
+
+    if (nodePtr->leftPtr != NULL)
+    {
+        return Maximum(nodePtr->leftPtr);
+    }
+
+    // Go up until we come up from a right child.
+    le_rbtree_Node_t* parentPtr = nodePtr->parentPtr;
+
+    while ((parentPtr != NULL) && (nodePtr == parentPtr->leftPtr))
+    {
+        nodePtr = parentPtr;
+        parentPtr = parentPtr->parentPtr;
+    }
+
+    return parentPtr;
+}
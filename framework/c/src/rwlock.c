@@ -0,0 +1,698 @@
+/** @file rwlock.c
+ *
+ * Legato @ref c_rwlock implementation.
+ *
+ * Each reader-writer lock is represented by a <b> RwLock object </b>.  They are dynamically
+ * allocated from the <b> RwLock Pool </b> and are stored on the <b> RwLock List </b> until they
+ * are destroyed.
+ *
+ * In addition, each thread has a <b> Per-Thread RwLock Record </b>, which is kept in the Thread
+ * object inside the thread module and is fetched through a call to thread_GetRwLockRecPtr().
+ * That Per-Thread RwLock Record holds a pointer to a lock that the thread is waiting on (or NULL
+ * if not waiting on a lock), and a list of <b> Hold records </b>, one for each lock that the thread
+ * holds, saying whether it holds that lock for reading or for writing.  Any number of threads can
+ * hold a lock for reading, so (unlike a mutex) the lock itself can't be linked onto its holders'
+ * lists.  Hold records come from the <b> Hold Pool </b>.  A thread normally holds very few locks
+ * at a time, so looking one up in the list is quick.
+ *
+ * The real work is done by a pthreads rwlock of the "prefer writer, non-recursive" kind, which
+ * stops taking new readers as soon as a writer is waiting.  Like the @ref c_mutex "mutexes", the
+ * diagnostic command-line tools can ask:
+ *  -# What reader-writer locks currently exist in the process?
+ *    - A single per-process list of all locks keeps track of this (the RwLock List).
+ *  -# How many threads hold a given lock for reading?
+ *    - Each RwLock object keeps an (atomic) count of its readers.
+ *  -# What thread holds a given lock for writing?
+ *    - Each RwLock object points to the writer's Per-Thread RwLock Record (NULL if no writer).
+ *  -# What threads, if any, are currently waiting on a given lock, and how often have they had to?
+ *    - Each RwLock object has a list of Per-Thread RwLock Records, and counts of the times that
+ *      readers and writers have had to wait.
+ *
+ * As with le_mutex_Lock(), a thread first tries to get the lock without waiting, which is a single
+ * atomic operation when the lock is free.  Only if that fails does it lock the Waiting List Mutex
+ * to put itself on the waiting list and update the contention counters before blocking.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#include "legato.h"
+#include "limit.h"
+#include "rwlock.h"
+#include "thread.h"
+
+
+// ==============================
+//  PRIVATE DATA
+// ==============================
+
+/// Number of objects in the RwLock Pool to start with.
+#define DEFAULT_POOL_SIZE 4
+
+/// Number of objects in the Hold Pool to start with.
+#define DEFAULT_HOLD_POOL_SIZE 8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hold record.  Records that a thread holds a reader-writer lock, and how.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t   link;       ///< Used to link onto the thread's list of held locks.
+    RwLock_t*       lockPtr;    ///< The lock that is held.
+    bool            isWrite;    ///< true if held for writing, false if held for reading.
+}
+Hold_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A counter that increments every time a change is made to the RwLock List.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RwLockListChangeCount = 0;
+static size_t* RwLockListChangeCountRef = &RwLockListChangeCount;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RwLock Pool.
+ *
+ * Memory pool from which RwLock objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RwLockPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hold Pool.
+ *
+ * Memory pool from which Hold records are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t HoldPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RwLock List.
+ *
+ * List on which all RwLock objects in the process are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t RwLockList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RwLock List Mutex.
+ *
+ * Basic pthreads mutex used to protect the RwLock List from multi-threaded race conditions.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t RwLockListMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+// ==============================
+//  PRIVATE FUNCTIONS
+// ==============================
+
+/// Lock the RwLock List Mutex.
+#define LOCK_RWLOCK_LIST()      LE_ASSERT(pthread_mutex_lock(&RwLockListMutex) == 0)
+
+/// Unlock the RwLock List Mutex.
+#define UNLOCK_RWLOCK_LIST()    LE_ASSERT(pthread_mutex_unlock(&RwLockListMutex) == 0)
+
+
+/// Lock a reader-writer lock's Waiting List Mutex.
+#define LOCK_WAITING_LIST(lockPtr) \
+            LE_ASSERT(pthread_mutex_lock(&(lockPtr)->waitingListMutex) == 0)
+
+/// Unlock a reader-writer lock's Waiting List Mutex.
+#define UNLOCK_WAITING_LIST(lockPtr) \
+            LE_ASSERT(pthread_mutex_unlock(&(lockPtr)->waitingListMutex) == 0)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a thread's RwLock Record to a RwLock object's waiting list, and counts the wait.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToWaitingList
+(
+    RwLock_t*           lockPtr,
+    rwlock_ThreadRec_t* perThreadRecPtr,
+    bool                isWrite
+)
+//--------------------------------------------------------------------------------------------------
+{
+    perThreadRecPtr->waitingOnRwLock = lockPtr;
+    perThreadRecPtr->isWaitingToWrite = isWrite;
+
+    LOCK_WAITING_LIST(lockPtr);
+
+    le_dls_Queue(&lockPtr->waitingList, &perThreadRecPtr->waitingListLink);
+
+    if (isWrite)
+    {
+        lockPtr->writeWaitCount++;
+    }
+    else
+    {
+        lockPtr->readWaitCount++;
+    }
+
+    UNLOCK_WAITING_LIST(lockPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes a thread's RwLock Record from a RwLock object's waiting list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFromWaitingList
+(
+    RwLock_t*           lockPtr,
+    rwlock_ThreadRec_t* perThreadRecPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LOCK_WAITING_LIST(lockPtr);
+
+    le_dls_Remove(&lockPtr->waitingList, &perThreadRecPtr->waitingListLink);
+
+    UNLOCK_WAITING_LIST(lockPtr);
+
+    perThreadRecPtr->waitingOnRwLock = NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the calling thread's Hold record for a reader-writer lock.
+ *
+ * @return Pointer to the Hold record, or NULL if the thread doesn't hold the lock.
+ */
+//--------------------------------------------------------------------------------------------------
+static Hold_t* FindHold
+(
+    rwlock_ThreadRec_t* perThreadRecPtr,    ///< [in] Pointer to the thread's rwlock record.
+    RwLock_t*           lockPtr             ///< [in] Pointer to the RwLock object.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&perThreadRecPtr->heldList);
+
+    while (linkPtr != NULL)
+    {
+        Hold_t* holdPtr = CONTAINER_OF(linkPtr, Hold_t, link);
+
+        if (holdPtr->lockPtr == lockPtr)
+        {
+            return holdPtr;
+        }
+
+        linkPtr = le_dls_PeekNext(&perThreadRecPtr->heldList, linkPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Kills the process if the calling thread already holds a reader-writer lock that it is about to
+ * lock.  These locks aren't recursive, so that could deadlock.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckNotHeld
+(
+    rwlock_ThreadRec_t* perThreadRecPtr,    ///< [in] Pointer to the thread's rwlock record.
+    RwLock_t*           lockPtr             ///< [in] Pointer to the RwLock object.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Hold_t* holdPtr = FindHold(perThreadRecPtr, lockPtr);
+
+    if (holdPtr != NULL)
+    {
+        LE_FATAL("DEADLOCK DETECTED! Thread '%s' attempting to re-lock reader-writer lock '%s',"
+                 " which it holds for %s.",
+                 le_thread_GetMyName(),
+                 lockPtr->name,
+                 holdPtr->isWrite ? "writing" : "reading");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a reader-writer lock "locked" by the calling thread.
+ *
+ * @warning Assumes that the calling thread already holds the pthreads rwlock.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MarkLocked
+(
+    rwlock_ThreadRec_t* perThreadRecPtr,    ///< [in] Pointer to the thread's rwlock record.
+    RwLock_t*           lockPtr,            ///< [in] Pointer to the RwLock object that was locked.
+    bool                isWrite             ///< [in] true if locked for writing.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (isWrite)
+    {
+        lockPtr->writerRecPtr = perThreadRecPtr;
+    }
+    else
+    {
+        __atomic_add_fetch(&lockPtr->readerCount, 1, __ATOMIC_RELAXED);
+    }
+
+    Hold_t* holdPtr = le_mem_ForceAlloc(HoldPoolRef);
+    holdPtr->link = LE_DLS_LINK_INIT;
+    holdPtr->lockPtr = lockPtr;
+    holdPtr->isWrite = isWrite;
+    le_dls_Stack(&perThreadRecPtr->heldList, &holdPtr->link);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Locks a reader-writer lock for reading or writing, waiting if necessary.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Lock
+(
+    RwLock_t*   lockPtr,
+    bool        isWrite
+)
+//--------------------------------------------------------------------------------------------------
+{
+    rwlock_ThreadRec_t* perThreadRecPtr = thread_GetRwLockRecPtr();
+
+    CheckNotHeld(perThreadRecPtr, lockPtr);
+
+    // Fast path: if the lock can be had straight away, the waiting list is never touched.
+    int result = (isWrite ? pthread_rwlock_trywrlock(&lockPtr->rwLock)
+                          : pthread_rwlock_tryrdlock(&lockPtr->rwLock));
+
+    // Slow path: let the diagnostic tools know what this thread is waiting for.
+    if (result == EBUSY)
+    {
+        AddToWaitingList(lockPtr, perThreadRecPtr, isWrite);
+
+        result = (isWrite ? pthread_rwlock_wrlock(&lockPtr->rwLock)
+                          : pthread_rwlock_rdlock(&lockPtr->rwLock));
+
+        RemoveFromWaitingList(lockPtr, perThreadRecPtr);
+    }
+
+    if (result == 0)
+    {
+        MarkLocked(perThreadRecPtr, lockPtr, isWrite);
+    }
+    else if (result == EDEADLK)
+    {
+        LE_FATAL("DEADLOCK DETECTED! Thread '%s' attempting to re-lock reader-writer lock '%s'.",
+                 le_thread_GetMyName(),
+                 lockPtr->name);
+    }
+    else
+    {
+        LE_FATAL("Thread '%s' failed to lock reader-writer lock '%s' for %s. Error code %d.",
+                 le_thread_GetMyName(),
+                 lockPtr->name,
+                 isWrite ? "writing" : "reading",
+                 result);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tries to lock a reader-writer lock for reading or writing, without waiting.
+ *
+ * @return
+ *  - LE_OK if the lock was locked.
+ *  - LE_WOULD_BLOCK if it wasn't available.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t TryLock
+(
+    RwLock_t*   lockPtr,
+    bool        isWrite
+)
+//--------------------------------------------------------------------------------------------------
+{
+    rwlock_ThreadRec_t* perThreadRecPtr = thread_GetRwLockRecPtr();
+
+    CheckNotHeld(perThreadRecPtr, lockPtr);
+
+    int result = (isWrite ? pthread_rwlock_trywrlock(&lockPtr->rwLock)
+                          : pthread_rwlock_tryrdlock(&lockPtr->rwLock));
+
+    if (result == 0)
+    {
+        MarkLocked(perThreadRecPtr, lockPtr, isWrite);
+
+        return LE_OK;
+    }
+    else if (result == EBUSY)
+    {
+        return LE_WOULD_BLOCK;
+    }
+
+    LE_FATAL("Thread '%s' failed to try-lock reader-writer lock '%s' for %s. Error code %d.",
+             le_thread_GetMyName(),
+             lockPtr->name,
+             isWrite ? "writing" : "reading",
+             result);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The thread is dying.  Make sure no reader-writer locks are held by it.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ThreadDeathCleanUp
+(
+    void* contextPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    rwlock_ThreadRec_t* perThreadRecPtr = contextPtr;
+
+    if (le_dls_IsEmpty(&perThreadRecPtr->heldList) == false)
+    {
+        le_dls_Link_t* linkPtr = le_dls_Peek(&perThreadRecPtr->heldList);
+        while (linkPtr != NULL)
+        {
+            Hold_t* holdPtr = CONTAINER_OF(linkPtr, Hold_t, link);
+
+            LE_EMERG("Thread died while holding reader-writer lock '%s' for %s.",
+                     holdPtr->lockPtr->name,
+                     holdPtr->isWrite ? "writing" : "reading");
+
+            linkPtr = le_dls_PeekNext(&perThreadRecPtr->heldList, linkPtr);
+        }
+        LE_FATAL("Killing process to prevent future deadlock.");
+    }
+
+    if (perThreadRecPtr->waitingOnRwLock != NULL)
+    {
+        RemoveFromWaitingList(perThreadRecPtr->waitingOnRwLock, perThreadRecPtr);
+    }
+}
+
+
+// ==============================
+//  INTRA-FRAMEWORK FUNCTIONS
+// ==============================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the reader-writer lock list; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* rwlock_GetRwLockList
+(
+    void
+)
+{
+    return (&RwLockList);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the reader-writer lock list change counter; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t** rwlock_GetRwLockListChgCntRef
+(
+    void
+)
+{
+    return (&RwLockListChangeCountRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Reader-Writer Lock module.
+ *
+ * This function must be called exactly once at process start-up before any other reader-writer
+ * lock module functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void rwlock_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RwLockPoolRef = le_mem_CreatePool("rwlock", sizeof(RwLock_t));
+    le_mem_ExpandPool(RwLockPoolRef, DEFAULT_POOL_SIZE);
+
+    HoldPoolRef = le_mem_CreatePool("rwlockHold", sizeof(Hold_t));
+    le_mem_ExpandPool(HoldPoolRef, DEFAULT_HOLD_POOL_SIZE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the thread-specific parts of the reader-writer lock module.
+ *
+ * This function must be called once by each thread when it starts, before any other reader-writer
+ * lock module functions are called by that thread.
+ */
+//--------------------------------------------------------------------------------------------------
+void rwlock_ThreadInit
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    rwlock_ThreadRec_t* perThreadRecPtr = thread_GetRwLockRecPtr();
+
+    perThreadRecPtr->waitingOnRwLock = NULL;
+    perThreadRecPtr->isWaitingToWrite = false;
+    perThreadRecPtr->waitingListLink = LE_DLS_LINK_INIT;
+    perThreadRecPtr->heldList = LE_DLS_LIST_INIT;
+
+    // Register a thread destructor function to check that everything has been cleaned up properly.
+    (void)le_thread_AddDestructor(ThreadDeathCleanUp, perThreadRecPtr);
+}
+
+
+// ==============================
+//  PUBLIC API FUNCTIONS
+// ==============================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a reader-writer lock.
+ *
+ * @return  Returns a reference to the lock.
+ *
+ * @note Terminates the process on failure, no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_rwlock_Ref_t le_rwlock_Create
+(
+    const char* nameStr     ///< [in] Name of the lock.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Allocate a RwLock object and initialize it.
+    RwLock_t* lockPtr = le_mem_ForceAlloc(RwLockPoolRef);
+    lockPtr->rwLockListLink = LE_DLS_LINK_INIT;
+    lockPtr->writerRecPtr = NULL;
+    lockPtr->readerCount = 0;
+    lockPtr->waitingList = LE_DLS_LIST_INIT;
+    pthread_mutex_init(&lockPtr->waitingListMutex, NULL);  // Default attributes = Fast mutex.
+    lockPtr->readWaitCount = 0;
+    lockPtr->writeWaitCount = 0;
+    if (le_utf8_Copy(lockPtr->name, nameStr, sizeof(lockPtr->name), NULL) == LE_OVERFLOW)
+    {
+        LE_WARN("Reader-writer lock name '%s' truncated to '%s'.", nameStr, lockPtr->name);
+    }
+
+    // Make the underlying POSIX rwlock stop letting readers in while a writer is waiting.
+    pthread_rwlockattr_t lockAttrs;
+    pthread_rwlockattr_init(&lockAttrs);
+    int result = pthread_rwlockattr_setkind_np(&lockAttrs,
+                                               PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    if (result != 0)
+    {
+        LE_FATAL("Failed to make reader-writer lock '%s' prefer writers. Error code %d.",
+                 lockPtr->name,
+                 result);
+    }
+    pthread_rwlock_init(&lockPtr->rwLock, &lockAttrs);
+    pthread_rwlockattr_destroy(&lockAttrs);
+
+    // Add the lock to the process's RwLock List.
+    LOCK_RWLOCK_LIST();
+    le_dls_Queue(&RwLockList, &lockPtr->rwLockListLink);
+    RwLockListChangeCount++;
+    UNLOCK_RWLOCK_LIST();
+
+    return lockPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a reader-writer lock.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_Delete
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((lockRef->writerRecPtr != NULL)
+        || (__atomic_load_n(&lockRef->readerCount, __ATOMIC_RELAXED) != 0))
+    {
+        LE_FATAL("Reader-writer lock '%s' deleted while still locked!", lockRef->name);
+    }
+
+    LOCK_WAITING_LIST(lockRef);
+    bool isWaitedOn = !le_dls_IsEmpty(&lockRef->waitingList);
+    UNLOCK_WAITING_LIST(lockRef);
+
+    if (isWaitedOn)
+    {
+        LE_FATAL("Reader-writer lock '%s' deleted while threads are still waiting for it!",
+                 lockRef->name);
+    }
+
+    // Remove the RwLock object from the RwLock List.
+    LOCK_RWLOCK_LIST();
+    le_dls_Remove(&RwLockList, &lockRef->rwLockListLink);
+    RwLockListChangeCount++;
+    UNLOCK_RWLOCK_LIST();
+
+    pthread_rwlock_destroy(&lockRef->rwLock);
+    pthread_mutex_destroy(&lockRef->waitingListMutex);
+
+    // Release the RwLock object back to the RwLock Pool.
+    le_mem_Release(lockRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock a reader-writer lock for reading, waiting if another thread holds it for writing or is
+ * waiting to.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_ReadLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Lock(lockRef, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Try to lock a reader-writer lock for reading.
+ *
+ * @return
+ *  - LE_OK if the lock was locked for reading.
+ *  - LE_WOULD_BLOCK if another thread holds the lock for writing or is waiting to.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_rwlock_TryReadLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return TryLock(lockRef, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock a reader-writer lock for writing, waiting until no other thread holds it.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_WriteLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Lock(lockRef, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Try to lock a reader-writer lock for writing.
+ *
+ * @return
+ *  - LE_OK if the lock was locked for writing.
+ *  - LE_WOULD_BLOCK if another thread holds the lock.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_rwlock_TryWriteLock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return TryLock(lockRef, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unlock a reader-writer lock that the calling thread holds, for reading or for writing.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_rwlock_Unlock
+(
+    le_rwlock_Ref_t lockRef ///< [in] Lock reference.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    rwlock_ThreadRec_t* perThreadRecPtr = thread_GetRwLockRecPtr();
+    Hold_t* holdPtr = FindHold(perThreadRecPtr, lockRef);
+
+    if (holdPtr == NULL)
+    {
+        LE_FATAL("Thread '%s' attempted to unlock reader-writer lock '%s' without holding it.",
+                 le_thread_GetMyName(),
+                 lockRef->name);
+    }
+
+    if (holdPtr->isWrite)
+    {
+        lockRef->writerRecPtr = NULL;
+    }
+    else
+    {
+        __atomic_sub_fetch(&lockRef->readerCount, 1, __ATOMIC_RELAXED);
+    }
+
+    le_dls_Remove(&perThreadRecPtr->heldList, &holdPtr->link);
+    le_mem_Release(holdPtr);
+
+    int result = pthread_rwlock_unlock(&lockRef->rwLock);
+    if (result != 0)
+    {
+        LE_FATAL("Thread '%s' failed to unlock reader-writer lock '%s'. Error code %d.",
+                 le_thread_GetMyName(),
+                 lockRef->name,
+                 result);
+    }
+}
@@ -0,0 +1,107 @@
+/** @file rwlock.h
+ *
+ * Reader-writer lock module's intra-framework header file.  This file exposes type definitions and
+ * function interfaces to other modules inside the framework implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
+ */
+
+#ifndef LEGATO_SRC_RWLOCK_H_INCLUDE_GUARD
+#define LEGATO_SRC_RWLOCK_H_INCLUDE_GUARD
+
+#include "limit.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reader-Writer Lock Thread Record.
+ *
+ * This structure is to be stored as a member in each Thread object.  The function
+ * thread_GetRwLockRecPtr() is used by the reader-writer lock module to fetch a pointer to one of
+ * these records for a given thread.
+ *
+ * @warning No code outside of the reader-writer lock module (rwlock.c) should ever access the
+ *          members of this structure.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_rwlock_Ref_t waitingOnRwLock;    ///< Reference to the lock that is being waited on.
+    bool            isWaitingToWrite;   ///< true if waiting to write, false if waiting to read.
+    le_dls_Link_t   waitingListLink;    ///< Used to link into RwLock object's waiting list.
+    le_dls_List_t   heldList;           ///< Hold records of the locks this thread holds (newest
+                                        ///< first).
+}
+rwlock_ThreadRec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reader-Writer Lock object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_rwlock
+{
+    le_dls_Link_t       rwLockListLink;     ///< Used to link onto the process's RwLock List.
+    rwlock_ThreadRec_t* writerRecPtr;       ///< Record of the thread holding the lock for writing.
+    size_t              readerCount;        ///< Number of threads holding the lock for reading.
+    le_dls_List_t       waitingList;        ///< List of threads waiting for this lock.
+    pthread_mutex_t     waitingListMutex;   ///< Pthreads mutex used to protect the waiting list.
+    size_t              readWaitCount;      ///< Number of times a reader has had to wait.
+    size_t              writeWaitCount;     ///< Number of times a writer has had to wait.
+    pthread_rwlock_t    rwLock;             ///< Pthreads rwlock that does the real work.
+    char                name[LIMIT_MAX_RWLOCK_NAME_BYTES]; ///< The name of the lock (UTF8 string).
+}
+RwLock_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the reader-writer lock list; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* rwlock_GetRwLockList
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Exposing the reader-writer lock list change counter; mainly for the Inspect tool.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t** rwlock_GetRwLockListChgCntRef
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Reader-Writer Lock module.
+ *
+ * This function must be called exactly once at process start-up before any other reader-writer
+ * lock module functions are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void rwlock_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the thread-specific parts of the reader-writer lock module.
+ *
+ * This function must be called once by each thread when it starts, before any other reader-writer
+ * lock module functions are called by that thread.
+ */
+//--------------------------------------------------------------------------------------------------
+void rwlock_ThreadInit
+(
+    void
+);
+
+
+#endif /* LEGATO_SRC_RWLOCK_H_INCLUDE_GUARD */
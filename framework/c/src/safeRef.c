@@ -9,6 +9,24 @@
  *       processor architectures.  Also, if they try to use a memory address as a Safe Ref,
  *       the memory address is guaranteed to be detected as an invalid Safe Reference.
  *
+ * Each Reference Map is an array of slots.  A Safe Reference holds the index of the slot that it
+ * maps through, and the generation number that the slot had when the reference was created:
+ *
+ * @verbatim
+   | generation (GENERATION_BITS) | slot index (INDEX_BITS) | 1 |
+   @endverbatim
+ *
+ * A slot's generation number is incremented each time the slot is re-used, so a lookup is just an
+ * array index and a comparison with the whole reference that is stored in the slot, and a
+ * reference that has been deleted stays invalid even after its slot has been re-used.  A free
+ * slot holds its last reference with the low bit cleared, which never matches a Safe Reference.
+ *
+ * Free slots are re-used in the order they were freed, so that generation numbers go up as slowly
+ * as possible.  Each map starts its generation numbers at a different value, which makes it
+ * unlikely that a reference from one map is valid in another.  A slot whose generation number
+ * would wrap around to the one it started at is retired instead of being re-used, so a Safe
+ * Reference is never handed out twice by the same map.
+ *
  * Copyright (C) Sierra Wireless Inc. Use of this work is subject to license.
  */
 
@@ -26,20 +44,75 @@
 /// @todo Make this configurable.
 #define DEFAULT_MAP_POOL_SIZE 10
 
+/// Number of bits of a Safe Reference that hold the slot index.  Limits the number of Safe
+/// References that can exist in a map at any one time.  On 32-bit systems this leaves 15 bits
+/// for the generation number.
+#define INDEX_BITS      ((sizeof(uintptr_t) > 4) ? 32 : 16)
+
+/// Largest possible slot index, which is also the mask for the index bits.
+#define MAX_INDEX       (((uintptr_t)1 << INDEX_BITS) - 1)
+
+/// Number of bits of a Safe Reference that hold the generation number.
+#define GENERATION_BITS (sizeof(uintptr_t) * 8 - 1 - INDEX_BITS)
+
+/// Mask for the generation number bits.
+#define GENERATION_MASK (((uintptr_t)1 << GENERATION_BITS) - 1)
+
+/// Value of nextFree and freeTail that means "no slot".
+#define NO_SLOT         SIZE_MAX
+
 /// Name used for diagnostics.
 static const char ModuleName[] = "ref";
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A slot in a Reference Map.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uintptr_t   ref;        ///< Safe Reference that maps through this slot, or (if the slot is
+                            ///  free) the last one that did, with the low bit cleared.
+    union
+    {
+        void*   ptr;        ///< Pointer that the Safe Reference maps to (if in use).
+        size_t  nextFree;   ///< Index of the next free slot (if free), or NO_SLOT.
+    };
+}
+Slot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Iterator over a Reference Map.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_ref_Iter
+{
+    le_ref_MapRef_t mapRef;     ///< The map being iterated over.
+    size_t          index;      ///< Index of the current slot, or NO_SLOT if not started.
+    bool            isDone;     ///< true if the iterator has gone past the end of the map.
+}
+Iter_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Reference Map object, which stores mappings from Safe References to pointers.
- * The actual mapping is held in a hashmap.
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct le_ref_Map
 {
-    ssize_t             nextRefNum;     ///< The next Safe Reference value to be assigned.
+    Slot_t*             slotsPtr;       ///< The slot array.
+    size_t              slotCount;      ///< Number of slots in the array.
+    size_t              usedCount;      ///< Number of slots that have ever been used.  All slots
+                                        ///  from this index on are unused.
+    size_t              freeHead;       ///< First slot to re-use, or NO_SLOT.
+    size_t              freeTail;       ///< Last slot to re-use, or NO_SLOT.
+    uintptr_t           firstGeneration;///< Generation number of a slot's first Safe Reference.
 
-    le_hashmap_Ref_t    referenceMap;    ///< HashMap of Mapping objects.
+    Iter_t              iterator;       ///< The map's iterator.
 
     char          name[MAX_NAME_BYTES]; ///< The name of the map (for diagnostics).
 }
@@ -53,46 +126,144 @@ Map_t;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t MapPool;
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generation number to start the next map's slots at (before masking with GENERATION_MASK).
+ *
+ * Maps can be created by any thread, so this is only ever updated atomically.
+ */
+//--------------------------------------------------------------------------------------------------
+static uintptr_t NextFirstGeneration = 1;
+
+
 // =============================================
 //  PRIVATE FUNCTIONS
 // =============================================
 
 //--------------------------------------------------------------------------------------------------
 /**
- * SafeRef hashing function.
- *
- * @return  Returns the SafeRef itself as it can used as a hash
+ * Builds a Safe Reference.
  *
+ * @return  The Safe Reference.
  */
 //--------------------------------------------------------------------------------------------------
-
-size_t hashSafeRef
+static inline uintptr_t MakeRef
 (
-    const void* safeRefPtr    ///< [in] Safe Ref to be hashed
+    size_t      index,      ///< [in] Slot index.
+    uintptr_t   generation  ///< [in] Generation number.
 )
 {
-    // Return the key value itself.
-    return (size_t) safeRefPtr;
+    return (generation << (INDEX_BITS + 1)) | ((uintptr_t)index << 1) | 1;
 }
 
+
 //--------------------------------------------------------------------------------------------------
 /**
- * SafeRef equality function.
+ * Gets the generation number that a slot will have when it is next re-used.
  *
- * @return  Returns true if the integers are equal, false otherwise
+ * @return  The generation number.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uintptr_t NextGeneration
+(
+    const Slot_t* slotPtr   ///< [in] The slot.
+)
+{
+    // Skip generation 0, so that no Safe Reference is a small number.
+    uintptr_t generation = ((slotPtr->ref >> (INDEX_BITS + 1)) + 1) & GENERATION_MASK;
+    if (generation == 0)
+    {
+        generation = 1;
+    }
+
+    return generation;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the slot that a Safe Reference maps through, if it is a valid Safe Reference in this map.
  *
+ * @return  Pointer to the slot, or NULL.
  */
 //--------------------------------------------------------------------------------------------------
+static inline Slot_t* FindSlot
+(
+    le_ref_MapRef_t mapRef, ///< [in] The Reference Map.
+    void*           safeRef ///< [in] The Safe Reference.
+)
+{
+    uintptr_t ref = (uintptr_t)safeRef;
+    size_t index = (ref >> 1) & MAX_INDEX;
+
+    // Even values (including NULL) never match a slot's reference, so they don't need checking.
+    if (index < mapRef->usedCount)
+    {
+        Slot_t* slotPtr = &mapRef->slotsPtr[index];
 
-bool equalsSafeRef
+        if (slotPtr->ref == ref)
+        {
+            return slotPtr;
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a slot for a new Safe Reference, re-using a free one if there is one.
+ *
+ * @return  Index of the slot.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t AllocSlot
 (
-    const void* firstSafeRef,    ///< [in] First SafeRef for comparing.
-    const void* secondSafeRef    ///< [in] Second SafeRef for comparing.
+    le_ref_MapRef_t mapRef  ///< [in] The Reference Map.
 )
 {
-    return firstSafeRef == secondSafeRef;
+    size_t index = mapRef->freeHead;
+
+    if (index != NO_SLOT)
+    {
+        Slot_t* slotPtr = &mapRef->slotsPtr[index];
+
+        mapRef->freeHead = slotPtr->nextFree;
+        if (mapRef->freeHead == NO_SLOT)
+        {
+            mapRef->freeTail = NO_SLOT;
+        }
+
+        slotPtr->ref = MakeRef(index, NextGeneration(slotPtr));
+
+        return index;
+    }
+
+    if (mapRef->usedCount == mapRef->slotCount)
+    {
+        LE_FATAL_IF(mapRef->slotCount > MAX_INDEX,
+                    "Too many Safe References in Map '%s'.", mapRef->name);
+
+        size_t newCount = mapRef->slotCount * 2;
+        if (newCount > MAX_INDEX + 1)
+        {
+            newCount = MAX_INDEX + 1;
+        }
+
+        mapRef->slotsPtr = realloc(mapRef->slotsPtr, newCount * sizeof(Slot_t));
+        LE_ASSERT(mapRef->slotsPtr != NULL);
+        mapRef->slotCount = newCount;
+    }
+
+    index = mapRef->usedCount++;
+    mapRef->slotsPtr[index].ref = MakeRef(index, mapRef->firstGeneration);
+
+    return index;
 }
 
+
 // =============================================
 //  PROTECTED (Intra-Module) FUNCTIONS
 // =============================================
@@ -149,15 +320,36 @@ le_ref_MapRef_t le_ref_CreateMap
         LE_WARN("Map name '%s%s' truncated to '%s'.", ModuleName, name, mapPtr->name);
     }
 
-    /// @todo Make this a random number so that using a reference from another Map is unlikely to
-    ///       get by undetected.
-    mapPtr->nextRefNum = 0x10000001; // Use only odd numbers.
+    // The map grows if more references than this are needed, so this is only a hint.
+    if (maxRefs == 0)
+    {
+        maxRefs = 1;
+    }
+    else if (maxRefs > MAX_INDEX + 1)
+    {
+        maxRefs = MAX_INDEX + 1;
+    }
+
+    mapPtr->slotsPtr = malloc(maxRefs * sizeof(Slot_t));
+    LE_ASSERT(mapPtr->slotsPtr != NULL);
+    mapPtr->slotCount = maxRefs;
+    mapPtr->usedCount = 0;
+    mapPtr->freeHead = NO_SLOT;
+    mapPtr->freeTail = NO_SLOT;
+
+    /// @todo Make this a random number so that using a reference from another Map is even less
+    ///       likely to get by undetected.
+    // Step by a large odd number, so that maps made one after the other start far apart.
+    mapPtr->firstGeneration =
+        __atomic_fetch_add(&NextFirstGeneration, 0x9E3779B9u, __ATOMIC_RELAXED) & GENERATION_MASK;
+    if (mapPtr->firstGeneration == 0)
+    {
+        mapPtr->firstGeneration = 1;
+    }
 
-    mapPtr->referenceMap = le_hashmap_Create(mapPtr->name,
-                                             maxRefs,
-                                             hashSafeRef,
-                                             equalsSafeRef
-                                            );
+    mapPtr->iterator.mapRef = mapPtr;
+    mapPtr->iterator.index = NO_SLOT;
+    mapPtr->iterator.isDone = false;
 
     return mapPtr;
 }
@@ -178,13 +370,13 @@ void* le_ref_CreateRef
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ssize_t thisRef = mapRef->nextRefNum;
+    // AllocSlot() may move the slot array, so look it up afterwards.
+    size_t index = AllocSlot(mapRef);
+    Slot_t* slotPtr = &mapRef->slotsPtr[index];
 
-    le_hashmap_Put(mapRef->referenceMap, (const void*)(thisRef), ptr);
+    slotPtr->ptr = ptr;
 
-    mapRef->nextRefNum += 2; // Increment the reference number for next time, keeping it odd.
-
-    return (void *)thisRef;
+    return (void*)slotPtr->ref;
 }
 
 
@@ -204,7 +396,9 @@ void* le_ref_Lookup
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return le_hashmap_Get(mapRef->referenceMap, safeRef);
+    Slot_t* slotPtr = FindSlot(mapRef, safeRef);
+
+    return (slotPtr == NULL) ? NULL : slotPtr->ptr;
 }
 
 
@@ -220,10 +414,37 @@ void le_ref_DeleteRef
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (le_hashmap_Remove(mapRef->referenceMap, safeRef) == NULL)
+    Slot_t* slotPtr = FindSlot(mapRef, safeRef);
+
+    if (slotPtr == NULL)
     {
         LE_ERROR("Deleting non-existent Safe Reference %p from Map '%s'.", safeRef, mapRef->name);
+        return;
+    }
+
+    size_t index = slotPtr - mapRef->slotsPtr;
+
+    // Clearing the low bit invalidates the reference, but keeps its generation number for when
+    // the slot is re-used.
+    slotPtr->ref &= ~(uintptr_t)1;
+    slotPtr->nextFree = NO_SLOT;
+
+    // Re-using the slot again would hand out the same references it has already handed out, so
+    // leave it free but out of the free list for good.
+    if (NextGeneration(slotPtr) == mapRef->firstGeneration)
+    {
+        return;
+    }
+
+    if (mapRef->freeTail == NO_SLOT)
+    {
+        mapRef->freeHead = index;
+    }
+    else
+    {
+        mapRef->slotsPtr[mapRef->freeTail].nextFree = index;
     }
+    mapRef->freeTail = index;
 }
 
 
@@ -243,7 +464,10 @@ le_ref_IterRef_t le_ref_GetIterator
     le_ref_MapRef_t mapRef ///< [in] Reference to the map.
 )
 {
-    return (le_ref_IterRef_t)le_hashmap_GetIterator(mapRef->referenceMap);
+    mapRef->iterator.index = NO_SLOT;
+    mapRef->iterator.isDone = false;
+
+    return &mapRef->iterator;
 }
 
 
@@ -261,7 +485,52 @@ le_result_t le_ref_NextNode
     le_ref_IterRef_t iteratorRef ///< [IN] Reference to the iterator.
 )
 {
-    return le_hashmap_NextNode((le_hashmap_It_Ref_t)iteratorRef);
+    le_ref_MapRef_t mapRef = iteratorRef->mapRef;
+
+    if (iteratorRef->isDone)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    // NO_SLOT + 1 wraps around to the first slot.
+    size_t index;
+    for (index = iteratorRef->index + 1; index < mapRef->usedCount; index++)
+    {
+        if ((mapRef->slotsPtr[index].ref & 1) != 0)
+        {
+            iteratorRef->index = index;
+            return LE_OK;
+        }
+    }
+
+    iteratorRef->index = NO_SLOT;
+    iteratorRef->isDone = true;
+
+    return LE_NOT_FOUND;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the slot the iterator is currently pointing at, if it is in use.
+ *
+ * @return  Pointer to the slot, or NULL.
+ */
+//--------------------------------------------------------------------------------------------------
+static Slot_t* IteratorSlot
+(
+    le_ref_IterRef_t iteratorRef ///< [IN] Reference to the iterator.
+)
+{
+    if (iteratorRef->index == NO_SLOT)
+    {
+        return NULL;
+    }
+
+    Slot_t* slotPtr = &iteratorRef->mapRef->slotsPtr[iteratorRef->index];
+
+    // The current reference may have been deleted since the iterator moved to it.
+    return ((slotPtr->ref & 1) != 0) ? slotPtr : NULL;
 }
 
 
@@ -280,7 +549,9 @@ const void* le_ref_GetSafeRef
     le_ref_IterRef_t iteratorRef ///< [IN] Reference to the iterator.
 )
 {
-    return le_hashmap_GetKey((le_hashmap_It_Ref_t)iteratorRef);
+    Slot_t* slotPtr = IteratorSlot(iteratorRef);
+
+    return (slotPtr == NULL) ? NULL : (const void*)slotPtr->ref;
 }
 
 
@@ -299,5 +570,7 @@ void* le_ref_GetValue
     le_ref_IterRef_t iteratorRef ///< [IN] Reference to the iterator.
 )
 {
-    return le_hashmap_GetValue((le_hashmap_It_Ref_t)iteratorRef);
+    Slot_t* slotPtr = IteratorSlot(iteratorRef);
+
+    return (slotPtr == NULL) ? NULL : slotPtr->ptr;
 }
@@ -132,6 +132,20 @@
 #define CFG_NODE_LIMIT_MAX_FILE_DESCRIPTORS             "maxFileDescriptors"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The name of the node in the config tree that contains the list of CPUs (e.g., "0-1,3") that an
+ * application's or a process's threads are allowed to run on.
+ *
+ * At the application level this is applied through the application's cpuset cgroup.  A process's
+ * own list is applied as the process's CPU affinity, and must be a subset of its application's.
+ *
+ * If this entry in the config tree is missing or is empty, the threads can run on any CPU.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_NODE_CPU_SET                                "cpuSet"
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Resource limit defaults.
@@ -161,6 +175,14 @@
 #define MAX_LIMIT_FILE_DESCRIPTORS                      1024
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes in a configured list of CPUs.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_CPU_SET_BYTES                               256
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the resource limit value from the config tree.
@@ -307,6 +329,99 @@ static void SetRLimit
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts a list of CPUs (e.g., "0-1,3") to a CPU set.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the list is malformed or names a CPU that can't be in a CPU set.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ParseCpuList
+(
+    const char* cpuListPtr,         // The list of CPUs.
+    cpu_set_t* cpuSetPtr            // The set to fill in.
+)
+{
+    CPU_ZERO(cpuSetPtr);
+
+    const char* itemPtr = cpuListPtr;
+
+    while (true)
+    {
+        char* endPtr;
+
+        errno = 0;
+        unsigned long first = strtoul(itemPtr, &endPtr, 10);
+        unsigned long last = first;
+
+        if ((endPtr == itemPtr) || (errno != 0))
+        {
+            return LE_FAULT;
+        }
+
+        if (*endPtr == '-')
+        {
+            itemPtr = endPtr + 1;
+            last = strtoul(itemPtr, &endPtr, 10);
+
+            if ((endPtr == itemPtr) || (errno != 0))
+            {
+                return LE_FAULT;
+            }
+        }
+
+        if ((last < first) || (last >= CPU_SETSIZE))
+        {
+            return LE_FAULT;
+        }
+
+        for (; first <= last; first++)
+        {
+            CPU_SET(first, cpuSetPtr);
+        }
+
+        if (*endPtr == '\0')
+        {
+            return LE_OK;
+        }
+
+        if (*endPtr != ',')
+        {
+            return LE_FAULT;
+        }
+
+        itemPtr = endPtr + 1;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the CPUs that a process's threads can run on.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetCpuAffinity
+(
+    pid_t pid,                      // The pid of the process.
+    const char* cpuListPtr          // The list of CPUs.
+)
+{
+    cpu_set_t cpuSet;
+
+    if (ParseCpuList(cpuListPtr, &cpuSet) != LE_OK)
+    {
+        LE_ERROR("Configured %s '%s' is invalid.", CFG_NODE_CPU_SET, cpuListPtr);
+        return;
+    }
+
+    LE_INFO("Setting CPU affinity of process %d to CPUs %s.", pid, cpuListPtr);
+    LE_ERROR_IF(sched_setaffinity(pid, sizeof(cpuSet), &cpuSet) == -1,
+                "Could not set CPU affinity of process %d to CPUs %s.  %m.", pid, cpuListPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets the resource limits for the specified application.
@@ -327,6 +442,12 @@ le_result_t resLim_SetAppLimits
     cgrp_SubSys_t subSys = 0;
     while (subSys < CGRP_NUM_SUBSYSTEMS)
     {
+        if (!cgrp_IsSubSysAvailable(subSys))
+        {
+            subSys++;
+            continue;
+        }
+
         switch(cgrp_Create(subSys, appNamePtr))
         {
             case LE_FAULT:
@@ -373,6 +494,26 @@ le_result_t resLim_SetAppLimits
         return LE_FAULT;
     }
 
+    // Set the CPUs the app can run on.  Without a cpuset cgroup, resLim_SetProcLimits() sets the
+    // affinity of each of the app's processes instead.
+    char cpuSet[MAX_CPU_SET_BYTES] = "";
+
+    if (le_cfg_GetString(appCfg, CFG_NODE_CPU_SET, cpuSet, sizeof(cpuSet), "") != LE_OK)
+    {
+        LE_ERROR("Configured %s is too long.", CFG_NODE_CPU_SET);
+        le_cfg_CancelTxn(appCfg);
+        return LE_FAULT;
+    }
+
+    if ( (cpuSet[0] != '\0') && cgrp_IsSubSysAvailable(CGRP_SUBSYS_CPUSET) )
+    {
+        if (cgrp_cpuset_SetCpus(appNamePtr, cpuSet) != LE_OK)
+        {
+            le_cfg_CancelTxn(appCfg);
+            return LE_FAULT;
+        }
+    }
+
     le_cfg_CancelTxn(appCfg);
     return LE_OK;
 }
@@ -394,6 +535,7 @@ le_result_t resLim_SetProcLimits
 )
 {
     pid_t pid = proc_GetPID(procRef);
+    char cpuSet[MAX_CPU_SET_BYTES] = "";
 
     // Create an iterator for this process.
     if (proc_GetConfigPath(procRef) != NULL)
@@ -413,6 +555,10 @@ le_result_t resLim_SetProcLimits
         SetRLimit(pid, procCfg, CFG_NODE_LIMIT_MAX_FILE_DESCRIPTORS, RLIMIT_NOFILE,
                   DEFAULT_LIMIT_MAX_FILE_DESCRIPTORS);
 
+        LE_ERROR_IF(le_cfg_GetString(procCfg, CFG_NODE_CPU_SET, cpuSet, sizeof(cpuSet), "")
+                        != LE_OK,
+                    "Configured %s is too long.", CFG_NODE_CPU_SET);
+
         // Set the application limits.
         //
         // @note Even though these are application limits they still need to be set for the process
@@ -431,6 +577,14 @@ le_result_t resLim_SetProcLimits
         SetRLimit(pid, procCfg, CFG_NODE_LIMIT_MAX_QUEUED_SIGNALS, RLIMIT_SIGPENDING,
                   DEFAULT_LIMIT_MAX_QUEUED_SIGNALS);
 
+        // Without a cpuset cgroup the app's CPUs have to be applied to each process.
+        if ( (cpuSet[0] == '\0') && !cgrp_IsSubSysAvailable(CGRP_SUBSYS_CPUSET) )
+        {
+            LE_ERROR_IF(le_cfg_GetString(procCfg, CFG_NODE_CPU_SET, cpuSet, sizeof(cpuSet), "")
+                            != LE_OK,
+                        "Configured %s is too long.", CFG_NODE_CPU_SET);
+        }
+
         le_cfg_CancelTxn(procCfg);
     }
     else
@@ -470,12 +624,19 @@ le_result_t resLim_SetProcLimits
     for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
     {
         // Do not add realtime processes to the cpu cgroup.
-        if ( (subSys != CGRP_SUBSYS_CPU) || (!proc_IsRealtime(procRef)) )
+        if (   cgrp_IsSubSysAvailable(subSys)
+            && ( (subSys != CGRP_SUBSYS_CPU) || (!proc_IsRealtime(procRef)) ) )
         {
             LE_ASSERT(cgrp_AddProc(subSys, proc_GetAppName(procRef), pid) == LE_OK);
         }
     }
 
+    // Set the CPU affinity last because moving a process into a cpuset resets it.
+    if (cpuSet[0] != '\0')
+    {
+        SetCpuAffinity(pid, cpuSet);
+    }
+
     return LE_OK;
 }
 
@@ -498,6 +659,11 @@ void resLim_CleanupApp
     cgrp_SubSys_t subSys = 0;
     for (; subSys < CGRP_NUM_SUBSYSTEMS; subSys++)
     {
+        if (!cgrp_IsSubSysAvailable(subSys))
+        {
+            continue;
+        }
+
         LE_ERROR_IF(cgrp_Delete(subSys, appNamePtr) != LE_OK,
                     "Could not remove %s cgroup for application '%s'.",
                     cgrp_SubSysName(subSys), appNamePtr);
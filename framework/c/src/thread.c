@@ -238,6 +238,10 @@ static void CleanupThread
         le_mem_Release(destructorObjPtr);
     }
 
+    // Delete any coroutines that are left.  This has to be done before the event loop and the
+    // timers are destructed, because coroutines can have FD Monitors and timers of their own.
+    coro_DestructThread();
+
     // Destruct the event loop.
     event_DestructThread();
 
@@ -271,17 +275,60 @@ void thread_InitThread
     void
 )
 {
+    // Remember the kernel's ID for this thread, so its CPU usage can be found in /proc.
+    // le_thread_SetCpuAffinity() reads it from other threads, so it's set under the lock.
+    thread_Obj_t* threadPtr = pthread_getspecific(ThreadLocalDataKey);
+    Lock();
+    threadPtr->tid = syscall(SYS_gettid);
+    Unlock();
+
     // Init the thread's mutex tracking structures.
     mutex_ThreadInit();
 
     // Init the thread's mutex.
     sem_ThreadInit();
 
+    // Init the thread's reader-writer lock record.
+    rwlock_ThreadInit();
+
     // Init the event loop.
     event_InitThread();
 
     // Init the thread's timer resources
     timer_InitThread();
+
+    // Init the thread's coroutine record.
+    coro_InitThread();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts a CPU bit mask into a CPU set, leaving out CPUs that the system doesn't have.
+ *
+ * @return The number of CPUs in the set.
+ */
+//--------------------------------------------------------------------------------------------------
+static int MaskToCpuSet
+(
+    uint64_t    cpuMask,    ///< [in] Bit n set = CPU n.
+    cpu_set_t*  cpuSetPtr   ///< [out] The CPU set.
+)
+{
+    int numCpus = get_nprocs_conf();
+    int cpu;
+
+    CPU_ZERO(cpuSetPtr);
+
+    for (cpu = 0; (cpu < numCpus) && (cpu < 64); cpu++)
+    {
+        if (cpuMask & ((uint64_t)1 << cpu))
+        {
+            CPU_SET(cpu, cpuSetPtr);
+        }
+    }
+
+    return CPU_COUNT(cpuSetPtr);
 }
 
 
@@ -363,6 +410,30 @@ static void* PThreadStartRoutine
         }
     }
 
+    // Publish the kernel thread ID and pick up the CPU mask in one go, so that a concurrent
+    // le_thread_SetCpuAffinity() either leaves its mask here for this thread to apply, or sees the
+    // ID and applies the mask itself.
+    Lock();
+    threadPtr->tid = syscall(SYS_gettid);
+    uint64_t cpuMask = threadPtr->cpuMask;
+    Unlock();
+
+    // If the thread was restricted to some of the CPUs before it was started, apply that now.
+    if (cpuMask != 0)
+    {
+        cpu_set_t cpuSet;
+        MaskToCpuSet(cpuMask, &cpuSet);
+
+        if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+        {
+            LE_CRIT("Failed to set CPU affinity to 0x%" PRIx64 " (%m).", cpuMask);
+        }
+        else
+        {
+            LE_DEBUG("Set CPU affinity to 0x%" PRIx64 ".", cpuMask);
+        }
+    }
+
     // Perform thread specific init
     thread_InitThread();
 
@@ -426,9 +497,12 @@ static thread_Obj_t* CreateThread
     threadPtr->context = context;
     threadPtr->destructorList = LE_DLS_LIST_INIT;
     threadPtr->threadHandle = 0;
+    threadPtr->tid = 0;
+    threadPtr->cpuMask = 0;
 
     memset(&threadPtr->mutexRec, 0, sizeof(threadPtr->mutexRec));
     memset(&threadPtr->semaphoreRec, 0, sizeof(threadPtr->semaphoreRec));
+    memset(&threadPtr->rwLockRec, 0, sizeof(threadPtr->rwLockRec));
     memset(&threadPtr->eventRec, 0, sizeof(threadPtr->eventRec));
     memset(&threadPtr->timerRec, 0, sizeof(threadPtr->timerRec));
 
@@ -598,6 +672,20 @@ sem_ThreadRec_t* thread_GetSemaphoreRecPtr
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's reader-writer lock record.
+ */
+//--------------------------------------------------------------------------------------------------
+rwlock_ThreadRec_t* thread_GetRwLockRecPtr
+(
+    void
+)
+{
+    return &((GetCurrentThreadPtr())->rwLockRec);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the calling thread's event record pointer.
@@ -648,6 +736,20 @@ timer_ThreadRec_t* thread_GetTimerRecPtr
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's coroutine record pointer.
+ */
+//--------------------------------------------------------------------------------------------------
+coro_ThreadRec_t* thread_GetCoroRecPtr
+(
+    void
+)
+{
+    return &((GetCurrentThreadPtr())->coroRec);
+}
+
+
 // ===================================
 //  PUBLIC API FUNCTIONS
 // ===================================
@@ -788,6 +890,86 @@ le_result_t le_thread_SetStackSize
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the CPUs that a thread is allowed to run on.  Bit n of the mask stands for CPU n.
+ *
+ * If the thread hasn't been started yet, the affinity is applied by the thread itself when it
+ * starts, and a failure at that point is logged.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_OUT_OF_RANGE if none of the CPUs in the mask exist or are available to the process.
+ *      - LE_FAULT if the thread's affinity couldn't be changed for some other reason.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_thread_SetCpuAffinity
+(
+    le_thread_Ref_t     thread,     ///< [in]
+    uint64_t            cpuMask     ///< [in] Bit mask of the CPUs that the thread may run on.
+)
+{
+    cpu_set_t cpuSet;
+
+    if (MaskToCpuSet(cpuMask, &cpuSet) == 0)
+    {
+        return LE_OUT_OF_RANGE;
+    }
+
+    Lock();
+
+    thread_Obj_t* threadPtr = le_ref_Lookup(ThreadRefMap, thread);
+
+    LE_FATAL_IF(threadPtr == NULL, "Invalid thread reference %p.", thread);
+
+    // The kernel thread ID is set (under the lock) by the thread itself when it starts running.
+    // Until then, leave the mask for the thread to pick up.  Never pass a zero ID to
+    // sched_setaffinity(), because that would change the calling thread's affinity instead.
+    pid_t tid = threadPtr->tid;
+
+    if (tid == 0)
+    {
+        threadPtr->cpuMask = cpuMask;
+
+        Unlock();
+
+        return LE_OK;
+    }
+
+    Unlock();
+
+    int result = 0;
+
+    if (sched_setaffinity(tid, sizeof(cpuSet), &cpuSet) != 0)
+    {
+        result = errno;
+    }
+
+    switch (result)
+    {
+        case 0:
+            // Look the thread up again, in case it ended while the lock wasn't held.
+            Lock();
+            threadPtr = le_ref_Lookup(ThreadRefMap, thread);
+            if (threadPtr != NULL)
+            {
+                threadPtr->cpuMask = cpuMask;
+            }
+            Unlock();
+            return LE_OK;
+
+        case EINVAL:
+            return LE_OUT_OF_RANGE;
+
+        default:
+            LE_ERROR("Failed to set CPU affinity of thread '%s' (%s).",
+                     threadPtr->name,
+                     strerror(result));
+            return LE_FAULT;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Makes a thread "joinable", meaning that when it finishes, it will remain in existence until
@@ -13,7 +13,9 @@
 #include "eventLoop.h"
 #include "mutex.h"
 #include "semaphores.h"
+#include "rwlock.h"
 #include "timer.h"
+#include "coro.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -55,10 +57,14 @@ typedef struct
     le_dls_List_t           destructorList; ///< The destructor list for this thread.
     mutex_ThreadRec_t       mutexRec;       ///< The thread's mutex record.
     sem_ThreadRec_t         semaphoreRec;   ///< the thread's semaphore record.
+    rwlock_ThreadRec_t      rwLockRec;      ///< The thread's reader-writer lock record.
     event_PerThreadRec_t    eventRec;       ///< The thread's event record.
     pthread_t               threadHandle;   ///< The pthreads thread handle.
+    pid_t                   tid;            ///< Kernel thread ID (0 until the thread has started).
+    uint64_t                cpuMask;        ///< CPUs the thread may run on (0 = not restricted).
     le_thread_Ref_t         safeRef;        ///< Safe reference for this object.
     timer_ThreadRec_t       timerRec;       ///< The thread's timer record.
+    coro_ThreadRec_t        coroRec;        ///< The thread's coroutine record.
 }
 thread_Obj_t;
 
@@ -133,6 +139,17 @@ sem_ThreadRec_t* thread_GetSemaphoreRecPtr
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's reader-writer lock record.
+ */
+//--------------------------------------------------------------------------------------------------
+rwlock_ThreadRec_t* thread_GetRwLockRecPtr
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the calling thread's event record.
@@ -166,4 +183,15 @@ timer_ThreadRec_t* thread_GetTimerRecPtr
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's coroutine record.
+ */
+//--------------------------------------------------------------------------------------------------
+coro_ThreadRec_t* thread_GetCoroRecPtr
+(
+    void
+);
+
+
 #endif  // THREAD_INCLUDE_GUARD
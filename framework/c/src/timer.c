@@ -32,6 +32,16 @@ static size_t TimerListChangeCount = 0;
 static size_t* TimerListChangeCountRef = &TimerListChangeCount;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of timerFD expiries handled by all threads, and number of timerFD expiries that were
+ * avoided by expiring timers with different expiry times together.  Updated atomically.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t WakeupCount = 0;
+static uint64_t SavedWakeupCount = 0;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The default timer memory pool.  Initialized in timer_Init().
@@ -110,7 +120,8 @@ static Timer_t* CreateTimer
     timerPtr->interval = (le_clk_Time_t){0, 0};
     timerPtr->repeatCount = 1;
     timerPtr->contextPtr = NULL;
-    timerPtr->link = LE_DLS_LINK_INIT;
+    timerPtr->slack = (le_clk_Time_t){0, 0};
+    le_rbtree_InitNode(&timerPtr->treeNode, &timerPtr->expiryTime);
     timerPtr->isActive = false;
     timerPtr->expiryTime = (le_clk_Time_t){0, 0};
     timerPtr->expiryCount = 0;
@@ -123,50 +134,54 @@ static Timer_t* CreateTimer
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add the timer record to the given list, sorted according to the timer value
+ * Compare the expiry times of two timers, for the active timer tree.
+ *
+ * @return
+ *      Less than, equal to, or greater than zero if the first time is earlier than, the same as,
+ *      or later than the second time.
  */
 //--------------------------------------------------------------------------------------------------
-static void AddToTimerList
+static int CompareExpiryTimes
 (
-    le_dls_List_t* listPtr,               ///< [IN] The list to add to.
-    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+    const void* time1Ptr,                 ///< [IN] The first expiry time.
+    const void* time2Ptr                  ///< [IN] The second expiry time.
 )
 {
-    Timer_t* timerPtr;
-    le_dls_Link_t* linkPtr;
+    const le_clk_Time_t* t1Ptr = time1Ptr;
+    const le_clk_Time_t* t2Ptr = time2Ptr;
 
-    if ( newTimerPtr->isActive )
+    if (le_clk_GreaterThan(*t1Ptr, *t2Ptr))
     {
-        LE_ERROR("Timer '%s' is already active", newTimerPtr->name);
-        return;
+        return 1;
     }
-
-    // Get the start of the list
-    linkPtr = le_dls_Peek(listPtr);
-
-    // Find the timer whose expiry time is greater than the new timer.
-    while ( linkPtr != NULL )
+    if (le_clk_GreaterThan(*t2Ptr, *t1Ptr))
     {
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        return -1;
+    }
+    return 0;
+}
 
-        if ( le_clk_GreaterThan(timerPtr->expiryTime, newTimerPtr->expiryTime) )
-            break;
 
-        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the timer record to the given thread's active timers, sorted according to the timer value.
+ * Timers with the same expiry time stay in the order they were added.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToTimerList
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+)
+{
+    if ( newTimerPtr->isActive )
+    {
+        LE_ERROR("Timer '%s' is already active", newTimerPtr->name);
+        return;
     }
 
     TimerListChangeCount++;
-    if (linkPtr == NULL)
-    {
-        // The list is either empty, or the new timer has the largest expiry time.
-        // In either case, add the new timer to the end of the list.
-        le_dls_Queue(listPtr, &newTimerPtr->link);
-    }
-    else
-    {
-        // Found a timer with larger expiry time; insert the new timer before it.
-        le_dls_AddBefore(listPtr, linkPtr, &newTimerPtr->link);
-    }
+    le_rbtree_Insert(&threadRecPtr->activeTimerTree, &newTimerPtr->treeNode);
 
     // The new timer is now on the active list
     newTimerPtr->isActive = true;
@@ -175,24 +190,24 @@ static void AddToTimerList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Peek at the first timer from the given timer list
+ * Peek at the first timer from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the first timer
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
 static Timer_t* PeekFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
 )
 {
-    le_dls_Link_t* linkPtr;
+    le_rbtree_Node_t* nodePtr;
 
-    linkPtr = le_dls_Peek(listPtr);
-    if (linkPtr != NULL)
+    nodePtr = le_rbtree_GetFirst(&threadRecPtr->activeTimerTree);
+    if (nodePtr != NULL)
     {
-        return ( CONTAINER_OF(linkPtr, Timer_t, link) );
+        return ( CONTAINER_OF(nodePtr, Timer_t, treeNode) );
     }
     return NULL;
 }
@@ -200,48 +215,44 @@ static Timer_t* PeekFromTimerList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Pop the first timer from the given timer list
+ * Pop the first timer from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the first timer
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
 static Timer_t* PopFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
 )
 {
-    le_dls_Link_t* linkPtr;
-    Timer_t* timerPtr;
+    Timer_t* timerPtr = PeekFromTimerList(threadRecPtr);
 
-    linkPtr = le_dls_Pop(listPtr);
-    if (linkPtr != NULL)
+    if (timerPtr != NULL)
     {
         TimerListChangeCount++;
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        le_rbtree_Remove(&threadRecPtr->activeTimerTree, &timerPtr->treeNode);
 
         // The timer is no longer on the active list
         timerPtr->isActive = false;
-
-        return timerPtr;
     }
-    return NULL;
+    return timerPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove the timer from the given timer list
+ * Remove the timer from the given thread's active timers
  *
  * @return
  *      - LE_OK on success
- *      - LE_FAULT if the timer was not in the list
+ *      - LE_FAULT if the timer was not active
  */
 //--------------------------------------------------------------------------------------------------
 static le_result_t RemoveFromTimerList
 (
-    le_dls_List_t* listPtr,             ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] The thread's timer record.
     Timer_t* timerPtr                   ///< [IN] The timer to remove
 )
 {
@@ -253,7 +264,7 @@ static le_result_t RemoveFromTimerList
     // Remove the timer from the active list
     timerPtr->isActive = false;
     TimerListChangeCount++;
-    le_dls_Remove(listPtr, &timerPtr->link);
+    le_rbtree_Remove(&threadRecPtr->activeTimerTree, &timerPtr->treeNode);
 
     return LE_OK;
 }
@@ -271,31 +282,30 @@ static le_result_t RemoveFromTimerList
 //--------------------------------------------------------------------------------------------------
 static void PrintTimerList
 (
-    le_dls_List_t* listPtr               ///< [IN] The list to print.
+    le_rbtree_Tree_t* treePtr            ///< [IN] The active timer tree to print.
 )
 {
     Timer_t* timerPtr;
-    le_dls_Link_t* linkPtr;
+    le_rbtree_Node_t* nodePtr;
 
     // Get the start of the list
-    linkPtr = le_dls_Peek(listPtr);
+    nodePtr = le_rbtree_GetFirst(treePtr);
     LE_DEBUG("Timer List:");
 
     // Print out all the timers on the list
-    while ( linkPtr != NULL )
+    while ( nodePtr != NULL )
     {
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        timerPtr = CONTAINER_OF(nodePtr, Timer_t, treeNode);
 
-        LE_PRINT_VALUE("%p", linkPtr)
+        LE_PRINT_VALUE("%p", nodePtr)
         LE_PRINT_VALUE("%p", timerPtr->handlerRef);
         LE_PRINT_VALUE("%li", timerPtr->interval.sec);
         LE_PRINT_VALUE("%li", timerPtr->interval.usec);
         LE_PRINT_VALUE("%p", timerPtr->repeatCount);
-        LE_PRINT_VALUE("%p", timerPtr->link);
         LE_PRINT_VALUE("%li", timerPtr->expiryTime.sec);
         LE_PRINT_VALUE("%li", timerPtr->expiryTime.usec);
 
-        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+        nodePtr = le_rbtree_GetNext(treePtr, nodePtr);
     }
 }
 #endif
@@ -308,17 +318,18 @@ static void PrintTimerList
 //--------------------------------------------------------------------------------------------------
 static void RestartTimerFD
 (
-    Timer_t* timerPtr      ///< [IN] (Re)start this timer object
+    Timer_t* timerPtr,          ///< [IN] (Re)start this timer object
+    le_clk_Time_t expiryTime    ///< [IN] Time to expire at; at or after the timer's expiry time.
 )
 {
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
     struct itimerspec timerInterval;
 
-    // Set the timer to expire at the expiry time of the given timer
+    // Set the timer to expire at the given time.
     // There is a small possibility that the time set now will be slightly in the past
     // at this point but it will just cause the timerfd to expire immediately.
-    timerInterval.it_value.tv_sec = timerPtr->expiryTime.sec;
-    timerInterval.it_value.tv_nsec = timerPtr->expiryTime.usec * 1000;
+    timerInterval.it_value.tv_sec = expiryTime.sec;
+    timerInterval.it_value.tv_nsec = expiryTime.usec * 1000;
 
     // The timerFD does not repeat
     timerInterval.it_interval.tv_sec = 0;
@@ -335,6 +346,7 @@ static void RestartTimerFD
 
     // Store the timer for future reference
     threadRecPtr->firstTimerPtr = timerPtr;
+    threadRecPtr->armedTime = expiryTime;
 }
 
 
@@ -371,6 +383,83 @@ static void StopTimerFD
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Work out when the timerFD should expire.  This is the latest time that is within the slack of
+ * every active timer that would have expired by then, so that as many timers as possible are
+ * expired together, and none of them is late by more than its slack.
+ *
+ * @return
+ *      The time for the timerFD to expire at.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t GetCoalescedExpiryTime
+(
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] The thread's timer record.
+    Timer_t* firstTimerPtr              ///< [IN] The first active timer.
+)
+{
+    le_clk_Time_t expiryTime = le_clk_Add(firstTimerPtr->expiryTime, firstTimerPtr->slack);
+    le_rbtree_Node_t* nodePtr = le_rbtree_GetNext(&threadRecPtr->activeTimerTree,
+                                                  &firstTimerPtr->treeNode);
+
+    // Timers that expire after the time found so far can't make it any earlier, and the timers
+    // are in order of expiry time, so stop at the first of those.
+    while (nodePtr != NULL)
+    {
+        Timer_t* timerPtr = CONTAINER_OF(nodePtr, Timer_t, treeNode);
+
+        if (le_clk_GreaterThan(timerPtr->expiryTime, expiryTime))
+        {
+            break;
+        }
+
+        le_clk_Time_t latestTime = le_clk_Add(timerPtr->expiryTime, timerPtr->slack);
+        if (le_clk_GreaterThan(expiryTime, latestTime))
+        {
+            expiryTime = latestTime;
+        }
+
+        nodePtr = le_rbtree_GetNext(&threadRecPtr->activeTimerTree, nodePtr);
+    }
+
+    return expiryTime;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make sure the timerFD is set for the current active timers: (re)start it if the first timer or
+ * the time to expire at has changed, or stop it if there are no active timers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmTimerFD
+(
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
+)
+{
+    Timer_t* firstTimerPtr = PeekFromTimerList(threadRecPtr);
+
+    if (firstTimerPtr == NULL)
+    {
+        if (threadRecPtr->firstTimerPtr != NULL)
+        {
+            StopTimerFD();
+        }
+        return;
+    }
+
+    le_clk_Time_t expiryTime = GetCoalescedExpiryTime(threadRecPtr, firstTimerPtr);
+
+    if ( (threadRecPtr->firstTimerPtr != firstTimerPtr) ||
+         le_clk_GreaterThan(threadRecPtr->armedTime, expiryTime) ||
+         le_clk_GreaterThan(expiryTime, threadRecPtr->armedTime) )
+    {
+        RestartTimerFD(firstTimerPtr, expiryTime);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process a single expired timer
@@ -404,8 +493,8 @@ static void ProcessExpiredTimer
         expiredTimer->expiryTime = le_clk_Add(expiredTimer->expiryTime, expiredTimer->interval);
 
         // Add the timer back to the timer list
-        AddToTimerList(&threadRecPtr->activeTimerList, expiredTimer);
-        //PrintTimerList(&threadRecPtr->activeTimerList);
+        AddToTimerList(threadRecPtr, expiredTimer);
+        //PrintTimerList(&threadRecPtr->activeTimerTree);
     }
 
     // call the optional expiry handler function
@@ -457,7 +546,7 @@ static void TimerFdHandler
     LE_ERROR_IF(expiry != 1,  "On TimerFD read, unexpected expiry=%u", (unsigned int)expiry);
 
     // Pop off the first timer from the active list, and make sure it is the expected timer.
-    firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PopFromTimerList(threadRecPtr);
     LE_ASSERT( threadRecPtr->firstTimerPtr == firstTimerPtr );
 
     // Need to reset the expected timer, in case processing the current timer will cause the same
@@ -466,39 +555,38 @@ static void TimerFdHandler
     threadRecPtr->firstTimerPtr = NULL;
 
     // It is the expected timer so process it.
+    le_clk_Time_t lastExpiryTime = firstTimerPtr->expiryTime;
+    uint64_t savedWakeups = 0;
     ProcessExpiredTimer(firstTimerPtr);
 
     // Check if there are any other timers that have since expired, pop them off the
     // list and process them.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PeekFromTimerList(threadRecPtr);
     while ( firstTimerPtr != NULL &&
             le_clk_GreaterThan(le_clk_GetRelativeTime(), firstTimerPtr->expiryTime) )
     {
+        // Each different expiry time handled here would otherwise have needed its own wakeup.
+        if (le_clk_GreaterThan(firstTimerPtr->expiryTime, lastExpiryTime))
+        {
+            lastExpiryTime = firstTimerPtr->expiryTime;
+            savedWakeups++;
+        }
+
         // Pop off the timer and process it
-        firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PopFromTimerList(threadRecPtr);
         ProcessExpiredTimer(firstTimerPtr);
 
         // Try the next timer on the list
-        firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PeekFromTimerList(threadRecPtr);
     }
 
-    // While processing expired timers in the above loop, it is possible that a timer was started,
-    // put in the active list, and expired before the loop completed. If the active list is empty,
-    // but the timerFD is still running, then we need to stop it.
-    if ( (firstTimerPtr == NULL) && ( threadRecPtr->firstTimerPtr != NULL ) )
-    {
-        StopTimerFD();
-    }
+    __atomic_fetch_add(&WakeupCount, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&SavedWakeupCount, savedWakeups, __ATOMIC_RELAXED);
 
-    // If the next timer on the active list exists, then if the timerFD is not running, or it is
-    // running a timer that is no longer at the beginning of the active list, then (re)start the
-    // timerFD.  The timerFD could be running here, if the expiry handler started a new timer,
-    // although it might no longer be at the beginning of the list, if we had multiple timers
-    // expire, and one of them is a repetitive timer.
-    if ( (firstTimerPtr != NULL) && ( threadRecPtr->firstTimerPtr != firstTimerPtr ) )
-    {
-        RestartTimerFD(firstTimerPtr);
-    }
+    // While processing expired timers in the above loop, timers may have been started or stopped,
+    // and the timerFD may or may not be running.  Make sure it is set for the first active timer,
+    // if any.
+    ArmTimerFD(threadRecPtr);
 }
 
 // =============================================
@@ -594,8 +682,9 @@ void timer_InitThread
     timer_ThreadRec_t* recPtr = thread_GetTimerRecPtr();
 
     recPtr->timerFD = -1;
-    recPtr->activeTimerList = LE_DLS_LIST_INIT;
+    le_rbtree_InitTree(&recPtr->activeTimerTree, CompareExpiryTimes);
     recPtr->firstTimerPtr = NULL;
+    recPtr->armedTime = (le_clk_Time_t){0, 0};
 }
 
 
@@ -632,19 +721,14 @@ void timer_DestructThread
         fd_Close(threadRecPtr->timerFD);
     }
 
-    le_dls_Link_t* linkPtr;
+    le_rbtree_Node_t* nodePtr;
 
-    // Get the start of the list
-    linkPtr = le_dls_Peek(&threadRecPtr->activeTimerList);
-
-    // Release the timer list
-    while ( linkPtr != NULL )
+    // Release the active timers
+    while ( (nodePtr = le_rbtree_GetFirst(&threadRecPtr->activeTimerTree)) != NULL )
     {
-        Timer_t* timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
-
-        linkPtr = le_dls_PeekNext(&threadRecPtr->activeTimerList, linkPtr);
+        Timer_t* timerPtr = CONTAINER_OF(nodePtr, Timer_t, treeNode);
 
-        le_dls_Remove(&threadRecPtr->activeTimerList, &timerPtr->link);
+        le_rbtree_Remove(&threadRecPtr->activeTimerTree, &timerPtr->treeNode);
 
         le_mem_Release(timerPtr);
     }
@@ -805,6 +889,44 @@ le_result_t le_timer_SetMsInterval
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the timer slack, in milliseconds
+ *
+ * The timer may expire up to this much later than its interval, so that it can expire at the same
+ * time as other timers in the same thread instead of needing a wakeup of its own.  The default is
+ * 0, so that the timer expires as close to its interval as possible.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BUSY if the timer is currently running
+ *
+ * @note
+ *      If an invalid timer object is given, the process exits
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_timer_SetSlack
+(
+    le_timer_Ref_t timerRef,     ///< [IN] Set slack for this timer object.
+    uint32_t slack               ///< [IN] Timer slack in milliseconds.
+)
+{
+    Timer_t* timerPtr = le_ref_Lookup(SafeRefMap, timerRef);
+    LE_FATAL_IF(timerPtr == NULL, "Invalid timer reference %p.", timerRef);
+
+    if ( timerPtr->isActive )
+    {
+        return LE_BUSY;
+    }
+
+    time_t seconds = slack / 1000;
+    timerPtr->slack.sec = seconds;
+    timerPtr->slack.usec = (slack - (seconds * 1000)) * 1000;
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set how many times the timer will repeat
@@ -957,7 +1079,6 @@ le_result_t le_timer_Start
     TRACE("Starting timer '%s'", timerPtr->name);
 
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
-    Timer_t* firstTimerPtr;
 
     // todo: verify that the minimum number of fields have been appropriately initialized
 
@@ -990,19 +1111,13 @@ le_result_t le_timer_Start
     // Add the timer to the timer list. This is the only place we reset the expiry count.
     timerPtr->expiryCount = 0;
     timerPtr->expiryTime = le_clk_Add(le_clk_GetRelativeTime(), timerPtr->interval);
-    AddToTimerList(&threadRecPtr->activeTimerList, timerPtr);
-    //PrintTimerList(&threadRecPtr->activeTimerList);
-
-    // Get the first timer from the active list. This is needed to determine whether the timerFD
-    // needs to be restarted, in case the new timer was put at the beginning of the list.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    AddToTimerList(threadRecPtr, timerPtr);
+    //PrintTimerList(&threadRecPtr->activeTimerTree);
 
     // If the timerFD is not running, or it is running a timer that is no longer at the beginning
-    // of the active list, then (re)start the timerFD.
-    if ( threadRecPtr->firstTimerPtr != firstTimerPtr )
-    {
-        RestartTimerFD(firstTimerPtr);
-    }
+    // of the active list, or the new timer's slack needs it to expire sooner, then (re)start the
+    // timerFD.
+    ArmTimerFD(threadRecPtr);
 
     return LE_OK;
 }
@@ -1037,11 +1152,10 @@ le_result_t le_timer_Stop
 
     // Timer is valid and active; proceed with stopping it.
     le_result_t result;
-    Timer_t* firstTimerPtr;
 
     timer_ThreadRec_t* threadRecPtr = thread_GetTimerRecPtr();
 
-    result = RemoveFromTimerList(&threadRecPtr->activeTimerList, timerPtr);
+    result = RemoveFromTimerList(threadRecPtr, timerPtr);
     if (result == LE_OK)
     {
         // If the timer was at the start of the active list, then restart the timerFD using the next
@@ -1049,18 +1163,7 @@ le_result_t le_timer_Stop
         if (timerPtr == threadRecPtr->firstTimerPtr)
         {
             TRACE("Stopping the first active timer");
-            threadRecPtr->firstTimerPtr = NULL;
-
-            firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
-            if (firstTimerPtr != NULL)
-            {
-                RestartTimerFD(firstTimerPtr);
-            }
-            else
-            {
-                StopTimerFD();
-
-            }
+            ArmTimerFD(threadRecPtr);
         }
     }
 
@@ -1114,3 +1217,26 @@ bool le_timer_IsRunning
     return timerPtr->isActive;
 }
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of timer wakeups in this process, and how many wakeups were saved by expiring
+ * timers with different expiry times together (because of timer slack, or because the event loop
+ * was busy).  Either pointer may be NULL.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_timer_GetWakeupCounts
+(
+    uint64_t* wakeupCountPtr,       ///< [OUT] Number of timer wakeups.
+    uint64_t* savedWakeupCountPtr   ///< [OUT] Number of timer wakeups saved.
+)
+{
+    if (wakeupCountPtr != NULL)
+    {
+        *wakeupCountPtr = __atomic_load_n(&WakeupCount, __ATOMIC_RELAXED);
+    }
+    if (savedWakeupCountPtr != NULL)
+    {
+        *savedWakeupCountPtr = __atomic_load_n(&SavedWakeupCount, __ATOMIC_RELAXED);
+    }
+}
@@ -25,9 +25,11 @@ typedef struct
     le_clk_Time_t interval;                  ///< Interval
     uint32_t repeatCount;                    ///< Number of times the timer will repeat
     void* contextPtr;                        ///< Context for timer expiry
+    le_clk_Time_t slack;                     ///< How late the timer may expire, so that it can
+                                             ///  share a timerFD expiry with other timers
 
     // Internal State
-    le_dls_Link_t link;                      ///< For adding to the timer list
+    le_rbtree_Node_t treeNode;               ///< For adding to the active timer tree
     bool isActive;                           ///< Is the timer active/running?
     le_clk_Time_t expiryTime;                ///< Time at which the timer should expire
     uint32_t expiryCount;                    ///< Number of times the counter has expired
@@ -50,11 +52,15 @@ Timer_t;
 typedef struct
 {
     int timerFD;                        ///< System timer used by the thread.
-    le_dls_List_t activeTimerList;      ///< Linked list of running legato timers for this thread
-    Timer_t* firstTimerPtr;             ///< Pointer to the timer on the active list that is
-                                        ///  associated with the currently running timerFD,
-                                        ///  or NULL if there are no timers on the active list.
-                                        ///  This is normally the first timer on the list.
+    le_rbtree_Tree_t activeTimerTree;   ///< Running legato timers for this thread, in order of
+                                        ///  expiry time.
+    Timer_t* firstTimerPtr;             ///< Pointer to the active timer that is associated with
+                                        ///  the currently running timerFD, or NULL if there are
+                                        ///  no active timers.  This is normally the first timer
+                                        ///  in the tree.
+    le_clk_Time_t armedTime;            ///< Time the timerFD is set to expire at, if it is
+                                        ///  running.  Later than the first timer's expiry time if
+                                        ///  slack lets more timers expire at the same time.
 
 }
 timer_ThreadRec_t;
@@ -715,6 +715,61 @@ le_result_t unixSocket_ReceiveDataMsg
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of the data payload of the next message waiting to be received on a connected
+ * Unix domain datagram or sequenced-packet socket, without removing the message from the socket.
+ *
+ * @return
+ * - LE_OK if successful.
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ *
+ * @note A size of zero is reported if the next message has no data payload, or if the connection
+ *       has closed in a way that can only be detected by receiving.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_PeekMsgSize
+(
+    int localSocketFd,      ///< [IN] fd of local socket that will be used to receive the message.
+    size_t* dataSizePtr     ///< [OUT] Ptr to where the size of the data payload will be put.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ssize_t bytesWaiting;
+
+    // MSG_TRUNC makes recv() report the real size of the message, even though nothing is copied.
+    do
+    {
+        bytesWaiting = recv(localSocketFd, NULL, 0, MSG_PEEK | MSG_TRUNC);
+    }
+    while ((bytesWaiting < 0) && (errno == EINTR));
+
+    if (bytesWaiting < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        else if (errno == ECONNRESET)
+        {
+            return LE_CLOSED;
+        }
+        else
+        {
+            LE_ERROR("recv() failed with errno %d (%m).", errno);
+            return LE_FAULT;
+        }
+    }
+
+    *dataSizePtr = bytesWaiting;
+
+    return LE_OK;
+}
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
@@ -518,6 +518,28 @@ le_result_t unixSocket_ReceiveDataMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the size of the data payload of the next message waiting to be received on a connected
+ * Unix domain datagram or sequenced-packet socket, without removing the message from the socket.
+ *
+ * @return
+ * - LE_OK if successful.
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ *
+ * @note A size of zero is reported if the next message has no data payload, or if the connection
+ *       has closed in a way that can only be detected by receiving.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_PeekMsgSize
+(
+    int localSocketFd,      ///< [IN] fd of local socket that will be used to receive the message.
+    size_t* dataSizePtr     ///< [OUT] Ptr to where the size of the data payload will be put.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
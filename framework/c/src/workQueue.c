@@ -0,0 +1,607 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file workQueue.c Implementation of the Work Queue API.
+ *
+ * Each worker has a fixed-size Chase-Lev work-stealing deque ("Dynamic Circular Work-Stealing
+ * Deque", Chase and Lev, 2005, with the memory orderings from Lê et al., 2013).  Only the worker
+ * that owns a deque pushes and takes jobs at its bottom end.  Other workers steal from its top
+ * end with a compare-and-swap.  Jobs that are submitted by threads outside of the pool, or that
+ * don't fit in a full deque, go on the Injection Queue, which is a mutex-protected list.
+ *
+ * The number of jobs that have been submitted but not yet picked up by a worker is kept in
+ * PendingJobs.  A worker that finds nothing to do sleeps on a condition variable until
+ * PendingJobs is non-zero.  To avoid taking the mutex on every submission, submitters only
+ * signal the condition variable when IdleWorkers says that a worker might be sleeping.  Both
+ * counters are updated with sequentially consistent atomics, so either the submitter sees the
+ * worker's increment of IdleWorkers (and signals it), or the worker sees the submitter's increment
+ * of PendingJobs (and doesn't go to sleep).
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.  Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "workQueue.h"
+#include "limit.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of jobs that fit in a worker's deque.  Must be a power of two.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEQUE_SIZE          256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of workers.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_WORKERS         64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Environment variable that sets the number of workers.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_WORKERS_ENV_VAR "LE_WORKQUEUE_THREADS"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Job object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;                     ///< Used to link into the Injection Queue.
+    le_workQueue_JobFunc_t jobFunc;         ///< Function to run in a worker.
+    le_workQueue_JobFunc_t completionFunc;  ///< Function to call when done (NULL if none).
+    void* contextPtr;                       ///< Value to pass to both functions.
+    le_thread_Ref_t threadRef;              ///< Thread to call completionFunc in (NULL if the
+                                            ///  job was submitted by a worker).
+}
+Job_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Worker object, including its deque.
+ *
+ * top and bottom only ever increase (apart from take's temporary decrement of bottom), and index
+ * the jobs array modulo DEQUE_SIZE.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int64_t top;                    ///< Index of the oldest job (stolen from here).
+    int64_t bottom;                 ///< Index after the newest job (pushed and taken here).
+    Job_t* jobs[DEQUE_SIZE];        ///< The jobs.
+    unsigned int randomSeed;        ///< For picking which worker to steal from.
+}
+Worker_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Job objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t JobPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The workers.  Allocated when the pool is started.
+ */
+//--------------------------------------------------------------------------------------------------
+static Worker_t* Workers;
+static size_t NumWorkers;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Used to start the pool the first time it's needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_once_t StartOnce = PTHREAD_ONCE_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread-local data key used to find the calling worker's Worker object (NULL if the calling
+ * thread isn't a worker).
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t WorkerKey;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Injection Queue, and the mutex and condition variable that workers sleep on.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t WorkAvailable = PTHREAD_COND_INITIALIZER;
+static le_sls_List_t InjectionQueue = LE_SLS_LIST_INIT;
+static size_t InjectionQueueLength;     ///< Read without the mutex, to skip empty checks.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of jobs that are waiting to be picked up, and number of workers that are (or are about
+ * to be) waiting for them.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t PendingJobs;
+static size_t IdleWorkers;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pushes a job onto the bottom of the calling worker's deque.
+ *
+ * @return false if the deque is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PushJob
+(
+    Worker_t* workerPtr,
+    Job_t* jobPtr
+)
+{
+    int64_t bottom = __atomic_load_n(&workerPtr->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&workerPtr->top, __ATOMIC_ACQUIRE);
+
+    if (bottom - top >= DEQUE_SIZE)
+    {
+        return false;
+    }
+
+    __atomic_store_n(&workerPtr->jobs[bottom & (DEQUE_SIZE - 1)], jobPtr, __ATOMIC_RELAXED);
+
+    // Publish the job (and its contents) to thieves.
+    __atomic_store_n(&workerPtr->bottom, bottom + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes the newest job from the bottom of the calling worker's deque.
+ *
+ * @return The job, or NULL if the deque is empty (or the last job was stolen).
+ */
+//--------------------------------------------------------------------------------------------------
+static Job_t* TakeJob
+(
+    Worker_t* workerPtr
+)
+{
+    int64_t bottom = __atomic_load_n(&workerPtr->bottom, __ATOMIC_RELAXED) - 1;
+
+    // Claim the bottom job before looking at top, so a thief can't take it at the same time
+    // without one of us noticing.
+    __atomic_store_n(&workerPtr->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    int64_t top = __atomic_load_n(&workerPtr->top, __ATOMIC_RELAXED);
+    Job_t* jobPtr = NULL;
+
+    if (top <= bottom)
+    {
+        jobPtr = __atomic_load_n(&workerPtr->jobs[bottom & (DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+
+        if (top == bottom)
+        {
+            // Last job: race any thieves for it.
+            if (!__atomic_compare_exchange_n(&workerPtr->top, &top, top + 1, false,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            {
+                jobPtr = NULL;
+            }
+            __atomic_store_n(&workerPtr->bottom, bottom + 1, __ATOMIC_RELAXED);
+        }
+    }
+    else
+    {
+        // Empty.
+        __atomic_store_n(&workerPtr->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+    return jobPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Steals the oldest job from the top of another worker's deque.
+ *
+ * @return The job, or NULL if the deque is empty or another thread got there first.
+ */
+//--------------------------------------------------------------------------------------------------
+static Job_t* StealJob
+(
+    Worker_t* victimPtr
+)
+{
+    int64_t top = __atomic_load_n(&victimPtr->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t bottom = __atomic_load_n(&victimPtr->bottom, __ATOMIC_ACQUIRE);
+
+    if (top >= bottom)
+    {
+        return NULL;
+    }
+
+    Job_t* jobPtr = __atomic_load_n(&victimPtr->jobs[top & (DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+
+    if (!__atomic_compare_exchange_n(&victimPtr->top, &top, top + 1, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+    {
+        return NULL;
+    }
+
+    return jobPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes the oldest job from the Injection Queue.
+ *
+ * @return The job, or NULL if the queue is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static Job_t* PopInjectedJob
+(
+    void
+)
+{
+    if (__atomic_load_n(&InjectionQueueLength, __ATOMIC_RELAXED) == 0)
+    {
+        return NULL;
+    }
+
+    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+
+    le_sls_Link_t* linkPtr = le_sls_Pop(&InjectionQueue);
+    if (linkPtr != NULL)
+    {
+        __atomic_sub_fetch(&InjectionQueueLength, 1, __ATOMIC_RELAXED);
+    }
+
+    LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+
+    return (linkPtr == NULL ? NULL : CONTAINER_OF(linkPtr, Job_t, link));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks everywhere for a job for a worker to run: its own deque, then the Injection Queue, then
+ * the other workers' deques (starting from a random one).
+ *
+ * @return The job, or NULL if none was found.
+ */
+//--------------------------------------------------------------------------------------------------
+static Job_t* FindJob
+(
+    Worker_t* workerPtr
+)
+{
+    Job_t* jobPtr = TakeJob(workerPtr);
+
+    if (jobPtr == NULL)
+    {
+        jobPtr = PopInjectedJob();
+    }
+
+    if ((jobPtr == NULL) && (NumWorkers > 1))
+    {
+        size_t start = rand_r(&workerPtr->randomSeed) % NumWorkers;
+        size_t i;
+
+        for (i = 0; (i < NumWorkers) && (jobPtr == NULL); i++)
+        {
+            Worker_t* victimPtr = &Workers[(start + i) % NumWorkers];
+
+            if (victimPtr != workerPtr)
+            {
+                jobPtr = StealJob(victimPtr);
+            }
+        }
+    }
+
+    if (jobPtr != NULL)
+    {
+        __atomic_sub_fetch(&PendingJobs, 1, __ATOMIC_SEQ_CST);
+    }
+
+    return jobPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Puts a worker to sleep until there are jobs waiting to be picked up.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WaitForJobs
+(
+    void
+)
+{
+    LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+
+    __atomic_add_fetch(&IdleWorkers, 1, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(&PendingJobs, __ATOMIC_SEQ_CST) == 0)
+    {
+        LE_ASSERT(pthread_cond_wait(&WorkAvailable, &Mutex) == 0);
+    }
+
+    __atomic_sub_fetch(&IdleWorkers, 1, __ATOMIC_SEQ_CST);
+
+    LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calls a job's completion function and releases the job.  Runs in the submitting thread, as a
+ * queued function.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompleteJob
+(
+    void* param1Ptr,    ///< The job.
+    void* param2Ptr     ///< Not used.
+)
+{
+    Job_t* jobPtr = param1Ptr;
+
+    jobPtr->completionFunc(jobPtr->contextPtr);
+
+    le_mem_Release(jobPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs a job in a worker, then sends it back to be completed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunJob
+(
+    Job_t* jobPtr
+)
+{
+    jobPtr->jobFunc(jobPtr->contextPtr);
+
+    if (jobPtr->completionFunc == NULL)
+    {
+        le_mem_Release(jobPtr);
+    }
+    else if (jobPtr->threadRef == NULL)
+    {
+        CompleteJob(jobPtr, NULL);
+    }
+    else
+    {
+        le_event_QueueFunctionToThread(jobPtr->threadRef, CompleteJob, jobPtr, NULL);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WorkerMain
+(
+    void* contextPtr    ///< The Worker object.
+)
+{
+    Worker_t* workerPtr = contextPtr;
+
+    LE_ASSERT(pthread_setspecific(WorkerKey, workerPtr) == 0);
+
+    for (;;)
+    {
+        Job_t* jobPtr = FindJob(workerPtr);
+
+        if (jobPtr != NULL)
+        {
+            RunJob(jobPtr);
+        }
+        else if (__atomic_load_n(&PendingJobs, __ATOMIC_SEQ_CST) == 0)
+        {
+            WaitForJobs();
+        }
+        else
+        {
+            // A job is on its way into a queue, or was just taken by someone else who hasn't
+            // decremented PendingJobs yet.
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of workers to start.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetNumWorkersToStart
+(
+    void
+)
+{
+    long numWorkers = sysconf(_SC_NPROCESSORS_ONLN);
+    const char* envStr = getenv(NUM_WORKERS_ENV_VAR);
+
+    if (envStr != NULL)
+    {
+        char* endPtr;
+
+        errno = 0;
+        long value = strtol(envStr, &endPtr, 10);
+
+        if ((errno != 0) || (endPtr == envStr) || (*endPtr != '\0') || (value < 1))
+        {
+            LE_ERROR("Ignoring invalid %s value '%s'.", NUM_WORKERS_ENV_VAR, envStr);
+        }
+        else
+        {
+            numWorkers = value;
+        }
+    }
+
+    if (numWorkers < 1)
+    {
+        numWorkers = 1;
+    }
+    else if (numWorkers > MAX_WORKERS)
+    {
+        LE_WARN("Limiting the Work Queue to %d workers.", MAX_WORKERS);
+        numWorkers = MAX_WORKERS;
+    }
+
+    return numWorkers;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts the workers.  Called once, the first time the pool is needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartWorkers
+(
+    void
+)
+{
+    size_t i;
+
+    NumWorkers = GetNumWorkersToStart();
+    Workers = calloc(NumWorkers, sizeof(Worker_t));
+    LE_ASSERT(Workers != NULL);
+
+    LE_DEBUG("Starting %zu Work Queue workers.", NumWorkers);
+
+    for (i = 0; i < NumWorkers; i++)
+    {
+        char name[LIMIT_MAX_THREAD_NAME_BYTES];
+
+        snprintf(name, sizeof(name), "workQueue%zu", i);
+
+        Workers[i].randomSeed = i;
+
+        le_thread_Start(le_thread_Create(name, WorkerMain, &Workers[i]));
+    }
+}
+
+
+// =======================================
+//  PROTECTED (INTER-MODULE) FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Work Queue module.
+ *
+ * Must be called exactly once at start-up before any other Work Queue functions are called.
+ * The workers aren't started until they are needed.
+ */
+//--------------------------------------------------------------------------------------------------
+void workQueue_Init
+(
+    void
+)
+{
+    JobPool = le_mem_CreatePool("WorkQueueJobs", sizeof(Job_t));
+
+    LE_ASSERT(pthread_key_create(&WorkerKey, NULL) == 0);
+}
+
+
+// =======================================
+//  PUBLIC API FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Submits a job to be run by a worker thread.
+ *
+ * Can be called from any thread, including from inside a job.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_workQueue_Submit
+(
+    le_workQueue_JobFunc_t jobFunc,         ///< [IN] Function to run in a worker thread.
+    le_workQueue_JobFunc_t completionFunc,  ///< [IN] Function to call in this thread when the job
+                                            ///       is done (NULL if none).
+    void* contextPtr                        ///< [IN] Value to pass to both functions.
+)
+{
+    LE_ASSERT(jobFunc != NULL);
+
+    LE_ASSERT(pthread_once(&StartOnce, StartWorkers) == 0);
+
+    Worker_t* workerPtr = pthread_getspecific(WorkerKey);
+
+    Job_t* jobPtr = le_mem_ForceAlloc(JobPool);
+
+    jobPtr->link = LE_SLS_LINK_INIT;
+    jobPtr->jobFunc = jobFunc;
+    jobPtr->completionFunc = completionFunc;
+    jobPtr->contextPtr = contextPtr;
+    jobPtr->threadRef = (workerPtr == NULL ? le_thread_GetCurrent() : NULL);
+
+    __atomic_add_fetch(&PendingJobs, 1, __ATOMIC_SEQ_CST);
+
+    if ((workerPtr == NULL) || !PushJob(workerPtr, jobPtr))
+    {
+        LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+
+        le_sls_Queue(&InjectionQueue, &jobPtr->link);
+        __atomic_add_fetch(&InjectionQueueLength, 1, __ATOMIC_RELAXED);
+
+        LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+    }
+
+    if (__atomic_load_n(&IdleWorkers, __ATOMIC_SEQ_CST) > 0)
+    {
+        LE_ASSERT(pthread_mutex_lock(&Mutex) == 0);
+        LE_ASSERT(pthread_cond_signal(&WorkAvailable) == 0);
+        LE_ASSERT(pthread_mutex_unlock(&Mutex) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the number of worker threads (starting them, if they haven't been started yet).
+ *
+ * @return The number of worker threads.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_workQueue_GetNumWorkers
+(
+    void
+)
+{
+    LE_ASSERT(pthread_once(&StartOnce, StartWorkers) == 0);
+
+    return NumWorkers;
+}
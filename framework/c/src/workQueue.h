@@ -0,0 +1,28 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file workQueue.h
+ *
+ * Interfaces exported by the Work Queue module to other modules inside the Legato framework
+ * implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc.  Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef WORKQUEUE_H_INCLUDE_GUARD
+#define WORKQUEUE_H_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Work Queue module.
+ *
+ * Must be called exactly once at start-up before any other Work Queue functions are called.
+ * The workers aren't started until they are needed.
+ */
+//--------------------------------------------------------------------------------------------------
+void workQueue_Init
+(
+    void
+);
+
+#endif // WORKQUEUE_H_INCLUDE_GUARD
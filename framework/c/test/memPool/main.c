@@ -31,6 +31,14 @@ colourObj_t;
 #define FORCE_SIZE          3
 #define NUM_EXPAND_SUB_POOL 2
 #define NUM_ALLOC_SUPER_POOL    1
+#define NUM_THREADS         4
+#define THREAD_POOL_SIZE    64
+#define NUM_TRIM_OBJS       1000
+#define TRIM_LOW_WATERMARK  10
+#define TRIM_HIGH_WATERMARK 100
+#define NUM_CHURN_LOOPS     100000
+#define CHURN_BATCH_SIZE    8
+#define BATCH_SIZE          100
 
 static unsigned int NumRelease = 0;
 static unsigned int ReleaseId;
@@ -46,6 +54,71 @@ static void IdDestructor(void* objPtr)
 }
 
 
+static le_mem_PoolRef_t ThreadTestPool;
+static pthread_barrier_t ThreadTestBarrier;
+static size_t NumThreadAllocs[NUM_THREADS];
+
+// Each thread first allocates and releases a block (leaving free blocks in its per-thread cache),
+// then grabs as many blocks as it can.  Between them, the threads must get every block in the
+// pool, even though some of the free blocks were sitting in other threads' caches.
+static void* AllocThreadMain(void* contextPtr)
+{
+    size_t threadIndex = (size_t)contextPtr;
+    void* objPtrs[THREAD_POOL_SIZE];
+    void* objPtr;
+    size_t numAllocs = 0;
+
+    le_mem_Release(le_mem_AssertAlloc(ThreadTestPool));
+
+    pthread_barrier_wait(&ThreadTestBarrier);
+
+    while ((objPtr = le_mem_TryAlloc(ThreadTestPool)) != NULL)
+    {
+        objPtrs[numAllocs++] = objPtr;
+    }
+
+    NumThreadAllocs[threadIndex] = numAllocs;
+
+    // Wait until all threads are done allocating before releasing anything.
+    pthread_barrier_wait(&ThreadTestBarrier);
+
+    while (numAllocs > 0)
+    {
+        le_mem_Release(objPtrs[--numAllocs]);
+    }
+
+    return NULL;
+}
+
+
+// Each thread repeatedly allocates a few blocks, tags them with its thread index, then checks the
+// tags before releasing them again.  Two threads getting the same block would clobber each other's
+// tags.
+static void* ChurnThreadMain(void* contextPtr)
+{
+    uint32_t threadIndex = (uint32_t)(size_t)contextPtr;
+    idObj_t* objPtrs[CHURN_BATCH_SIZE];
+    size_t i, j;
+
+    for (i = 0; i < NUM_CHURN_LOOPS; i++)
+    {
+        for (j = 0; j < CHURN_BATCH_SIZE; j++)
+        {
+            objPtrs[j] = le_mem_ForceAlloc(ThreadTestPool);
+            objPtrs[j]->id = threadIndex;
+        }
+
+        for (j = 0; j < CHURN_BATCH_SIZE; j++)
+        {
+            LE_ASSERT(objPtrs[j]->id == threadIndex);
+            le_mem_Release(objPtrs[j]);
+        }
+    }
+
+    return NULL;
+}
+
+
 int main(int argc, char *argv[])
 {
     le_mem_PoolRef_t idPool, colourPool;
@@ -531,6 +604,207 @@ int main(int argc, char *argv[])
     printf("Successfully searched for pools by name.\n");
 
 
+    //
+    // Allocate and release from multiple threads.
+    //
+    pthread_t threads[NUM_THREADS];
+    size_t totalThreadAllocs = 0;
+
+    ThreadTestPool = le_mem_CreatePool("Thread Pool", sizeof(idObj_t));
+    le_mem_ExpandPool(ThreadTestPool, THREAD_POOL_SIZE);
+    pthread_barrier_init(&ThreadTestBarrier, NULL, NUM_THREADS);
+
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(pthread_create(&threads[i], NULL, AllocThreadMain, (void*)(size_t)i) == 0);
+    }
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(pthread_join(threads[i], NULL) == 0);
+        totalThreadAllocs += NumThreadAllocs[i];
+    }
+
+    le_mem_PoolStats_t threadPoolStats;
+    le_mem_GetStats(ThreadTestPool, &threadPoolStats);
+
+    if ( (totalThreadAllocs != THREAD_POOL_SIZE) ||
+         (threadPoolStats.numBlocksInUse != 0) ||
+         (threadPoolStats.numFree != THREAD_POOL_SIZE) ||
+         (threadPoolStats.maxNumBlocksUsed != THREAD_POOL_SIZE) ||
+         (threadPoolStats.numAllocs != THREAD_POOL_SIZE + NUM_THREADS) ||
+         (le_mem_GetObjectCount(ThreadTestPool) != THREAD_POOL_SIZE) )
+    {
+        printf("Error allocating from multiple threads: %d", __LINE__);
+        return LE_FAULT;
+    }
+    printf("Allocated and released from multiple threads correctly.\n");
+
+
+    //
+    // Trim pools.
+    //
+    // Only trimmable pools can be trimmed.
+    if ( (le_mem_Trim(ThreadTestPool) != 0) ||
+         (le_mem_GetObjectCount(ThreadTestPool) != THREAD_POOL_SIZE) )
+    {
+        printf("Error trimming pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    le_mem_PoolRef_t trimPool = le_mem_CreatePool("Trim Pool", sizeof(idObj_t));
+    le_mem_SetTrimWatermarks(trimPool, TRIM_LOW_WATERMARK, TRIM_HIGH_WATERMARK);
+
+    idObj_t* trimObjsPtr[NUM_TRIM_OBJS];
+    for (i = 0; i < NUM_TRIM_OBJS; i++)
+    {
+        trimObjsPtr[i] = le_mem_ForceAlloc(trimPool);
+    }
+
+    le_mem_GetStats(trimPool, &threadPoolStats);
+    size_t trimPoolSize = le_mem_GetObjectCount(trimPool);
+
+    if ( (trimPoolSize < NUM_TRIM_OBJS) ||
+         (threadPoolStats.numOverflows >= NUM_TRIM_OBJS / 10) )
+    {
+        printf("Error expanding trimmable pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    for (i = 0; i < NUM_TRIM_OBJS; i++)
+    {
+        le_mem_Release(trimObjsPtr[i]);
+    }
+
+    le_mem_GetStats(trimPool, &threadPoolStats);
+
+    if ( (le_mem_GetObjectCount(trimPool) >= trimPoolSize) ||
+         (threadPoolStats.numBlocksInUse != 0) )
+    {
+        printf("Error auto-trimming pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    le_mem_Trim(trimPool);
+
+    if (le_mem_GetObjectCount(trimPool) != 0)
+    {
+        printf("Error trimming pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    // Memory added before a pool was made trimmable stays in the pool.
+    trimPool = le_mem_CreatePool("Late Trim Pool", sizeof(idObj_t));
+    le_mem_ExpandPool(trimPool, 10);
+    le_mem_SetTrimWatermarks(trimPool, 0, TRIM_HIGH_WATERMARK);
+    le_mem_ExpandPool(trimPool, 10);
+
+    if ( (le_mem_Trim(trimPool) < 10) ||
+         (le_mem_GetObjectCount(trimPool) != 10) )
+    {
+        printf("Error trimming pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+    printf("Trimmed pools correctly.\n");
+
+
+    //
+    // Allocate and release from a concurrent pool in multiple threads.
+    //
+    ThreadTestPool = le_mem_CreatePool("Concurrent Pool", sizeof(idObj_t));
+    le_mem_SetConcurrent(ThreadTestPool);
+    le_mem_ExpandPool(ThreadTestPool, THREAD_POOL_SIZE);
+
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(pthread_create(&threads[i], NULL, AllocThreadMain, (void*)(size_t)i) == 0);
+    }
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(pthread_join(threads[i], NULL) == 0);
+    }
+
+    le_mem_GetStats(ThreadTestPool, &threadPoolStats);
+
+    if ( (threadPoolStats.numBlocksInUse != 0) ||
+         (threadPoolStats.numFree != THREAD_POOL_SIZE) ||
+         (threadPoolStats.maxNumBlocksUsed != THREAD_POOL_SIZE) ||
+         (threadPoolStats.numAllocs != THREAD_POOL_SIZE + NUM_THREADS) )
+    {
+        printf("Error allocating from concurrent pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(pthread_create(&threads[i], NULL, ChurnThreadMain, (void*)(size_t)i) == 0);
+    }
+    for (i = 0; i < NUM_THREADS; i++)
+    {
+        LE_ASSERT(pthread_join(threads[i], NULL) == 0);
+    }
+
+    le_mem_GetStats(ThreadTestPool, &threadPoolStats);
+
+    if ( (threadPoolStats.numBlocksInUse != 0) ||
+         (threadPoolStats.numFree != le_mem_GetObjectCount(ThreadTestPool)) ||
+         (le_mem_GetObjectCount(ThreadTestPool) < NUM_THREADS * CHURN_BATCH_SIZE) )
+    {
+        printf("Error churning concurrent pool: %d", __LINE__);
+        return LE_FAULT;
+    }
+    printf("Allocated and released from concurrent pool correctly.\n");
+
+
+    //
+    // Allocate and release in batches.
+    //
+    void* batchPtrs[BATCH_SIZE * 2];
+    le_mem_PoolRef_t batchPool = le_mem_CreatePool("Batch Pool", sizeof(idObj_t));
+    le_mem_ExpandPool(batchPool, BATCH_SIZE / 2);
+
+    // Half of the objects come from the pool, the rest from expanding it.
+    le_mem_AllocBatch(batchPool, BATCH_SIZE, batchPtrs);
+
+    // Mix in objects from the concurrent pool, some of which still have other references.
+    le_mem_AllocBatch(ThreadTestPool, BATCH_SIZE, batchPtrs + BATCH_SIZE);
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        ((idObj_t*)batchPtrs[i])->id = i;
+        ((idObj_t*)batchPtrs[BATCH_SIZE + i])->id = i;
+    }
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        LE_ASSERT(((idObj_t*)batchPtrs[i])->id == i);
+    }
+    le_mem_AddRef(batchPtrs[BATCH_SIZE]);
+
+    le_mem_PoolStats_t batchPoolStats;
+    le_mem_GetStats(batchPool, &batchPoolStats);
+
+    if ( (batchPoolStats.numBlocksInUse != BATCH_SIZE) ||
+         (batchPoolStats.numAllocs != BATCH_SIZE) ||
+         (le_mem_GetObjectCount(batchPool) < BATCH_SIZE) )
+    {
+        printf("Error allocating batch: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    le_mem_ReleaseBatch(batchPtrs, BATCH_SIZE * 2);
+
+    le_mem_GetStats(batchPool, &batchPoolStats);
+    le_mem_GetStats(ThreadTestPool, &threadPoolStats);
+
+    if ( (batchPoolStats.numBlocksInUse != 0) ||
+         (threadPoolStats.numBlocksInUse != 1) )
+    {
+        printf("Error releasing batch: %d", __LINE__);
+        return LE_FAULT;
+    }
+
+    le_mem_Release(batchPtrs[BATCH_SIZE]);
+    printf("Allocated and released batches correctly.\n");
+
+
     printf("*** Unit Test for le_mem module passed. ***\n");
     printf("\n");
     return LE_OK;
@@ -48,8 +48,22 @@ FuncImplTemplate = """
     $ endfor
     {{""}}
 
+    // Work out how big the message needs to be.  The server responds using the same message, so it
+    // needs room for whichever is bigger: the request or the response.
+    size_t _requestSize = {{ func.parmListIn | sumParmList("clientMsgSize") }};
+    size_t _responseSize = {{ func.parmListOut | sumParmList("clientMsgSize") }};
+    $ if func.type
+    _responseSize += sizeof(_result);
+    $ endif
+    size_t _msgSize = offsetof(_Message_t, buffer) +
+                      ( (_requestSize > _responseSize) ? _requestSize : _responseSize );
+    if ( _msgSize > sizeof(_Message_t) )
+    {
+        _msgSize = sizeof(_Message_t);
+    }
+
     // Create a new message object and get the message buffer
-    _msgRef = le_msg_CreateMsg(GetCurrentSessionRef());
+    _msgRef = le_msg_CreateMsgWithSize(GetCurrentSessionRef(), _msgSize);
     _msgPtr = le_msg_GetPayloadPtr(_msgRef);
     _msgPtr->id = _MSGID_{{func.name}};
     _msgBufPtr = _msgPtr->buffer;
@@ -57,7 +71,8 @@ FuncImplTemplate = """
     // Pack the input parameters
     {{ func.parmListIn | printParmList("clientPack", sep="\n") | indent }}
 
-    // Send a request to the server and get the response.
+    // Send a request to the server and get the response.  If this is called from a coroutine,
+    // only the coroutine waits for the response (see le_coro.h).
     LE_DEBUG("Sending message to server and waiting for response : %ti bytes sent",
              _msgBufPtr-_msgPtr->buffer);
     _responseMsgRef = le_msg_RequestSyncResponse(_msgRef);
@@ -39,6 +39,22 @@ def PrintParmList(parmList, templateName, sep=',\n', leadSep=False):
 Environment.filters["printParmList"] = PrintParmList
 
 
+#
+# Define and register the filter for adding up a parameter list's size expressions from the given
+# parameter template.  Parameters whose template is empty are left out.
+#
+def SumParmList(parmList, templateName):
+    resultList = [ getattr(p, templateName).format(parm=p) for p in parmList ]
+    resultList = [ r for r in resultList if r ]
+
+    if not resultList:
+        return "0"
+
+    return " + ".join( resultList )
+
+Environment.filters["sumParmList"] = SumParmList
+
+
 #
 # Register the filter for adding the common prefix to names.  This may be needed in cases of
 # auto-generated types/names that are part of the public interface.
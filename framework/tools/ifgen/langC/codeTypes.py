@@ -173,6 +173,13 @@ _msgBufPtr = PackData( _msgBufPtr, {parm.serverAddr}, {parm.numBytes} );\
 
     asyncServerPack = """\
 _msgBufPtr = PackData( _msgBufPtr, {parm.serverAddr}, {parm.numBytes} );\
+"""
+
+    # Expression for the largest number of message buffer bytes that the parameter can use on the
+    # client side, when packing it into the request or unpacking it from the response.  This is
+    # used to pick the size of the message.  Empty if the parameter doesn't use the message buffer.
+    clientMsgSize = """\
+{parm.numBytes}\
 """
 
     # Ensure that the array/string length is not greater than the maximum from the API definition.
@@ -318,6 +325,9 @@ class FileInParmData(BaseParmData):
 le_msg_SetFd(_msgRef, {parm.parmName});\
 """
 
+        # The fd isn't sent in the message buffer
+        self.clientMsgSize = ""
+
         self.serverUnpack = """\
 {parm.serverType} {parm.serverName};
 {parm.serverName} = le_msg_GetFd(_msgRef);\
@@ -333,6 +343,9 @@ class FileOutParmData(PointerParmData):
 {parm.value} = le_msg_GetFd(_responseMsgRef);\
 """
 
+    # The fd isn't sent in the message buffer
+    clientMsgSize = ""
+
     serverPack = """\
 le_msg_SetFd(_msgRef, {parm.serverName});\
 """
@@ -384,6 +397,7 @@ class ArrayParmData(BaseParmData):
             # Definition for the client side -- size is a pointer variable
             self.numBytes = "%s*sizeof(%s)" % ('*%sPtr'%self.sizeVar, self.type)
             self.clientUnpack = self.clientUnpack.format(parm=self)
+            self.clientMsgSize = self.clientMsgSize.format(parm=self)
 
             # Definition for the server side -- size is not a pointer variable
             self.numBytes = "%s*sizeof(%s)" % (self.sizeVar, self.type)
@@ -438,6 +452,11 @@ class StringParmData(BaseParmData):
 
         self.clientPack = """\
 _msgBufPtr = PackString( _msgBufPtr, {parm.parmName} );\
+"""
+
+        # The string is packed with its length first
+        self.clientMsgSize = """\
+sizeof(uint32_t) + strlen({parm.parmName})\
 """
 
         self.serverUnpack = """\
@@ -484,6 +503,12 @@ _msgBufPtr = PackString( _msgBufPtr, {parm.serverAddr} );\
 _msgBufPtr = UnpackString( _msgBufPtr, {parm.address}, {parm.numBytes} );\
 """
 
+        # The server packs the string with its length first, and the string can't be longer than
+        # the buffer provided by the client.
+        self.clientMsgSize = """\
+sizeof(uint32_t) + {parm.sizeVar}\
+"""
+
 
 
 class HandlerPointerParmData(BaseParmData):
@@ -519,6 +544,9 @@ _UNLOCK\
         # Nothing to do in this case
         self.serverUnpack = ""
 
+        # The handler isn't sent to the server (the context pointer is sent instead)
+        self.clientMsgSize = ""
+
 
     def setFuncName(self, funcName, funcType):
         self.funcName = funcName
@@ -2,7 +2,7 @@
 /** @file inspect.c
  *
  * Legato inspection tool used to inspect Legato structures such as memory pools, timers, threads,
- * mutexes, etc. in running processes.
+ * mutexes, reader-writer locks, etc. in running processes.
  *
  * Must be run as root.
  *
@@ -14,6 +14,7 @@
 #include "legato.h"
 #include "mem.h"
 #include "thread.h"
+#include "cond.h"
 #include "hashmap.h"
 #include "messagingInterface.h"
 #include "messagingProtocol.h"
@@ -26,8 +27,8 @@
 //--------------------------------------------------------------------------------------------------
 /**
  * Objects of these types are used to refer to lists of memory pools, thread objects, timers,
- * mutexes, semaphores, and service objects. They can be used to iterate over those lists in a
- * remote process.
+ * mutexes, semaphores, reader-writer locks, condition variables, service objects, and event loops.
+ * They can be used to iterate over those lists in a remote process.
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct MemPoolIter*         MemPoolIter_Ref_t;
@@ -35,11 +36,14 @@ typedef struct ThreadObjIter*       ThreadObjIter_Ref_t;
 typedef struct TimerIter*           TimerIter_Ref_t;
 typedef struct MutexIter*           MutexIter_Ref_t;
 typedef struct SemaphoreIter*       SemaphoreIter_Ref_t;
+typedef struct RwLockIter*          RwLockIter_Ref_t;
+typedef struct CondIter*            CondIter_Ref_t;
 typedef struct ThreadMemberObjIter* ThreadMemberObjIter_Ref_t;
 typedef struct ServiceObjIter*      ServiceObjIter_Ref_t;
 typedef struct ClientObjIter*       ClientObjIter_Ref_t;
 typedef struct SessionObjIter*      SessionObjIter_Ref_t;
 typedef struct InterfaceObjIter*    InterfaceObjIter_Ref_t;
+typedef struct EventLoopIter*       EventLoopIter_Ref_t;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -54,10 +58,14 @@ typedef enum
     INSPECT_INSP_TYPE_TIMER,
     INSPECT_INSP_TYPE_MUTEX,
     INSPECT_INSP_TYPE_SEMAPHORE,
+    INSPECT_INSP_TYPE_RWLOCK,
+    INSPECT_INSP_TYPE_COND,
     INSPECT_INSP_TYPE_IPC_SERVERS,
     INSPECT_INSP_TYPE_IPC_CLIENTS,
     INSPECT_INSP_TYPE_IPC_SERVERS_SESSIONS,
-    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS
+    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS,
+    INSPECT_INSP_TYPE_EVENT_LOOP,
+    INSPECT_INSP_TYPE_EVENT_HANDLER
 }
 InspType_t;
 
@@ -85,6 +93,8 @@ typedef struct
 {
     le_dls_List_t* bucketsPtr;  ///< Array of buckets in the hashmap in the remote process.
     size_t bucketCount;         ///< Size of the array of buckets.
+    le_dls_List_t* oldBucketsPtr; ///< Array of buckets being migrated out of, if resizing.
+    size_t oldBucketCount;      ///< Size of the array of old buckets (0 if not resizing).
     size_t* mapChgCntRef;       ///< Change counter for the remote map.
 }
 RemoteHashmapAccess_t;
@@ -113,9 +123,12 @@ ThreadObjIter_t;
 typedef struct TimerIter
 {
     RemoteListAccess_t threadObjList;
-    RemoteListAccess_t timerList;     ///< Timer list for the current thread in the remote process.
+    RemoteListAccess_t timerList;     ///< Only the change counter is used, since the timers are
+                                      ///< read from the current thread's active timer tree.
     thread_Obj_t currThreadObj;
-    Timer_t currTimer;                ///< Current timer from the list.
+    Timer_t currTimer;                ///< Current timer from the tree.
+    le_rbtree_Node_t* remTreeNodePtr; ///< Tree node of the current timer in the remote process,
+                                      ///< or NULL if there is no current timer yet.
 }
 TimerIter_t;
 
@@ -137,6 +150,20 @@ typedef struct SemaphoreIter
 }
 SemaphoreIter_t;
 
+typedef struct RwLockIter
+{
+    RemoteListAccess_t rwLockList;    ///< Reader-writer lock list in the remote process.
+    RwLock_t currRwLock;              ///< Current reader-writer lock from the list.
+}
+RwLockIter_t;
+
+typedef struct CondIter
+{
+    RemoteListAccess_t condList;      ///< Condition variable list in the remote process.
+    Cond_t currCond;                  ///< Current condition variable from the list.
+}
+CondIter_t;
+
 // Type describing the commonalities of the thread memeber objects - namely timer, mutex, and
 // semaphore.
 typedef struct ThreadMemberObjIter
@@ -198,6 +225,25 @@ typedef struct InterfaceObjIter
 }
 InterfaceObjIter_t;
 
+// An event loop, or one of its handlers. Since there's no event loop list, each thread obj owns
+// its event loop directly and the handler statistics are an array in the event loop statistics.
+typedef struct
+{
+    char threadName[MAX_THREAD_NAME_SIZE]; ///< Name of the thread owning the event loop.
+    event_PerThreadRec_t eventRec;         ///< The event loop's per-thread record.
+    bool hasStats;                         ///< true if the event loop keeps statistics.
+    event_Stats_t stats;                   ///< The event loop statistics (if hasStats is true).
+    size_t handlerIndex;                   ///< Index of the current handler in the statistics.
+}
+EventLoopNode_t;
+
+typedef struct EventLoopIter
+{
+    ThreadObjIter_t threadObjIter;         ///< Iterator over the thread objs owning event loops.
+    EventLoopNode_t currEventLoop;         ///< Current event loop (and handler).
+}
+EventLoopIter_t;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -416,6 +462,135 @@ static int OpenProcMemFile
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens one of the /proc/<PID>/task/<TID>/ files for a thread in the process being inspected.
+ *
+ * @return
+ *      The opened file, or NULL if the thread no longer exists.
+ */
+//--------------------------------------------------------------------------------------------------
+static FILE* OpenThreadProcFile
+(
+    pid_t tid,              ///< [IN] Kernel thread ID.
+    const char* fileName    ///< [IN] Name of the file in the thread's task directory.
+)
+{
+    char filePath[LIMIT_MAX_PATH_BYTES];
+    int snprintSize = snprintf(filePath, sizeof(filePath), "/proc/%d/task/%d/%s",
+                               PidToInspect, tid, fileName);
+
+    if (snprintSize >= sizeof(filePath))
+    {
+        INTERNAL_ERR("Path is too long '%s'.", filePath);
+    }
+    else if (snprintSize < 0)
+    {
+        INTERNAL_ERR("snprintf encoding error.");
+    }
+
+    return fopen(filePath, "r");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the CPU time (user plus system) that a thread in the process being inspected has used.
+ *
+ * @return
+ *      The CPU time in seconds, or 0 if the thread hasn't started or no longer exists.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetThreadCpuTime
+(
+    pid_t tid   ///< [IN] Kernel thread ID (0 if the thread hasn't started).
+)
+{
+    if (tid == 0)
+    {
+        return 0;
+    }
+
+    FILE* filePtr = OpenThreadProcFile(tid, "stat");
+
+    if (filePtr == NULL)
+    {
+        return 0;
+    }
+
+    char line[512];
+    unsigned long userTicks = 0;
+    unsigned long systemTicks = 0;
+
+    if (fgets(line, sizeof(line), filePtr) != NULL)
+    {
+        // The thread name (field 2) is in parentheses and can contain spaces, so skip past it.
+        // User and system time are fields 14 and 15.
+        char* fieldsPtr = strrchr(line, ')');
+
+        if ((fieldsPtr == NULL) ||
+            (sscanf(fieldsPtr + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu",
+                    &userTicks, &systemTicks) != 2))
+        {
+            userTicks = 0;
+            systemTicks = 0;
+        }
+    }
+
+    fclose(filePtr);
+
+    return (double)(userTicks + systemTicks) / sysconf(_SC_CLK_TCK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the list of CPUs that a thread in the process being inspected is allowed to run on, in the
+ * kernel's list format (e.g., "0-3,6").  The string is empty if the thread hasn't started or no
+ * longer exists.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetThreadCpuList
+(
+    pid_t tid,          ///< [IN] Kernel thread ID (0 if the thread hasn't started).
+    char* buffPtr,      ///< [OUT] Buffer to store the list in.
+    size_t buffSize     ///< [IN] Size of the buffer.
+)
+{
+    buffPtr[0] = '\0';
+
+    if (tid == 0)
+    {
+        return;
+    }
+
+    FILE* filePtr = OpenThreadProcFile(tid, "status");
+
+    if (filePtr == NULL)
+    {
+        return;
+    }
+
+    static const char key[] = "Cpus_allowed_list:";
+    char line[256];
+
+    while (fgets(line, sizeof(line), filePtr) != NULL)
+    {
+        if (strncmp(line, key, sizeof(key) - 1) == 0)
+        {
+            char* listPtr = line + sizeof(key) - 1;
+            listPtr += strspn(listPtr, " \t");
+            listPtr[strcspn(listPtr, "\n")] = '\0';
+
+            le_utf8_Copy(buffPtr, listPtr, buffSize, NULL);
+            break;
+        }
+    }
+
+    fclose(filePtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize a RemoteListAccess_t data struct.
@@ -432,6 +607,31 @@ static void InitRemoteListAccessObj
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the address of a bucket of a hashmap in the remote process.  While the map is being
+ * resized, its old buckets come first, followed by the new ones (the same order the hashmap
+ * module uses for iterating).
+ *
+ * @return
+ *      Address of the bucket's list in the remote process.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t* GetRemoteBucket
+(
+    RemoteHashmapAccess_t* remoteMap,   ///< [IN] The remote map.
+    size_t index                        ///< [IN] Index of the bucket.
+)
+{
+    if (index < remoteMap->oldBucketCount)
+    {
+        return remoteMap->oldBucketsPtr + index;
+    }
+
+    return remoteMap->bucketsPtr + (index - remoteMap->oldBucketCount);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates an iterator that can be used to iterate over the list of available memory pools for a
@@ -617,7 +817,12 @@ static TimerIter_Ref_t CreateTimerIter
     void
 )
 {
-    return (TimerIter_Ref_t)CreateThreadMemberObjIter(INSPECT_INSP_TYPE_TIMER);
+    TimerIter_Ref_t iteratorRef =
+        (TimerIter_Ref_t)CreateThreadMemberObjIter(INSPECT_INSP_TYPE_TIMER);
+
+    iteratorRef->remTreeNodePtr = NULL;
+
+    return iteratorRef;
 }
 
 static MutexIter_Ref_t CreateMutexIter
@@ -637,6 +842,77 @@ static SemaphoreIter_Ref_t CreateSemaphoreIter
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads a list that the framework keeps for the whole process (like the memory pool list), and
+ * its change counter ref, from the remote process.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadRemoteProcessList
+(
+    RemoteListAccess_t* remoteListPtr,  ///< [OUT] Object for accessing the remote list.
+    le_dls_List_t* localListPtr,        ///< [IN] Our own copy of the list.
+    size_t** localListChgCntRefPtr,     ///< [IN] Our own copy of the list change counter ref.
+    const char* listName                ///< [IN] Name of the list, for error messages.
+)
+{
+    off_t listAddrOffset = GetRemoteAddress(PidToInspect, localListPtr);
+    off_t listChgCntAddrOffset = GetRemoteAddress(PidToInspect, localListChgCntRefPtr);
+
+    InitRemoteListAccessObj(remoteListPtr);
+
+    if (fd_ReadFromOffset(FdProcMem, listAddrOffset, &(remoteListPtr->List),
+                          sizeof(remoteListPtr->List)) != LE_OK)
+    {
+        INTERNAL_ERR("Error reading %s from the remote process.", listName);
+    }
+
+    if (fd_ReadFromOffset(FdProcMem, listChgCntAddrOffset, &(remoteListPtr->ListChgCntRef),
+                          sizeof(remoteListPtr->ListChgCntRef)) != LE_OK)
+    {
+        INTERNAL_ERR("Error reading %s change counter ref from the remote process.", listName);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an iterator that can be used to iterate over the list of reader-writer locks or
+ * condition variables for a specific process.  See the comment block for CreateMemPoolIter for
+ * additional detail.
+ *
+ * @return
+ *      An iterator to the list of reader-writer locks/condition variables for the specified
+ *      process.
+ */
+//--------------------------------------------------------------------------------------------------
+static RwLockIter_Ref_t CreateRwLockIter
+(
+    void
+)
+{
+    RwLockIter_t* iteratorPtr = le_mem_ForceAlloc(IteratorPool);
+
+    ReadRemoteProcessList(&iteratorPtr->rwLockList, rwlock_GetRwLockList(),
+                          rwlock_GetRwLockListChgCntRef(), "reader-writer lock list");
+
+    return iteratorPtr;
+}
+
+static CondIter_Ref_t CreateCondIter
+(
+    void
+)
+{
+    CondIter_t* iteratorPtr = le_mem_ForceAlloc(IteratorPool);
+
+    ReadRemoteProcessList(&iteratorPtr->condList, cond_GetCondList(),
+                          cond_GetCondListChgCntRef(), "condition variable list");
+
+    return iteratorPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates an iterator that can be used to iterate over the map of interface objects. See the
@@ -709,6 +985,8 @@ static InterfaceObjIter_Ref_t CreateInterfaceObjIter
 
     iteratorPtr->interfaceObjMap.bucketsPtr = map.bucketsPtr;
     iteratorPtr->interfaceObjMap.bucketCount = map.bucketCount;
+    iteratorPtr->interfaceObjMap.oldBucketsPtr = map.oldBucketsPtr;
+    iteratorPtr->interfaceObjMap.oldBucketCount = map.oldBucketCount;
 
     // Get the mapChgCntRef for the process-under-inspection.
     if (fd_ReadFromOffset(FdProcMem, mapChgCntAddrOffset, &(iteratorPtr->interfaceObjMap.mapChgCntRef),
@@ -721,7 +999,7 @@ static InterfaceObjIter_Ref_t CreateInterfaceObjIter
     iteratorPtr->currIndex = 0;
 
     // Get the list of interface objects.
-    if (fd_ReadFromOffset(FdProcMem, (ssize_t)iteratorPtr->interfaceObjMap.bucketsPtr,
+    if (fd_ReadFromOffset(FdProcMem, (ssize_t)GetRemoteBucket(&iteratorPtr->interfaceObjMap, 0),
                           &(iteratorPtr->interfaceObjList.List),
                           sizeof(iteratorPtr->interfaceObjList.List)) != LE_OK)
     {
@@ -811,6 +1089,35 @@ static SessionObjIter_Ref_t CreateSessionObjIter
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates an iterator that can be used to iterate over the event loops (or the event handlers) of
+ * all threads for a specific process. See the comment block for CreateMemPoolIter for additional
+ * detail.
+ *
+ * @return
+ *      An iterator to the list of event loops.
+ */
+//--------------------------------------------------------------------------------------------------
+static EventLoopIter_Ref_t CreateEventLoopIter
+(
+    void
+)
+{
+    ThreadObjIter_Ref_t threadObjIterRef = CreateThreadObjIter();
+
+    // Create the iterator.
+    EventLoopIter_t* iteratorPtr = le_mem_ForceAlloc(IteratorPool);
+    iteratorPtr->threadObjIter = *threadObjIterRef;
+    iteratorPtr->currEventLoop.hasStats = false;
+    iteratorPtr->currEventLoop.handlerIndex = 0;
+
+    le_mem_Release(threadObjIterRef);
+
+    return iteratorPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the memory pool list change counter from the specified iterator.
@@ -859,6 +1166,24 @@ static size_t GetThreadObjListChgCnt
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the event loop list change counter from the specified iterator. Since the event loops
+ * belong to the thread objects, this is the thread object list change counter.
+ *
+ * @return
+ *      List change counter.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetEventLoopListChgCnt
+(
+    EventLoopIter_Ref_t iterator ///< [IN] The iterator to get the list change counter from.
+)
+{
+    return GetThreadObjListChgCnt(&(iterator->threadObjIter));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the timer list change counter from the specified iterator. Note while there's one timer list
@@ -893,6 +1218,56 @@ static size_t GetThreadMemberObjListChgCnt
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the change counter of a remote list.
+ *
+ * @return
+ *      List change counter.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetRemoteListChgCnt
+(
+    RemoteListAccess_t* remoteListPtr ///< [IN] Object for accessing the remote list.
+)
+{
+    size_t listChgCnt;
+    if (fd_ReadFromOffset(FdProcMem, (ssize_t)(remoteListPtr->ListChgCntRef),
+                          &listChgCnt, sizeof(listChgCnt)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("list change counter"));
+    }
+
+    return listChgCnt;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the reader-writer lock or condition variable list change counter from the specified
+ * iterator.
+ *
+ * @return
+ *      List change counter.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetRwLockListChgCnt
+(
+    RwLockIter_Ref_t iterator ///< [IN] The iterator to get the list change counter from.
+)
+{
+    return GetRemoteListChgCnt(&(iterator->rwLockList));
+}
+
+static size_t GetCondListChgCnt
+(
+    CondIter_Ref_t iterator ///< [IN] The iterator to get the list change counter from.
+)
+{
+    return GetRemoteListChgCnt(&(iterator->condList));
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the interface object map change counter from the specified iterator.
@@ -1103,10 +1478,6 @@ static le_dls_Link_t* GetThreadMemberObjList
 {
     switch (memberObjType)
     {
-        case INSPECT_INSP_TYPE_TIMER:
-            return threadObjRef->timerRec.activeTimerList.headLinkPtr;
-            break;
-
         case INSPECT_INSP_TYPE_MUTEX:
             return threadObjRef->mutexRec.lockedMutexList.headLinkPtr;
             break;
@@ -1120,7 +1491,7 @@ static le_dls_Link_t* GetThreadMemberObjList
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the next thread member object link ptr from the specified iterator. For other detail see
- * GetNextMemPool. This is a helper function for GetNextTimer and GetNextMutex.
+ * GetNextMemPool. This is a helper function for GetNextMutex.
  *
  * @return
  *      A thread member obj link ptr.
@@ -1137,15 +1508,9 @@ static le_dls_Link_t* GetNextThreadMemberObjLinkPtr
 
     switch (memberObjType)
     {
-        case INSPECT_INSP_TYPE_TIMER:
+        case INSPECT_INSP_TYPE_MUTEX:
             // an empty statement for the label to belong to, since a declaration is not a statement
             // in C.
-            ;
-            TimerIter_Ref_t timerIterRef = (TimerIter_Ref_t)threadMemberObjItrRef;
-            currThreadMemberObjLinkPtr = &(timerIterRef->currTimer.link);
-            break;
-
-        case INSPECT_INSP_TYPE_MUTEX:
             ;
             MutexIter_Ref_t mutexIterRef = (MutexIter_Ref_t)threadMemberObjItrRef;
             currThreadMemberObjLinkPtr = &(mutexIterRef->currMutex.lockedByThreadLink);
@@ -1203,66 +1568,171 @@ static le_dls_Link_t* GetNextThreadMemberObjLinkPtr
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Gets the next timer from the specified iterator. All timers from all thread objects are
- * considered to be on a single timer list. Therefore the out param would be NULL only when all
- * timer lists from all thread objects have been iterated.
- *
- * @return
- *      A timer from the iterator's list of timers.
+ * Reads a red/black tree node from the remote process.  Used to walk a tree in the remote process
+ * the same way le_rbtree_GetNext() would walk a local one.
  */
 //--------------------------------------------------------------------------------------------------
-static Timer_t* GetNextTimer
+static void ReadRemoteTreeNode
 (
-    TimerIter_Ref_t timerIterRef ///< [IN] The iterator to get the next timer from.
+    le_rbtree_Node_t* remNodePtr,   ///< [IN] Address of the node in the remote process.
+    le_rbtree_Node_t* nodePtr       ///< [OUT] Local copy of the node.
 )
 {
-    le_dls_Link_t* remThreadMemberObjNextLinkPtr =
-        GetNextThreadMemberObjLinkPtr(INSPECT_INSP_TYPE_TIMER,
-                                      (ThreadMemberObjIter_Ref_t)timerIterRef);
-
-    if (remThreadMemberObjNextLinkPtr == NULL)
-    {
-        return NULL;
-    }
-
-    // Get the address of timer.
-    Timer_t* remTimerPtr = CONTAINER_OF(remThreadMemberObjNextLinkPtr, Timer_t, link);
-
-    // Read the timer into our own memory.
-    if (fd_ReadFromOffset(FdProcMem, (ssize_t)remTimerPtr, &(timerIterRef->currTimer),
-                          sizeof(timerIterRef->currTimer)) != LE_OK)
+    if (fd_ReadFromOffset(FdProcMem, (ssize_t)remNodePtr, nodePtr, sizeof(*nodePtr)) != LE_OK)
     {
-        INTERNAL_ERR(REMOTE_READ_ERR("timer object"));
+        INTERNAL_ERR(REMOTE_READ_ERR("tree node"));
     }
-
-    return &(timerIterRef->currTimer);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * See GetNextTimer.
+ * Gets the node that comes after a given node of a red/black tree in the remote process, in key
+ * order.
+ *
+ * The tree may change while it is being walked, which the caller finds out from the change
+ * counter.  So that a tree that is changing can't send us round in circles, the walk gives up
+ * after more steps than the height of any red/black tree.
  *
  * @return
- *      A mutex from the iterator's list of mutexes.
+ *      Address of the next node in the remote process, or NULL if there isn't one.
  */
 //--------------------------------------------------------------------------------------------------
-static Mutex_t* GetNextMutex
+static le_rbtree_Node_t* GetNextRemoteTreeNode
 (
-    MutexIter_Ref_t mutexIterRef ///< [IN] The iterator to get the next mutex from.
+    le_rbtree_Node_t* remNodePtr,       ///< [IN] Address of the node in the remote process.
+    const le_rbtree_Node_t* nodePtr     ///< [IN] Local copy of the node.
 )
 {
-    le_dls_Link_t* remThreadMemberObjNextLinkPtr =
-        GetNextThreadMemberObjLinkPtr(INSPECT_INSP_TYPE_MUTEX,
-                                      (ThreadMemberObjIter_Ref_t)mutexIterRef);
+    const size_t maxSteps = 2 * sizeof(void*) * 8;
+    le_rbtree_Node_t node;
+    size_t steps;
 
-    if (remThreadMemberObjNextLinkPtr == NULL)
+    // The next node is the left-most node of the right subtree, if there is a right subtree.
+    if (nodePtr->rightPtr != NULL)
     {
-        return NULL;
-    }
+        remNodePtr = nodePtr->rightPtr;
+        ReadRemoteTreeNode(remNodePtr, &node);
+
+        for (steps = 0; (node.leftPtr != NULL) && (steps < maxSteps); steps++)
+        {
+            remNodePtr = node.leftPtr;
+            ReadRemoteTreeNode(remNodePtr, &node);
+        }
+
+        return remNodePtr;
+    }
+
+    // Otherwise it's the first ancestor that the node is in the left subtree of.
+    le_rbtree_Node_t* remParentPtr = nodePtr->parentPtr;
+
+    for (steps = 0; (remParentPtr != NULL) && (steps < maxSteps); steps++)
+    {
+        ReadRemoteTreeNode(remParentPtr, &node);
+
+        if (node.leftPtr == remNodePtr)
+        {
+            return remParentPtr;
+        }
+
+        remNodePtr = remParentPtr;
+        remParentPtr = node.parentPtr;
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next timer from the specified iterator. All timers from all thread objects are
+ * considered to be on a single timer list. Therefore the out param would be NULL only when all
+ * active timer trees from all thread objects have been iterated.  Each thread's timers are walked
+ * in order of expiry time.
+ *
+ * @return
+ *      A timer from the iterator's list of timers.
+ */
+//--------------------------------------------------------------------------------------------------
+static Timer_t* GetNextTimer
+(
+    TimerIter_Ref_t timerIterRef ///< [IN] The iterator to get the next timer from.
+)
+{
+    le_rbtree_Node_t* remTreeNodePtr = NULL;
+
+    // Get the next timer of the current thread.
+    if (timerIterRef->remTreeNodePtr != NULL)
+    {
+        remTreeNodePtr = GetNextRemoteTreeNode(timerIterRef->remTreeNodePtr,
+                                               &(timerIterRef->currTimer.treeNode));
+    }
+
+    // If there isn't one, move on to the first timer of the next thread that has any.
+    while (remTreeNodePtr == NULL)
+    {
+        le_dls_Link_t* remThreadObjNextLinkPtr =
+            GetNextLink(&(timerIterRef->threadObjList), &(timerIterRef->currThreadObj.link));
+
+        // There are no more thread objects on the list (or list is empty)
+        if (remThreadObjNextLinkPtr == NULL)
+        {
+            return NULL;
+        }
+
+        // Get the address of thread obj.
+        thread_Obj_t* remThreadObjPtr = CONTAINER_OF(remThreadObjNextLinkPtr, thread_Obj_t, link);
+
+        // Read the thread obj into our own memory.
+        if (fd_ReadFromOffset(FdProcMem, (ssize_t)remThreadObjPtr, &(timerIterRef->currThreadObj),
+                              sizeof(timerIterRef->currThreadObj)) != LE_OK)
+        {
+            INTERNAL_ERR(REMOTE_READ_ERR("thread object"));
+        }
+
+        remTreeNodePtr = timerIterRef->currThreadObj.timerRec.activeTimerTree.firstPtr;
+    }
+
+    timerIterRef->remTreeNodePtr = remTreeNodePtr;
+
+    // Get the address of timer.
+    Timer_t* remTimerPtr = CONTAINER_OF(remTreeNodePtr, Timer_t, treeNode);
+
+    // Read the timer into our own memory.
+    if (fd_ReadFromOffset(FdProcMem, (ssize_t)remTimerPtr, &(timerIterRef->currTimer),
+                          sizeof(timerIterRef->currTimer)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("timer object"));
+    }
+
+    return &(timerIterRef->currTimer);
+}
 
-    // Get the address of mutex.
-    Mutex_t* remMutexPtr = CONTAINER_OF(remThreadMemberObjNextLinkPtr, Mutex_t, lockedByThreadLink);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * See GetNextTimer.
+ *
+ * @return
+ *      A mutex from the iterator's list of mutexes.
+ */
+//--------------------------------------------------------------------------------------------------
+static Mutex_t* GetNextMutex
+(
+    MutexIter_Ref_t mutexIterRef ///< [IN] The iterator to get the next mutex from.
+)
+{
+    le_dls_Link_t* remThreadMemberObjNextLinkPtr =
+        GetNextThreadMemberObjLinkPtr(INSPECT_INSP_TYPE_MUTEX,
+                                      (ThreadMemberObjIter_Ref_t)mutexIterRef);
+
+    if (remThreadMemberObjNextLinkPtr == NULL)
+    {
+        return NULL;
+    }
+
+    // Get the address of mutex.
+    Mutex_t* remMutexPtr = CONTAINER_OF(remThreadMemberObjNextLinkPtr, Mutex_t, lockedByThreadLink);
 
     // Read the mutex into our own memory.
     if (fd_ReadFromOffset(FdProcMem, (ssize_t)remMutexPtr, &(mutexIterRef->currMutex),
@@ -1337,6 +1807,74 @@ static Semaphore_t* GetNextSemaphore
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next reader-writer lock from the specified iterator. For other detail see
+ * GetNextMemPool.
+ *
+ * @return
+ *      A reader-writer lock from the iterator's list of reader-writer locks.
+ */
+//--------------------------------------------------------------------------------------------------
+static RwLock_t* GetNextRwLock
+(
+    RwLockIter_Ref_t rwLockIterRef ///< [IN] The iterator to get the next reader-writer lock from.
+)
+{
+    le_dls_Link_t* linkPtr = GetNextLink(&(rwLockIterRef->rwLockList),
+                                         &(rwLockIterRef->currRwLock.rwLockListLink));
+
+    if (linkPtr == NULL)
+    {
+        return NULL;
+    }
+
+    RwLock_t* remRwLockPtr = CONTAINER_OF(linkPtr, RwLock_t, rwLockListLink);
+
+    if (fd_ReadFromOffset(FdProcMem, (ssize_t)remRwLockPtr, &(rwLockIterRef->currRwLock),
+                          sizeof(rwLockIterRef->currRwLock)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("reader-writer lock object"));
+    }
+
+    return &(rwLockIterRef->currRwLock);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next condition variable from the specified iterator. For other detail see
+ * GetNextMemPool.
+ *
+ * @return
+ *      A condition variable from the iterator's list of condition variables.
+ */
+//--------------------------------------------------------------------------------------------------
+static Cond_t* GetNextCond
+(
+    CondIter_Ref_t condIterRef ///< [IN] The iterator to get the next condition variable from.
+)
+{
+    le_dls_Link_t* linkPtr = GetNextLink(&(condIterRef->condList),
+                                         &(condIterRef->currCond.condListLink));
+
+    if (linkPtr == NULL)
+    {
+        return NULL;
+    }
+
+    Cond_t* remCondPtr = CONTAINER_OF(linkPtr, Cond_t, condListLink);
+
+    if (fd_ReadFromOffset(FdProcMem, (ssize_t)remCondPtr, &(condIterRef->currCond),
+                          sizeof(condIterRef->currCond)) != LE_OK)
+    {
+        INTERNAL_ERR(REMOTE_READ_ERR("condition variable object"));
+    }
+
+    return &(condIterRef->currCond);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the pointer to the next interface instance object. For other detail see GetNextMemPool.
@@ -1365,7 +1903,8 @@ static void* GetNextInterfaceObjPtr
     while (remEntryNextLinkPtr == NULL)
     {
         // Increment the bucket index. Return null if we run out of buckets.
-        if (iterator->currIndex < (iterator->interfaceObjMap.bucketCount - 1))
+        if (iterator->currIndex < (iterator->interfaceObjMap.oldBucketCount +
+                                   iterator->interfaceObjMap.bucketCount - 1))
         {
             iterator->currIndex++;
         }
@@ -1376,7 +1915,8 @@ static void* GetNextInterfaceObjPtr
 
         // So we haven't run out of buckets yet. Then update our interface object list.
         if (fd_ReadFromOffset(FdProcMem,
-                              (ssize_t)(iterator->interfaceObjMap.bucketsPtr + iterator->currIndex),
+                              (ssize_t)GetRemoteBucket(&iterator->interfaceObjMap,
+                                                       iterator->currIndex),
                               &(iterator->interfaceObjList.List),
                               sizeof(iterator->interfaceObjList.List)) != LE_OK)
         {
@@ -1535,6 +2075,110 @@ static msgSession_Session_t* GetNextSessionObj
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the event loop of a thread object, and its statistics if it keeps any, into the iterator.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadEventLoop
+(
+    EventLoopIter_Ref_t eventLoopIterRef, ///< [IN] The iterator to read the event loop into.
+    thread_Obj_t* threadObjRef            ///< [IN] Local copy of the thread obj.
+)
+{
+    EventLoopNode_t* eventLoopPtr = &(eventLoopIterRef->currEventLoop);
+
+    strncpy(eventLoopPtr->threadName, threadObjRef->name, sizeof(eventLoopPtr->threadName));
+    eventLoopPtr->eventRec = threadObjRef->eventRec;
+    eventLoopPtr->hasStats = (threadObjRef->eventRec.statsPtr != NULL);
+    eventLoopPtr->handlerIndex = 0;
+
+    if (eventLoopPtr->hasStats)
+    {
+        // Read the statistics into our own memory.
+        if (fd_ReadFromOffset(FdProcMem, (ssize_t)threadObjRef->eventRec.statsPtr,
+                              &(eventLoopPtr->stats), sizeof(eventLoopPtr->stats)) != LE_OK)
+        {
+            INTERNAL_ERR(REMOTE_READ_ERR("event loop statistics"));
+        }
+
+        // Nothing stops the statistics changing while they're read, so don't trust the count.
+        if (eventLoopPtr->stats.numHandlers > EVENT_STATS_MAX_HANDLERS)
+        {
+            eventLoopPtr->stats.numHandlers = EVENT_STATS_MAX_HANDLERS;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next event loop from the specified iterator. Like GetNextSemaphore, this walks the
+ * thread objects directly, since each thread obj owns one event loop. For other detail see
+ * GetNextMemPool.
+ *
+ * @return
+ *      An event loop from the iterator's list of thread objs.
+ */
+//--------------------------------------------------------------------------------------------------
+static EventLoopNode_t* GetNextEventLoop
+(
+    EventLoopIter_Ref_t eventLoopIterRef ///< [IN] The iterator to get the next event loop from.
+)
+{
+    thread_Obj_t* threadObjRef = GetNextThreadObj(&(eventLoopIterRef->threadObjIter));
+
+    if (threadObjRef == NULL)
+    {
+        return NULL;
+    }
+
+    ReadEventLoop(eventLoopIterRef, threadObjRef);
+
+    return &(eventLoopIterRef->currEventLoop);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next event handler from the specified iterator. Event handlers are only known for the
+ * event loops that keep statistics, so the other event loops are skipped. For other detail see
+ * GetNextMemPool.
+ *
+ * @return
+ *      An event loop, with the handlerIndex of the next handler in its statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static EventLoopNode_t* GetNextEventHandler
+(
+    EventLoopIter_Ref_t eventLoopIterRef ///< [IN] The iterator to get the next event handler from.
+)
+{
+    EventLoopNode_t* eventLoopPtr = &(eventLoopIterRef->currEventLoop);
+
+    if (eventLoopPtr->hasStats)
+    {
+        eventLoopPtr->handlerIndex++;
+    }
+
+    // Move on to the next event loop with statistics once the current one runs out of handlers.
+    while ((!eventLoopPtr->hasStats) ||
+           (eventLoopPtr->handlerIndex >= eventLoopPtr->stats.numHandlers))
+    {
+        thread_Obj_t* threadObjRef = GetNextThreadObj(&(eventLoopIterRef->threadObjIter));
+
+        if (threadObjRef == NULL)
+        {
+            return NULL;
+        }
+
+        ReadEventLoop(eventLoopIterRef, threadObjRef);
+    }
+
+    return eventLoopPtr;
+}
+
+
 // TODO: migrate the above to a separate module.
 //--------------------------------------------------------------------------------------------------
 /**
@@ -1552,16 +2196,24 @@ static void PrintHelp
         "              Legato process.\n"
         "\n"
         "SYNOPSIS:\n"
-        "    inspect <pools|threads|timers|mutexes|semaphores> [OPTIONS] PID\n"
+        "    inspect <pools|threads|timers|mutexes|semaphores|rwlocks|conds> [OPTIONS] PID\n"
         "    inspect ipc <servers|clients [sessions]> [OPTIONS] PID\n"
+        "    inspect events [handlers] [OPTIONS] PID\n"
         "\n"
         "DESCRIPTION:\n"
         "    inspect pools              Prints the memory pools usage for the specified process.\n"
-        "    inspect threads            Prints the info of threads for the specified process.\n"
+        "    inspect threads            Prints the info of threads (including CPU time used) for the specified process.\n"
         "    inspect timers             Prints the info of timers in all threads for the specified process.\n"
         "    inspect mutexes            Prints the info of mutexes in all threads for the specified process.\n"
         "    inspect semaphores         Prints the info of semaphores in all threads for the specified process.\n"
+        "    inspect rwlocks            Prints the info of reader-writer locks for the specified process,\n"
+        "                               including how many times readers and writers have had to wait.\n"
+        "    inspect conds              Prints the info of condition variables for the specified process.\n"
         "    inspect ipc                Prints the info of ipc in all threads for the specified process.\n"
+        "    inspect events             Prints the event loop statistics of all threads for the specified process.\n"
+        "    inspect events handlers    Prints the execution times of the event handlers in all threads for\n"
+        "                               the specified process.  Statistics are only kept for processes\n"
+        "                               started with the LE_EVENT_STATS environment variable set.\n"
         "\n"
         "OPTIONS:\n"
         "    -f\n"
@@ -1623,6 +2275,23 @@ static size_t TableLineLen = 0;
 static char* TableLineBuffer;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Max length of the text showing an event loop time histogram. Longer histograms are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HISTOGRAM_TEXT_LEN  120
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Max size of the list of CPUs a thread can run on (e.g., "0-3,6"), as shown in the thread table.
+ * Longer lists are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_CPU_LIST_BYTES  16
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Strings representing sub-pool and super-pool.
@@ -1668,7 +2337,10 @@ static ColumnInfo_t ThreadObjTableInfo[] =
     {"CONTENTION SCOPE", "%*s", NULL, "%*s",  0,                    true,  0, true},
     {"GUARD SIZE",       "%*s", NULL, "%*zu", sizeof(size_t),       false, 0, true},
     {"STACK ADDR",       "%*s", NULL, "%*X",  sizeof(uint64_t),     false, 0, true},
-    {"STACK SIZE",       "%*s", NULL, "%*zu", sizeof(size_t),       false, 0, true}
+    {"STACK SIZE",       "%*s", NULL, "%*zu", sizeof(size_t),       false, 0, true},
+    {"TID",              "%*s", NULL, "%*d",  sizeof(pid_t),        false, 0, true},
+    {"CPUS",             "%*s", NULL, "%*s",  MAX_CPU_LIST_BYTES,   true,  0, true},
+    {"CPU TIME",         "%*s", NULL, "%*f",  sizeof(double),       false, 0, true}
 };
 static size_t ThreadObjTableInfoSize = NUM_ARRAY_MEMBERS(ThreadObjTableInfo);
 
@@ -1699,6 +2371,27 @@ static ColumnInfo_t SemaphoreTableInfo[] =
 };
 static size_t SemaphoreTableInfoSize = NUM_ARRAY_MEMBERS(SemaphoreTableInfo);
 
+static ColumnInfo_t RwLockTableInfo[] =
+{
+    {"NAME",         "%*s", NULL, "%*s",  LIMIT_MAX_RWLOCK_NAME_BYTES, true,  0, true},
+    {"READERS",      "%*s", NULL, "%*zu", sizeof(uint16_t),            false, 0, true},
+    {"WRITER",       "%*s", NULL, "%*s",  MAX_THREAD_NAME_SIZE,        true,  0, true},
+    {"READ WAITS",   "%*s", NULL, "%*zu", sizeof(uint32_t),            false, 0, true},
+    {"WRITE WAITS",  "%*s", NULL, "%*zu", sizeof(uint32_t),            false, 0, true},
+    {"WAITING LIST", "%*s", NULL, "%*s",  MAX_THREAD_NAME_SIZE,        true,  0, true}
+};
+static size_t RwLockTableInfoSize = NUM_ARRAY_MEMBERS(RwLockTableInfo);
+
+static ColumnInfo_t CondTableInfo[] =
+{
+    {"NAME",         "%*s", NULL, "%*s",  LIMIT_MAX_COND_NAME_BYTES, true,  0, true},
+    {"WAITERS",      "%*s", NULL, "%*u",  sizeof(uint16_t),          false, 0, true},
+    {"WAITS",        "%*s", NULL, "%*zu", sizeof(uint32_t),          false, 0, true},
+    {"TIMEOUTS",     "%*s", NULL, "%*zu", sizeof(uint32_t),          false, 0, true},
+    {"SIGNALS",      "%*s", NULL, "%*zu", sizeof(uint32_t),          false, 0, true}
+};
+static size_t CondTableInfoSize = NUM_ARRAY_MEMBERS(CondTableInfo);
+
 static ColumnInfo_t ServiceObjTableInfo[] =
 {
     {"INTERFACE NAME", "%*s", NULL, "%*s",  LIMIT_MAX_IPC_INTERFACE_NAME_BYTES, true,  0, true},
@@ -1727,6 +2420,36 @@ static ColumnInfo_t SessionObjTableInfo[] =
 };
 static size_t SessionObjTableInfoSize = NUM_ARRAY_MEMBERS(SessionObjTableInfo);
 
+static ColumnInfo_t EventLoopTableInfo[] =
+{
+    {"THREAD NAME",       "%*s",  NULL, "%*s",        MAX_THREAD_NAME_SIZE, true,  0, true},
+    {"QUEUE MAX",         "%*s",  NULL, "%*zu",       sizeof(uint32_t),     false, 0, true},
+    {"URGENT MAX",        "%*s",  NULL, "%*zu",       sizeof(uint32_t),     false, 0, true},
+    {"WAKEUPS",           "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),     false, 0, true},
+    {"WAKEUPS/S",         "%*s",  NULL, "%*u",        sizeof(uint16_t),     false, 0, true},
+    {"AVG WAKEUPS/S",     "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),     false, 0, false},
+    {"DISPATCHED",        "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),     false, 0, true},
+    {"AVG LATENCY US",    "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),     false, 0, true},
+    {"P99 LATENCY US",    "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),     false, 0, true},
+    {"MAX LATENCY US",    "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),     false, 0, true},
+    {"LATENCY HISTOGRAM", "%-*s", NULL, "%-*s",       HISTOGRAM_TEXT_LEN,   true,  0, false}
+};
+static size_t EventLoopTableInfoSize = NUM_ARRAY_MEMBERS(EventLoopTableInfo);
+
+static ColumnInfo_t EventHandlerTableInfo[] =
+{
+    {"THREAD NAME",  "%*s",  NULL, "%*s",        MAX_THREAD_NAME_SIZE,               true,  0, true},
+    {"HANDLER NAME", "%*s",  NULL, "%*s",        LIMIT_MAX_EVENT_HANDLER_NAME_BYTES, true,  0, true},
+    {"CALLS",        "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),                   false, 0, true},
+    {"AVG US",       "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),                   false, 0, true},
+    {"P50 US",       "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),                   false, 0, true},
+    {"P99 US",       "%*s",  NULL, "%*"PRIu64"", sizeof(uint16_t),                   false, 0, true},
+    {"MAX US",       "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),                   false, 0, true},
+    {"TOTAL US",     "%*s",  NULL, "%*"PRIu64"", sizeof(uint32_t),                   false, 0, false},
+    {"HISTOGRAM",    "%-*s", NULL, "%-*s",       HISTOGRAM_TEXT_LEN,                 true,  0, false}
+};
+static size_t EventHandlerTableInfoSize = NUM_ARRAY_MEMBERS(EventHandlerTableInfo);
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -2042,6 +2765,14 @@ static void InitDisplay
             InitDisplayTable(SemaphoreTableInfo, SemaphoreTableInfoSize);
             break;
 
+        case INSPECT_INSP_TYPE_RWLOCK:
+            InitDisplayTable(RwLockTableInfo, RwLockTableInfoSize);
+            break;
+
+        case INSPECT_INSP_TYPE_COND:
+            InitDisplayTable(CondTableInfo, CondTableInfoSize);
+            break;
+
         case INSPECT_INSP_TYPE_IPC_SERVERS:
             InitDisplayTable(ServiceObjTableInfo, ServiceObjTableInfoSize);
             break;
@@ -2055,6 +2786,14 @@ static void InitDisplay
             InitDisplayTable(SessionObjTableInfo, SessionObjTableInfoSize);
             break;
 
+        case INSPECT_INSP_TYPE_EVENT_LOOP:
+            InitDisplayTable(EventLoopTableInfo, EventLoopTableInfoSize);
+            break;
+
+        case INSPECT_INSP_TYPE_EVENT_HANDLER:
+            InitDisplayTable(EventHandlerTableInfo, EventHandlerTableInfoSize);
+            break;
+
         default:
             INTERNAL_ERR("Failed to initialize display table - unexpected inspect type %d.",
                          inspectType);
@@ -2237,6 +2976,18 @@ static int PrintInspectHeader
             tableSize = SemaphoreTableInfoSize;
             break;
 
+        case INSPECT_INSP_TYPE_RWLOCK:
+            strncpy(inspectTypeString, "Reader-Writer Locks", inspectTypeStringSize);
+            table = RwLockTableInfo;
+            tableSize = RwLockTableInfoSize;
+            break;
+
+        case INSPECT_INSP_TYPE_COND:
+            strncpy(inspectTypeString, "Condition Variables", inspectTypeStringSize);
+            table = CondTableInfo;
+            tableSize = CondTableInfoSize;
+            break;
+
         case INSPECT_INSP_TYPE_IPC_SERVERS:
             strncpy(inspectTypeString, "IPC Server Interface", inspectTypeStringSize);
             table = ServiceObjTableInfo;
@@ -2261,6 +3012,18 @@ static int PrintInspectHeader
             tableSize = SessionObjTableInfoSize;
             break;
 
+        case INSPECT_INSP_TYPE_EVENT_LOOP:
+            strncpy(inspectTypeString, "Event Loops", inspectTypeStringSize);
+            table = EventLoopTableInfo;
+            tableSize = EventLoopTableInfoSize;
+            break;
+
+        case INSPECT_INSP_TYPE_EVENT_HANDLER:
+            strncpy(inspectTypeString, "Event Handlers", inspectTypeStringSize);
+            table = EventHandlerTableInfo;
+            tableSize = EventHandlerTableInfoSize;
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", InspectType);
     }
@@ -2860,6 +3623,11 @@ static int PrintThreadObjInfo
         INTERNAL_ERR("pthread_attr_getstack failed.");
     }
 
+    char cpuList[MAX_CPU_LIST_BYTES];
+    GetThreadCpuList(threadObjRef->tid, cpuList, sizeof(cpuList));
+
+    double cpuTime = GetThreadCpuTime(threadObjRef->tid);
+
     // Output thread object info
     int index = 0;
 
@@ -2887,6 +3655,12 @@ static int PrintThreadObjInfo
                                                                     ThreadObjTableInfoSize, &index);
         FillSizeTColField (stackSize,                               ThreadObjTableInfo,
                                                                     ThreadObjTableInfoSize, &index);
+        FillIntColField   (threadObjRef->tid,                       ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        FillStrColField   (cpuList,                                 ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        FillDoubleColField(cpuTime,                                 ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
 
         PrintInfo(ThreadObjTableInfo, ThreadObjTableInfoSize);
         lineCount++;
@@ -2929,6 +3703,12 @@ static int PrintThreadObjInfo
                                                           ThreadObjTableInfoSize, &index, &printed);
         ExportSizeTToJson (stackSize,                     ThreadObjTableInfo,
                                                           ThreadObjTableInfoSize, &index, &printed);
+        ExportIntToJson   (threadObjRef->tid,             ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        ExportStrToJson   (cpuList,                       ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        ExportDoubleToJson(cpuTime,                       ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
 
         printf("]");
     }
@@ -3044,23 +3824,45 @@ static thread_Obj_t* GetThreadPtrFromSemLink
     return CONTAINER_OF(currNodePtr, thread_Obj_t, semaphoreRec);
 }
 
-// Retrieve the waiting list link from a mutex or semaphore thread record.
-static le_dls_Link_t GetWaitingListLink
+// Given a waiting list link ptr, get a ptr to the thread record
+static void* GetRwLockThreadRecPtr
 (
-    InspType_t inspectType, ///< [IN] What to inspect.
-    void* threadRecPtr
+    le_dls_Link_t* currNodeLinkPtr  ///< [IN] waiting list link ptr.
 )
 {
-    switch (inspectType)
-    {
-        case INSPECT_INSP_TYPE_MUTEX:
-            return ((mutex_ThreadRec_t*)threadRecPtr)->waitingListLink;
-            break;
+    return CONTAINER_OF(currNodeLinkPtr, rwlock_ThreadRec_t, waitingListLink);
+}
+
+// Given a thread rec ptr, get a ptr to the thread obj
+static thread_Obj_t* GetThreadPtrFromRwLockLink
+(
+    void* currNodePtr    ///< [IN] thread record ptr.
+)
+{
+    return CONTAINER_OF(currNodePtr, thread_Obj_t, rwLockRec);
+}
+
+// Retrieve the waiting list link from a mutex, semaphore or reader-writer lock thread record.
+static le_dls_Link_t GetWaitingListLink
+(
+    InspType_t inspectType, ///< [IN] What to inspect.
+    void* threadRecPtr
+)
+{
+    switch (inspectType)
+    {
+        case INSPECT_INSP_TYPE_MUTEX:
+            return ((mutex_ThreadRec_t*)threadRecPtr)->waitingListLink;
+            break;
 
         case INSPECT_INSP_TYPE_SEMAPHORE:
             return ((sem_ThreadRec_t*)threadRecPtr)->waitingListLink;
             break;
 
+        case INSPECT_INSP_TYPE_RWLOCK:
+            return ((rwlock_ThreadRec_t*)threadRecPtr)->waitingListLink;
+            break;
+
         default:
             INTERNAL_ERR("Failed to get the waiting list link - unexpected inspect type %d.",
                          inspectType);
@@ -3091,6 +3893,7 @@ static void GetWaitingListThreadNames
     {
         mutex_ThreadRec_t m;
         sem_ThreadRec_t s;
+        rwlock_ThreadRec_t r;
     }
     ThreadRec_t;
 
@@ -3110,6 +3913,12 @@ static void GetWaitingListThreadNames
             threadRecSize = sizeof(sem_ThreadRec_t);
             break;
 
+        case INSPECT_INSP_TYPE_RWLOCK:
+            getThreadRecPtrFunc      = GetRwLockThreadRecPtr;
+            getThreadPtrFromLinkFunc = GetThreadPtrFromRwLockLink;
+            threadRecSize = sizeof(rwlock_ThreadRec_t);
+            break;
+
         default:
             INTERNAL_ERR("Failed to get the waiting list link - unexpected inspect type %d.",
                          inspectType);
@@ -3382,6 +4191,155 @@ static int PrintSemaphoreInfo
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print reader-writer lock information to stdout.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintRwLockInfo
+(
+    RwLock_t* rwLockRef   ///< [IN] ref to reader-writer lock to be printed.
+)
+{
+    int lineCount = 0;
+
+    #define MAX_THREADS 400 // should be plenty; with an AR7 only 379 threads can be created.
+    char* waitingThreadNames[MAX_THREADS] = {0};
+    int i = 0;
+    GetWaitingListThreadNames(INSPECT_INSP_TYPE_RWLOCK, rwLockRef->waitingList,
+                              waitingThreadNames, MAX_THREADS, &i);
+
+    // Get the name of the thread holding the lock for writing, if any.
+    thread_Obj_t writerThreadObj;
+    memset(writerThreadObj.name, 0, sizeof(writerThreadObj.name));
+
+    if (rwLockRef->writerRecPtr != NULL)
+    {
+        thread_Obj_t* remThreadObjPtr = CONTAINER_OF(rwLockRef->writerRecPtr, thread_Obj_t,
+                                                     rwLockRec);
+
+        if (fd_ReadFromOffset(FdProcMem, (ssize_t)remThreadObjPtr, &writerThreadObj,
+                              sizeof(writerThreadObj)) != LE_OK)
+        {
+            INTERNAL_ERR(REMOTE_READ_ERR("thread object"));
+        }
+    }
+
+    // Output reader-writer lock info
+    int index = 0;
+
+    if (!IsOutputJson)
+    {
+        FillStrColField  (rwLockRef->name,          RwLockTableInfo, RwLockTableInfoSize, &index);
+        FillSizeTColField(rwLockRef->readerCount,   RwLockTableInfo, RwLockTableInfoSize, &index);
+        FillStrColField  (writerThreadObj.name,     RwLockTableInfo, RwLockTableInfoSize, &index);
+        FillSizeTColField(rwLockRef->readWaitCount, RwLockTableInfo, RwLockTableInfoSize, &index);
+        FillSizeTColField(rwLockRef->writeWaitCount, RwLockTableInfo, RwLockTableInfoSize, &index);
+        FillStrColField  (waitingThreadNames[0],    RwLockTableInfo, RwLockTableInfoSize, &index);
+
+        PrintInfo(RwLockTableInfo, RwLockTableInfoSize);
+        lineCount++;
+
+        int j;
+        for (j = 1; j < i; j++)
+        {
+            PrintUnderColumn("WAITING LIST", RwLockTableInfo, RwLockTableInfoSize,
+                             waitingThreadNames[j]);
+            lineCount++;
+        }
+    }
+    else
+    {
+        int waitingThreadJsonArraySize = EstimateJsonArraySizeFromStrings(waitingThreadNames, i);
+        char waitingThreadJsonArray[waitingThreadJsonArraySize];
+        ConstructJsonArrayFromStrings(waitingThreadNames, i, waitingThreadJsonArray,
+                                      waitingThreadJsonArraySize);
+
+        // If it's not the first time, print a comma.
+        if (!IsPrintedNodeFirst)
+        {
+            printf(",");
+        }
+        else
+        {
+            IsPrintedNodeFirst = false;
+        }
+
+        bool printed = false;
+
+        printf("[");
+
+        ExportStrToJson  (rwLockRef->name,           RwLockTableInfo,
+                                                     RwLockTableInfoSize, &index, &printed);
+        ExportSizeTToJson(rwLockRef->readerCount,    RwLockTableInfo,
+                                                     RwLockTableInfoSize, &index, &printed);
+        ExportStrToJson  (writerThreadObj.name,      RwLockTableInfo,
+                                                     RwLockTableInfoSize, &index, &printed);
+        ExportSizeTToJson(rwLockRef->readWaitCount,  RwLockTableInfo,
+                                                     RwLockTableInfoSize, &index, &printed);
+        ExportSizeTToJson(rwLockRef->writeWaitCount, RwLockTableInfo,
+                                                     RwLockTableInfoSize, &index, &printed);
+        ExportArrayToJson(waitingThreadJsonArray,    RwLockTableInfo,
+                                                     RwLockTableInfoSize, &index, &printed);
+
+        printf("]");
+    }
+
+    return lineCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print condition variable information to stdout.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintCondInfo
+(
+    Cond_t* condRef   ///< [IN] ref to condition variable to be printed.
+)
+{
+    int index = 0;
+
+    if (!IsOutputJson)
+    {
+        FillStrColField   (condRef->name,         CondTableInfo, CondTableInfoSize, &index);
+        FillUint32ColField(condRef->numWaiters,   CondTableInfo, CondTableInfoSize, &index);
+        FillSizeTColField (condRef->waitCount,    CondTableInfo, CondTableInfoSize, &index);
+        FillSizeTColField (condRef->timeoutCount, CondTableInfo, CondTableInfoSize, &index);
+        FillSizeTColField (condRef->signalCount,  CondTableInfo, CondTableInfoSize, &index);
+
+        PrintInfo(CondTableInfo, CondTableInfoSize);
+
+        return 1;
+    }
+
+    // If it's not the first time, print a comma.
+    if (!IsPrintedNodeFirst)
+    {
+        printf(",");
+    }
+    else
+    {
+        IsPrintedNodeFirst = false;
+    }
+
+    bool printed = false;
+
+    printf("[");
+
+    ExportStrToJson   (condRef->name,         CondTableInfo, CondTableInfoSize, &index, &printed);
+    ExportUint32ToJson(condRef->numWaiters,   CondTableInfo, CondTableInfoSize, &index, &printed);
+    ExportSizeTToJson (condRef->waitCount,    CondTableInfo, CondTableInfoSize, &index, &printed);
+    ExportSizeTToJson (condRef->timeoutCount, CondTableInfo, CondTableInfoSize, &index, &printed);
+    ExportSizeTToJson (condRef->signalCount,  CondTableInfo, CondTableInfoSize, &index, &printed);
+
+    printf("]");
+
+    return 0;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Look up the thread name associated with the thread object safe ref being passed in. If there's no
@@ -3646,6 +4604,331 @@ static int PrintSessionObjInfo
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Helper functions for the event loop statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+// Get the current second of the monotonic clock, which the statistics are based on.
+static uint64_t GetMonotonicSecond
+(
+    void
+)
+{
+    struct timespec now;
+
+    INTERNAL_ERR_IF(clock_gettime(CLOCK_MONOTONIC, &now) != 0, "clock_gettime failed.");
+
+    return now.tv_sec;
+}
+
+// Get the number of wake-ups of an event loop in the last full second.
+static uint32_t GetWakeupsInLastSecond
+(
+    event_Stats_t* statsPtr ///< [IN] event loop statistics.
+)
+{
+    uint64_t lastSecond = GetMonotonicSecond() - 1;
+
+    if (statsPtr->wakeupSecond == lastSecond)
+    {
+        return statsPtr->wakeupsInSecond;
+    }
+    else if (statsPtr->prevWakeupSecond == lastSecond)
+    {
+        return statsPtr->wakeupsInPrevSecond;
+    }
+
+    return 0;
+}
+
+// Get the average number of wake-ups per second of an event loop since it started.
+static uint64_t GetAvgWakeupsPerSecond
+(
+    event_Stats_t* statsPtr ///< [IN] event loop statistics.
+)
+{
+    uint64_t seconds = GetMonotonicSecond() - statsPtr->startSecond;
+
+    return statsPtr->wakeupCount / (seconds > 0 ? seconds : 1);
+}
+
+// Get the average time in a histogram.
+static uint64_t GetHistogramAvg
+(
+    event_Histogram_t* histogramPtr ///< [IN] time histogram.
+)
+{
+    return (histogramPtr->count > 0 ? histogramPtr->totalUsec / histogramPtr->count : 0);
+}
+
+// Get an upper bound for a percentile of the times in a histogram.  Bucket n only holds times
+// under 2^n microseconds, except for the last one, so this is within a factor of two.
+static uint64_t GetHistogramPercentile
+(
+    event_Histogram_t* histogramPtr, ///< [IN] time histogram.
+    uint64_t percent                 ///< [IN] percentile.
+)
+{
+    uint64_t target = (histogramPtr->count * percent + 99) / 100;
+    uint64_t count = 0;
+    int i;
+
+    for (i = 0; i < EVENT_STATS_HISTOGRAM_BUCKETS - 1; i++)
+    {
+        count += histogramPtr->buckets[i];
+
+        if ((count >= target) && (count > 0))
+        {
+            uint64_t upperBound = (uint64_t)1 << i;
+            return (upperBound < histogramPtr->maxUsec ? upperBound : histogramPtr->maxUsec);
+        }
+    }
+
+    return histogramPtr->maxUsec;
+}
+
+// Format the non-empty buckets of a histogram as text (e.g. "<1us:5 <2us:40 >=4194304us:1"), or
+// all of the buckets as a json array.
+static void FormatHistogram
+(
+    event_Histogram_t* histogramPtr, ///< [IN] time histogram.
+    char* buffer,                    ///< [OUT] buffer for the text.
+    size_t bufferSize                ///< [IN] buffer size.
+)
+{
+    size_t index = 0;
+    int i;
+
+    buffer[0] = '\0';
+
+    for (i = 0; (i < EVENT_STATS_HISTOGRAM_BUCKETS) && (index < bufferSize); i++)
+    {
+        uint32_t count = histogramPtr->buckets[i];
+
+        if (IsOutputJson)
+        {
+            index += snprintf(buffer + index, bufferSize - index, "%s%"PRIu32,
+                              (i == 0 ? "[" : ","), count);
+        }
+        else if (count > 0)
+        {
+            index += snprintf(buffer + index, bufferSize - index, "%s%s%"PRIu64"us:%"PRIu32,
+                              (index == 0 ? "" : " "),
+                              (i < EVENT_STATS_HISTOGRAM_BUCKETS - 1 ? "<" : ">="),
+                              (uint64_t)1 << (i < EVENT_STATS_HISTOGRAM_BUCKETS - 1 ? i : i - 1),
+                              count);
+        }
+    }
+
+    if (IsOutputJson && (index < bufferSize))
+    {
+        snprintf(buffer + index, bufferSize - index, "]");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print event loop information to stdout.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintEventLoopInfo
+(
+    EventLoopNode_t* eventLoopRef   ///< [IN] ref to event loop to be printed.
+)
+{
+    int lineCount = 0;
+
+    // Threads that don't keep statistics get all zeros.
+    event_Stats_t* statsPtr = &(eventLoopRef->stats);
+    if (!eventLoopRef->hasStats)
+    {
+        memset(statsPtr, 0, sizeof(*statsPtr));
+        statsPtr->startSecond = GetMonotonicSecond();
+    }
+
+    uint32_t wakeupsInLastSecond = GetWakeupsInLastSecond(statsPtr);
+    uint64_t avgWakeupsPerSecond = GetAvgWakeupsPerSecond(statsPtr);
+    uint64_t avgLatency = GetHistogramAvg(&(statsPtr->dispatchLatency));
+    uint64_t p99Latency = GetHistogramPercentile(&(statsPtr->dispatchLatency), 99);
+
+    // A json array of all buckets needs room for the biggest count in each.
+    char histogram[EVENT_STATS_HISTOGRAM_BUCKETS * 11 + 2];
+    FormatHistogram(&(statsPtr->dispatchLatency), histogram, sizeof(histogram));
+
+    // Output event loop info
+    int index = 0;
+
+    if (!IsOutputJson)
+    {
+        FillStrColField   (eventLoopRef->threadName,                  EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillSizeTColField (eventLoopRef->eventRec.eventQueue.maxLength, EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillSizeTColField (eventLoopRef->eventRec.urgentQueue.maxLength, EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint64ColField(statsPtr->wakeupCount,                     EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint32ColField(wakeupsInLastSecond,                       EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint64ColField(avgWakeupsPerSecond,                       EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint64ColField(statsPtr->dispatchLatency.count,           EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint64ColField(avgLatency,                                EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint64ColField(p99Latency,                                EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillUint64ColField(statsPtr->dispatchLatency.maxUsec,         EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+        FillStrColField   (histogram,                                 EventLoopTableInfo,
+                                                                      EventLoopTableInfoSize, &index);
+
+        PrintInfo(EventLoopTableInfo, EventLoopTableInfoSize);
+        lineCount++;
+    }
+    else
+    {
+        // If it's not the first time, print a comma.
+        if (!IsPrintedNodeFirst)
+        {
+            printf(",");
+        }
+        else
+        {
+            IsPrintedNodeFirst = false;
+        }
+
+        bool printed = false;
+
+        printf("[");
+
+        ExportStrToJson   (eventLoopRef->threadName,          EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportSizeTToJson (eventLoopRef->eventRec.eventQueue.maxLength, EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportSizeTToJson (eventLoopRef->eventRec.urgentQueue.maxLength, EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint64ToJson(statsPtr->wakeupCount,             EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint32ToJson(wakeupsInLastSecond,               EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint64ToJson(avgWakeupsPerSecond,               EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint64ToJson(statsPtr->dispatchLatency.count,   EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint64ToJson(avgLatency,                        EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint64ToJson(p99Latency,                        EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportUint64ToJson(statsPtr->dispatchLatency.maxUsec, EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+        ExportArrayToJson (histogram,                         EventLoopTableInfo,
+                                                              EventLoopTableInfoSize, &index, &printed);
+
+        printf("]");
+    }
+
+    return lineCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print event handler information to stdout.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintEventHandlerInfo
+(
+    EventLoopNode_t* eventLoopRef   ///< [IN] ref to event loop whose current handler is printed.
+)
+{
+    int lineCount = 0;
+
+    event_HandlerStats_t* handlerStatsPtr =
+        &(eventLoopRef->stats.handlers[eventLoopRef->handlerIndex]);
+    event_Histogram_t* execTimePtr = &(handlerStatsPtr->execTime);
+
+    // The name could be torn if it was being written while it was read.
+    handlerStatsPtr->name[sizeof(handlerStatsPtr->name) - 1] = '\0';
+
+    uint64_t avgTime = GetHistogramAvg(execTimePtr);
+    uint64_t p50Time = GetHistogramPercentile(execTimePtr, 50);
+    uint64_t p99Time = GetHistogramPercentile(execTimePtr, 99);
+
+    char histogram[EVENT_STATS_HISTOGRAM_BUCKETS * 11 + 2];
+    FormatHistogram(execTimePtr, histogram, sizeof(histogram));
+
+    // Output event handler info
+    int index = 0;
+
+    if (!IsOutputJson)
+    {
+        FillStrColField   (eventLoopRef->threadName, EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillStrColField   (handlerStatsPtr->name,    EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillUint64ColField(execTimePtr->count,       EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillUint64ColField(avgTime,                  EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillUint64ColField(p50Time,                  EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillUint64ColField(p99Time,                  EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillUint64ColField(execTimePtr->maxUsec,     EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillUint64ColField(execTimePtr->totalUsec,   EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+        FillStrColField   (histogram,                EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index);
+
+        PrintInfo(EventHandlerTableInfo, EventHandlerTableInfoSize);
+        lineCount++;
+    }
+    else
+    {
+        // If it's not the first time, print a comma.
+        if (!IsPrintedNodeFirst)
+        {
+            printf(",");
+        }
+        else
+        {
+            IsPrintedNodeFirst = false;
+        }
+
+        bool printed = false;
+
+        printf("[");
+
+        ExportStrToJson   (eventLoopRef->threadName, EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportStrToJson   (handlerStatsPtr->name,    EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportUint64ToJson(execTimePtr->count,       EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportUint64ToJson(avgTime,                  EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportUint64ToJson(p50Time,                  EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportUint64ToJson(p99Time,                  EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportUint64ToJson(execTimePtr->maxUsec,     EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportUint64ToJson(execTimePtr->totalUsec,   EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+        ExportArrayToJson (histogram,                EventHandlerTableInfo,
+                                                     EventHandlerTableInfoSize, &index, &printed);
+
+        printf("]");
+    }
+
+    return lineCount;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function prototype needed by InspectEndHandling.
@@ -3805,6 +5088,20 @@ static void InspectFunc
             printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintSemaphoreInfo;
             break;
 
+        case INSPECT_INSP_TYPE_RWLOCK:
+            createIterFunc    = (CreateIterFunc_t)    CreateRwLockIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetRwLockListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextRwLock;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintRwLockInfo;
+            break;
+
+        case INSPECT_INSP_TYPE_COND:
+            createIterFunc    = (CreateIterFunc_t)    CreateCondIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetCondListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextCond;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintCondInfo;
+            break;
+
         case INSPECT_INSP_TYPE_IPC_SERVERS:
             createIterFunc    = (CreateIterFunc_t)    CreateServiceObjIter;
             getListChgCntFunc = (GetListChgCntFunc_t) GetInterfaceObjMapChgCnt;
@@ -3827,6 +5124,20 @@ static void InspectFunc
             printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintSessionObjInfo;
             break;
 
+        case INSPECT_INSP_TYPE_EVENT_LOOP:
+            createIterFunc    = (CreateIterFunc_t)    CreateEventLoopIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetEventLoopListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextEventLoop;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintEventLoopInfo;
+            break;
+
+        case INSPECT_INSP_TYPE_EVENT_HANDLER:
+            createIterFunc    = (CreateIterFunc_t)    CreateEventLoopIter;
+            getListChgCntFunc = (GetListChgCntFunc_t) GetEventLoopListChgCnt;
+            getNextNodeFunc   = (GetNextNodeFunc_t)   GetNextEventHandler;
+            printNodeInfoFunc = (PrintNodeInfoFunc_t) PrintEventHandlerInfo;
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", inspectType);
     }
@@ -3994,6 +5305,31 @@ static void IpcInterfaceTypeHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handlers argument handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EventHandlersArgHandler
+(
+    const char* handlersArg
+)
+{
+    if (strcmp(handlersArg, "handlers") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_EVENT_HANDLER;
+
+        // Handle the next argument which should be PID.
+        le_arg_AddPositionalCallback(PidArgHandler);
+    }
+    else
+    {
+        // Assume this argument is PID.
+        PidArgHandler(handlersArg);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function called by command line argument scanner when the command argument is found.
@@ -4024,17 +5360,30 @@ static void CommandArgHandler
     {
         InspectType = INSPECT_INSP_TYPE_SEMAPHORE;
     }
+    else if (strcmp(command, "rwlocks") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_RWLOCK;
+    }
+    else if (strcmp(command, "conds") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_COND;
+    }
     else if (strcmp(command, "ipc") == 0)
     {
         le_arg_AddPositionalCallback(IpcInterfaceTypeHandler);
     }
+    else if (strcmp(command, "events") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_EVENT_LOOP;
+        le_arg_AddPositionalCallback(EventHandlersArgHandler);
+    }
     else
     {
         fprintf(stderr, "Invalid command '%s'.\n", command);
         exit(EXIT_FAILURE);
     }
 
-    if (strcmp(command, "ipc") != 0)
+    if ((strcmp(command, "ipc") != 0) && (strcmp(command, "events") != 0))
     {
         le_arg_AddPositionalCallback(PidArgHandler);
     }
@@ -4123,6 +5472,14 @@ static void InitIteratorPool
             size = sizeof(SemaphoreIter_t);
             break;
 
+        case INSPECT_INSP_TYPE_RWLOCK:
+            size = sizeof(RwLockIter_t);
+            break;
+
+        case INSPECT_INSP_TYPE_COND:
+            size = sizeof(CondIter_t);
+            break;
+
         case INSPECT_INSP_TYPE_IPC_SERVERS:
             // Make the block size big enough to accomodate either one.
             // Technically a little wasteful.
@@ -4140,6 +5497,12 @@ static void InitIteratorPool
                    sizeof(ThreadObjIter_t) : sizeof(SessionObjIter_t);
             break;
 
+        case INSPECT_INSP_TYPE_EVENT_LOOP:
+        case INSPECT_INSP_TYPE_EVENT_HANDLER:
+            // The thread obj iterator used to create an event loop iterator comes from here too.
+            size = sizeof(EventLoopIter_t);
+            break;
+
         default:
             INTERNAL_ERR("unexpected inspect type %d.", inspectType);
     }
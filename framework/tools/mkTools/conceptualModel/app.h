@@ -58,6 +58,7 @@ struct App_t
 
     // Per-user limits:
     PositiveIntLimit_t      cpuShare;           ///< Relative share value
+    CpuSet_t                cpuSet;             ///< CPUs that the app's processes can run on.
     NonNegativeIntLimit_t   maxFileSystemBytes; ///< Total bytes in sandbox tmpfs file system.
     PositiveIntLimit_t      maxMemoryBytes;     ///< Total bytes of RAM.
     NonNegativeIntLimit_t   maxMQueueBytes;     ///< Total bytes in all POSIX MQueues.
@@ -34,6 +34,7 @@ class Limit_t
 #include "watchdogTimeout.h"
 #include "watchdogAction.h"
 #include "faultAction.h"
+#include "cpuSet.h"
 #include "priority.h"
 
 
@@ -0,0 +1,85 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Implementation of the CpuSet_t class.
+ *
+ *  Copyright (C) Sierra Wireless, Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "mkTools.h"
+#include <stdlib.h>
+
+namespace model
+{
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Assignment operator.  Validates and stores the CpuSet_t value.
+ *
+ * The lexer has already checked that the list is made up of CPU numbers and ranges, so this only
+ * has to check that the ranges are the right way around.
+ *
+ * @throws mk::Exception_t if a range in the list ends before it starts.
+ */
+//--------------------------------------------------------------------------------------------------
+void CpuSet_t::operator =
+(
+    const std::string& cpuList
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* itemPtr = cpuList.c_str();
+
+    while (*itemPtr != '\0')
+    {
+        char* endPtr;
+        unsigned long first = strtoul(itemPtr, &endPtr, 10);
+        unsigned long last = first;
+
+        if (*endPtr == '-')
+        {
+            last = strtoul(endPtr + 1, &endPtr, 10);
+        }
+
+        if (last < first)
+        {
+            throw mk::Exception_t("Invalid range of CPUs '" + std::string(itemPtr, endPtr - itemPtr)
+                                  + "' in CPU list '" + cpuList + "'.");
+        }
+
+        itemPtr = (*endPtr == ',') ? endPtr + 1 : endPtr;
+    }
+
+    value = cpuList;
+    isSet = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fetches the limit value.
+ *
+ * @throw   mk::Exception_t if the limit is not set.
+ *
+ * @return  The value.
+ */
+//--------------------------------------------------------------------------------------------------
+const std::string& CpuSet_t::Get
+(
+    void
+)
+const
+//--------------------------------------------------------------------------------------------------
+{
+    if (!isSet)
+    {
+        throw mk::Exception_t("Fetching CPU set that has not been set.");
+    }
+
+    return value;
+}
+
+
+
+} // namespace model
@@ -0,0 +1,32 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Class whose objects can be used to store cpuSet settings.
+ *
+ *  Copyright (C) Sierra Wireless, Inc. Use of this work is subject to license.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef CPU_SET_H_INCLUDE_GUARD
+#define CPU_SET_H_INCLUDE_GUARD
+
+
+
+class CpuSet_t : public Limit_t
+{
+    public:
+
+        virtual ~CpuSet_t() {}
+
+    private:
+
+        std::string value;  ///< List of CPUs in the kernel's format (e.g., "0-1,3").
+
+    public:
+
+        void operator =(const std::string &cpuList);
+
+        const std::string& Get() const;
+};
+
+
+#endif  // CPU_SET_H_INCLUDE_GUARD
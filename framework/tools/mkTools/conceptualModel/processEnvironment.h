@@ -33,6 +33,9 @@ struct ProcessEnv_t
     NonNegativeIntLimit_t maxLockedMemoryBytes; ///< Maximum bytes that can be locked in RAM.
     PositiveIntLimit_t    maxFileDescriptors;   ///< Maximum number of open file descriptors.
 
+    /// CPUs that the processes can run on (within those allowed to the app).
+    CpuSet_t cpuSet;
+
     // Watchdog
     WatchdogAction_t  watchdogAction;
     WatchdogTimeout_t watchdogTimeout;
@@ -67,6 +67,11 @@ static void GenerateAppLimitsConfig
 
     cfgStream << "  \"cpuShare\" [" << appPtr->cpuShare.Get() << "]" << std::endl;
 
+    if (appPtr->cpuSet.IsSet())
+    {
+        cfgStream << "  \"cpuSet\" \"" << appPtr->cpuSet.Get() << "\"" << std::endl;
+    }
+
     if (appPtr->maxFileSystemBytes.IsSet())
     {
         // This is not supported for unsandboxed apps.
@@ -532,6 +537,12 @@ static void GenerateProcessConfig
                       << procEnvPtr->maxFileDescriptors.Get() << "]"
                       << std::endl;
 
+            if (procEnvPtr->cpuSet.IsSet())
+            {
+                cfgStream << "      \"cpuSet\" \"" << procEnvPtr->cpuSet.Get() << "\""
+                          << std::endl;
+            }
+
             if (procEnvPtr->watchdogTimeout.IsSet())
             {
                 cfgStream << "      \"watchdogTimeout\" [" << procEnvPtr->watchdogTimeout.Get()
@@ -529,6 +529,10 @@ static void AddProcessesSection
         {
             procEnvPtr->SetStartPriority(ToSimpleSectionPtr(subsectionPtr)->Text());
         }
+        else if (subsectionName == "cpuSet")
+        {
+            procEnvPtr->cpuSet = ToSimpleSectionPtr(subsectionPtr)->Text();
+        }
         else if (subsectionName == "maxCoreDumpFileBytes")
         {
             procEnvPtr->maxCoreDumpFileBytes = GetNonNegativeInt(ToSimpleSectionPtr(subsectionPtr));
@@ -996,6 +1000,10 @@ void PrintSummary
         std::cout << "    maxQueuedSignals: " << appPtr->maxQueuedSignals.Get() << std::endl;
         std::cout << "    maxMemoryBytes: " << appPtr->maxMemoryBytes.Get() << std::endl;
         std::cout << "    cpuShare: " << appPtr->cpuShare.Get() << std::endl;
+        if (appPtr->cpuSet.IsSet())
+        {
+            std::cout << "    cpuSet: " << appPtr->cpuSet.Get() << std::endl;
+        }
         std::cout << "    maxFileSystemBytes: " << appPtr->maxFileSystemBytes.Get() << std::endl;
 
         // Config Tree access.
@@ -1395,6 +1403,10 @@ model::App_t* GetApp
         {
             appPtr->cpuShare = GetPositiveInt(ToSimpleSectionPtr(sectionPtr));
         }
+        else if (sectionName == "cpuSet")
+        {
+            appPtr->cpuSet = ToSimpleSectionPtr(sectionPtr)->Text();
+        }
         else if (sectionName == "executables")
         {
             AddExecutables(appPtr, sectionPtr, buildParams);
@@ -84,6 +84,10 @@ static void ModelAppOverrides
         {
             appPtr->cpuShare = GetPositiveInt(ToSimpleSectionPtr(subsectionPtr));
         }
+        else if (subsectionName == "cpuSet")
+        {
+            appPtr->cpuSet = ToSimpleSectionPtr(subsectionPtr)->Text();
+        }
         else if (subsectionName == "faultAction")
         {
             for (auto procEnvPtr : appPtr->processEnvs)
@@ -143,6 +143,9 @@ std::string Token_t::TypeName
         case MD5_HASH:
             return "MD5 hash";
 
+        case CPU_LIST:
+            return "CPU list";
+
         default:
         {
             std::stringstream typeName;
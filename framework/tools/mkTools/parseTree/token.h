@@ -53,6 +53,7 @@ struct Token_t: public Content_t
         FLOAT,              ///< Standard  C style floating point number.
         STRING,             ///< String value quoted with a ' or a ".
         MD5_HASH,           ///< MD5 cryptographic hash/checksum.
+        CPU_LIST,           ///< List of CPU numbers and ranges (e.g., "0-1,3").
     };
 
     Type_t type;        ///< The type of token.
@@ -210,6 +210,10 @@ static parseTree::CompoundItem_t* ParseProcessesSubsection
     {
         return ParsePriority(lexer, subsectionNameTokenPtr);
     }
+    else if (subsectionName == "cpuSet")
+    {
+        return ParseSimpleSection(lexer, subsectionNameTokenPtr, parseTree::Token_t::CPU_LIST);
+    }
     else if (subsectionName == "maxCoreDumpFileBytes")
     {
         return ParseSimpleSection(lexer, subsectionNameTokenPtr, parseTree::Token_t::INTEGER);
@@ -459,6 +463,10 @@ static parseTree::CompoundItem_t* ParseSection
     {
         return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::INTEGER);
     }
+    else if (sectionName == "cpuSet")
+    {
+        return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::CPU_LIST);
+    }
     else if (sectionName == "bindings")
     {
         return ParseComplexSection(lexer, sectionNameTokenPtr, internal::ParseBinding);
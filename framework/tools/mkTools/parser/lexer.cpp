@@ -262,6 +262,9 @@ bool Lexer_t::IsMatch
 
         case parseTree::Token_t::MD5_HASH:
             return isxdigit(nextChar);
+
+        case parseTree::Token_t::CPU_LIST:
+            return (isdigit(nextChar));
     }
 
     throw mk::Exception_t("Internal bug: IsMatch(): Invalid token type requested.");
@@ -426,6 +429,11 @@ parseTree::Token_t* Lexer_t::Pull
 
             PullMd5(tokenPtr);
             break;
+
+        case parseTree::Token_t::CPU_LIST:
+
+            PullCpuList(tokenPtr);
+            break;
     }
 
     return tokenPtr;
@@ -1417,6 +1425,57 @@ void Lexer_t::PullMd5
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pull a list of CPUs from the input file and store it in the token.
+ *
+ * The list is in the same format the Linux kernel uses: comma-separated CPU numbers and ranges of
+ * CPU numbers (e.g., "0-1,3").
+ */
+//--------------------------------------------------------------------------------------------------
+void Lexer_t::PullCpuList
+(
+    parseTree::Token_t* tokenPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (;;)
+    {
+        if (!isdigit(nextChar))
+        {
+            UnexpectedChar("in CPU list.");
+        }
+
+        while (isdigit(nextChar))
+        {
+            AdvanceOneCharacter(tokenPtr);
+        }
+
+        if (nextChar == '-')
+        {
+            AdvanceOneCharacter(tokenPtr);
+
+            if (!isdigit(nextChar))
+            {
+                UnexpectedChar("at end of CPU range.");
+            }
+
+            while (isdigit(nextChar))
+            {
+                AdvanceOneCharacter(tokenPtr);
+            }
+        }
+
+        if (nextChar != ',')
+        {
+            break;
+        }
+
+        AdvanceOneCharacter(tokenPtr);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Advance the current file position by one character, appending the character into a given token's
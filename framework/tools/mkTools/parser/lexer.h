@@ -74,6 +74,7 @@ class Lexer_t
         void PullQuoted(parseTree::Token_t* tokenPtr, char quoteChar);
         void PullEnvVar(parseTree::Token_t* tokenPtr);
         void PullMd5(parseTree::Token_t* tokenPtr);
+        void PullCpuList(parseTree::Token_t* tokenPtr);
         size_t Lookahead(char* buffPtr, size_t n);
         void AdvanceOneCharacter(parseTree::Token_t* tokenPtr);
         void AdvanceOneCharacter(std::string& string);
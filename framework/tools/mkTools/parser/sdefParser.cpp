@@ -95,6 +95,10 @@ static parseTree::CompoundItem_t* ParseAppOverride
     {
         return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::INTEGER);
     }
+    else if (sectionName == "cpuSet")
+    {
+        return ParseSimpleSection(lexer, sectionNameTokenPtr, parseTree::Token_t::CPU_LIST);
+    }
     else if (sectionName == "faultAction")
     {
         return ParseFaultAction(lexer, sectionNameTokenPtr);